@@ -207,6 +207,11 @@ ifeq ($(ART_SEA_IR_MODE),true)
   art_cflags += -DART_SEA_IR_MODE=1
 endif
 
+# Size of the interface method table embedded in classes. A larger table means fewer interface
+# methods share a slot and go through a conflict table, at the cost of larger classes.
+ART_IMT_SIZE ?= 64
+art_cflags += -DIMT_SIZE=$(ART_IMT_SIZE)
+
 # Cflags for non-debug ART and ART tools.
 art_non_debug_cflags := \
   -O3
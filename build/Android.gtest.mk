@@ -24,6 +24,7 @@ include art/build/Android.common_path.mk
 GTEST_DEX_DIRECTORIES := \
   AbstractMethod \
   AllFields \
+  DeepHierarchy \
   ExceptionHandle \
   GetMethodSignature \
   Interfaces \
@@ -46,7 +47,7 @@ $(foreach dir,$(GTEST_DEX_DIRECTORIES), $(eval $(call build-art-test-dex,art-gte
   ART_TEST_HOST_GTEST_$(dir)_DEX)))
 
 # Dex file dependencies for each gtest.
-ART_GTEST_class_linker_test_DEX_DEPS := Interfaces MyClass Nested Statics StaticsFromCode
+ART_GTEST_class_linker_test_DEX_DEPS := DeepHierarchy Interfaces MyClass Nested Statics StaticsFromCode
 ART_GTEST_compiler_driver_test_DEX_DEPS := AbstractMethod
 ART_GTEST_dex_file_test_DEX_DEPS := GetMethodSignature Nested
 ART_GTEST_exception_test_DEX_DEPS := ExceptionHandle
@@ -109,18 +110,23 @@ RUNTIME_GTEST_COMMON_SRC_FILES := \
   runtime/handle_scope_test.cc \
   runtime/indenter_test.cc \
   runtime/indirect_reference_table_test.cc \
+  runtime/inline_cache_test.cc \
   runtime/instruction_set_test.cc \
   runtime/intern_table_test.cc \
   runtime/leb128_test.cc \
+  runtime/lock_contention_profiler_test.cc \
+  runtime/mapping_table_test.cc \
   runtime/mem_map_test.cc \
   runtime/mirror/dex_cache_test.cc \
   runtime/mirror/object_test.cc \
   runtime/monitor_pool_test.cc \
   runtime/monitor_test.cc \
   runtime/parsed_options_test.cc \
+  runtime/quickener_test.cc \
   runtime/reference_table_test.cc \
   runtime/thread_pool_test.cc \
   runtime/transaction_test.cc \
+  runtime/type_lookup_table_test.cc \
   runtime/utils_test.cc \
   runtime/verifier/method_verifier_test.cc \
   runtime/verifier/reg_type_test.cc \
@@ -151,6 +157,7 @@ COMPILER_GTEST_COMMON_SRC_FILES := \
   compiler/optimizing/liveness_test.cc \
   compiler/optimizing/live_interval_test.cc \
   compiler/optimizing/live_ranges_test.cc \
+  compiler/optimizing/load_store_elimination_test.cc \
   compiler/optimizing/nodes_test.cc \
   compiler/optimizing/parallel_move_test.cc \
   compiler/optimizing/pretty_printer_test.cc \
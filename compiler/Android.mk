@@ -97,6 +97,7 @@ LIBART_COMPILER_SRC_FILES := \
 	optimizing/graph_visualizer.cc \
 	optimizing/gvn.cc \
 	optimizing/instruction_simplifier.cc \
+	optimizing/load_store_elimination.cc \
 	optimizing/locations.cc \
 	optimizing/nodes.cc \
 	optimizing/optimization.cc \
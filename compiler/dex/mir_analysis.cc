@@ -1117,6 +1117,12 @@ bool MIRGraph::SkipCompilation(std::string* skip_message) {
     return true;
   }
 
+  // The driver only hands the hot methods of the profile to the compiler, do not
+  // apply any size cutoff to them.
+  if (compiler_filter == CompilerOptions::kProfiled) {
+    return false;
+  }
+
   // Set up compilation cutoffs based on current filter mode.
   size_t small_cutoff = 0;
   size_t default_cutoff = 0;
@@ -669,15 +669,23 @@ void Mir2Lir::CreateMappingTables() {
   }
 
   uint32_t total_entries = pc2dex_entries + dex2pc_entries;
-  uint32_t hdr_data_size = UnsignedLeb128Size(total_entries) + UnsignedLeb128Size(pc2dex_entries);
+  uint32_t pc2dex_index_entries = MappingTable::PcToDexIndexSize(pc2dex_entries);
+  uint32_t hdr_data_size = UnsignedLeb128Size(total_entries) + UnsignedLeb128Size(pc2dex_entries) +
+      UnsignedLeb128Size(pc2dex_index_entries) +
+      pc2dex_index_entries * MappingTable::kPcToDexIndexEntrySize;
   uint32_t data_size = hdr_data_size + pc2dex_data_size + dex2pc_data_size;
   encoded_mapping_table_.resize(data_size);
   uint8_t* write_pos = &encoded_mapping_table_[0];
   write_pos = EncodeUnsignedLeb128(write_pos, total_entries);
   write_pos = EncodeUnsignedLeb128(write_pos, pc2dex_entries);
+  write_pos = EncodeUnsignedLeb128(write_pos, pc2dex_index_entries);
+  uint8_t* index_pos = write_pos;
+  write_pos += pc2dex_index_entries * MappingTable::kPcToDexIndexEntrySize;
   DCHECK_EQ(static_cast<size_t>(write_pos - &encoded_mapping_table_[0]), hdr_data_size);
+  uint8_t* const pc2dex_start = write_pos;
   uint8_t* write_pos2 = write_pos + pc2dex_data_size;
 
+  uint32_t pc2dex_written = 0u;
   pc2dex_offset = 0u;
   pc2dex_dalvik_offset = 0u;
   dex2pc_offset = 0u;
@@ -694,6 +702,11 @@ void Mir2Lir::CreateMappingTables() {
                                      static_cast<int32_t>(pc2dex_dalvik_offset));
       pc2dex_offset = tgt_lir->offset;
       pc2dex_dalvik_offset = tgt_lir->dalvik_offset;
+      if (MappingTable::NeedsPcToDexIndexEntry(pc2dex_written, pc2dex_entries)) {
+        index_pos = MappingTable::EncodePcToDexIndexEntry(
+            index_pos, pc2dex_offset, pc2dex_dalvik_offset, write_pos - pc2dex_start);
+      }
+      ++pc2dex_written;
     }
     if (!tgt_lir->flags.is_nop && (tgt_lir->opcode == kPseudoExportedPC)) {
       DCHECK(dex2pc_offset <= tgt_lir->offset);
@@ -704,6 +717,7 @@ void Mir2Lir::CreateMappingTables() {
       dex2pc_dalvik_offset = tgt_lir->dalvik_offset;
     }
   }
+  DCHECK(index_pos == pc2dex_start);
   DCHECK_EQ(static_cast<size_t>(write_pos - &encoded_mapping_table_[0]),
             hdr_data_size + pc2dex_data_size);
   DCHECK_EQ(static_cast<size_t>(write_pos2 - &encoded_mapping_table_[0]), data_size);
@@ -717,10 +731,17 @@ void Mir2Lir::CreateMappingTables() {
     CHECK_EQ(table.PcToDexSize(), pc2dex_entries);
     auto it = table.PcToDexBegin();
     auto it2 = table.DexToPcBegin();
+    uint32_t previous_native_pc_offset = 0u;
     for (LIR* tgt_lir = first_lir_insn_; tgt_lir != NULL; tgt_lir = NEXT_LIR(tgt_lir)) {
       if (!tgt_lir->flags.is_nop && (tgt_lir->opcode == kPseudoSafepointPC)) {
         CHECK_EQ(tgt_lir->offset, it.NativePcOffset());
         CHECK_EQ(tgt_lir->dalvik_offset, it.DexPc());
+        uint32_t found_dex_pc;
+        CHECK(table.FindPcToDex(tgt_lir->offset, &found_dex_pc));
+        if (it == table.PcToDexBegin() || previous_native_pc_offset != tgt_lir->offset) {
+          CHECK_EQ(tgt_lir->dalvik_offset, found_dex_pc);
+        }
+        previous_native_pc_offset = tgt_lir->offset;
         ++it;
       }
       if (!tgt_lir->flags.is_nop && (tgt_lir->opcode == kPseudoExportedPC)) {
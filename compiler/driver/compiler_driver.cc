@@ -84,7 +84,9 @@ class CompilerDriver::AOTCompilationStats {
         resolved_instance_fields_(0), unresolved_instance_fields_(0),
         resolved_local_static_fields_(0), resolved_static_fields_(0), unresolved_static_fields_(0),
         type_based_devirtualization_(0),
-        safe_casts_(0), not_safe_casts_(0) {
+        safe_casts_(0), not_safe_casts_(0),
+        hot_methods_compiled_(0), hot_methods_not_compiled_(0),
+        cold_methods_quickened_(0), cold_methods_interpreted_(0) {
     for (size_t i = 0; i <= kMaxInvokeType; i++) {
       resolved_methods_[i] = 0;
       unresolved_methods_[i] = 0;
@@ -281,6 +283,37 @@ class CompilerDriver::AOTCompilationStats {
     not_safe_casts_++;
   }
 
+  // The buckets of the profile-guided compiler filter. These are always reported,
+  // so they are not lossy.
+  void HotMethodCompiled() {
+    MutexLock mu(Thread::Current(), stats_lock_);
+    hot_methods_compiled_++;
+  }
+
+  void HotMethodNotCompiled() {
+    MutexLock mu(Thread::Current(), stats_lock_);
+    hot_methods_not_compiled_++;
+  }
+
+  void ColdMethodQuickened() {
+    MutexLock mu(Thread::Current(), stats_lock_);
+    cold_methods_quickened_++;
+  }
+
+  void ColdMethodInterpreted() {
+    MutexLock mu(Thread::Current(), stats_lock_);
+    cold_methods_interpreted_++;
+  }
+
+  void DumpProfileBuckets() {
+    MutexLock mu(Thread::Current(), stats_lock_);
+    LOG(INFO) << "Profile-guided compilation: "
+              << hot_methods_compiled_ << " hot methods compiled, "
+              << hot_methods_not_compiled_ << " hot methods not compilable, "
+              << cold_methods_quickened_ << " cold methods quickened, "
+              << cold_methods_interpreted_ << " cold methods interpreted";
+  }
+
  private:
   Mutex stats_lock_;
 
@@ -311,6 +344,11 @@ class CompilerDriver::AOTCompilationStats {
   size_t safe_casts_;
   size_t not_safe_casts_;
 
+  size_t hot_methods_compiled_;
+  size_t hot_methods_not_compiled_;
+  size_t cold_methods_quickened_;
+  size_t cold_methods_interpreted_;
+
   DISALLOW_COPY_AND_ASSIGN(AOTCompilationStats);
 };
 
@@ -385,6 +423,11 @@ CompilerDriver::CompilerDriver(const CompilerOptions* compiler_options,
       LOG(INFO) << "Failed to load profile file " << profile_file;
     }
   }
+  if (profile_present_) {
+    profile_file_.GetTopKSamples(hot_methods_, compiler_options_->GetTopKProfileThreshold());
+  } else if (compiler_options_->GetCompilerFilter() == CompilerOptions::kProfiled) {
+    LOG(WARNING) << "No profile data for profile-guided compilation, no method will be compiled";
+  }
 }
 
 std::vector<uint8_t>* CompilerDriver::DeduplicateCode(const std::vector<uint8_t>& code) {
@@ -414,6 +457,17 @@ std::vector<uint8_t>* CompilerDriver::DeduplicateCFIInfo(const std::vector<uint8
   return dedupe_cfi_info_.Add(Thread::Current(), *cfi_info);
 }
 
+std::string CompilerDriver::GetDedupeStatsString() const {
+  std::ostringstream oss;
+  oss << dedupe_code_.DumpStats() << "\n"
+      << dedupe_src_mapping_table_.DumpStats() << "\n"
+      << dedupe_mapping_table_.DumpStats() << "\n"
+      << dedupe_vmap_table_.DumpStats() << "\n"
+      << dedupe_gc_map_.DumpStats() << "\n"
+      << dedupe_cfi_info_.DumpStats();
+  return oss.str();
+}
+
 CompilerDriver::~CompilerDriver() {
   Thread* self = Thread::Current();
   {
@@ -498,6 +552,9 @@ void CompilerDriver::CompileAll(jobject class_loader,
   if (dump_stats_) {
     stats_->Dump();
   }
+  if (compiler_options_->GetCompilerFilter() == CompilerOptions::kProfiled) {
+    stats_->DumpProfileBuckets();
+  }
 }
 
 static DexToDexCompilationLevel GetDexToDexCompilationlevel(
@@ -1973,6 +2030,9 @@ void CompilerDriver::CompileMethod(const DexFile::CodeItem* code_item, uint32_t
   uint64_t start_ns = kTimeCompileMethod ? NanoTime() : 0;
 
   if ((access_flags & kAccNative) != 0) {
+    // Pick up @FastNative and @CriticalNative so the stub matches the runtime's view.
+    access_flags |= ClassLinker::GetNativeMethodAnnotationFlags(
+        dex_file, dex_file.GetClassDef(class_def_idx), method_idx, access_flags);
     // Are we interpreting only and have support for generic JNI down calls?
     if (!compiler_options_->IsCompilationEnabled() &&
         InstructionSetHasGenericJniStub(instruction_set_)) {
@@ -1986,6 +2046,11 @@ void CompilerDriver::CompileMethod(const DexFile::CodeItem* code_item, uint32_t
   } else {
     MethodReference method_ref(&dex_file, method_idx);
     bool compile = verification_results_->IsCandidateForCompilation(method_ref, access_flags);
+    bool profile_guided = compiler_options_->GetCompilerFilter() == CompilerOptions::kProfiled;
+    if (compile && profile_guided) {
+      // Cold methods are left to the interpreter, after quickening when possible.
+      compile = IsHotMethod(PrettyMethod(method_idx, dex_file));
+    }
     if (compile) {
       // NOTE: if compiler declines to compile this method, it will return nullptr.
       compiled_method = compiler_->Compile(code_item, access_flags, invoke_type, class_def_idx,
@@ -1998,6 +2063,17 @@ void CompilerDriver::CompileMethod(const DexFile::CodeItem* code_item, uint32_t
                               method_idx, class_loader, dex_file,
                               dex_to_dex_compilation_level);
     }
+    if (profile_guided) {
+      if (compiled_method != nullptr) {
+        stats_->HotMethodCompiled();
+      } else if (compile) {
+        stats_->HotMethodNotCompiled();
+      } else if (dex_to_dex_compilation_level != kDontDexToDexCompile) {
+        stats_->ColdMethodQuickened();
+      } else {
+        stats_->ColdMethodInterpreted();
+      }
+    }
   }
   if (kTimeCompileMethod) {
     uint64_t duration_ns = NanoTime() - start_ns;
@@ -2147,6 +2223,10 @@ void CompilerDriver::InstructionSetToLLVMTarget(InstructionSet instruction_set,
     }
   }
 
+bool CompilerDriver::IsHotMethod(const std::string& method_name) const {
+  return hot_methods_.find(method_name) != hot_methods_.end();
+}
+
 bool CompilerDriver::SkipCompilation(const std::string& method_name) {
   if (!profile_present_) {
     return false;
@@ -131,6 +131,9 @@ class CompilerDriver {
     return profile_present_;
   }
 
+  // Is the method part of the top K percent of the samples of the profile?
+  bool IsHotMethod(const std::string& method_name) const;
+
   // Are we compiling and creating an image file?
   bool IsImage() const {
     return image_;
@@ -372,12 +375,18 @@ class CompilerDriver {
   std::vector<uint8_t>* DeduplicateGCMap(const std::vector<uint8_t>& code);
   std::vector<uint8_t>* DeduplicateCFIInfo(const std::vector<uint8_t>* cfi_info);
 
+  // Returns the hit rates of the deduplication sets, one line per set.
+  std::string GetDedupeStatsString() const;
+
   ProfileFile profile_file_;
   bool profile_present_;
 
   // Should the compiler run on this method given profile information?
   bool SkipCompilation(const std::string& method_name);
 
+  // Methods making up the top K percent of the samples of the profile.
+  std::set<std::string> hot_methods_;
+
  private:
   // These flags are internal to CompilerDriver for collecting INVOKE resolution statistics.
   // The only external contract is that unresolved method has flags 0 and resolved non-0.
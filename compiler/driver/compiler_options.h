@@ -34,6 +34,7 @@ class CompilerOptions FINAL {
     kSpeed,               // Maximize runtime performance.
     kEverything,          // Force compilation (Note: excludes compilation of class initializers).
     kTime,                // Compile methods, but minimize compilation time.
+    kProfiled,            // Compile only the hot methods of the profile, interpret the others.
   };
 
   // Guide heuristics to determine whether to compile method if profile data not available.
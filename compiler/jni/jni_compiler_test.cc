@@ -169,6 +169,9 @@ class JniCompilerTest : public CommonCompilerTest {
   void StackArgsIntsFirstImpl();
   void StackArgsFloatsFirstImpl();
   void StackArgsMixedImpl();
+  void FastNativeMethodImpl();
+  void CriticalNativeMethodImpl();
+  void CriticalNativeMixedArgsImpl();
 
   JNIEnv* env_;
   jmethodID jmethod_;
@@ -1732,4 +1735,80 @@ void JniCompilerTest::StackArgsMixedImpl() {
 
 JNI_TEST(StackArgsMixed)
 
+int gJava_MyClassNatives_fastII_calls = 0;
+jint Java_MyClassNatives_fastII(JNIEnv* env, jobject thisObj, jint x, jint y) {
+  // @FastNative methods run without leaving the Runnable state.
+  EXPECT_EQ(kRunnable, Thread::Current()->GetState());
+  EXPECT_EQ(Thread::Current()->GetJniEnv(), env);
+  EXPECT_TRUE(thisObj != nullptr);
+  gJava_MyClassNatives_fastII_calls++;
+  return x - y;  // non-commutative operator
+}
+
+void JniCompilerTest::FastNativeMethodImpl() {
+  TEST_DISABLED_FOR_PORTABLE();
+  SetUpForTest(false, "fastII", "(II)I",
+               reinterpret_cast<void*>(&Java_MyClassNatives_fastII));
+
+  {
+    ScopedObjectAccess soa(Thread::Current());
+    EXPECT_TRUE(soa.DecodeMethod(jmethod_)->IsFastNative());
+  }
+  EXPECT_EQ(0, gJava_MyClassNatives_fastII_calls);
+  jint result = env_->CallNonvirtualIntMethod(jobj_, jklass_, jmethod_, 99, 10);
+  EXPECT_EQ(99 - 10, result);
+  EXPECT_EQ(1, gJava_MyClassNatives_fastII_calls);
+
+  gJava_MyClassNatives_fastII_calls = 0;
+}
+
+JNI_TEST(FastNativeMethod)
+
+int gJava_MyClassNatives_criticalSJI_calls = 0;
+jlong Java_MyClassNatives_criticalSJI(jlong x, jint y) {
+  // @CriticalNative methods get neither a JNIEnv* nor a jclass.
+  EXPECT_EQ(kRunnable, Thread::Current()->GetState());
+  gJava_MyClassNatives_criticalSJI_calls++;
+  return x - y;  // non-commutative operator
+}
+
+void JniCompilerTest::CriticalNativeMethodImpl() {
+  TEST_DISABLED_FOR_PORTABLE();
+  SetUpForTest(true, "criticalSJI", "(JI)J",
+               reinterpret_cast<void*>(&Java_MyClassNatives_criticalSJI));
+
+  {
+    ScopedObjectAccess soa(Thread::Current());
+    EXPECT_TRUE(soa.DecodeMethod(jmethod_)->IsCriticalNative());
+  }
+  EXPECT_EQ(0, gJava_MyClassNatives_criticalSJI_calls);
+  jlong a = INT64_C(0x1234567890ABCDEF);
+  jlong result = env_->CallStaticLongMethod(jklass_, jmethod_, a, 0x13579);
+  EXPECT_EQ(a - 0x13579, result);
+  EXPECT_EQ(1, gJava_MyClassNatives_criticalSJI_calls);
+  result = env_->CallStaticLongMethod(jklass_, jmethod_, INT64_C(-1), -1);
+  EXPECT_EQ(0, result);
+  EXPECT_EQ(2, gJava_MyClassNatives_criticalSJI_calls);
+
+  gJava_MyClassNatives_criticalSJI_calls = 0;
+}
+
+JNI_TEST(CriticalNativeMethod)
+
+jdouble Java_MyClassNatives_criticalSIDIF(jint i1, jdouble d, jint i2, jfloat f) {
+  EXPECT_EQ(kRunnable, Thread::Current()->GetState());
+  return i1 * d - i2 * f;
+}
+
+void JniCompilerTest::CriticalNativeMixedArgsImpl() {
+  TEST_DISABLED_FOR_PORTABLE();
+  SetUpForTest(true, "criticalSIDIF", "(IDIF)D",
+               reinterpret_cast<void*>(&Java_MyClassNatives_criticalSIDIF));
+
+  jdouble result = env_->CallStaticDoubleMethod(jklass_, jmethod_, 3, 1.5, 2, 0.25f);
+  EXPECT_EQ(3 * 1.5 - 2 * 0.25, result);
+}
+
+JNI_TEST(CriticalNativeMixedArgs)
+
 }  // namespace art
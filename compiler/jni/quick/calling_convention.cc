@@ -101,20 +101,25 @@ bool ManagedRuntimeCallingConvention::IsCurrentParamALong() {
 // JNI calling convention
 
 JniCallingConvention* JniCallingConvention::Create(bool is_static, bool is_synchronized,
-                                                   const char* shorty,
+                                                   bool is_critical_native, const char* shorty,
                                                    InstructionSet instruction_set) {
   switch (instruction_set) {
     case kArm:
     case kThumb2:
-      return new arm::ArmJniCallingConvention(is_static, is_synchronized, shorty);
+      return new arm::ArmJniCallingConvention(is_static, is_synchronized, is_critical_native,
+                                              shorty);
     case kArm64:
-      return new arm64::Arm64JniCallingConvention(is_static, is_synchronized, shorty);
+      return new arm64::Arm64JniCallingConvention(is_static, is_synchronized, is_critical_native,
+                                                  shorty);
     case kMips:
-      return new mips::MipsJniCallingConvention(is_static, is_synchronized, shorty);
+      return new mips::MipsJniCallingConvention(is_static, is_synchronized, is_critical_native,
+                                                shorty);
     case kX86:
-      return new x86::X86JniCallingConvention(is_static, is_synchronized, shorty);
+      return new x86::X86JniCallingConvention(is_static, is_synchronized, is_critical_native,
+                                              shorty);
     case kX86_64:
-      return new x86_64::X86_64JniCallingConvention(is_static, is_synchronized, shorty);
+      return new x86_64::X86_64JniCallingConvention(is_static, is_synchronized, is_critical_native,
+                                                    shorty);
     default:
       LOG(FATAL) << "Unknown InstructionSet: " << instruction_set;
       return NULL;
@@ -122,6 +127,9 @@ JniCallingConvention* JniCallingConvention::Create(bool is_static, bool is_synch
 }
 
 size_t JniCallingConvention::ReferenceCount() const {
+  if (is_critical_native_) {
+    return 0;  // No references, not even the jclass.
+  }
   return NumReferenceArgs() + (IsStatic() ? 1 : 0);
 }
 
@@ -136,6 +144,9 @@ FrameOffset JniCallingConvention::ReturnValueSaveLocation() const {
 }
 
 bool JniCallingConvention::HasNext() {
+  if (is_critical_native_) {
+    return itr_args_ < NumArgs();
+  }
   if (itr_args_ <= kObjectOrClass) {
     return true;
   } else {
@@ -146,7 +157,7 @@ bool JniCallingConvention::HasNext() {
 
 void JniCallingConvention::Next() {
   CHECK(HasNext());
-  if (itr_args_ > kObjectOrClass) {
+  if (is_critical_native_ || itr_args_ > kObjectOrClass) {
     int arg_pos = itr_args_ - NumberOfExtraArgumentsForJni();
     if (IsParamALongOrDouble(arg_pos)) {
       itr_longs_and_doubles_++;
@@ -164,6 +175,9 @@ void JniCallingConvention::Next() {
 }
 
 bool JniCallingConvention::IsCurrentParamAReference() {
+  if (is_critical_native_) {
+    return IsParamAReference(itr_args_);
+  }
   switch (itr_args_) {
     case kJniEnv:
       return false;  // JNIEnv*
@@ -177,10 +191,13 @@ bool JniCallingConvention::IsCurrentParamAReference() {
 }
 
 bool JniCallingConvention::IsCurrentParamJniEnv() {
-  return (itr_args_ == kJniEnv);
+  return !is_critical_native_ && (itr_args_ == kJniEnv);
 }
 
 bool JniCallingConvention::IsCurrentParamAFloatOrDouble() {
+  if (is_critical_native_) {
+    return IsParamAFloatOrDouble(itr_args_);
+  }
   switch (itr_args_) {
     case kJniEnv:
       return false;  // JNIEnv*
@@ -194,6 +211,9 @@ bool JniCallingConvention::IsCurrentParamAFloatOrDouble() {
 }
 
 bool JniCallingConvention::IsCurrentParamADouble() {
+  if (is_critical_native_) {
+    return IsParamADouble(itr_args_);
+  }
   switch (itr_args_) {
     case kJniEnv:
       return false;  // JNIEnv*
@@ -207,6 +227,9 @@ bool JniCallingConvention::IsCurrentParamADouble() {
 }
 
 bool JniCallingConvention::IsCurrentParamALong() {
+  if (is_critical_native_) {
+    return IsParamALong(itr_args_);
+  }
   switch (itr_args_) {
     case kJniEnv:
       return false;  // JNIEnv*
@@ -230,7 +253,7 @@ FrameOffset JniCallingConvention::CurrentParamHandleScopeEntryOffset() {
 }
 
 size_t JniCallingConvention::CurrentParamSize() {
-  if (itr_args_ <= kObjectOrClass) {
+  if (!is_critical_native_ && itr_args_ <= kObjectOrClass) {
     return frame_pointer_size_;  // JNIEnv or jobject/jclass
   } else {
     int arg_pos = itr_args_ - NumberOfExtraArgumentsForJni();
@@ -241,6 +264,10 @@ size_t JniCallingConvention::CurrentParamSize() {
 size_t JniCallingConvention::NumberOfExtraArgumentsForJni() {
   // The first argument is the JNIEnv*.
   // Static methods have an extra argument which is the jclass.
+  // Critical natives have neither.
+  if (is_critical_native_) {
+    return 0;
+  }
   return IsStatic() ? 2 : 1;
 }
 
@@ -51,6 +51,116 @@ static void SetNativeParameter(Assembler* jni_asm,
                                JniCallingConvention* jni_conv,
                                ManagedRegister in_reg);
 
+// Generate the JNI bridge for a critical native method. Such methods are static, unsynchronized
+// and only take and return primitives, so the bridge needs neither a handle scope nor the JNIEnv*
+// and jclass arguments, and calls the native code without leaving the Runnable state.
+static CompiledMethod* ArtJniCompileCriticalNativeMethod(CompilerDriver* driver,
+                                                         const char* shorty) {
+  InstructionSet instruction_set = driver->GetInstructionSet();
+  const bool is_64_bit_target = Is64BitInstructionSet(instruction_set);
+  std::unique_ptr<JniCallingConvention> main_jni_conv(
+      JniCallingConvention::Create(true, false, true, shorty, instruction_set));
+  CHECK(!main_jni_conv->IsReturnAReference());
+  std::unique_ptr<ManagedRuntimeCallingConvention> mr_conv(
+      ManagedRuntimeCallingConvention::Create(true, false, shorty, instruction_set));
+
+  // Assembler that holds generated instructions
+  std::unique_ptr<Assembler> jni_asm(Assembler::Create(instruction_set));
+  jni_asm->InitializeFrameDescriptionEntry();
+
+  // 1. Build the frame saving all callee saves
+  const size_t frame_size(main_jni_conv->FrameSize());
+  const std::vector<ManagedRegister>& callee_save_regs = main_jni_conv->CalleeSaveRegisters();
+  __ BuildFrame(frame_size, mr_conv->MethodRegister(), callee_save_regs, mr_conv->EntrySpills());
+
+  // 2. Write out the end of the quick frames, the native code may still need to be looked up and
+  //    that may throw.
+  if (is_64_bit_target) {
+    __ StoreStackPointerToThread64(Thread::TopOfManagedStackOffset<8>());
+  } else {
+    __ StoreStackPointerToThread32(Thread::TopOfManagedStackOffset<4>());
+  }
+
+  // 3. Move frame down to allow space for out going args.
+  const size_t out_arg_size = main_jni_conv->OutArgSize();
+  __ IncreaseFrameSize(out_arg_size);
+
+  // 4. Shuffle the arguments, doing a backward pass as for regular native methods.
+  mr_conv->ResetIterator(FrameOffset(frame_size + out_arg_size));
+  uint32_t args_count = 0;
+  while (mr_conv->HasNext()) {
+    args_count++;
+    mr_conv->Next();
+  }
+  for (uint32_t i = 0; i < args_count; ++i) {
+    mr_conv->ResetIterator(FrameOffset(frame_size + out_arg_size));
+    main_jni_conv->ResetIterator(FrameOffset(out_arg_size));
+    for (uint32_t j = 0; j < args_count - i - 1; ++j) {
+      mr_conv->Next();
+      main_jni_conv->Next();
+    }
+    CopyParameter(jni_asm.get(), mr_conv.get(), main_jni_conv.get(), frame_size, out_arg_size);
+  }
+
+  // 5. Plant call to native code associated with method.
+  main_jni_conv->ResetIterator(FrameOffset(out_arg_size));
+  __ Call(main_jni_conv->MethodStackOffset(), mirror::ArtMethod::NativeMethodOffset(),
+          mr_conv->InterproceduralScratchRegister());
+
+  // 6. Fix differences in result widths.
+  if (main_jni_conv->RequiresSmallResultTypeExtension()) {
+    if (main_jni_conv->GetReturnType() == Primitive::kPrimByte ||
+        main_jni_conv->GetReturnType() == Primitive::kPrimShort) {
+      __ SignExtend(main_jni_conv->ReturnRegister(),
+                    Primitive::ComponentSize(main_jni_conv->GetReturnType()));
+    } else if (main_jni_conv->GetReturnType() == Primitive::kPrimBoolean ||
+               main_jni_conv->GetReturnType() == Primitive::kPrimChar) {
+      __ ZeroExtend(main_jni_conv->ReturnRegister(),
+                    Primitive::ComponentSize(main_jni_conv->GetReturnType()));
+    }
+  }
+
+  // 7. Move the result to the managed return register, going through the frame if the native
+  //    and managed conventions disagree.
+  if (main_jni_conv->SizeOfReturnValue() != 0 &&
+      !main_jni_conv->ReturnRegister().Equals(mr_conv->ReturnRegister())) {
+    FrameOffset return_save_location = main_jni_conv->ReturnValueSaveLocation();
+    if (instruction_set == kMips && main_jni_conv->GetReturnType() == Primitive::kPrimDouble &&
+        return_save_location.Uint32Value() % 8 != 0) {
+      // Ensure doubles are 8-byte aligned for MIPS
+      return_save_location = FrameOffset(return_save_location.Uint32Value() + kMipsPointerSize);
+    }
+    CHECK_LT(return_save_location.Uint32Value(), frame_size + out_arg_size);
+    __ Store(return_save_location, main_jni_conv->ReturnRegister(),
+             main_jni_conv->SizeOfReturnValue());
+    __ Load(mr_conv->ReturnRegister(), return_save_location, mr_conv->SizeOfReturnValue());
+  }
+
+  // 8. Move frame up now we're done with the out arg space.
+  __ DecreaseFrameSize(out_arg_size);
+
+  // 9. Process a pending exception from looking up the native code.
+  __ ExceptionPoll(main_jni_conv->InterproceduralScratchRegister(), 0);
+
+  // 10. Remove activation.
+  __ RemoveFrame(frame_size, callee_save_regs);
+
+  // 11. Finalize code generation
+  __ EmitSlowPaths();
+  size_t cs = __ CodeSize();
+  std::vector<uint8_t> managed_code(cs);
+  MemoryRegion code(&managed_code[0], managed_code.size());
+  __ FinalizeInstructions(code);
+  jni_asm->FinalizeFrameDescriptionEntry();
+  return new CompiledMethod(driver,
+                            instruction_set,
+                            managed_code,
+                            frame_size,
+                            main_jni_conv->CoreSpillMask(),
+                            main_jni_conv->FpSpillMask(),
+                            jni_asm->GetFrameDescriptionEntry());
+}
+
 // Generate the JNI bridge for the given method, general contract:
 // - Arguments are in the managed runtime format, either on stack or in
 //   registers, a reference to the method object is supplied as part of this
@@ -64,11 +174,15 @@ CompiledMethod* ArtJniCompileMethodInternal(CompilerDriver* driver,
   const bool is_static = (access_flags & kAccStatic) != 0;
   const bool is_synchronized = (access_flags & kAccSynchronized) != 0;
   const char* shorty = dex_file.GetMethodShorty(dex_file.GetMethodId(method_idx));
+  if ((access_flags & kAccCriticalNative) != 0) {
+    CHECK(is_static && !is_synchronized) << PrettyMethod(method_idx, dex_file);
+    return ArtJniCompileCriticalNativeMethod(driver, shorty);
+  }
   InstructionSet instruction_set = driver->GetInstructionSet();
   const bool is_64_bit_target = Is64BitInstructionSet(instruction_set);
   // Calling conventions used to iterate over parameters to method
   std::unique_ptr<JniCallingConvention> main_jni_conv(
-      JniCallingConvention::Create(is_static, is_synchronized, shorty, instruction_set));
+      JniCallingConvention::Create(is_static, is_synchronized, false, shorty, instruction_set));
   bool reference_return = main_jni_conv->IsReturnAReference();
 
   std::unique_ptr<ManagedRuntimeCallingConvention> mr_conv(
@@ -88,7 +202,8 @@ CompiledMethod* ArtJniCompileMethodInternal(CompilerDriver* driver,
   }
 
   std::unique_ptr<JniCallingConvention> end_jni_conv(
-      JniCallingConvention::Create(is_static, is_synchronized, jni_end_shorty, instruction_set));
+      JniCallingConvention::Create(is_static, is_synchronized, false, jni_end_shorty,
+                                   instruction_set));
 
   // Assembler that holds generated instructions
   std::unique_ptr<Assembler> jni_asm(Assembler::Create(instruction_set));
@@ -37,6 +37,7 @@
 #include "safe_map.h"
 #include "scoped_thread_state_change.h"
 #include "handle_scope-inl.h"
+#include "type_lookup_table.h"
 #include "utils/arm/assembler_thumb2.h"
 #include "utils/arm64/assembler_arm64.h"
 #include "verifier/method_verifier.h"
@@ -430,11 +431,14 @@ OatWriter::OatWriter(const std::vector<const DexFile*>& dex_files,
     size_oat_dex_file_location_data_(0),
     size_oat_dex_file_location_checksum_(0),
     size_oat_dex_file_offset_(0),
+    size_oat_dex_file_lookup_table_offset_(0),
     size_oat_dex_file_methods_offsets_(0),
     size_oat_class_type_(0),
     size_oat_class_status_(0),
     size_oat_class_method_bitmaps_(0),
     size_oat_class_method_offsets_(0),
+    size_oat_lookup_table_alignment_(0),
+    size_oat_lookup_table_(0),
     method_offset_map_() {
   CHECK(key_value_store != nullptr);
 
@@ -469,6 +473,10 @@ OatWriter::OatWriter(const std::vector<const DexFile*>& dex_files,
     TimingLogger::ScopedTiming split("InitDexFiles", timings);
     offset = InitDexFiles(offset);
   }
+  {
+    TimingLogger::ScopedTiming split("InitLookupTables", timings);
+    offset = InitLookupTables(offset);
+  }
   {
     TimingLogger::ScopedTiming split("InitOatClasses", timings);
     offset = InitOatClasses(offset);
@@ -612,7 +620,15 @@ class OatWriter::OatDexMethodVisitor : public DexMethodVisitor {
   OatDexMethodVisitor(OatWriter* writer, size_t offset)
     : DexMethodVisitor(writer, offset),
       oat_class_index_(0u),
-      method_offsets_index_(0u) {
+      method_offsets_index_(0u),
+      code_section_(kHotCodeSection) {
+  }
+
+  // Prepares for another visit of all the methods, processing the code of the
+  // given section only.
+  void StartCodeSection(CodeSection code_section) {
+    oat_class_index_ = 0u;
+    code_section_ = code_section;
   }
 
   bool StartClass(const DexFile* dex_file, size_t class_def_index) {
@@ -628,8 +644,18 @@ class OatWriter::OatDexMethodVisitor : public DexMethodVisitor {
   }
 
  protected:
+  bool IsInCodeSection(const OatClass* oat_class) const {
+    DCHECK_LT(method_offsets_index_, oat_class->code_sections_.size());
+    return oat_class->code_sections_[method_offsets_index_] == code_section_;
+  }
+
+  bool IsLastCodeSection() const {
+    return static_cast<size_t>(code_section_) + 1u == writer_->NumberOfCodeSections();
+  }
+
   size_t oat_class_index_;
   size_t method_offsets_index_;
+  CodeSection code_section_;
 };
 
 class OatWriter::InitOatClassesMethodVisitor : public DexMethodVisitor {
@@ -637,13 +663,16 @@ class OatWriter::InitOatClassesMethodVisitor : public DexMethodVisitor {
   InitOatClassesMethodVisitor(OatWriter* writer, size_t offset)
     : DexMethodVisitor(writer, offset),
       compiled_methods_(),
+      code_sections_(),
       num_non_null_compiled_methods_(0u) {
     compiled_methods_.reserve(256u);
+    code_sections_.reserve(256u);
   }
 
   bool StartClass(const DexFile* dex_file, size_t class_def_index) {
     DexMethodVisitor::StartClass(dex_file, class_def_index);
     compiled_methods_.clear();
+    code_sections_.clear();
     num_non_null_compiled_methods_ = 0u;
     return true;
   }
@@ -659,6 +688,7 @@ class OatWriter::InitOatClassesMethodVisitor : public DexMethodVisitor {
     compiled_methods_.push_back(compiled_method);
     if (compiled_method != nullptr) {
         ++num_non_null_compiled_methods_;
+        code_sections_.push_back(writer_->GetCodeSection(*dex_file_, it));
     }
     return true;
   }
@@ -677,6 +707,7 @@ class OatWriter::InitOatClassesMethodVisitor : public DexMethodVisitor {
 
     OatClass* oat_class = new OatClass(offset_, compiled_methods_,
                                        num_non_null_compiled_methods_, status);
+    oat_class->code_sections_.swap(code_sections_);
     writer_->oat_classes_.push_back(oat_class);
     oat_class->UpdateChecksum(writer_->oat_header_);
     offset_ += oat_class->SizeOf();
@@ -685,6 +716,7 @@ class OatWriter::InitOatClassesMethodVisitor : public DexMethodVisitor {
 
  private:
   std::vector<CompiledMethod*> compiled_methods_;
+  std::vector<CodeSection> code_sections_;
   size_t num_non_null_compiled_methods_;
 };
 
@@ -698,7 +730,7 @@ class OatWriter::InitCodeMethodVisitor : public OatDexMethodVisitor {
 
   bool EndClass() {
     OatDexMethodVisitor::EndClass();
-    if (oat_class_index_ == writer_->oat_classes_.size()) {
+    if (oat_class_index_ == writer_->oat_classes_.size() && IsLastCodeSection()) {
       offset_ = writer_->relative_call_patcher_->ReserveSpace(offset_, nullptr);
     }
     return true;
@@ -709,7 +741,10 @@ class OatWriter::InitCodeMethodVisitor : public OatDexMethodVisitor {
     OatClass* oat_class = writer_->oat_classes_[oat_class_index_];
     CompiledMethod* compiled_method = oat_class->GetCompiledMethod(class_def_method_index);
 
-    if (compiled_method != nullptr) {
+    if (compiled_method != nullptr && !IsInCodeSection(oat_class)) {
+      // Laid out with another section.
+      ++method_offsets_index_;
+    } else if (compiled_method != nullptr) {
       // Derived from CompiledMethod.
       uint32_t quick_code_offset = 0;
 
@@ -970,7 +1005,7 @@ class OatWriter::WriteCodeMethodVisitor : public OatDexMethodVisitor {
 
   bool EndClass() SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
     bool result = OatDexMethodVisitor::EndClass();
-    if (oat_class_index_ == writer_->oat_classes_.size()) {
+    if (oat_class_index_ == writer_->oat_classes_.size() && IsLastCodeSection()) {
       DCHECK(result);  // OatDexMethodVisitor::EndClass() never fails.
       offset_ = writer_->relative_call_patcher_->WriteThunks(out_, offset_);
       if (UNLIKELY(offset_ == 0u)) {
@@ -986,7 +1021,10 @@ class OatWriter::WriteCodeMethodVisitor : public OatDexMethodVisitor {
     OatClass* oat_class = writer_->oat_classes_[oat_class_index_];
     const CompiledMethod* compiled_method = oat_class->GetCompiledMethod(class_def_method_index);
 
-    if (compiled_method != NULL) {  // ie. not an abstract method
+    if (compiled_method != NULL && !IsInCodeSection(oat_class)) {
+      // Written with another section.
+      ++method_offsets_index_;
+    } else if (compiled_method != NULL) {  // ie. not an abstract method
       size_t file_offset = file_offset_;
       OutputStream* out = out_;
 
@@ -1199,6 +1237,24 @@ class OatWriter::WriteMapMethodVisitor : public OatDexMethodVisitor {
   }
 };
 
+size_t OatWriter::NumberOfCodeSections() const {
+  return compiler_driver_->ProfilePresent() ? static_cast<size_t>(kCodeSectionCount) : 1u;
+}
+
+OatWriter::CodeSection OatWriter::GetCodeSection(const DexFile& dex_file,
+                                                 const ClassDataItemIterator& it) const {
+  if (!compiler_driver_->ProfilePresent() ||
+      compiler_driver_->IsHotMethod(PrettyMethod(it.GetMemberIndex(), dex_file))) {
+    return kHotCodeSection;
+  }
+  const DexFile::CodeItem* code_item = it.GetMethodCodeItem();
+  if (code_item != nullptr &&
+      compiler_driver_->GetCompilerOptions().IsHugeMethod(code_item->insns_size_in_code_units_)) {
+    return kHugeCodeSection;
+  }
+  return kColdCodeSection;
+}
+
 // Visit all methods from all classes in all dex files with the specified visitor.
 bool OatWriter::VisitDexMethods(DexMethodVisitor* visitor) {
   for (const DexFile* dex_file : *dex_files_) {
@@ -1281,6 +1337,25 @@ size_t OatWriter::InitDexFiles(size_t offset) {
   return offset;
 }
 
+size_t OatWriter::InitLookupTables(size_t offset) {
+  for (size_t i = 0; i != dex_files_->size(); ++i) {
+    const DexFile* dex_file = (*dex_files_)[i];
+    if (!TypeLookupTable::SupportedSize(dex_file->NumClassDefs())) {
+      continue;
+    }
+    // the tables are arrays of 4 byte aligned entries
+    size_t original_offset = offset;
+    offset = RoundUp(offset, 4);
+    size_oat_lookup_table_alignment_ += offset - original_offset;
+
+    OatDexFile* oat_dex_file = oat_dex_files_[i];
+    oat_dex_file->lookup_table_offset_ = offset;
+    oat_dex_file->lookup_table_.reset(TypeLookupTable::Create(*dex_file));
+    offset += oat_dex_file->lookup_table_->RawDataLength();
+  }
+  return offset;
+}
+
 size_t OatWriter::InitOatClasses(size_t offset) {
   // calculate the offsets within OatDexFiles to OatClasses
   InitOatClassesMethodVisitor visitor(this, offset);
@@ -1377,7 +1452,14 @@ size_t OatWriter::InitOatCodeDexFiles(size_t offset) {
       offset = visitor.GetOffset();                   \
     } while (false)
 
-  VISIT(InitCodeMethodVisitor);
+  InitCodeMethodVisitor code_visitor(this, offset);
+  for (size_t i = 0; i != NumberOfCodeSections(); ++i) {
+    code_visitor.StartCodeSection(static_cast<CodeSection>(i));
+    bool success = VisitDexMethods(&code_visitor);
+    DCHECK(success);
+    VLOG(compiler) << "Code section " << i << " ends at offset " << code_visitor.GetOffset();
+  }
+  offset = code_visitor.GetOffset();
   if (compiler_driver_->IsImage()) {
     VISIT(InitImageMethodVisitor);
   }
@@ -1472,11 +1554,14 @@ bool OatWriter::Write(OutputStream* out) {
     DO_STAT(size_oat_dex_file_location_data_);
     DO_STAT(size_oat_dex_file_location_checksum_);
     DO_STAT(size_oat_dex_file_offset_);
+    DO_STAT(size_oat_dex_file_lookup_table_offset_);
     DO_STAT(size_oat_dex_file_methods_offsets_);
     DO_STAT(size_oat_class_type_);
     DO_STAT(size_oat_class_status_);
     DO_STAT(size_oat_class_method_bitmaps_);
     DO_STAT(size_oat_class_method_offsets_);
+    DO_STAT(size_oat_lookup_table_alignment_);
+    DO_STAT(size_oat_lookup_table_);
     #undef DO_STAT
 
     VLOG(compiler) << "size_total=" << PrettySize(size_total) << " (" << size_total << "B)"; \
@@ -1530,6 +1615,28 @@ bool OatWriter::WriteTables(OutputStream* out, const size_t file_offset) {
     }
     size_dex_file_ += dex_file->GetHeader().file_size_;
   }
+  for (size_t i = 0; i != oat_dex_files_.size(); ++i) {
+    const OatDexFile* oat_dex_file = oat_dex_files_[i];
+    if (oat_dex_file->lookup_table_.get() == nullptr) {
+      continue;
+    }
+    uint32_t expected_offset = file_offset + oat_dex_file->lookup_table_offset_;
+    off_t actual_offset = out->Seek(expected_offset, kSeekSet);
+    if (static_cast<uint32_t>(actual_offset) != expected_offset) {
+      const DexFile* dex_file = (*dex_files_)[i];
+      PLOG(ERROR) << "Failed to seek to lookup table section. Actual: " << actual_offset
+                  << " Expected: " << expected_offset << " File: " << dex_file->GetLocation();
+      return false;
+    }
+    const TypeLookupTable* lookup_table = oat_dex_file->lookup_table_.get();
+    if (!out->WriteFully(lookup_table->RawData(), lookup_table->RawDataLength())) {
+      const DexFile* dex_file = (*dex_files_)[i];
+      PLOG(ERROR) << "Failed to write lookup table for " << dex_file->GetLocation()
+                  << " to " << out->GetLocation();
+      return false;
+    }
+    size_oat_lookup_table_ += lookup_table->RawDataLength();
+  }
   for (size_t i = 0; i != oat_classes_.size(); ++i) {
     if (!oat_classes_[i]->Write(this, out, file_offset)) {
       PLOG(ERROR) << "Failed to write oat methods information to " << out->GetLocation();
@@ -1613,20 +1720,14 @@ size_t OatWriter::WriteCode(OutputStream* out, const size_t file_offset, size_t
 size_t OatWriter::WriteCodeDexFiles(OutputStream* out,
                                     const size_t file_offset,
                                     size_t relative_offset) {
-  #define VISIT(VisitorType)                                              \
-    do {                                                                  \
-      VisitorType visitor(this, out, file_offset, relative_offset);       \
-      if (UNLIKELY(!VisitDexMethods(&visitor))) {                         \
-        return 0;                                                         \
-      }                                                                   \
-      relative_offset = visitor.GetOffset();                              \
-    } while (false)
-
-  VISIT(WriteCodeMethodVisitor);
-
-  #undef VISIT
-
-  return relative_offset;
+  WriteCodeMethodVisitor visitor(this, out, file_offset, relative_offset);
+  for (size_t i = 0; i != NumberOfCodeSections(); ++i) {
+    visitor.StartCodeSection(static_cast<CodeSection>(i));
+    if (UNLIKELY(!VisitDexMethods(&visitor))) {
+      return 0;
+    }
+  }
+  return visitor.GetOffset();
 }
 
 bool OatWriter::WriteCodeAlignment(OutputStream* out, uint32_t aligned_code_delta) {
@@ -1648,14 +1749,19 @@ OatWriter::OatDexFile::OatDexFile(size_t offset, const DexFile& dex_file) {
   dex_file_location_data_ = reinterpret_cast<const uint8_t*>(location.data());
   dex_file_location_checksum_ = dex_file.GetLocationChecksum();
   dex_file_offset_ = 0;
+  lookup_table_offset_ = 0;
   methods_offsets_.resize(dex_file.NumClassDefs());
 }
 
+OatWriter::OatDexFile::~OatDexFile() {
+}
+
 size_t OatWriter::OatDexFile::SizeOf() const {
   return sizeof(dex_file_location_size_)
           + dex_file_location_size_
           + sizeof(dex_file_location_checksum_)
           + sizeof(dex_file_offset_)
+          + sizeof(lookup_table_offset_)
           + (sizeof(methods_offsets_[0]) * methods_offsets_.size());
 }
 
@@ -1664,6 +1770,7 @@ void OatWriter::OatDexFile::UpdateChecksum(OatHeader* oat_header) const {
   oat_header->UpdateChecksum(dex_file_location_data_, dex_file_location_size_);
   oat_header->UpdateChecksum(&dex_file_location_checksum_, sizeof(dex_file_location_checksum_));
   oat_header->UpdateChecksum(&dex_file_offset_, sizeof(dex_file_offset_));
+  oat_header->UpdateChecksum(&lookup_table_offset_, sizeof(lookup_table_offset_));
   oat_header->UpdateChecksum(&methods_offsets_[0],
                             sizeof(methods_offsets_[0]) * methods_offsets_.size());
 }
@@ -1692,6 +1799,11 @@ bool OatWriter::OatDexFile::Write(OatWriter* oat_writer,
     return false;
   }
   oat_writer->size_oat_dex_file_offset_ += sizeof(dex_file_offset_);
+  if (!out->WriteFully(&lookup_table_offset_, sizeof(lookup_table_offset_))) {
+    PLOG(ERROR) << "Failed to write lookup table offset to " << out->GetLocation();
+    return false;
+  }
+  oat_writer->size_oat_dex_file_lookup_table_offset_ += sizeof(lookup_table_offset_);
   if (!out->WriteFully(&methods_offsets_[0],
                       sizeof(methods_offsets_[0]) * methods_offsets_.size())) {
     PLOG(ERROR) << "Failed to write methods offsets to " << out->GetLocation();
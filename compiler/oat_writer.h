@@ -34,6 +34,7 @@ class BitVector;
 class CompiledMethod;
 class ImageWriter;
 class OutputStream;
+class TypeLookupTable;
 
 // OatHeader         variable length with count of D OatDexFiles
 //
@@ -47,6 +48,11 @@ class OutputStream;
 // ...
 // Dex[D]
 //
+// TypeLookupTable[0] one descriptor to class def hash table for each DexFile, if it has class
+// TypeLookupTable[1] defs. These are 4 byte aligned.
+// ...
+// TypeLookupTable[D]
+//
 // OatClass[0]       one variable sized OatClass for each of C DexFile::ClassDefs
 // OatClass[1]       contains OatClass entries with class status, offsets to code, etc.
 // ...
@@ -136,6 +142,20 @@ class OatWriter {
   struct MappingTableDataAccess;
   struct VmapTableDataAccess;
 
+  // When a profile is available, the compiled code is laid out in sections so that
+  // the code of the hot methods is contiguous at the start of the executable code,
+  // away from code that is unlikely to run. Without a profile, all the code is in
+  // the first section, in definition order.
+  enum CodeSection {
+    kHotCodeSection,   // Methods in the top samples of the profile.
+    kColdCodeSection,  // Other methods.
+    kHugeCodeSection,  // Huge methods that are not hot.
+    kCodeSectionCount
+  };
+
+  size_t NumberOfCodeSections() const;
+  CodeSection GetCodeSection(const DexFile& dex_file, const ClassDataItemIterator& it) const;
+
   // The function VisitDexMethods() below iterates through all the methods in all
   // the compiled dex files in order of their definitions. The method visitor
   // classes provide individual bits of processing for each of the passes we need to
@@ -159,6 +179,7 @@ class OatWriter {
   size_t InitOatHeader();
   size_t InitOatDexFiles(size_t offset);
   size_t InitDexFiles(size_t offset);
+  size_t InitLookupTables(size_t offset);
   size_t InitOatClasses(size_t offset);
   size_t InitOatMaps(size_t offset);
   size_t InitOatCode(size_t offset)
@@ -176,6 +197,7 @@ class OatWriter {
   class OatDexFile {
    public:
     explicit OatDexFile(size_t offset, const DexFile& dex_file);
+    ~OatDexFile();
     size_t SizeOf() const;
     void UpdateChecksum(OatHeader* oat_header) const;
     bool Write(OatWriter* oat_writer, OutputStream* out, const size_t file_offset) const;
@@ -189,8 +211,12 @@ class OatWriter {
     const uint8_t* dex_file_location_data_;
     uint32_t dex_file_location_checksum_;
     uint32_t dex_file_offset_;
+    uint32_t lookup_table_offset_;
     std::vector<uint32_t> methods_offsets_;
 
+    // Written at lookup_table_offset_, nullptr if the dex file has no class defs.
+    std::unique_ptr<TypeLookupTable> lookup_table_;
+
    private:
     DISALLOW_COPY_AND_ASSIGN(OatDexFile);
   };
@@ -254,6 +280,9 @@ class OatWriter {
     std::vector<OatMethodOffsets> method_offsets_;
     std::vector<OatQuickMethodHeader> method_headers_;
 
+    // The code section of each CompiledMethod present in the OatClass.
+    std::vector<CodeSection> code_sections_;
+
    private:
     DISALLOW_COPY_AND_ASSIGN(OatClass);
   };
@@ -321,11 +350,14 @@ class OatWriter {
   uint32_t size_oat_dex_file_location_data_;
   uint32_t size_oat_dex_file_location_checksum_;
   uint32_t size_oat_dex_file_offset_;
+  uint32_t size_oat_dex_file_lookup_table_offset_;
   uint32_t size_oat_dex_file_methods_offsets_;
   uint32_t size_oat_class_type_;
   uint32_t size_oat_class_status_;
   uint32_t size_oat_class_method_bitmaps_;
   uint32_t size_oat_class_method_offsets_;
+  uint32_t size_oat_lookup_table_alignment_;
+  uint32_t size_oat_lookup_table_;
 
   class RelativeCallPatcher;
   class NoRelativeCallPatcher;
@@ -23,8 +23,10 @@
 #include "dex_instruction.h"
 #include "dex_instruction-inl.h"
 #include "driver/compiler_driver-inl.h"
+#include "leb128.h"
 #include "mirror/art_field.h"
 #include "mirror/art_field-inl.h"
+#include "mirror/class-inl.h"
 #include "mirror/class_loader.h"
 #include "mirror/dex_cache.h"
 #include "nodes.h"
@@ -120,13 +122,6 @@ bool HGraphBuilder::InitializeParameters(uint16_t number_of_parameters) {
   return true;
 }
 
-static bool CanHandleCodeItem(const DexFile::CodeItem& code_item) {
-  if (code_item.tries_size_ > 0) {
-    return false;
-  }
-  return true;
-}
-
 template<typename T>
 void HGraphBuilder::If_22t(const Instruction& instruction, uint32_t dex_offset) {
   int32_t target_offset = instruction.GetTargetOffset();
@@ -164,11 +159,123 @@ void HGraphBuilder::If_21t(const Instruction& instruction, uint32_t dex_offset)
   current_block_ = nullptr;
 }
 
-HGraph* HGraphBuilder::BuildGraph(const DexFile::CodeItem& code_item) {
-  if (!CanHandleCodeItem(code_item)) {
-    return nullptr;
+// Returns the branch offsets, relative to the switch instruction at `code_ptr`,
+// of the cases of that instruction, and sets `num_entries` to their number.
+static const int32_t* GetSwitchTargets(const Instruction& instruction,
+                                       const uint16_t* code_ptr,
+                                       uint16_t* num_entries) {
+  const uint16_t* payload_ptr = code_ptr + instruction.VRegB_31t();
+  if (instruction.Opcode() == Instruction::PACKED_SWITCH) {
+    const Instruction::PackedSwitchPayload* payload =
+        reinterpret_cast<const Instruction::PackedSwitchPayload*>(payload_ptr);
+    DCHECK_EQ(payload->ident, static_cast<uint16_t>(Instruction::kPackedSwitchSignature));
+    *num_entries = payload->case_count;
+    return payload->targets;
+  } else {
+    DCHECK_EQ(instruction.Opcode(), Instruction::SPARSE_SWITCH);
+    const Instruction::SparseSwitchPayload* payload =
+        reinterpret_cast<const Instruction::SparseSwitchPayload*>(payload_ptr);
+    DCHECK_EQ(payload->ident, static_cast<uint16_t>(Instruction::kSparseSwitchSignature));
+    *num_entries = payload->case_count;
+    return payload->GetTargets();
+  }
+}
+
+void HGraphBuilder::BuildSwitch(const Instruction& instruction, uint32_t dex_offset) {
+  uint16_t num_entries;
+  const int32_t* targets = GetSwitchTargets(instruction, code_start_ + dex_offset, &num_entries);
+  int32_t min_target_offset = 1;
+  for (uint16_t i = 0; i < num_entries; ++i) {
+    if (targets[i] < min_target_offset) {
+      min_target_offset = targets[i];
+    }
+  }
+  PotentiallyAddSuspendCheck(min_target_offset, dex_offset);
+
+  HBasicBlock* default_block = FindBlockStartingAt(dex_offset + instruction.SizeInCodeUnits());
+  DCHECK(default_block != nullptr);
+  if (num_entries == 0) {
+    current_block_->AddInstruction(new (arena_) HGoto());
+    current_block_->AddSuccessor(default_block);
+  } else if (instruction.Opcode() == Instruction::PACKED_SWITCH) {
+    // Dense cases are dispatched by the code generator, with a jump table
+    // if there are enough of them.
+    const Instruction::PackedSwitchPayload* payload =
+        reinterpret_cast<const Instruction::PackedSwitchPayload*>(
+            code_start_ + dex_offset + instruction.VRegB_31t());
+    HInstruction* value = LoadLocal(instruction.VRegA_31t(), Primitive::kPrimInt);
+    current_block_->AddInstruction(
+        new (arena_) HPackedSwitch(payload->first_key, num_entries, value));
+    for (uint16_t i = 0; i < num_entries; ++i) {
+      HBasicBlock* target = FindBlockStartingAt(dex_offset + targets[i]);
+      DCHECK(target != nullptr);
+      current_block_->AddSuccessor(target);
+    }
+    current_block_->AddSuccessor(default_block);
+  } else {
+    // Sparse cases are dispatched by a binary search on the sorted keys.
+    const Instruction::SparseSwitchPayload* payload =
+        reinterpret_cast<const Instruction::SparseSwitchPayload*>(
+            code_start_ + dex_offset + instruction.VRegB_31t());
+    BuildSparseSwitchCases(instruction.VRegA_31t(),
+                           payload->GetKeys(),
+                           targets,
+                           0,
+                           num_entries,
+                           default_block,
+                           dex_offset);
+  }
+  current_block_ = nullptr;
+}
+
+void HGraphBuilder::BuildSparseSwitchCases(uint32_t reg,
+                                           const int32_t* keys,
+                                           const int32_t* targets,
+                                           size_t first,
+                                           size_t last,
+                                           HBasicBlock* default_block,
+                                           uint32_t dex_offset) {
+  DCHECK_LT(first, last);
+  if (last - first <= kSparseSwitchLinearSearchThreshold) {
+    // Compare the value against each key in turn.
+    for (size_t i = first; i < last; ++i) {
+      HInstruction* value = LoadLocal(reg, Primitive::kPrimInt);
+      HEqual* comparison = new (arena_) HEqual(value, GetIntConstant(keys[i]));
+      current_block_->AddInstruction(comparison);
+      current_block_->AddInstruction(new (arena_) HIf(comparison));
+      HBasicBlock* target = FindBlockStartingAt(dex_offset + targets[i]);
+      DCHECK(target != nullptr);
+      current_block_->AddSuccessor(target);
+      if (i + 1 == last) {
+        current_block_->AddSuccessor(default_block);
+      } else {
+        HBasicBlock* next = new (arena_) HBasicBlock(graph_, dex_offset);
+        graph_->AddBlock(next);
+        current_block_->AddSuccessor(next);
+        current_block_ = next;
+      }
+    }
+    return;
   }
 
+  size_t middle = first + (last - first) / 2;
+  HInstruction* value = LoadLocal(reg, Primitive::kPrimInt);
+  HLessThan* comparison = new (arena_) HLessThan(value, GetIntConstant(keys[middle]));
+  current_block_->AddInstruction(comparison);
+  current_block_->AddInstruction(new (arena_) HIf(comparison));
+  HBasicBlock* lower = new (arena_) HBasicBlock(graph_, dex_offset);
+  graph_->AddBlock(lower);
+  HBasicBlock* upper = new (arena_) HBasicBlock(graph_, dex_offset);
+  graph_->AddBlock(upper);
+  current_block_->AddSuccessor(lower);
+  current_block_->AddSuccessor(upper);
+  current_block_ = lower;
+  BuildSparseSwitchCases(reg, keys, targets, first, middle, default_block, dex_offset);
+  current_block_ = upper;
+  BuildSparseSwitchCases(reg, keys, targets, middle, last, default_block, dex_offset);
+}
+
+HGraph* HGraphBuilder::BuildGraph(const DexFile::CodeItem& code_item) {
   const uint16_t* code_ptr = code_item.insns_;
   const uint16_t* code_end = code_item.insns_ + code_item.insns_size_in_code_units_;
   code_start_ = code_ptr;
@@ -187,6 +294,7 @@ HGraph* HGraphBuilder::BuildGraph(const DexFile::CodeItem& code_item) {
   // To avoid splitting blocks, we compute ahead of time the instructions that
   // start a new block, and create these blocks.
   ComputeBranchTargets(code_ptr, code_end);
+  ComputeCatchBlocks(code_item);
 
   if (!InitializeParameters(code_item.ins_size_)) {
     return nullptr;
@@ -197,11 +305,16 @@ HGraph* HGraphBuilder::BuildGraph(const DexFile::CodeItem& code_item) {
     // Update the current block if dex_offset starts a new block.
     MaybeUpdateCurrentBlock(dex_offset);
     const Instruction& instruction = *Instruction::At(code_ptr);
-    if (!AnalyzeDexInstruction(instruction, dex_offset)) return nullptr;
+    if (!AnalyzeDexInstruction(instruction, dex_offset)) {
+      unsupported_instruction_ = &instruction;
+      return nullptr;
+    }
     dex_offset += instruction.SizeInCodeUnits();
     code_ptr += instruction.SizeInCodeUnits();
   }
 
+  LinkCatchBlocks(code_item);
+
   // Add the exit block at the end to give it the highest id.
   graph_->AddBlock(exit_block_);
   exit_block_->AddInstruction(new (arena_) HExit());
@@ -229,7 +342,6 @@ void HGraphBuilder::MaybeUpdateCurrentBlock(size_t index) {
 }
 
 void HGraphBuilder::ComputeBranchTargets(const uint16_t* code_ptr, const uint16_t* code_end) {
-  // TODO: Support switch instructions.
   branch_targets_.SetSize(code_end - code_ptr);
 
   // Create the first block for the dex instructions, single successor of the entry block.
@@ -255,6 +367,19 @@ void HGraphBuilder::ComputeBranchTargets(const uint16_t* code_ptr, const uint16_
         block = new (arena_) HBasicBlock(graph_, dex_offset);
         branch_targets_.Put(dex_offset, block);
       }
+    } else if (instruction.IsSwitch()) {
+      // Create a block for each case target, and for the instruction following
+      // the switch, which is the target of values not matching any case.
+      uint16_t num_entries;
+      const int32_t* targets = GetSwitchTargets(instruction, code_ptr, &num_entries);
+      for (uint16_t i = 0; i < num_entries; ++i) {
+        MaybeCreateBlockAt(dex_offset + targets[i]);
+      }
+      dex_offset += instruction.SizeInCodeUnits();
+      code_ptr += instruction.SizeInCodeUnits();
+      if (code_ptr < code_end) {
+        MaybeCreateBlockAt(dex_offset);
+      }
     } else {
       code_ptr += instruction.SizeInCodeUnits();
       dex_offset += instruction.SizeInCodeUnits();
@@ -262,6 +387,98 @@ void HGraphBuilder::ComputeBranchTargets(const uint16_t* code_ptr, const uint16_
   }
 }
 
+void HGraphBuilder::ComputeCatchBlocks(const DexFile::CodeItem& code_item) {
+  if (code_item.tries_size_ == 0) {
+    return;
+  }
+  graph_->SetHasTryCatch(true);
+
+  // Start a new block at the boundaries of each try item, so that a block is
+  // either entirely covered by a try item or not covered at all.
+  for (uint32_t i = 0; i < code_item.tries_size_; ++i) {
+    const DexFile::TryItem* try_item = DexFile::GetTryItems(code_item, i);
+    MaybeCreateBlockAt(try_item->start_addr_);
+    MaybeCreateBlockAt(try_item->start_addr_ + try_item->insn_count_);
+  }
+
+  // Create a block for each exception handler.
+  const uint8_t* handlers_ptr = DexFile::GetCatchHandlerData(code_item, 0);
+  uint32_t handlers_size = DecodeUnsignedLeb128(&handlers_ptr);
+  for (uint32_t i = 0; i < handlers_size; ++i) {
+    CatchHandlerIterator iterator(handlers_ptr);
+    for (; iterator.HasNext(); iterator.Next()) {
+      MaybeCreateBlockAt(iterator.GetHandlerAddress())->SetIsCatchBlock();
+    }
+    handlers_ptr = iterator.EndDataPointer();
+  }
+}
+
+static bool HasThrowingInstruction(HBasicBlock* block) {
+  for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+    if (it.Current()->CanThrow()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void HGraphBuilder::LinkCatchBlocks(const DexFile::CodeItem& code_item) {
+  if (code_item.tries_size_ == 0) {
+    return;
+  }
+  const GrowableArray<HBasicBlock*>& blocks = graph_->GetBlocks();
+  size_t number_of_blocks = blocks.Size();
+
+  // The runtime enters a catch block with the values of the dex registers in
+  // the phis of the block, so a catch block must only be reached by exceptional
+  // edges. A handler also reached by normal control flow gets a dedicated catch
+  // block that jumps to it.
+  for (size_t i = 0; i < number_of_blocks; ++i) {
+    HBasicBlock* handler = blocks.Get(i);
+    if (handler->IsCatchBlock() && !handler->GetPredecessors().IsEmpty()) {
+      HBasicBlock* catch_block = new (arena_) HBasicBlock(graph_, handler->GetDexPc());
+      graph_->AddBlock(catch_block);
+      catch_block->SetIsCatchBlock();
+      catch_block->AddInstruction(new (arena_) HGoto());
+      catch_block->AddSuccessor(handler);
+      handler->ClearIsCatchBlock();
+      // Exceptions thrown to the handler now go to `catch_block`.
+      branch_targets_.Put(handler->GetDexPc(), catch_block);
+    }
+  }
+
+  // Any instruction that can throw, in a block covered by a try item, may throw to
+  // the handlers of that try item. Model this with edges from the block to the
+  // catch blocks, added after the normal successors of the block so that branching
+  // instructions are not affected.
+  for (size_t i = 0; i < number_of_blocks; ++i) {
+    HBasicBlock* block = blocks.Get(i);
+    if (block == entry_block_ || !HasThrowingInstruction(block)) {
+      continue;
+    }
+    for (CatchHandlerIterator it(code_item, block->GetDexPc()); it.HasNext(); it.Next()) {
+      HBasicBlock* catch_block = FindBlockStartingAt(it.GetHandlerAddress());
+      DCHECK(catch_block != nullptr && catch_block->IsCatchBlock());
+      if (!block->GetCatchHandlers().Contains(catch_block)) {
+        block->AddCatchHandler(catch_block);
+      }
+    }
+  }
+}
+
+HBasicBlock* HGraphBuilder::MaybeCreateBlockAt(uint32_t dex_pc) {
+  if (dex_pc >= branch_targets_.Size()) {
+    // The end of the code item does not start a block.
+    return nullptr;
+  }
+  HBasicBlock* block = FindBlockStartingAt(dex_pc);
+  if (block == nullptr) {
+    block = new (arena_) HBasicBlock(graph_, dex_pc);
+    branch_targets_.Put(dex_pc, block);
+  }
+  return block;
+}
+
 HBasicBlock* HGraphBuilder::FindBlockStartingAt(int32_t index) const {
   DCHECK_GE(index, 0);
   return branch_targets_.Get(index);
@@ -290,6 +507,22 @@ void HGraphBuilder::Binop_12x(const Instruction& instruction, Primitive::Type ty
   UpdateLocal(instruction.VRegA(), current_block_->GetLastInstruction());
 }
 
+template<typename T>
+void HGraphBuilder::Binop_23x_shift(const Instruction& instruction, Primitive::Type type) {
+  HInstruction* first = LoadLocal(instruction.VRegB(), type);
+  HInstruction* second = LoadLocal(instruction.VRegC(), Primitive::kPrimInt);
+  current_block_->AddInstruction(new (arena_) T(type, first, second));
+  UpdateLocal(instruction.VRegA(), current_block_->GetLastInstruction());
+}
+
+template<typename T>
+void HGraphBuilder::Binop_12x_shift(const Instruction& instruction, Primitive::Type type) {
+  HInstruction* first = LoadLocal(instruction.VRegA(), type);
+  HInstruction* second = LoadLocal(instruction.VRegB(), Primitive::kPrimInt);
+  current_block_->AddInstruction(new (arena_) T(type, first, second));
+  UpdateLocal(instruction.VRegA(), current_block_->GetLastInstruction());
+}
+
 template<typename T>
 void HGraphBuilder::Binop_22s(const Instruction& instruction, bool reverse) {
   HInstruction* first = LoadLocal(instruction.VRegB(), Primitive::kPrimInt);
@@ -312,6 +545,48 @@ void HGraphBuilder::Binop_22b(const Instruction& instruction, bool reverse) {
   UpdateLocal(instruction.VRegA(), current_block_->GetLastInstruction());
 }
 
+void HGraphBuilder::Conversion_12x(const Instruction& instruction,
+                                   Primitive::Type input_type,
+                                   Primitive::Type result_type,
+                                   uint32_t dex_offset) {
+  HInstruction* first = LoadLocal(instruction.VRegB(), input_type);
+  current_block_->AddInstruction(new (arena_) HTypeConversion(result_type, first, dex_offset));
+  UpdateLocal(instruction.VRegA(), current_block_->GetLastInstruction());
+}
+
+void HGraphBuilder::BuildCheckedDivRem(uint16_t out_reg,
+                                       uint16_t first_reg,
+                                       int32_t second_reg_or_constant,
+                                       uint32_t dex_offset,
+                                       Primitive::Type type,
+                                       bool second_is_constant,
+                                       bool is_div) {
+  DCHECK(type == Primitive::kPrimInt || type == Primitive::kPrimLong);
+  HInstruction* first = LoadLocal(first_reg, type);
+  HInstruction* second = nullptr;
+  if (second_is_constant) {
+    DCHECK_EQ(type, Primitive::kPrimInt);
+    second = GetIntConstant(second_reg_or_constant);
+  } else {
+    second = LoadLocal(second_reg_or_constant, type);
+  }
+
+  // A non-zero literal divisor does not need to be checked.
+  if (!second_is_constant || second_reg_or_constant == 0) {
+    second = new (arena_) HDivZeroCheck(second, dex_offset);
+    current_block_->AddInstruction(second);
+  }
+
+  if (is_div) {
+    current_block_->AddInstruction(
+        new (arena_) HDiv(type, first, second, dex_offset));
+  } else {
+    current_block_->AddInstruction(
+        new (arena_) HRem(type, first, second, dex_offset));
+  }
+  UpdateLocal(out_reg, current_block_->GetLastInstruction());
+}
+
 void HGraphBuilder::BuildReturn(const Instruction& instruction, Primitive::Type type) {
   if (type == Primitive::kPrimVoid) {
     current_block_->AddInstruction(new (arena_) HReturnVoid());
@@ -366,20 +641,34 @@ bool HGraphBuilder::BuildInvoke(const Instruction& instruction,
   const size_t number_of_arguments = strlen(descriptor) - (is_instance_call ? 0 : 1);
 
   HInvoke* invoke = nullptr;
-  if (invoke_type == kVirtual) {
+  if (invoke_type == kVirtual || invoke_type == kInterface || invoke_type == kSuper) {
     MethodReference target_method(dex_file_, method_idx);
     uintptr_t direct_code;
     uintptr_t direct_method;
-    int vtable_index;
+    int table_index;
+    InvokeType optimized_invoke_type = invoke_type;
     // TODO: Add devirtualization support.
     compiler_driver_->ComputeInvokeInfo(dex_compilation_unit_, dex_offset, true, true,
-                                        &invoke_type, &target_method, &vtable_index,
+                                        &optimized_invoke_type, &target_method, &table_index,
                                         &direct_code, &direct_method);
-    if (vtable_index == -1) {
+    if (table_index == -1) {
       return false;
     }
-    invoke = new (arena_) HInvokeVirtual(
-        arena_, number_of_arguments, return_type, dex_offset, vtable_index);
+    if (invoke_type == kVirtual) {
+      invoke = new (arena_) HInvokeVirtual(
+          arena_, number_of_arguments, return_type, dex_offset, table_index);
+    } else if (invoke_type == kInterface) {
+      invoke = new (arena_) HInvokeInterface(
+          arena_, number_of_arguments, return_type, dex_offset, method_idx, table_index);
+    } else {
+      // Only super calls sharpened to a direct call of a method of this dex file
+      // are supported. They are treated like static calls.
+      if (optimized_invoke_type != kDirect || target_method.dex_file != dex_file_) {
+        return false;
+      }
+      invoke = new (arena_) HInvokeStatic(
+          arena_, number_of_arguments, return_type, dex_offset, target_method.dex_method_index);
+    }
   } else {
     // Treat invoke-direct like static calls for now.
     invoke = new (arena_) HInvokeStatic(
@@ -469,6 +758,96 @@ bool HGraphBuilder::BuildFieldAccess(const Instruction& instruction,
   return true;
 }
 
+bool HGraphBuilder::BuildStaticFieldAccess(const Instruction& instruction,
+                                           uint32_t dex_offset,
+                                           bool is_put) {
+  uint32_t source_or_dest_reg = instruction.VRegA_21c();
+  uint16_t field_index = instruction.VRegB_21c();
+
+  MemberOffset field_offset(0u);
+  uint32_t storage_index;
+  bool is_referrers_class;
+  bool is_volatile;
+  bool is_initialized;
+  bool fast_path = compiler_driver_->ComputeStaticFieldInfo(
+      field_index, dex_compilation_unit_, is_put, &field_offset, &storage_index,
+      &is_referrers_class, &is_volatile, &is_initialized);
+  if (!fast_path) {
+    return false;
+  }
+  if (is_volatile) {
+    return false;
+  }
+
+  const DexFile::FieldId& field_id = dex_file_->GetFieldId(field_index);
+  Primitive::Type field_type = Primitive::GetType(dex_file_->GetFieldTypeDescriptor(field_id)[0]);
+  if (!IsTypeSupported(field_type)) {
+    return false;
+  }
+
+  // Load the value to store first, so that the class is the instruction
+  // just before its use and does not need a temporary.
+  HInstruction* value = is_put ? LoadLocal(source_or_dest_reg, field_type) : nullptr;
+
+  HLoadClass* load_class = new (arena_) HLoadClass(storage_index, is_referrers_class, dex_offset);
+  current_block_->AddInstruction(load_class);
+  HInstruction* cls = load_class;
+  // The class of the current method is being initialized, or already initialized.
+  if (!is_referrers_class && !is_initialized) {
+    cls = new (arena_) HClinitCheck(load_class, dex_offset);
+    current_block_->AddInstruction(cls);
+  }
+
+  if (is_put) {
+    current_block_->AddInstruction(
+        new (arena_) HStaticFieldSet(cls, value, field_type, field_offset));
+  } else {
+    current_block_->AddInstruction(new (arena_) HStaticFieldGet(cls, field_type, field_offset));
+    UpdateLocal(source_or_dest_reg, current_block_->GetLastInstruction());
+  }
+  return true;
+}
+
+bool HGraphBuilder::BuildTypeCheck(const Instruction& instruction,
+                                   uint8_t destination,
+                                   uint8_t reference,
+                                   uint16_t type_index,
+                                   uint32_t dex_offset) {
+  bool type_known_final;
+  bool type_known_abstract;
+  bool is_referrers_class;
+  bool can_access = compiler_driver_->CanAccessTypeWithoutChecks(
+      dex_compilation_unit_->GetDexMethodIndex(), *dex_file_, type_index,
+      &type_known_final, &type_known_abstract, &is_referrers_class);
+  if (!can_access) {
+    return false;
+  }
+  HInstruction* object = LoadLocal(reference, Primitive::kPrimNot);
+  HLoadClass* cls = new (arena_) HLoadClass(type_index, is_referrers_class, dex_offset);
+  current_block_->AddInstruction(cls);
+  if (instruction.Opcode() == Instruction::INSTANCE_OF) {
+    current_block_->AddInstruction(new (arena_) HInstanceOf(object, cls, dex_offset));
+    UpdateLocal(destination, current_block_->GetLastInstruction());
+  } else {
+    DCHECK_EQ(instruction.Opcode(), Instruction::CHECK_CAST);
+    current_block_->AddInstruction(new (arena_) HCheckCast(object, cls, dex_offset));
+  }
+  return true;
+}
+
+bool HGraphBuilder::CanRemoveAllocation(uint16_t type_index) const {
+  if (!compiler_driver_->CanAccessInstantiableTypeWithoutChecks(
+          dex_compilation_unit_->GetDexMethodIndex(), *dex_file_, type_index)) {
+    return false;
+  }
+  ScopedObjectAccess soa(Thread::Current());
+  mirror::DexCache* dex_cache = dex_compilation_unit_->GetClassLinker()->FindDexCache(*dex_file_);
+  mirror::Class* resolved_class = dex_cache->GetResolvedType(type_index);
+  return resolved_class != nullptr
+      && resolved_class->IsInitialized()
+      && !resolved_class->IsFinalizable();
+}
+
 void HGraphBuilder::BuildArrayAccess(const Instruction& instruction,
                                      uint32_t dex_offset,
                                      bool is_put,
@@ -719,7 +1098,9 @@ bool HGraphBuilder::AnalyzeDexInstruction(const Instruction& instruction, uint32
 
     case Instruction::INVOKE_STATIC:
     case Instruction::INVOKE_DIRECT:
-    case Instruction::INVOKE_VIRTUAL: {
+    case Instruction::INVOKE_VIRTUAL:
+    case Instruction::INVOKE_INTERFACE:
+    case Instruction::INVOKE_SUPER: {
       uint32_t method_idx = instruction.VRegB_35c();
       uint32_t number_of_vreg_arguments = instruction.VRegA_35c();
       uint32_t args[5];
@@ -732,7 +1113,9 @@ bool HGraphBuilder::AnalyzeDexInstruction(const Instruction& instruction, uint32
 
     case Instruction::INVOKE_STATIC_RANGE:
     case Instruction::INVOKE_DIRECT_RANGE:
-    case Instruction::INVOKE_VIRTUAL_RANGE: {
+    case Instruction::INVOKE_VIRTUAL_RANGE:
+    case Instruction::INVOKE_INTERFACE_RANGE:
+    case Instruction::INVOKE_SUPER_RANGE: {
       uint32_t method_idx = instruction.VRegB_3rc();
       uint32_t number_of_vreg_arguments = instruction.VRegA_3rc();
       uint32_t register_index = instruction.VRegC();
@@ -823,6 +1206,36 @@ bool HGraphBuilder::AnalyzeDexInstruction(const Instruction& instruction, uint32
       break;
     }
 
+    case Instruction::AND_INT: {
+      Binop_23x<HAnd>(instruction, Primitive::kPrimInt);
+      break;
+    }
+
+    case Instruction::AND_LONG: {
+      Binop_23x<HAnd>(instruction, Primitive::kPrimLong);
+      break;
+    }
+
+    case Instruction::OR_INT: {
+      Binop_23x<HOr>(instruction, Primitive::kPrimInt);
+      break;
+    }
+
+    case Instruction::OR_LONG: {
+      Binop_23x<HOr>(instruction, Primitive::kPrimLong);
+      break;
+    }
+
+    case Instruction::XOR_INT: {
+      Binop_23x<HXor>(instruction, Primitive::kPrimInt);
+      break;
+    }
+
+    case Instruction::XOR_LONG: {
+      Binop_23x<HXor>(instruction, Primitive::kPrimLong);
+      break;
+    }
+
     case Instruction::ADD_LONG_2ADDR: {
       Binop_12x<HAdd>(instruction, Primitive::kPrimLong);
       break;
@@ -878,6 +1291,36 @@ bool HGraphBuilder::AnalyzeDexInstruction(const Instruction& instruction, uint32
       break;
     }
 
+    case Instruction::AND_INT_2ADDR: {
+      Binop_12x<HAnd>(instruction, Primitive::kPrimInt);
+      break;
+    }
+
+    case Instruction::AND_LONG_2ADDR: {
+      Binop_12x<HAnd>(instruction, Primitive::kPrimLong);
+      break;
+    }
+
+    case Instruction::OR_INT_2ADDR: {
+      Binop_12x<HOr>(instruction, Primitive::kPrimInt);
+      break;
+    }
+
+    case Instruction::OR_LONG_2ADDR: {
+      Binop_12x<HOr>(instruction, Primitive::kPrimLong);
+      break;
+    }
+
+    case Instruction::XOR_INT_2ADDR: {
+      Binop_12x<HXor>(instruction, Primitive::kPrimInt);
+      break;
+    }
+
+    case Instruction::XOR_LONG_2ADDR: {
+      Binop_12x<HXor>(instruction, Primitive::kPrimLong);
+      break;
+    }
+
     case Instruction::ADD_INT_LIT16: {
       Binop_22s<HAdd>(instruction, false);
       break;
@@ -893,6 +1336,21 @@ bool HGraphBuilder::AnalyzeDexInstruction(const Instruction& instruction, uint32
       break;
     }
 
+    case Instruction::AND_INT_LIT16: {
+      Binop_22s<HAnd>(instruction, false);
+      break;
+    }
+
+    case Instruction::OR_INT_LIT16: {
+      Binop_22s<HOr>(instruction, false);
+      break;
+    }
+
+    case Instruction::XOR_INT_LIT16: {
+      Binop_22s<HXor>(instruction, false);
+      break;
+    }
+
     case Instruction::ADD_INT_LIT8: {
       Binop_22b<HAdd>(instruction, false);
       break;
@@ -908,9 +1366,247 @@ bool HGraphBuilder::AnalyzeDexInstruction(const Instruction& instruction, uint32
       break;
     }
 
+    case Instruction::AND_INT_LIT8: {
+      Binop_22b<HAnd>(instruction, false);
+      break;
+    }
+
+    case Instruction::OR_INT_LIT8: {
+      Binop_22b<HOr>(instruction, false);
+      break;
+    }
+
+    case Instruction::XOR_INT_LIT8: {
+      Binop_22b<HXor>(instruction, false);
+      break;
+    }
+
+    case Instruction::SHL_INT: {
+      Binop_23x<HShl>(instruction, Primitive::kPrimInt);
+      break;
+    }
+
+    case Instruction::SHR_INT: {
+      Binop_23x<HShr>(instruction, Primitive::kPrimInt);
+      break;
+    }
+
+    case Instruction::USHR_INT: {
+      Binop_23x<HUShr>(instruction, Primitive::kPrimInt);
+      break;
+    }
+
+    case Instruction::SHL_INT_2ADDR: {
+      Binop_12x<HShl>(instruction, Primitive::kPrimInt);
+      break;
+    }
+
+    case Instruction::SHR_INT_2ADDR: {
+      Binop_12x<HShr>(instruction, Primitive::kPrimInt);
+      break;
+    }
+
+    case Instruction::USHR_INT_2ADDR: {
+      Binop_12x<HUShr>(instruction, Primitive::kPrimInt);
+      break;
+    }
+
+    case Instruction::SHL_INT_LIT8: {
+      Binop_22b<HShl>(instruction, false);
+      break;
+    }
+
+    case Instruction::SHR_INT_LIT8: {
+      Binop_22b<HShr>(instruction, false);
+      break;
+    }
+
+    case Instruction::USHR_INT_LIT8: {
+      Binop_22b<HUShr>(instruction, false);
+      break;
+    }
+
+    case Instruction::SHL_LONG: {
+      Binop_23x_shift<HShl>(instruction, Primitive::kPrimLong);
+      break;
+    }
+
+    case Instruction::SHR_LONG: {
+      Binop_23x_shift<HShr>(instruction, Primitive::kPrimLong);
+      break;
+    }
+
+    case Instruction::USHR_LONG: {
+      Binop_23x_shift<HUShr>(instruction, Primitive::kPrimLong);
+      break;
+    }
+
+    case Instruction::SHL_LONG_2ADDR: {
+      Binop_12x_shift<HShl>(instruction, Primitive::kPrimLong);
+      break;
+    }
+
+    case Instruction::SHR_LONG_2ADDR: {
+      Binop_12x_shift<HShr>(instruction, Primitive::kPrimLong);
+      break;
+    }
+
+    case Instruction::USHR_LONG_2ADDR: {
+      Binop_12x_shift<HUShr>(instruction, Primitive::kPrimLong);
+      break;
+    }
+
+    case Instruction::DIV_INT: {
+      BuildCheckedDivRem(instruction.VRegA(), instruction.VRegB(), instruction.VRegC(),
+                         dex_offset, Primitive::kPrimInt, false, true);
+      break;
+    }
+
+    case Instruction::REM_INT: {
+      BuildCheckedDivRem(instruction.VRegA(), instruction.VRegB(), instruction.VRegC(),
+                         dex_offset, Primitive::kPrimInt, false, false);
+      break;
+    }
+
+    case Instruction::DIV_INT_2ADDR: {
+      BuildCheckedDivRem(instruction.VRegA(), instruction.VRegA(), instruction.VRegB(),
+                         dex_offset, Primitive::kPrimInt, false, true);
+      break;
+    }
+
+    case Instruction::REM_INT_2ADDR: {
+      BuildCheckedDivRem(instruction.VRegA(), instruction.VRegA(), instruction.VRegB(),
+                         dex_offset, Primitive::kPrimInt, false, false);
+      break;
+    }
+
+    case Instruction::DIV_INT_LIT16: {
+      BuildCheckedDivRem(instruction.VRegA(), instruction.VRegB(), instruction.VRegC_22s(),
+                         dex_offset, Primitive::kPrimInt, true, true);
+      break;
+    }
+
+    case Instruction::REM_INT_LIT16: {
+      BuildCheckedDivRem(instruction.VRegA(), instruction.VRegB(), instruction.VRegC_22s(),
+                         dex_offset, Primitive::kPrimInt, true, false);
+      break;
+    }
+
+    case Instruction::DIV_INT_LIT8: {
+      BuildCheckedDivRem(instruction.VRegA(), instruction.VRegB(), instruction.VRegC_22b(),
+                         dex_offset, Primitive::kPrimInt, true, true);
+      break;
+    }
+
+    case Instruction::REM_INT_LIT8: {
+      BuildCheckedDivRem(instruction.VRegA(), instruction.VRegB(), instruction.VRegC_22b(),
+                         dex_offset, Primitive::kPrimInt, true, false);
+      break;
+    }
+
+    case Instruction::DIV_LONG: {
+      BuildCheckedDivRem(instruction.VRegA(), instruction.VRegB(), instruction.VRegC(),
+                         dex_offset, Primitive::kPrimLong, false, true);
+      break;
+    }
+
+    case Instruction::REM_LONG: {
+      BuildCheckedDivRem(instruction.VRegA(), instruction.VRegB(), instruction.VRegC(),
+                         dex_offset, Primitive::kPrimLong, false, false);
+      break;
+    }
+
+    case Instruction::DIV_LONG_2ADDR: {
+      BuildCheckedDivRem(instruction.VRegA(), instruction.VRegA(), instruction.VRegB(),
+                         dex_offset, Primitive::kPrimLong, false, true);
+      break;
+    }
+
+    case Instruction::REM_LONG_2ADDR: {
+      BuildCheckedDivRem(instruction.VRegA(), instruction.VRegA(), instruction.VRegB(),
+                         dex_offset, Primitive::kPrimLong, false, false);
+      break;
+    }
+
+    case Instruction::INT_TO_LONG: {
+      Conversion_12x(instruction, Primitive::kPrimInt, Primitive::kPrimLong, dex_offset);
+      break;
+    }
+
+    case Instruction::LONG_TO_INT: {
+      Conversion_12x(instruction, Primitive::kPrimLong, Primitive::kPrimInt, dex_offset);
+      break;
+    }
+
+    case Instruction::INT_TO_BYTE: {
+      Conversion_12x(instruction, Primitive::kPrimInt, Primitive::kPrimByte, dex_offset);
+      break;
+    }
+
+    case Instruction::INT_TO_SHORT: {
+      Conversion_12x(instruction, Primitive::kPrimInt, Primitive::kPrimShort, dex_offset);
+      break;
+    }
+
+    case Instruction::INT_TO_CHAR: {
+      Conversion_12x(instruction, Primitive::kPrimInt, Primitive::kPrimChar, dex_offset);
+      break;
+    }
+
+    case Instruction::INT_TO_FLOAT: {
+      Conversion_12x(instruction, Primitive::kPrimInt, Primitive::kPrimFloat, dex_offset);
+      break;
+    }
+
+    case Instruction::INT_TO_DOUBLE: {
+      Conversion_12x(instruction, Primitive::kPrimInt, Primitive::kPrimDouble, dex_offset);
+      break;
+    }
+
+    case Instruction::LONG_TO_FLOAT: {
+      Conversion_12x(instruction, Primitive::kPrimLong, Primitive::kPrimFloat, dex_offset);
+      break;
+    }
+
+    case Instruction::LONG_TO_DOUBLE: {
+      Conversion_12x(instruction, Primitive::kPrimLong, Primitive::kPrimDouble, dex_offset);
+      break;
+    }
+
+    case Instruction::FLOAT_TO_INT: {
+      Conversion_12x(instruction, Primitive::kPrimFloat, Primitive::kPrimInt, dex_offset);
+      break;
+    }
+
+    case Instruction::FLOAT_TO_LONG: {
+      Conversion_12x(instruction, Primitive::kPrimFloat, Primitive::kPrimLong, dex_offset);
+      break;
+    }
+
+    case Instruction::FLOAT_TO_DOUBLE: {
+      Conversion_12x(instruction, Primitive::kPrimFloat, Primitive::kPrimDouble, dex_offset);
+      break;
+    }
+
+    case Instruction::DOUBLE_TO_INT: {
+      Conversion_12x(instruction, Primitive::kPrimDouble, Primitive::kPrimInt, dex_offset);
+      break;
+    }
+
+    case Instruction::DOUBLE_TO_LONG: {
+      Conversion_12x(instruction, Primitive::kPrimDouble, Primitive::kPrimLong, dex_offset);
+      break;
+    }
+
+    case Instruction::DOUBLE_TO_FLOAT: {
+      Conversion_12x(instruction, Primitive::kPrimDouble, Primitive::kPrimFloat, dex_offset);
+      break;
+    }
+
     case Instruction::NEW_INSTANCE: {
+      uint16_t type_index = instruction.VRegB_21c();
       current_block_->AddInstruction(
-          new (arena_) HNewInstance(dex_offset, instruction.VRegB_21c()));
+          new (arena_) HNewInstance(dex_offset, type_index, CanRemoveAllocation(type_index)));
       UpdateLocal(instruction.VRegA(), current_block_->GetLastInstruction());
       break;
     }
@@ -1011,6 +1707,72 @@ bool HGraphBuilder::AnalyzeDexInstruction(const Instruction& instruction, uint32
     case Instruction::NOP:
       break;
 
+    case Instruction::PACKED_SWITCH:
+    case Instruction::SPARSE_SWITCH: {
+      BuildSwitch(instruction, dex_offset);
+      break;
+    }
+
+    case Instruction::MOVE_EXCEPTION: {
+      current_block_->AddInstruction(new (arena_) HLoadException());
+      UpdateLocal(instruction.VRegA_11x(), current_block_->GetLastInstruction());
+      break;
+    }
+
+    case Instruction::THROW: {
+      HInstruction* exception = LoadLocal(instruction.VRegA_11x(), Primitive::kPrimNot);
+      current_block_->AddInstruction(new (arena_) HThrow(exception, dex_offset));
+      // A throw instruction must branch to the exit block.
+      current_block_->AddSuccessor(exit_block_);
+      // We finished building this block. Set the current block to null to avoid
+      // adding dead instructions to it.
+      current_block_ = nullptr;
+      break;
+    }
+
+    case Instruction::MONITOR_ENTER: {
+      HInstruction* object = LoadLocal(instruction.VRegA_11x(), Primitive::kPrimNot);
+      current_block_->AddInstruction(
+          new (arena_) HMonitorOperation(object, HMonitorOperation::kEnter, dex_offset));
+      break;
+    }
+
+    case Instruction::MONITOR_EXIT: {
+      HInstruction* object = LoadLocal(instruction.VRegA_11x(), Primitive::kPrimNot);
+      current_block_->AddInstruction(
+          new (arena_) HMonitorOperation(object, HMonitorOperation::kExit, dex_offset));
+      break;
+    }
+
+    case Instruction::CONST_STRING: {
+      current_block_->AddInstruction(new (arena_) HLoadString(instruction.VRegB_21c(), dex_offset));
+      UpdateLocal(instruction.VRegA_21c(), current_block_->GetLastInstruction());
+      break;
+    }
+
+    case Instruction::CONST_STRING_JUMBO: {
+      current_block_->AddInstruction(new (arena_) HLoadString(instruction.VRegB_31c(), dex_offset));
+      UpdateLocal(instruction.VRegA_31c(), current_block_->GetLastInstruction());
+      break;
+    }
+
+    case Instruction::CONST_CLASS: {
+      uint16_t type_index = instruction.VRegB_21c();
+      bool type_known_final;
+      bool type_known_abstract;
+      bool is_referrers_class;
+      bool can_access = compiler_driver_->CanAccessTypeWithoutChecks(
+          dex_compilation_unit_->GetDexMethodIndex(), *dex_file_, type_index,
+          &type_known_final, &type_known_abstract, &is_referrers_class);
+      if (!can_access) {
+        return false;
+      }
+      current_block_->AddInstruction(
+          new (arena_) HLoadClass(type_index, is_referrers_class, dex_offset));
+      UpdateLocal(instruction.VRegA_21c(), current_block_->GetLastInstruction());
+      break;
+    }
+
     case Instruction::IGET:
     case Instruction::IGET_WIDE:
     case Instruction::IGET_OBJECT:
@@ -1037,6 +1799,32 @@ bool HGraphBuilder::AnalyzeDexInstruction(const Instruction& instruction, uint32
       break;
     }
 
+    case Instruction::SGET:
+    case Instruction::SGET_WIDE:
+    case Instruction::SGET_OBJECT:
+    case Instruction::SGET_BOOLEAN:
+    case Instruction::SGET_BYTE:
+    case Instruction::SGET_CHAR:
+    case Instruction::SGET_SHORT: {
+      if (!BuildStaticFieldAccess(instruction, dex_offset, false)) {
+        return false;
+      }
+      break;
+    }
+
+    case Instruction::SPUT:
+    case Instruction::SPUT_WIDE:
+    case Instruction::SPUT_OBJECT:
+    case Instruction::SPUT_BOOLEAN:
+    case Instruction::SPUT_BYTE:
+    case Instruction::SPUT_CHAR:
+    case Instruction::SPUT_SHORT: {
+      if (!BuildStaticFieldAccess(instruction, dex_offset, true)) {
+        return false;
+      }
+      break;
+    }
+
 #define ARRAY_XX(kind, anticipated_type)                                          \
     case Instruction::AGET##kind: {                                               \
       BuildArrayAccess(instruction, dex_offset, false, anticipated_type);         \
@@ -1062,6 +1850,26 @@ bool HGraphBuilder::AnalyzeDexInstruction(const Instruction& instruction, uint32
       break;
     }
 
+    case Instruction::INSTANCE_OF: {
+      if (!BuildTypeCheck(instruction, instruction.VRegA_22c(), instruction.VRegB_22c(),
+                          instruction.VRegC_22c(), dex_offset)) {
+        return false;
+      }
+      break;
+    }
+
+    case Instruction::CHECK_CAST: {
+      // Casts the verifier proved to always succeed need no code.
+      if (compiler_driver_->IsSafeCast(dex_compilation_unit_, dex_offset)) {
+        break;
+      }
+      if (!BuildTypeCheck(instruction, 0, instruction.VRegA_21c(),
+                          instruction.VRegB_21c(), dex_offset)) {
+        return false;
+      }
+      break;
+    }
+
     default:
       return false;
   }
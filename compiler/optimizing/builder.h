@@ -50,7 +50,8 @@ class HGraphBuilder : public ValueObject {
         compiler_driver_(driver),
         return_type_(Primitive::GetType(dex_compilation_unit_->GetShorty()[0])),
         code_start_(nullptr),
-        latest_result_(nullptr) {}
+        latest_result_(nullptr),
+        unsupported_instruction_(nullptr) {}
 
   // Only for unit testing.
   HGraphBuilder(ArenaAllocator* arena, Primitive::Type return_type = Primitive::kPrimInt)
@@ -68,10 +69,15 @@ class HGraphBuilder : public ValueObject {
         compiler_driver_(nullptr),
         return_type_(return_type),
         code_start_(nullptr),
-        latest_result_(nullptr) {}
+        latest_result_(nullptr),
+        unsupported_instruction_(nullptr) {}
 
   HGraph* BuildGraph(const DexFile::CodeItem& code);
 
+  // Returns the instruction that made BuildGraph() fail, or null if the
+  // graph could be built or it failed for another reason.
+  const Instruction* GetUnsupportedInstruction() const { return unsupported_instruction_; }
+
  private:
   // Analyzes the dex instruction and adds HInstruction to the graph
   // to execute that instruction. Returns whether the instruction can
@@ -84,6 +90,20 @@ class HGraphBuilder : public ValueObject {
   void MaybeUpdateCurrentBlock(size_t index);
   HBasicBlock* FindBlockStartingAt(int32_t index) const;
 
+  // Returns the block starting at `dex_pc`, creating it if needed. Returns
+  // null if `dex_pc` is the end of the code item.
+  HBasicBlock* MaybeCreateBlockAt(uint32_t dex_pc);
+
+  // Creates the blocks starting at try item boundaries and at exception
+  // handlers, and marks the latter as catch blocks.
+  void ComputeCatchBlocks(const DexFile::CodeItem& code_item);
+
+  // Adds the edges from the blocks covered by try items, and containing an
+  // instruction that can throw, to the catch blocks of their handlers. Handlers
+  // also reached by normal control flow get a dedicated catch block. Must be
+  // called once all blocks have been added to the graph.
+  void LinkCatchBlocks(const DexFile::CodeItem& code_item);
+
   HIntConstant* GetIntConstant0();
   HIntConstant* GetIntConstant1();
   HIntConstant* GetIntConstant(int32_t constant);
@@ -107,18 +127,67 @@ class HGraphBuilder : public ValueObject {
   template<typename T>
   void Binop_12x(const Instruction& instruction, Primitive::Type type);
 
+  // Builds a shift of a value of the given type by an int distance.
+  template<typename T>
+  void Binop_23x_shift(const Instruction& instruction, Primitive::Type type);
+
+  template<typename T>
+  void Binop_12x_shift(const Instruction& instruction, Primitive::Type type);
+
   template<typename T>
   void Binop_22b(const Instruction& instruction, bool reverse);
 
   template<typename T>
   void Binop_22s(const Instruction& instruction, bool reverse);
 
+  void Conversion_12x(const Instruction& instruction,
+                      Primitive::Type input_type,
+                      Primitive::Type result_type,
+                      uint32_t dex_offset);
+
+  // Builds an integer division or remainder, preceded by a check of the
+  // divisor against zero unless it is a non-zero literal.
+  void BuildCheckedDivRem(uint16_t out_reg,
+                          uint16_t first_reg,
+                          int32_t second_reg_or_constant,
+                          uint32_t dex_offset,
+                          Primitive::Type type,
+                          bool second_is_constant,
+                          bool is_div);
+
   template<typename T> void If_21t(const Instruction& instruction, uint32_t dex_offset);
   template<typename T> void If_22t(const Instruction& instruction, uint32_t dex_offset);
 
+  // Builds the dispatch of a packed-switch or sparse-switch instruction.
+  void BuildSwitch(const Instruction& instruction, uint32_t dex_offset);
+
+  // Builds a search tree comparing the value of `reg` against the sorted
+  // `keys` in [first, last), with the current block as its root. Values
+  // matching no key branch to `default_block`.
+  void BuildSparseSwitchCases(uint32_t reg,
+                              const int32_t* keys,
+                              const int32_t* targets,
+                              size_t first,
+                              size_t last,
+                              HBasicBlock* default_block,
+                              uint32_t dex_offset);
+
   void BuildReturn(const Instruction& instruction, Primitive::Type type);
 
   bool BuildFieldAccess(const Instruction& instruction, uint32_t dex_offset, bool is_get);
+
+  // Builds the access to a static field, preceded by the initialization check
+  // of its class when needed. Returns whether the field access is supported.
+  bool BuildStaticFieldAccess(const Instruction& instruction, uint32_t dex_offset, bool is_put);
+
+  // Builds an instance-of or check-cast instruction. `destination` is only
+  // used by instance-of. Returns whether the type can be accessed without
+  // runtime access checks.
+  bool BuildTypeCheck(const Instruction& instruction,
+                      uint8_t destination,
+                      uint8_t reference,
+                      uint16_t type_index,
+                      uint32_t dex_offset);
   void BuildArrayAccess(const Instruction& instruction,
                         uint32_t dex_offset,
                         bool is_get,
@@ -133,6 +202,11 @@ class HGraphBuilder : public ValueObject {
                    uint32_t* args,
                    uint32_t register_index);
 
+  // Returns whether an allocation of the given type can be elided by the
+  // optimizations when the object does not escape: the class must be
+  // accessible and initialized, and must not need finalizer registration.
+  bool CanRemoveAllocation(uint16_t type_index) const;
+
   // Builds a new array node and the instructions that fill it.
   void BuildFilledNewArray(uint32_t dex_offset,
                            uint32_t type_index,
@@ -158,6 +232,10 @@ class HGraphBuilder : public ValueObject {
                               uint32_t element_count,
                               uint32_t dex_offset);
 
+  // Number of keys up to which the cases of a sparse switch are searched
+  // linearly rather than with a binary search.
+  static constexpr size_t kSparseSwitchLinearSearchThreshold = 3;
+
   ArenaAllocator* const arena_;
 
   // A list of the size of the dex code holding block information for
@@ -188,6 +266,9 @@ class HGraphBuilder : public ValueObject {
   // used by move-result instructions.
   HInstruction* latest_result_;
 
+  // The first instruction AnalyzeDexInstruction() could not handle.
+  const Instruction* unsupported_instruction_;
+
   DISALLOW_COPY_AND_ASSIGN(HGraphBuilder);
 };
 
@@ -56,6 +56,9 @@ void CodeGenerator::CompileBaseline(CodeAllocator* allocator, bool is_leaf) {
   for (size_t i = 0, e = blocks.Size(); i < e; ++i) {
     HBasicBlock* block = blocks.Get(i);
     Bind(block);
+    if (block->IsCatchBlock()) {
+      RecordCatchBlockInfo(block);
+    }
     for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
       HInstruction* current = it.Current();
       current->Accept(location_builder);
@@ -84,6 +87,9 @@ void CodeGenerator::CompileOptimized(CodeAllocator* allocator) {
   for (size_t i = 0, e = blocks.Size(); i < e; ++i) {
     HBasicBlock* block = blocks.Get(i);
     Bind(block);
+    if (block->IsCatchBlock()) {
+      RecordCatchBlockInfo(block);
+    }
     for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
       HInstruction* current = it.Current();
       current->Accept(instruction_visitor);
@@ -194,11 +200,24 @@ void CodeGenerator::AllocateRegistersLocally(HInstruction* instruction) const {
       // Check that a register is not specified twice in the summary.
       DCHECK(!blocked_core_registers_[loc.reg()]);
       blocked_core_registers_[loc.reg()] = true;
+    } else if (loc.IsFpuRegister()) {
+      DCHECK(!blocked_fpu_registers_[loc.reg()]);
+      blocked_fpu_registers_[loc.reg()] = true;
     } else {
       DCHECK_EQ(loc.GetPolicy(), Location::kRequiresRegister);
     }
   }
 
+  Location output = locations->Out();
+  if (output.IsRegister()) {
+    blocked_core_registers_[output.reg()] = true;
+  } else if (output.IsFpuRegister()) {
+    blocked_fpu_registers_[output.reg()] = true;
+  } else if (output.IsRegisterPair()) {
+    blocked_core_registers_[output.AsRegisterPairLow<int>()] = true;
+    blocked_core_registers_[output.AsRegisterPairHigh<int>()] = true;
+  }
+
   SetupBlockedRegisters();
 
   // Allocate all unallocated input locations.
@@ -329,13 +348,14 @@ void CodeGenerator::BuildMappingTable(std::vector<uint8_t>* data, SrcMap* src_ma
   uint32_t pc2dex_offset = 0u;
   int32_t pc2dex_dalvik_offset = 0;
   uint32_t dex2pc_data_size = 0u;
-  uint32_t dex2pc_entries = 0u;
+  uint32_t dex2pc_entries = catch_infos_.Size();
+  uint32_t dex2pc_offset = 0u;
+  int32_t dex2pc_dalvik_offset = 0;
 
   if (src_map != nullptr) {
     src_map->reserve(pc2dex_entries);
   }
 
-  // We currently only have pc2dex entries.
   for (size_t i = 0; i < pc2dex_entries; i++) {
     struct PcInfo pc_info = pc_infos_.Get(i);
     pc2dex_data_size += UnsignedLeb128Size(pc_info.native_pc - pc2dex_offset);
@@ -347,8 +367,21 @@ void CodeGenerator::BuildMappingTable(std::vector<uint8_t>* data, SrcMap* src_ma
     }
   }
 
+  // The dex2pc entries are the entry points of the catch blocks, used by the
+  // runtime to find where to deliver an exception.
+  for (size_t i = 0; i < dex2pc_entries; i++) {
+    struct PcInfo catch_info = catch_infos_.Get(i);
+    dex2pc_data_size += UnsignedLeb128Size(catch_info.native_pc - dex2pc_offset);
+    dex2pc_data_size += SignedLeb128Size(catch_info.dex_pc - dex2pc_dalvik_offset);
+    dex2pc_offset = catch_info.native_pc;
+    dex2pc_dalvik_offset = catch_info.dex_pc;
+  }
+
   uint32_t total_entries = pc2dex_entries + dex2pc_entries;
-  uint32_t hdr_data_size = UnsignedLeb128Size(total_entries) + UnsignedLeb128Size(pc2dex_entries);
+  uint32_t pc2dex_index_entries = MappingTable::PcToDexIndexSize(pc2dex_entries);
+  uint32_t hdr_data_size = UnsignedLeb128Size(total_entries) + UnsignedLeb128Size(pc2dex_entries) +
+      UnsignedLeb128Size(pc2dex_index_entries) +
+      pc2dex_index_entries * MappingTable::kPcToDexIndexEntrySize;
   uint32_t data_size = hdr_data_size + pc2dex_data_size + dex2pc_data_size;
   data->resize(data_size);
 
@@ -356,7 +389,11 @@ void CodeGenerator::BuildMappingTable(std::vector<uint8_t>* data, SrcMap* src_ma
   uint8_t* write_pos = data_ptr;
   write_pos = EncodeUnsignedLeb128(write_pos, total_entries);
   write_pos = EncodeUnsignedLeb128(write_pos, pc2dex_entries);
+  write_pos = EncodeUnsignedLeb128(write_pos, pc2dex_index_entries);
+  uint8_t* index_pos = write_pos;
+  write_pos += pc2dex_index_entries * MappingTable::kPcToDexIndexEntrySize;
   DCHECK_EQ(static_cast<size_t>(write_pos - data_ptr), hdr_data_size);
+  uint8_t* const pc2dex_start = write_pos;
   uint8_t* write_pos2 = write_pos + pc2dex_data_size;
 
   pc2dex_offset = 0u;
@@ -368,6 +405,23 @@ void CodeGenerator::BuildMappingTable(std::vector<uint8_t>* data, SrcMap* src_ma
     write_pos = EncodeSignedLeb128(write_pos, pc_info.dex_pc - pc2dex_dalvik_offset);
     pc2dex_offset = pc_info.native_pc;
     pc2dex_dalvik_offset = pc_info.dex_pc;
+    if (MappingTable::NeedsPcToDexIndexEntry(i, pc2dex_entries)) {
+      index_pos = MappingTable::EncodePcToDexIndexEntry(
+          index_pos, pc2dex_offset, static_cast<uint32_t>(pc2dex_dalvik_offset),
+          write_pos - pc2dex_start);
+    }
+  }
+  DCHECK(index_pos == pc2dex_start);
+
+  dex2pc_offset = 0u;
+  dex2pc_dalvik_offset = 0u;
+  for (size_t i = 0; i < dex2pc_entries; i++) {
+    struct PcInfo catch_info = catch_infos_.Get(i);
+    DCHECK(dex2pc_offset <= catch_info.native_pc);
+    write_pos2 = EncodeUnsignedLeb128(write_pos2, catch_info.native_pc - dex2pc_offset);
+    write_pos2 = EncodeSignedLeb128(write_pos2, catch_info.dex_pc - dex2pc_dalvik_offset);
+    dex2pc_offset = catch_info.native_pc;
+    dex2pc_dalvik_offset = catch_info.dex_pc;
   }
   DCHECK_EQ(static_cast<size_t>(write_pos - data_ptr), hdr_data_size + pc2dex_data_size);
   DCHECK_EQ(static_cast<size_t>(write_pos2 - data_ptr), data_size);
@@ -383,8 +437,19 @@ void CodeGenerator::BuildMappingTable(std::vector<uint8_t>* data, SrcMap* src_ma
       struct PcInfo pc_info = pc_infos_.Get(i);
       CHECK_EQ(pc_info.native_pc, it.NativePcOffset());
       CHECK_EQ(pc_info.dex_pc, it.DexPc());
+      uint32_t found_dex_pc;
+      CHECK(table.FindPcToDex(pc_info.native_pc, &found_dex_pc));
+      if (i == 0 || pc_infos_.Get(i - 1).native_pc != pc_info.native_pc) {
+        CHECK_EQ(pc_info.dex_pc, found_dex_pc);
+      }
       ++it;
     }
+    for (size_t i = 0; i < dex2pc_entries; i++) {
+      struct PcInfo catch_info = catch_infos_.Get(i);
+      CHECK_EQ(catch_info.native_pc, it2.NativePcOffset());
+      CHECK_EQ(catch_info.dex_pc, it2.DexPc());
+      ++it2;
+    }
     CHECK(it == table.PcToDexEnd());
     CHECK(it2 == table.DexToPcEnd());
   }
@@ -408,6 +473,13 @@ void CodeGenerator::BuildStackMaps(std::vector<uint8_t>* data) {
   stack_map_stream_.FillIn(region);
 }
 
+void CodeGenerator::RecordCatchBlockInfo(HBasicBlock* block) {
+  struct PcInfo catch_info;
+  catch_info.dex_pc = block->GetDexPc();
+  catch_info.native_pc = GetAssembler()->CodeSize();
+  catch_infos_.Add(catch_info);
+}
+
 void CodeGenerator::RecordPcInfo(HInstruction* instruction, uint32_t dex_pc) {
   // Collect PC infos for the mapping table.
   struct PcInfo pc_info;
@@ -30,6 +30,11 @@ namespace art {
 static size_t constexpr kVRegSize = 4;
 static size_t constexpr kUninitializedFrameSize = 0;
 
+// Packed switches with up to this number of entries are compiled to a chain of
+// compares and branches, and larger ones to a bounds check and a jump table.
+// ARM has no jump tables, and only uses the threshold for its bounds check.
+static uint32_t constexpr kPackedSwitchJumpTableThreshold = 5;
+
 class Assembler;
 class CodeGenerator;
 class DexCompilationUnit;
@@ -173,6 +178,7 @@ class CodeGenerator : public ArenaObject {
         number_of_register_pairs_(number_of_register_pairs),
         graph_(graph),
         pc_infos_(graph->GetArena(), 32),
+        catch_infos_(graph->GetArena(), 0),
         slow_paths_(graph->GetArena(), 8),
         is_leaf_(true),
         stack_map_stream_(graph->GetArena()) {}
@@ -207,9 +213,14 @@ class CodeGenerator : public ArenaObject {
   void InitLocations(HInstruction* instruction);
   size_t GetStackOffsetOfSavedRegister(size_t index);
 
+  // Records the native pc at which `block`, a catch block, starts.
+  void RecordCatchBlockInfo(HBasicBlock* block);
+
   HGraph* const graph_;
 
   GrowableArray<PcInfo> pc_infos_;
+  // The dex and native pcs of the catch blocks, in code order.
+  GrowableArray<PcInfo> catch_infos_;
   GrowableArray<SlowPathCode*> slow_paths_;
 
   bool is_leaf_;
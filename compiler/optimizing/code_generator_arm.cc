@@ -171,6 +171,157 @@ class BoundsCheckSlowPathARM : public SlowPathCodeARM {
   DISALLOW_COPY_AND_ASSIGN(BoundsCheckSlowPathARM);
 };
 
+class DivZeroCheckSlowPathARM : public SlowPathCodeARM {
+ public:
+  explicit DivZeroCheckSlowPathARM(HDivZeroCheck* instruction) : instruction_(instruction) {}
+
+  virtual void EmitNativeCode(CodeGenerator* codegen) OVERRIDE {
+    __ Bind(GetEntryLabel());
+    int32_t offset = QUICK_ENTRYPOINT_OFFSET(kArmWordSize, pThrowDivZero).Int32Value();
+    __ LoadFromOffset(kLoadWord, LR, TR, offset);
+    __ blx(LR);
+    codegen->RecordPcInfo(instruction_, instruction_->GetDexPc());
+  }
+
+ private:
+  HDivZeroCheck* const instruction_;
+  DISALLOW_COPY_AND_ASSIGN(DivZeroCheckSlowPathARM);
+};
+
+class LoadStringSlowPathARM : public SlowPathCodeARM {
+ public:
+  explicit LoadStringSlowPathARM(HLoadString* instruction) : instruction_(instruction) {}
+
+  virtual void EmitNativeCode(CodeGenerator* codegen) OVERRIDE {
+    CodeGeneratorARM* arm_codegen = down_cast<CodeGeneratorARM*>(codegen);
+    LocationSummary* locations = instruction_->GetLocations();
+    __ Bind(GetEntryLabel());
+    codegen->SaveLiveRegisters(locations);
+    InvokeRuntimeCallingConvention calling_convention;
+    __ LoadFromOffset(
+        kLoadWord, calling_convention.GetRegisterAt(0), SP, kCurrentMethodStackOffset);
+    __ LoadImmediate(calling_convention.GetRegisterAt(1), instruction_->GetStringIndex());
+    int32_t offset = QUICK_ENTRYPOINT_OFFSET(kArmWordSize, pResolveString).Int32Value();
+    __ LoadFromOffset(kLoadWord, LR, TR, offset);
+    __ blx(LR);
+    codegen->RecordPcInfo(instruction_, instruction_->GetDexPc());
+    arm_codegen->Move32(locations->Out(), Location::RegisterLocation(R0));
+    codegen->RestoreLiveRegisters(locations);
+    __ b(GetExitLabel());
+  }
+
+ private:
+  HLoadString* const instruction_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoadStringSlowPathARM);
+};
+
+class LoadClassSlowPathARM : public SlowPathCodeARM {
+ public:
+  LoadClassSlowPathARM(HLoadClass* cls,
+                       HInstruction* at,
+                       uint32_t dex_pc,
+                       bool do_clinit)
+      : cls_(cls), at_(at), dex_pc_(dex_pc), do_clinit_(do_clinit) {
+    DCHECK(at->IsLoadClass() || at->IsClinitCheck());
+  }
+
+  virtual void EmitNativeCode(CodeGenerator* codegen) OVERRIDE {
+    CodeGeneratorARM* arm_codegen = down_cast<CodeGeneratorARM*>(codegen);
+    LocationSummary* locations = at_->GetLocations();
+    __ Bind(GetEntryLabel());
+    codegen->SaveLiveRegisters(locations);
+
+    InvokeRuntimeCallingConvention calling_convention;
+    __ LoadImmediate(calling_convention.GetRegisterAt(0), cls_->GetTypeIndex());
+    __ LoadFromOffset(
+        kLoadWord, calling_convention.GetRegisterAt(1), SP, kCurrentMethodStackOffset);
+    int32_t offset = do_clinit_
+        ? QUICK_ENTRYPOINT_OFFSET(kArmWordSize, pInitializeStaticStorage).Int32Value()
+        : QUICK_ENTRYPOINT_OFFSET(kArmWordSize, pInitializeType).Int32Value();
+    __ LoadFromOffset(kLoadWord, LR, TR, offset);
+    __ blx(LR);
+    codegen->RecordPcInfo(at_, dex_pc_);
+
+    // Move the class to the desired location.
+    if (locations->Out().IsValid()) {
+      arm_codegen->Move32(locations->Out(), Location::RegisterLocation(R0));
+    }
+    codegen->RestoreLiveRegisters(locations);
+    __ b(GetExitLabel());
+  }
+
+ private:
+  // The class this slow path will load.
+  HLoadClass* const cls_;
+
+  // The instruction where this slow path is happening.
+  // (Might be the load class or an initialization check).
+  HInstruction* const at_;
+
+  // The dex PC of `at_`.
+  const uint32_t dex_pc_;
+
+  // Whether to initialize the class.
+  const bool do_clinit_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoadClassSlowPathARM);
+};
+
+// Calls the runtime for the type checks that the inline code cannot decide:
+// instance-of gets the answer in its output, check-cast throws on failure.
+class TypeCheckSlowPathARM : public SlowPathCodeARM {
+ public:
+  TypeCheckSlowPathARM(HInstruction* instruction,
+                       Location class_to_check,
+                       Location object_class,
+                       uint32_t dex_pc)
+      : instruction_(instruction),
+        class_to_check_(class_to_check),
+        object_class_(object_class),
+        dex_pc_(dex_pc) {}
+
+  virtual void EmitNativeCode(CodeGenerator* codegen) OVERRIDE {
+    CodeGeneratorARM* arm_codegen = down_cast<CodeGeneratorARM*>(codegen);
+    LocationSummary* locations = instruction_->GetLocations();
+    __ Bind(GetEntryLabel());
+    codegen->SaveLiveRegisters(locations);
+
+    // The two classes may be in each other's argument register, so move
+    // them with the parallel move resolver.
+    InvokeRuntimeCallingConvention calling_convention;
+    ArenaAllocator* arena = codegen->GetGraph()->GetArena();
+    HParallelMove parallel_move(arena);
+    parallel_move.AddMove(new (arena) MoveOperands(
+        class_to_check_, Location::RegisterLocation(calling_convention.GetRegisterAt(0)), nullptr));
+    parallel_move.AddMove(new (arena) MoveOperands(
+        object_class_, Location::RegisterLocation(calling_convention.GetRegisterAt(1)), nullptr));
+    arm_codegen->GetMoveResolver()->EmitNativeCode(&parallel_move);
+
+    int32_t offset = instruction_->IsInstanceOf()
+        ? QUICK_ENTRYPOINT_OFFSET(kArmWordSize, pInstanceofNonTrivial).Int32Value()
+        : QUICK_ENTRYPOINT_OFFSET(kArmWordSize, pCheckCast).Int32Value();
+    DCHECK(instruction_->IsInstanceOf() || instruction_->IsCheckCast());
+    __ LoadFromOffset(kLoadWord, LR, TR, offset);
+    __ blx(LR);
+    codegen->RecordPcInfo(instruction_, dex_pc_);
+
+    if (instruction_->IsInstanceOf()) {
+      arm_codegen->Move32(locations->Out(), Location::RegisterLocation(R0));
+    }
+    codegen->RestoreLiveRegisters(locations);
+    __ b(GetExitLabel());
+  }
+
+ private:
+  HInstruction* const instruction_;
+  const Location class_to_check_;
+  const Location object_class_;
+  const uint32_t dex_pc_;
+
+  DISALLOW_COPY_AND_ASSIGN(TypeCheckSlowPathARM);
+};
+
 #undef __
 #define __ reinterpret_cast<ArmAssembler*>(GetAssembler())->
 
@@ -1038,6 +1189,39 @@ void InstructionCodeGeneratorARM::VisitInvokeVirtual(HInvokeVirtual* invoke) {
   codegen_->RecordPcInfo(invoke, invoke->GetDexPc());
 }
 
+void LocationsBuilderARM::VisitInvokeInterface(HInvokeInterface* invoke) {
+  HandleInvoke(invoke);
+}
+
+void InstructionCodeGeneratorARM::VisitInvokeInterface(HInvokeInterface* invoke) {
+  Register temp = invoke->GetLocations()->GetTemp(0).As<Register>();
+  uint32_t method_offset = mirror::Class::EmbeddedImTableOffset().Uint32Value() +
+          (invoke->GetImtIndex() % mirror::Class::kImtSize) * sizeof(mirror::Class::ImTableEntry);
+  LocationSummary* locations = invoke->GetLocations();
+  Location receiver = locations->InAt(0);
+  uint32_t class_offset = mirror::Object::ClassOffset().Int32Value();
+  // temp = object->GetClass();
+  if (receiver.IsStackSlot()) {
+    __ LoadFromOffset(kLoadWord, temp, SP, receiver.GetStackIndex());
+    __ LoadFromOffset(kLoadWord, temp, temp, class_offset);
+  } else {
+    __ LoadFromOffset(kLoadWord, temp, receiver.As<Register>(), class_offset);
+  }
+  // temp = temp->GetImtEntryAt(method_offset);
+  uint32_t entry_point = mirror::ArtMethod::EntryPointFromQuickCompiledCodeOffset().Int32Value();
+  __ LoadFromOffset(kLoadWord, temp, temp, method_offset);
+  // LR = temp->GetEntryPoint();
+  __ LoadFromOffset(kLoadWord, LR, temp, entry_point);
+  // Set the hidden argument in R12, which the IMT conflict trampoline uses
+  // to find the interface method. The loads above may use IP as a scratch
+  // register, so this comes last.
+  __ LoadImmediate(IP, invoke->GetDexMethodIndex());
+  // LR();
+  __ blx(LR);
+  DCHECK(!codegen_->IsLeafMethod());
+  codegen_->RecordPcInfo(invoke, invoke->GetDexPc());
+}
+
 void LocationsBuilderARM::VisitNeg(HNeg* neg) {
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(neg, LocationSummary::kNoCall);
@@ -1319,6 +1503,320 @@ void InstructionCodeGeneratorARM::VisitMul(HMul* mul) {
   }
 }
 
+void LocationsBuilderARM::VisitAnd(HAnd* instruction) {
+  HandleBitwiseOperation(instruction);
+}
+
+void InstructionCodeGeneratorARM::VisitAnd(HAnd* instruction) {
+  HandleBitwiseOperation(instruction);
+}
+
+void LocationsBuilderARM::VisitOr(HOr* instruction) {
+  HandleBitwiseOperation(instruction);
+}
+
+void InstructionCodeGeneratorARM::VisitOr(HOr* instruction) {
+  HandleBitwiseOperation(instruction);
+}
+
+void LocationsBuilderARM::VisitXor(HXor* instruction) {
+  HandleBitwiseOperation(instruction);
+}
+
+void InstructionCodeGeneratorARM::VisitXor(HXor* instruction) {
+  HandleBitwiseOperation(instruction);
+}
+
+void LocationsBuilderARM::HandleBitwiseOperation(HBinaryOperation* instruction) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
+  DCHECK(instruction->GetResultType() == Primitive::kPrimInt
+         || instruction->GetResultType() == Primitive::kPrimLong);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  // The low half of a long output must not be the high half of an input.
+  bool output_overlaps = (instruction->GetResultType() == Primitive::kPrimLong);
+  locations->SetOut(Location::RequiresRegister(), output_overlaps);
+}
+
+void InstructionCodeGeneratorARM::HandleBitwiseOperation(HBinaryOperation* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  Location out = locations->Out();
+  Location first = locations->InAt(0);
+  Location second = locations->InAt(1);
+
+  if (instruction->GetResultType() == Primitive::kPrimInt) {
+    Register out_reg = out.As<Register>();
+    Register first_reg = first.As<Register>();
+    ShifterOperand second_reg(second.As<Register>());
+    if (instruction->IsAnd()) {
+      __ and_(out_reg, first_reg, second_reg);
+    } else if (instruction->IsOr()) {
+      __ orr(out_reg, first_reg, second_reg);
+    } else {
+      DCHECK(instruction->IsXor());
+      __ eor(out_reg, first_reg, second_reg);
+    }
+  } else {
+    DCHECK_EQ(instruction->GetResultType(), Primitive::kPrimLong);
+    Register out_low = out.AsRegisterPairLow<Register>();
+    Register out_high = out.AsRegisterPairHigh<Register>();
+    Register first_low = first.AsRegisterPairLow<Register>();
+    Register first_high = first.AsRegisterPairHigh<Register>();
+    ShifterOperand second_low(second.AsRegisterPairLow<Register>());
+    ShifterOperand second_high(second.AsRegisterPairHigh<Register>());
+    if (instruction->IsAnd()) {
+      __ and_(out_low, first_low, second_low);
+      __ and_(out_high, first_high, second_high);
+    } else if (instruction->IsOr()) {
+      __ orr(out_low, first_low, second_low);
+      __ orr(out_high, first_high, second_high);
+    } else {
+      DCHECK(instruction->IsXor());
+      __ eor(out_low, first_low, second_low);
+      __ eor(out_high, first_high, second_high);
+    }
+  }
+}
+
+
+void LocationsBuilderARM::VisitShl(HShl* instruction) {
+  HandleShift(instruction);
+}
+
+void InstructionCodeGeneratorARM::VisitShl(HShl* instruction) {
+  HandleShift(instruction);
+}
+
+void LocationsBuilderARM::VisitShr(HShr* instruction) {
+  HandleShift(instruction);
+}
+
+void InstructionCodeGeneratorARM::VisitShr(HShr* instruction) {
+  HandleShift(instruction);
+}
+
+void LocationsBuilderARM::VisitUShr(HUShr* instruction) {
+  HandleShift(instruction);
+}
+
+void InstructionCodeGeneratorARM::VisitUShr(HUShr* instruction) {
+  HandleShift(instruction);
+}
+
+void LocationsBuilderARM::HandleShift(HBinaryOperation* instruction) {
+  if (instruction->GetResultType() == Primitive::kPrimLong) {
+    if (instruction->InputAt(1)->IsConstant()) {
+      // The words of the output are computed from both words of the input,
+      // so they must not share a register.
+      LocationSummary* locations =
+          new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
+      locations->SetInAt(0, Location::RequiresRegister());
+      locations->SetInAt(1, Location::ConstantLocation(instruction->InputAt(1)->AsConstant()));
+      locations->SetOut(Location::RequiresRegister());
+    } else {
+      // The runtime takes the value in R0:R1 and the distance in R2, and
+      // returns the result in R0:R1.
+      LocationSummary* locations =
+          new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCall);
+      InvokeRuntimeCallingConvention calling_convention;
+      locations->SetInAt(0, Location::RegisterPairLocation(
+          calling_convention.GetRegisterAt(0), calling_convention.GetRegisterAt(1)));
+      locations->SetInAt(1, Location::RegisterLocation(calling_convention.GetRegisterAt(2)));
+      locations->SetOut(Location::RegisterPairLocation(R0, R1));
+    }
+    return;
+  }
+
+  DCHECK_EQ(instruction->GetResultType(), Primitive::kPrimInt);
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RegisterOrConstant(instruction->InputAt(1)));
+  // The masked shift distance is computed in the output register before the
+  // first input is read.
+  locations->SetOut(Location::RequiresRegister(), Location::kNoOutputOverlap);
+}
+
+void InstructionCodeGeneratorARM::HandleShift(HBinaryOperation* instruction) {
+  if (instruction->GetResultType() == Primitive::kPrimLong) {
+    GenerateLongShift(instruction);
+    return;
+  }
+
+  LocationSummary* locations = instruction->GetLocations();
+  Register out = locations->Out().As<Register>();
+  Register first = locations->InAt(0).As<Register>();
+  Location second = locations->InAt(1);
+
+  if (second.IsRegister()) {
+    // Register shifts use the low byte of the distance, but Java only uses
+    // its low 5 bits.
+    __ and_(out, second.As<Register>(), ShifterOperand(kMaxIntShiftValue));
+    if (instruction->IsShl()) {
+      __ Lsl(out, first, out);
+    } else if (instruction->IsShr()) {
+      __ Asr(out, first, out);
+    } else {
+      DCHECK(instruction->IsUShr());
+      __ Lsr(out, first, out);
+    }
+  } else {
+    int32_t value = second.GetConstant()->AsIntConstant()->GetValue();
+    uint32_t shift_value = static_cast<uint32_t>(value & kMaxIntShiftValue);
+    if (shift_value == 0) {
+      __ Mov(out, first);
+    } else if (instruction->IsShl()) {
+      __ Lsl(out, first, shift_value);
+    } else if (instruction->IsShr()) {
+      __ Asr(out, first, shift_value);
+    } else {
+      DCHECK(instruction->IsUShr());
+      __ Lsr(out, first, shift_value);
+    }
+  }
+}
+
+void InstructionCodeGeneratorARM::GenerateLongShift(HBinaryOperation* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  Location second = locations->InAt(1);
+
+  if (!second.IsConstant()) {
+    // The runtime helpers only use the low 6 bits of the distance.
+    int32_t offset;
+    if (instruction->IsShl()) {
+      offset = QUICK_ENTRYPOINT_OFFSET(kArmWordSize, pShlLong).Int32Value();
+    } else if (instruction->IsShr()) {
+      offset = QUICK_ENTRYPOINT_OFFSET(kArmWordSize, pShrLong).Int32Value();
+    } else {
+      DCHECK(instruction->IsUShr());
+      offset = QUICK_ENTRYPOINT_OFFSET(kArmWordSize, pUshrLong).Int32Value();
+    }
+    __ LoadFromOffset(kLoadWord, LR, TR, offset);
+    __ blx(LR);
+    return;
+  }
+
+  Register in_lo = locations->InAt(0).AsRegisterPairLow<Register>();
+  Register in_hi = locations->InAt(0).AsRegisterPairHigh<Register>();
+  Register out_lo = locations->Out().AsRegisterPairLow<Register>();
+  Register out_hi = locations->Out().AsRegisterPairHigh<Register>();
+  uint32_t shift =
+      static_cast<uint32_t>(second.GetConstant()->AsIntConstant()->GetValue() & kMaxLongShiftValue);
+
+  if (shift == 0) {
+    __ Mov(out_lo, in_lo);
+    __ Mov(out_hi, in_hi);
+  } else if (shift < 32) {
+    if (instruction->IsShl()) {
+      __ Lsl(out_hi, in_hi, shift);
+      __ orr(out_hi, out_hi, ShifterOperand(in_lo, LSR, 32 - shift));
+      __ Lsl(out_lo, in_lo, shift);
+    } else {
+      __ Lsr(out_lo, in_lo, shift);
+      __ orr(out_lo, out_lo, ShifterOperand(in_hi, LSL, 32 - shift));
+      if (instruction->IsShr()) {
+        __ Asr(out_hi, in_hi, shift);
+      } else {
+        DCHECK(instruction->IsUShr());
+        __ Lsr(out_hi, in_hi, shift);
+      }
+    }
+  } else {
+    // Shifting by 32 or more moves one word into the other.
+    uint32_t word_shift = shift - 32;
+    if (instruction->IsShl()) {
+      if (word_shift == 0) {
+        __ Mov(out_hi, in_lo);
+      } else {
+        __ Lsl(out_hi, in_lo, word_shift);
+      }
+      __ LoadImmediate(out_lo, 0);
+    } else if (instruction->IsShr()) {
+      if (word_shift == 0) {
+        __ Mov(out_lo, in_hi);
+      } else {
+        __ Asr(out_lo, in_hi, word_shift);
+      }
+      __ Asr(out_hi, in_hi, 31);
+    } else {
+      DCHECK(instruction->IsUShr());
+      if (word_shift == 0) {
+        __ Mov(out_lo, in_hi);
+      } else {
+        __ Lsr(out_lo, in_hi, word_shift);
+      }
+      __ LoadImmediate(out_hi, 0);
+    }
+  }
+}
+
+void LocationsBuilderARM::VisitDiv(HDiv* instruction) {
+  HandleDivRem(instruction);
+}
+
+void InstructionCodeGeneratorARM::VisitDiv(HDiv* instruction) {
+  HandleDivRem(instruction);
+}
+
+void LocationsBuilderARM::VisitRem(HRem* instruction) {
+  HandleDivRem(instruction);
+}
+
+void InstructionCodeGeneratorARM::VisitRem(HRem* instruction) {
+  HandleDivRem(instruction);
+}
+
+void LocationsBuilderARM::HandleDivRem(HBinaryOperation* instruction) {
+  if (instruction->GetResultType() == Primitive::kPrimLong) {
+    // The runtime takes the dividend in R0:R1 and the divisor in R2:R3, and
+    // returns the quotient in R0:R1 and the remainder in R2:R3.
+    LocationSummary* locations =
+        new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCall);
+    InvokeRuntimeCallingConvention calling_convention;
+    locations->SetInAt(0, Location::RegisterPairLocation(
+        calling_convention.GetRegisterAt(0), calling_convention.GetRegisterAt(1)));
+    locations->SetInAt(1, Location::RegisterPairLocation(R2, R3));
+    if (instruction->IsDiv()) {
+      locations->SetOut(Location::RegisterPairLocation(R0, R1));
+    } else {
+      locations->SetOut(Location::RegisterPairLocation(R2, R3));
+    }
+    return;
+  }
+
+  DCHECK_EQ(instruction->GetResultType(), Primitive::kPrimInt);
+  // Not every ARM core has a divide instruction, so call the runtime, which
+  // returns the quotient in R0 and the remainder in R1.
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCall);
+  InvokeRuntimeCallingConvention calling_convention;
+  locations->SetInAt(0, Location::RegisterLocation(calling_convention.GetRegisterAt(0)));
+  locations->SetInAt(1, Location::RegisterLocation(calling_convention.GetRegisterAt(1)));
+  if (instruction->IsDiv()) {
+    locations->SetOut(Location::RegisterLocation(R0));
+  } else {
+    locations->SetOut(Location::RegisterLocation(R1));
+  }
+}
+
+void InstructionCodeGeneratorARM::HandleDivRem(HBinaryOperation* instruction) {
+  int32_t offset;
+  if (instruction->GetResultType() == Primitive::kPrimLong) {
+    offset = instruction->IsDiv()
+        ? QUICK_ENTRYPOINT_OFFSET(kArmWordSize, pLdiv).Int32Value()
+        : QUICK_ENTRYPOINT_OFFSET(kArmWordSize, pLmod).Int32Value();
+  } else {
+    offset = QUICK_ENTRYPOINT_OFFSET(kArmWordSize, pIdivmod).Int32Value();
+  }
+  __ LoadFromOffset(kLoadWord, LR, TR, offset);
+  __ blx(LR);
+  uint32_t dex_pc = instruction->IsDiv()
+      ? instruction->AsDiv()->GetDexPc()
+      : instruction->AsRem()->GetDexPc();
+  codegen_->RecordPcInfo(instruction, dex_pc);
+}
+
 void LocationsBuilderARM::VisitNewInstance(HNewInstance* instruction) {
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCall);
@@ -1466,10 +1964,10 @@ void InstructionCodeGeneratorARM::VisitPhi(HPhi* instruction) {
   LOG(FATAL) << "Unreachable";
 }
 
-void LocationsBuilderARM::VisitInstanceFieldSet(HInstanceFieldSet* instruction) {
+void LocationsBuilderARM::HandleFieldSet(HInstruction* instruction, Primitive::Type field_type) {
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
-  bool is_object_type = instruction->GetFieldType() == Primitive::kPrimNot;
+  bool is_object_type = field_type == Primitive::kPrimNot;
   locations->SetInAt(0, Location::RequiresRegister());
   locations->SetInAt(1, Location::RequiresRegister());
   // Temporary registers for the write barrier.
@@ -1479,11 +1977,11 @@ void LocationsBuilderARM::VisitInstanceFieldSet(HInstanceFieldSet* instruction)
   }
 }
 
-void InstructionCodeGeneratorARM::VisitInstanceFieldSet(HInstanceFieldSet* instruction) {
+void InstructionCodeGeneratorARM::HandleFieldSet(HInstruction* instruction,
+                                                 Primitive::Type field_type,
+                                                 uint32_t offset) {
   LocationSummary* locations = instruction->GetLocations();
   Register obj = locations->InAt(0).As<Register>();
-  uint32_t offset = instruction->GetFieldOffset().Uint32Value();
-  Primitive::Type field_type = instruction->GetFieldType();
 
   switch (field_type) {
     case Primitive::kPrimBoolean:
@@ -1528,17 +2026,16 @@ void InstructionCodeGeneratorARM::VisitInstanceFieldSet(HInstanceFieldSet* instr
   }
 }
 
-void LocationsBuilderARM::VisitInstanceFieldGet(HInstanceFieldGet* instruction) {
+void LocationsBuilderARM::HandleFieldGet(HInstruction* instruction) {
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
   locations->SetInAt(0, Location::RequiresRegister());
   locations->SetOut(Location::RequiresRegister(), Location::kNoOutputOverlap);
 }
 
-void InstructionCodeGeneratorARM::VisitInstanceFieldGet(HInstanceFieldGet* instruction) {
+void InstructionCodeGeneratorARM::HandleFieldGet(HInstruction* instruction, uint32_t offset) {
   LocationSummary* locations = instruction->GetLocations();
   Register obj = locations->InAt(0).As<Register>();
-  uint32_t offset = instruction->GetFieldOffset().Uint32Value();
 
   switch (instruction->GetType()) {
     case Primitive::kPrimBoolean: {
@@ -1589,6 +2086,42 @@ void InstructionCodeGeneratorARM::VisitInstanceFieldGet(HInstanceFieldGet* instr
   }
 }
 
+void LocationsBuilderARM::VisitInstanceFieldSet(HInstanceFieldSet* instruction) {
+  HandleFieldSet(instruction, instruction->GetFieldType());
+}
+
+void InstructionCodeGeneratorARM::VisitInstanceFieldSet(HInstanceFieldSet* instruction) {
+  HandleFieldSet(instruction,
+                 instruction->GetFieldType(),
+                 instruction->GetFieldOffset().Uint32Value());
+}
+
+void LocationsBuilderARM::VisitInstanceFieldGet(HInstanceFieldGet* instruction) {
+  HandleFieldGet(instruction);
+}
+
+void InstructionCodeGeneratorARM::VisitInstanceFieldGet(HInstanceFieldGet* instruction) {
+  HandleFieldGet(instruction, instruction->GetFieldOffset().Uint32Value());
+}
+
+void LocationsBuilderARM::VisitStaticFieldSet(HStaticFieldSet* instruction) {
+  HandleFieldSet(instruction, instruction->GetFieldType());
+}
+
+void InstructionCodeGeneratorARM::VisitStaticFieldSet(HStaticFieldSet* instruction) {
+  HandleFieldSet(instruction,
+                 instruction->GetFieldType(),
+                 instruction->GetFieldOffset().Uint32Value());
+}
+
+void LocationsBuilderARM::VisitStaticFieldGet(HStaticFieldGet* instruction) {
+  HandleFieldGet(instruction);
+}
+
+void InstructionCodeGeneratorARM::VisitStaticFieldGet(HStaticFieldGet* instruction) {
+  HandleFieldGet(instruction, instruction->GetFieldOffset().Uint32Value());
+}
+
 void LocationsBuilderARM::VisitNullCheck(HNullCheck* instruction) {
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
@@ -1897,6 +2430,421 @@ void InstructionCodeGeneratorARM::VisitSuspendCheck(HSuspendCheck* instruction)
   GenerateSuspendCheck(instruction, nullptr);
 }
 
+void LocationsBuilderARM::VisitLoadException(HLoadException* load) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(load, LocationSummary::kNoCall);
+  locations->SetOut(Location::RequiresRegister());
+}
+
+void InstructionCodeGeneratorARM::VisitLoadException(HLoadException* load) {
+  Register out = load->GetLocations()->Out().As<Register>();
+  int32_t offset = Thread::ExceptionOffset<kArmWordSize>().Int32Value();
+  __ LoadFromOffset(kLoadWord, out, TR, offset);
+  __ LoadImmediate(IP, 0);
+  __ StoreToOffset(kStoreWord, IP, TR, offset);
+}
+
+void LocationsBuilderARM::VisitPackedSwitch(HPackedSwitch* switch_instr) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(switch_instr, LocationSummary::kNoCall);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+}
+
+void InstructionCodeGeneratorARM::VisitPackedSwitch(HPackedSwitch* switch_instr) {
+  int32_t start_value = switch_instr->GetStartValue();
+  uint32_t num_entries = switch_instr->GetNumEntries();
+  LocationSummary* locations = switch_instr->GetLocations();
+  Register value = locations->InAt(0).As<Register>();
+  Register temp = locations->GetTemp(0).As<Register>();
+  HBasicBlock* default_block = switch_instr->GetDefaultBlock();
+
+  // The Thumb2 assembler cannot emit data in the instruction stream, so
+  // compare the index of the case against each entry, after a bounds check
+  // for large switches.
+  Register index = IP;
+  __ AddConstant(index, value, static_cast<int32_t>(-static_cast<uint32_t>(start_value)));
+  if (num_entries > kPackedSwitchJumpTableThreshold) {
+    // Values out of the range of the cases give an unsigned index above the last entry.
+    __ LoadImmediate(temp, num_entries - 1);
+    __ cmp(index, ShifterOperand(temp));
+    __ b(codegen_->GetLabelOf(default_block), HI);
+  }
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    ShifterOperand operand;
+    if (ShifterOperand::CanHoldArm(i, &operand)) {
+      __ cmp(index, ShifterOperand(i));
+    } else {
+      __ LoadImmediate(temp, i);
+      __ cmp(index, ShifterOperand(temp));
+    }
+    __ b(codegen_->GetLabelOf(switch_instr->GetCaseSuccessor(i)), EQ);
+  }
+  if (!codegen_->GoesToNextBlock(switch_instr->GetBlock(), default_block)) {
+    __ b(codegen_->GetLabelOf(default_block));
+  }
+}
+
+void LocationsBuilderARM::VisitThrow(HThrow* instruction) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCall);
+  InvokeRuntimeCallingConvention calling_convention;
+  locations->SetInAt(0, Location::RegisterLocation(calling_convention.GetRegisterAt(0)));
+}
+
+void InstructionCodeGeneratorARM::VisitThrow(HThrow* instruction) {
+  int32_t offset = QUICK_ENTRYPOINT_OFFSET(kArmWordSize, pDeliverException).Int32Value();
+  __ LoadFromOffset(kLoadWord, LR, TR, offset);
+  __ blx(LR);
+  codegen_->RecordPcInfo(instruction, instruction->GetDexPc());
+}
+
+void LocationsBuilderARM::VisitDivZeroCheck(HDivZeroCheck* instruction) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
+  locations->SetInAt(0, Location::RegisterOrConstant(instruction->InputAt(0)));
+  if (instruction->HasUses()) {
+    locations->SetOut(Location::SameAsFirstInput());
+  }
+}
+
+void InstructionCodeGeneratorARM::VisitDivZeroCheck(HDivZeroCheck* instruction) {
+  SlowPathCodeARM* slow_path = new (GetGraph()->GetArena()) DivZeroCheckSlowPathARM(instruction);
+  codegen_->AddSlowPath(slow_path);
+
+  Location value = instruction->GetLocations()->InAt(0);
+  if (value.IsRegister()) {
+    __ cmp(value.As<Register>(), ShifterOperand(0));
+    __ b(slow_path->GetEntryLabel(), EQ);
+  } else if (value.IsRegisterPair()) {
+    __ orrs(IP,
+            value.AsRegisterPairLow<Register>(),
+            ShifterOperand(value.AsRegisterPairHigh<Register>()));
+    __ b(slow_path->GetEntryLabel(), EQ);
+  } else {
+    DCHECK(value.IsConstant()) << value;
+    HConstant* constant = value.GetConstant();
+    bool is_zero = constant->IsIntConstant()
+        ? (constant->AsIntConstant()->GetValue() == 0)
+        : (constant->AsLongConstant()->GetValue() == 0);
+    if (is_zero) {
+      __ b(slow_path->GetEntryLabel());
+    }
+  }
+}
+
+void LocationsBuilderARM::VisitTypeConversion(HTypeConversion* conversion) {
+  Primitive::Type input_type = conversion->GetInputType();
+  Primitive::Type result_type = conversion->GetResultType();
+  bool is_fp_input =
+      (input_type == Primitive::kPrimFloat) || (input_type == Primitive::kPrimDouble);
+  bool is_fp_result =
+      (result_type == Primitive::kPrimFloat) || (result_type == Primitive::kPrimDouble);
+
+  if (is_fp_input && result_type == Primitive::kPrimLong) {
+    // There is no VFP instruction for this conversion, so call the runtime,
+    // which takes the value in S0 or D0 and returns the result in R0:R1.
+    LocationSummary* locations =
+        new (GetGraph()->GetArena()) LocationSummary(conversion, LocationSummary::kCall);
+    locations->SetInAt(0, Location::FpuRegisterLocation(D0));
+    locations->SetOut(Location::RegisterPairLocation(R0, R1));
+    return;
+  }
+
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(conversion, LocationSummary::kNoCall);
+  if (is_fp_input) {
+    locations->SetInAt(0, Location::RequiresFpuRegister());
+  } else {
+    locations->SetInAt(0, Location::RequiresRegister());
+  }
+
+  if (is_fp_result && input_type == Primitive::kPrimLong) {
+    // The two words are converted separately and then combined, so the
+    // output must not share a register with the temporaries.
+    locations->SetOut(Location::RequiresFpuRegister());
+    locations->AddTemp(Location::RequiresFpuRegister());
+    locations->AddTemp(Location::RequiresFpuRegister());
+  } else if (is_fp_result) {
+    locations->SetOut(Location::RequiresFpuRegister(), Location::kNoOutputOverlap);
+  } else if (result_type == Primitive::kPrimLong) {
+    // The high word is computed from the low word, so they must not share
+    // a register with the input.
+    locations->SetOut(Location::RequiresRegister());
+  } else {
+    locations->SetOut(Location::RequiresRegister(), Location::kNoOutputOverlap);
+    if (is_fp_input) {
+      // The conversion result is in a VFP register before being moved to the
+      // output.
+      locations->AddTemp(Location::RequiresFpuRegister());
+    }
+  }
+}
+
+void InstructionCodeGeneratorARM::VisitTypeConversion(HTypeConversion* conversion) {
+  LocationSummary* locations = conversion->GetLocations();
+  Location out = locations->Out();
+  Location in = locations->InAt(0);
+  Primitive::Type input_type = conversion->GetInputType();
+  switch (conversion->GetResultType()) {
+    case Primitive::kPrimLong: {
+      if (input_type == Primitive::kPrimFloat || input_type == Primitive::kPrimDouble) {
+        int32_t offset = input_type == Primitive::kPrimFloat
+            ? QUICK_ENTRYPOINT_OFFSET(kArmWordSize, pF2l).Int32Value()
+            : QUICK_ENTRYPOINT_OFFSET(kArmWordSize, pD2l).Int32Value();
+        __ LoadFromOffset(kLoadWord, LR, TR, offset);
+        __ blx(LR);
+        codegen_->RecordPcInfo(conversion, conversion->GetDexPc());
+        break;
+      }
+      DCHECK_EQ(input_type, Primitive::kPrimInt);
+      Register out_low = out.AsRegisterPairLow<Register>();
+      __ Mov(out_low, in.As<Register>());
+      __ Asr(out.AsRegisterPairHigh<Register>(), out_low, 31);
+      break;
+    }
+
+    case Primitive::kPrimInt:
+      if (input_type == Primitive::kPrimFloat || input_type == Primitive::kPrimDouble) {
+        // The VFP conversion rounds towards zero, saturates and converts NaN
+        // to zero, as Java does.
+        SRegister temp = FromDToLowS(locations->GetTemp(0).As<DRegister>());
+        if (input_type == Primitive::kPrimFloat) {
+          __ vcvtis(temp, FromDToLowS(in.As<DRegister>()));
+        } else {
+          __ vcvtid(temp, in.As<DRegister>());
+        }
+        __ vmovrs(out.As<Register>(), temp);
+        break;
+      }
+      DCHECK_EQ(input_type, Primitive::kPrimLong);
+      __ Mov(out.As<Register>(), in.AsRegisterPairLow<Register>());
+      break;
+
+    case Primitive::kPrimFloat:
+    case Primitive::kPrimDouble: {
+      DRegister result = out.As<DRegister>();
+      bool is_float = conversion->GetResultType() == Primitive::kPrimFloat;
+      if (input_type == Primitive::kPrimInt) {
+        __ vmovsr(FromDToLowS(result), in.As<Register>());
+        if (is_float) {
+          __ vcvtsi(FromDToLowS(result), FromDToLowS(result));
+        } else {
+          __ vcvtdi(result, FromDToLowS(result));
+        }
+      } else if (input_type == Primitive::kPrimLong) {
+        // Compute the exact high * 2^32 + low with a single rounding to a
+        // double. A float is then rounded from that double, as Quick does.
+        DRegister high = locations->GetTemp(0).As<DRegister>();
+        DRegister constant = locations->GetTemp(1).As<DRegister>();
+        __ vmovsr(FromDToLowS(high), in.AsRegisterPairHigh<Register>());
+        __ vcvtdi(high, FromDToLowS(high));
+        __ vmovsr(FromDToLowS(result), in.AsRegisterPairLow<Register>());
+        __ vcvtdu(result, FromDToLowS(result));
+        // constant = 2^32.
+        __ LoadImmediate(IP, 0);
+        __ vmovsr(FromDToLowS(constant), IP);
+        __ LoadImmediate(IP, 0x41f00000);
+        __ vmovsr(static_cast<SRegister>(FromDToLowS(constant) + 1), IP);
+        __ vmlad(result, high, constant);
+        if (is_float) {
+          __ vcvtsd(FromDToLowS(result), result);
+        }
+      } else if (is_float) {
+        DCHECK_EQ(input_type, Primitive::kPrimDouble);
+        __ vcvtsd(FromDToLowS(result), in.As<DRegister>());
+      } else {
+        DCHECK_EQ(input_type, Primitive::kPrimFloat);
+        __ vcvtds(result, FromDToLowS(in.As<DRegister>()));
+      }
+      break;
+    }
+
+    case Primitive::kPrimByte:
+      __ Lsl(out.As<Register>(), in.As<Register>(), 24);
+      __ Asr(out.As<Register>(), out.As<Register>(), 24);
+      break;
+
+    case Primitive::kPrimShort:
+      __ Lsl(out.As<Register>(), in.As<Register>(), 16);
+      __ Asr(out.As<Register>(), out.As<Register>(), 16);
+      break;
+
+    case Primitive::kPrimChar:
+      __ Lsl(out.As<Register>(), in.As<Register>(), 16);
+      __ Lsr(out.As<Register>(), out.As<Register>(), 16);
+      break;
+
+    default:
+      LOG(FATAL) << "Unexpected type conversion from " << conversion->GetInputType()
+                 << " to " << conversion->GetResultType();
+  }
+}
+
+void LocationsBuilderARM::VisitMonitorOperation(HMonitorOperation* instruction) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCall);
+  InvokeRuntimeCallingConvention calling_convention;
+  locations->SetInAt(0, Location::RegisterLocation(calling_convention.GetRegisterAt(0)));
+}
+
+void InstructionCodeGeneratorARM::VisitMonitorOperation(HMonitorOperation* instruction) {
+  int32_t offset = instruction->IsEnter()
+      ? QUICK_ENTRYPOINT_OFFSET(kArmWordSize, pLockObject).Int32Value()
+      : QUICK_ENTRYPOINT_OFFSET(kArmWordSize, pUnlockObject).Int32Value();
+  __ LoadFromOffset(kLoadWord, LR, TR, offset);
+  __ blx(LR);
+  codegen_->RecordPcInfo(instruction, instruction->GetDexPc());
+}
+
+void LocationsBuilderARM::VisitLoadString(HLoadString* load) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(load, LocationSummary::kCallOnSlowPath);
+  locations->SetOut(Location::RequiresRegister());
+}
+
+void InstructionCodeGeneratorARM::VisitLoadString(HLoadString* load) {
+  SlowPathCodeARM* slow_path = new (GetGraph()->GetArena()) LoadStringSlowPathARM(load);
+  codegen_->AddSlowPath(slow_path);
+
+  Register out = load->GetLocations()->Out().As<Register>();
+  uint32_t heap_reference_size = sizeof(mirror::HeapReference<mirror::Object>);
+  size_t index_in_cache = mirror::Array::DataOffset(heap_reference_size).Int32Value() +
+      load->GetStringIndex() * heap_reference_size;
+  LoadCurrentMethod(out);
+  __ LoadFromOffset(
+      kLoadWord, out, out, mirror::ArtMethod::DexCacheStringsOffset().Int32Value());
+  __ LoadFromOffset(kLoadWord, out, out, index_in_cache);
+  __ cmp(out, ShifterOperand(0));
+  __ b(slow_path->GetEntryLabel(), EQ);
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void LocationsBuilderARM::VisitLoadClass(HLoadClass* cls) {
+  LocationSummary::CallKind call_kind = cls->CanThrow()
+      ? LocationSummary::kCallOnSlowPath
+      : LocationSummary::kNoCall;
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(cls, call_kind);
+  locations->SetOut(Location::RequiresRegister());
+}
+
+void InstructionCodeGeneratorARM::VisitLoadClass(HLoadClass* cls) {
+  Register out = cls->GetLocations()->Out().As<Register>();
+  if (cls->IsReferrersClass()) {
+    LoadCurrentMethod(out);
+    __ LoadFromOffset(kLoadWord, out, out, mirror::ArtMethod::DeclaringClassOffset().Int32Value());
+  } else {
+    uint32_t heap_reference_size = sizeof(mirror::HeapReference<mirror::Object>);
+    size_t index_in_cache = mirror::Array::DataOffset(heap_reference_size).Int32Value() +
+        cls->GetTypeIndex() * heap_reference_size;
+    LoadCurrentMethod(out);
+    __ LoadFromOffset(
+        kLoadWord, out, out, mirror::ArtMethod::DexCacheResolvedTypesOffset().Int32Value());
+    __ LoadFromOffset(kLoadWord, out, out, index_in_cache);
+    SlowPathCodeARM* slow_path = new (GetGraph()->GetArena()) LoadClassSlowPathARM(
+        cls, cls, cls->GetDexPc(), false);
+    codegen_->AddSlowPath(slow_path);
+    __ cmp(out, ShifterOperand(0));
+    __ b(slow_path->GetEntryLabel(), EQ);
+    __ Bind(slow_path->GetExitLabel());
+  }
+}
+
+void LocationsBuilderARM::VisitClinitCheck(HClinitCheck* check) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(check, LocationSummary::kCallOnSlowPath);
+  locations->SetInAt(0, Location::RequiresRegister());
+  if (check->HasUses()) {
+    locations->SetOut(Location::SameAsFirstInput());
+  }
+}
+
+void InstructionCodeGeneratorARM::VisitClinitCheck(HClinitCheck* check) {
+  // We assume the class is not null.
+  SlowPathCodeARM* slow_path = new (GetGraph()->GetArena()) LoadClassSlowPathARM(
+      check->GetLoadClass(), check, check->GetDexPc(), true);
+  codegen_->AddSlowPath(slow_path);
+  GenerateClassInitializationCheck(slow_path, check->GetLocations()->InAt(0).As<Register>());
+}
+
+void InstructionCodeGeneratorARM::GenerateClassInitializationCheck(
+    SlowPathCodeARM* slow_path, Register class_reg) {
+  __ LoadFromOffset(kLoadWord, IP, class_reg, mirror::Class::StatusOffset().Int32Value());
+  __ cmp(IP, ShifterOperand(mirror::Class::kStatusInitialized));
+  __ b(slow_path->GetEntryLabel(), LT);
+  // Even if the initialized flag is set, we may be in a situation where caches are not synced
+  // properly. Therefore, we do a memory fence.
+  __ MemoryBarrier(ArmManagedRegister::FromCoreRegister(IP));
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void LocationsBuilderARM::VisitInstanceOf(HInstanceOf* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(
+      instruction, LocationSummary::kCallOnSlowPath);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  // The output holds the class of the object while the class to check is
+  // still needed, so they must not share a register.
+  locations->SetOut(Location::RequiresRegister());
+}
+
+void InstructionCodeGeneratorARM::VisitInstanceOf(HInstanceOf* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  Register obj = locations->InAt(0).As<Register>();
+  Register cls = locations->InAt(1).As<Register>();
+  Register out = locations->Out().As<Register>();
+  uint32_t class_offset = mirror::Object::ClassOffset().Int32Value();
+  Label done, zero;
+
+  // Return 0 if `obj` is null.
+  __ cmp(obj, ShifterOperand(0));
+  __ b(&zero, EQ);
+  // Compare the class of `obj` with `cls`.
+  __ LoadFromOffset(kLoadWord, out, obj, class_offset);
+  __ cmp(out, ShifterOperand(cls));
+  // If the classes are not equal, go into the slow path, which also handles
+  // the subclasses and interfaces.
+  SlowPathCodeARM* slow_path = new (GetGraph()->GetArena()) TypeCheckSlowPathARM(
+      instruction, locations->InAt(1), locations->Out(), instruction->GetDexPc());
+  codegen_->AddSlowPath(slow_path);
+  __ b(slow_path->GetEntryLabel(), NE);
+  __ LoadImmediate(out, 1);
+  __ b(&done);
+  __ Bind(&zero);
+  __ LoadImmediate(out, 0);
+  __ Bind(slow_path->GetExitLabel());
+  __ Bind(&done);
+}
+
+void LocationsBuilderARM::VisitCheckCast(HCheckCast* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(
+      instruction, LocationSummary::kCallOnSlowPath);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+}
+
+void InstructionCodeGeneratorARM::VisitCheckCast(HCheckCast* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  Register obj = locations->InAt(0).As<Register>();
+  Register cls = locations->InAt(1).As<Register>();
+  Register temp = locations->GetTemp(0).As<Register>();
+  uint32_t class_offset = mirror::Object::ClassOffset().Int32Value();
+  SlowPathCodeARM* slow_path = new (GetGraph()->GetArena()) TypeCheckSlowPathARM(
+      instruction, locations->InAt(1), locations->GetTemp(0), instruction->GetDexPc());
+  codegen_->AddSlowPath(slow_path);
+
+  // A null reference can be cast to any type.
+  __ cmp(obj, ShifterOperand(0));
+  __ b(slow_path->GetExitLabel(), EQ);
+  // Compare the class of `obj` with `cls`.
+  __ LoadFromOffset(kLoadWord, temp, obj, class_offset);
+  __ cmp(temp, ShifterOperand(cls));
+  __ b(slow_path->GetEntryLabel(), NE);
+  __ Bind(slow_path->GetExitLabel());
+}
+
 void InstructionCodeGeneratorARM::GenerateSuspendCheck(HSuspendCheck* instruction,
                                                        HBasicBlock* successor) {
   SuspendCheckSlowPathARM* slow_path =
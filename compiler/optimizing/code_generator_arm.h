@@ -26,6 +26,7 @@ namespace art {
 namespace arm {
 
 class CodeGeneratorARM;
+class SlowPathCodeARM;
 
 static constexpr size_t kArmWordSize = 4;
 
@@ -99,6 +100,11 @@ class LocationsBuilderARM : public HGraphVisitor {
 #undef DECLARE_VISIT_INSTRUCTION
 
   void HandleInvoke(HInvoke* invoke);
+  void HandleBitwiseOperation(HBinaryOperation* instruction);
+  void HandleShift(HBinaryOperation* instruction);
+  void HandleDivRem(HBinaryOperation* instruction);
+  void HandleFieldSet(HInstruction* instruction, Primitive::Type field_type);
+  void HandleFieldGet(HInstruction* instruction);
 
  private:
   CodeGeneratorARM* const codegen_;
@@ -126,6 +132,15 @@ class InstructionCodeGeneratorARM : public HGraphVisitor {
   // is the block to branch to if the suspend check is not needed, and after
   // the suspend call.
   void GenerateSuspendCheck(HSuspendCheck* check, HBasicBlock* successor);
+  void GenerateClassInitializationCheck(SlowPathCodeARM* slow_path, Register class_reg);
+  void HandleBitwiseOperation(HBinaryOperation* instruction);
+  void HandleShift(HBinaryOperation* instruction);
+  void GenerateLongShift(HBinaryOperation* instruction);
+  void HandleDivRem(HBinaryOperation* instruction);
+  // Instance and static fields share their code: input 0 is the object or
+  // the class holding the field.
+  void HandleFieldSet(HInstruction* instruction, Primitive::Type field_type, uint32_t offset);
+  void HandleFieldGet(HInstruction* instruction, uint32_t offset);
 
   ArmAssembler* const assembler_;
   CodeGeneratorARM* const codegen_;
@@ -281,6 +281,118 @@ class SuspendCheckSlowPathARM64 : public SlowPathCodeARM64 {
   DISALLOW_COPY_AND_ASSIGN(SuspendCheckSlowPathARM64);
 };
 
+class DivZeroCheckSlowPathARM64 : public SlowPathCodeARM64 {
+ public:
+  explicit DivZeroCheckSlowPathARM64(HDivZeroCheck* instr) : instruction_(instr) {}
+
+  virtual void EmitNativeCode(CodeGenerator* codegen) OVERRIDE {
+    __ Bind(GetEntryLabel());
+    int32_t offset = QUICK_ENTRYPOINT_OFFSET(kArm64WordSize, pThrowDivZero).Int32Value();
+    __ Ldr(lr, MemOperand(tr, offset));
+    __ Blr(lr);
+    codegen->RecordPcInfo(instruction_, instruction_->GetDexPc());
+  }
+
+ private:
+  HDivZeroCheck* const instruction_;
+
+  DISALLOW_COPY_AND_ASSIGN(DivZeroCheckSlowPathARM64);
+};
+
+class LoadStringSlowPathARM64 : public SlowPathCodeARM64 {
+ public:
+  explicit LoadStringSlowPathARM64(HLoadString* instr) : instruction_(instr) {}
+
+  virtual void EmitNativeCode(CodeGenerator* codegen) OVERRIDE {
+    // The string is loaded with a kCall summary, so no live register needs
+    // saving around the runtime call.
+    __ Bind(GetEntryLabel());
+    InvokeRuntimeCallingConvention calling_convention;
+    __ Ldr(calling_convention.GetRegisterAt(0).W(), MemOperand(sp, kCurrentMethodStackOffset));
+    __ Mov(calling_convention.GetRegisterAt(1).W(), instruction_->GetStringIndex());
+    int32_t offset = QUICK_ENTRYPOINT_OFFSET(kArm64WordSize, pResolveString).Int32Value();
+    __ Ldr(lr, MemOperand(tr, offset));
+    __ Blr(lr);
+    codegen->RecordPcInfo(instruction_, instruction_->GetDexPc());
+    __ B(GetExitLabel());
+  }
+
+ private:
+  HLoadString* const instruction_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoadStringSlowPathARM64);
+};
+
+class LoadClassSlowPathARM64 : public SlowPathCodeARM64 {
+ public:
+  LoadClassSlowPathARM64(HLoadClass* cls,
+                         HInstruction* at,
+                         uint32_t dex_pc,
+                         bool do_clinit)
+      : cls_(cls), at_(at), dex_pc_(dex_pc), do_clinit_(do_clinit) {
+    DCHECK(at->IsLoadClass() || at->IsClinitCheck());
+  }
+
+  virtual void EmitNativeCode(CodeGenerator* codegen) OVERRIDE {
+    // The class is loaded and checked with kCall summaries, so no live
+    // register needs saving, and the runtime returns the class in the output.
+    __ Bind(GetEntryLabel());
+    InvokeRuntimeCallingConvention calling_convention;
+    __ Mov(calling_convention.GetRegisterAt(0).W(), cls_->GetTypeIndex());
+    __ Ldr(calling_convention.GetRegisterAt(1).W(), MemOperand(sp, kCurrentMethodStackOffset));
+    int32_t offset = do_clinit_
+        ? QUICK_ENTRYPOINT_OFFSET(kArm64WordSize, pInitializeStaticStorage).Int32Value()
+        : QUICK_ENTRYPOINT_OFFSET(kArm64WordSize, pInitializeType).Int32Value();
+    __ Ldr(lr, MemOperand(tr, offset));
+    __ Blr(lr);
+    codegen->RecordPcInfo(at_, dex_pc_);
+    __ B(GetExitLabel());
+  }
+
+ private:
+  // The class this slow path will load.
+  HLoadClass* const cls_;
+
+  // The instruction where this slow path is happening.
+  // (Might be the load class or an initialization check).
+  HInstruction* const at_;
+
+  // The dex PC of `at_`.
+  const uint32_t dex_pc_;
+
+  // Whether to initialize the class.
+  const bool do_clinit_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoadClassSlowPathARM64);
+};
+
+// Calls the runtime for the type checks that the inline code cannot decide:
+// instance-of gets the answer in its output, check-cast throws on failure.
+class TypeCheckSlowPathARM64 : public SlowPathCodeARM64 {
+ public:
+  TypeCheckSlowPathARM64(HInstruction* instruction, uint32_t dex_pc)
+      : instruction_(instruction), dex_pc_(dex_pc) {}
+
+  virtual void EmitNativeCode(CodeGenerator* codegen) OVERRIDE {
+    // The inline code leaves the class to check and the class of the object
+    // in the first two argument registers.
+    __ Bind(GetEntryLabel());
+    int32_t offset = instruction_->IsInstanceOf()
+        ? QUICK_ENTRYPOINT_OFFSET(kArm64WordSize, pInstanceofNonTrivial).Int32Value()
+        : QUICK_ENTRYPOINT_OFFSET(kArm64WordSize, pCheckCast).Int32Value();
+    __ Ldr(lr, MemOperand(tr, offset));
+    __ Blr(lr);
+    codegen->RecordPcInfo(instruction_, dex_pc_);
+    __ B(GetExitLabel());
+  }
+
+ private:
+  HInstruction* const instruction_;
+  const uint32_t dex_pc_;
+
+  DISALLOW_COPY_AND_ASSIGN(TypeCheckSlowPathARM64);
+};
+
 #undef __
 
 Location InvokeDexCallingConventionVisitor::GetNextLocation(Primitive::Type type) {
@@ -623,6 +735,174 @@ void InstructionCodeGeneratorARM64::VisitAdd(HAdd* instruction) {
   HandleAddSub(instruction);
 }
 
+void LocationsBuilderARM64::HandleBitwiseOperation(HBinaryOperation* instr) {
+  DCHECK(instr->IsAnd() || instr->IsOr() || instr->IsXor());
+  LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(instr);
+  Primitive::Type type = instr->GetResultType();
+  switch (type) {
+    case Primitive::kPrimInt:
+    case Primitive::kPrimLong: {
+      locations->SetInAt(0, Location::RequiresRegister());
+      locations->SetInAt(1, Location::RegisterOrConstant(instr->InputAt(1)));
+      locations->SetOut(Location::RequiresRegister());
+      break;
+    }
+    default:
+      LOG(FATAL) << "Unexpected " << instr->DebugName() << " type " << type;
+  }
+}
+
+void InstructionCodeGeneratorARM64::HandleBitwiseOperation(HBinaryOperation* instr) {
+  DCHECK(instr->IsAnd() || instr->IsOr() || instr->IsXor());
+
+  Register dst = OutputRegister(instr);
+  Register lhs = InputRegisterAt(instr, 0);
+  Operand rhs = InputOperandAt(instr, 1);
+
+  if (instr->IsAnd()) {
+    __ And(dst, lhs, rhs);
+  } else if (instr->IsOr()) {
+    __ Orr(dst, lhs, rhs);
+  } else {
+    __ Eor(dst, lhs, rhs);
+  }
+}
+
+void LocationsBuilderARM64::VisitAnd(HAnd* instruction) {
+  HandleBitwiseOperation(instruction);
+}
+
+void InstructionCodeGeneratorARM64::VisitAnd(HAnd* instruction) {
+  HandleBitwiseOperation(instruction);
+}
+
+void LocationsBuilderARM64::VisitOr(HOr* instruction) {
+  HandleBitwiseOperation(instruction);
+}
+
+void InstructionCodeGeneratorARM64::VisitOr(HOr* instruction) {
+  HandleBitwiseOperation(instruction);
+}
+
+void LocationsBuilderARM64::VisitXor(HXor* instruction) {
+  HandleBitwiseOperation(instruction);
+}
+
+void InstructionCodeGeneratorARM64::VisitXor(HXor* instruction) {
+  HandleBitwiseOperation(instruction);
+}
+
+void LocationsBuilderARM64::HandleShift(HBinaryOperation* instr) {
+  DCHECK(instr->IsShl() || instr->IsShr() || instr->IsUShr());
+  DCHECK(instr->GetResultType() == Primitive::kPrimInt ||
+         instr->GetResultType() == Primitive::kPrimLong) << instr->GetResultType();
+  LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(instr);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RegisterOrConstant(instr->InputAt(1)));
+  locations->SetOut(Location::RequiresRegister());
+}
+
+void InstructionCodeGeneratorARM64::HandleShift(HBinaryOperation* instr) {
+  DCHECK(instr->IsShl() || instr->IsShr() || instr->IsUShr());
+
+  Register dst = OutputRegister(instr);
+  Register lhs = InputRegisterAt(instr, 0);
+  Location rhs = instr->GetLocations()->InAt(1);
+  if (rhs.IsRegister()) {
+    // Variable shifts only use the low 5 bits of the distance for W registers
+    // and the low 6 bits for X registers, as Java does.
+    Register shifter = RegisterFrom(rhs, instr->GetResultType());
+    if (instr->IsShl()) {
+      __ Lsl(dst, lhs, shifter);
+    } else if (instr->IsShr()) {
+      __ Asr(dst, lhs, shifter);
+    } else {
+      __ Lsr(dst, lhs, shifter);
+    }
+  } else {
+    unsigned shift_value = Int64ConstantFrom(rhs) &
+        (instr->GetResultType() == Primitive::kPrimInt ? kMaxIntShiftValue : kMaxLongShiftValue);
+    if (instr->IsShl()) {
+      __ Lsl(dst, lhs, shift_value);
+    } else if (instr->IsShr()) {
+      __ Asr(dst, lhs, shift_value);
+    } else {
+      __ Lsr(dst, lhs, shift_value);
+    }
+  }
+}
+
+void LocationsBuilderARM64::VisitShl(HShl* instruction) {
+  HandleShift(instruction);
+}
+
+void InstructionCodeGeneratorARM64::VisitShl(HShl* instruction) {
+  HandleShift(instruction);
+}
+
+void LocationsBuilderARM64::VisitShr(HShr* instruction) {
+  HandleShift(instruction);
+}
+
+void InstructionCodeGeneratorARM64::VisitShr(HShr* instruction) {
+  HandleShift(instruction);
+}
+
+void LocationsBuilderARM64::VisitUShr(HUShr* instruction) {
+  HandleShift(instruction);
+}
+
+void InstructionCodeGeneratorARM64::VisitUShr(HUShr* instruction) {
+  HandleShift(instruction);
+}
+
+void LocationsBuilderARM64::HandleDivRem(HBinaryOperation* instr) {
+  DCHECK(instr->IsDiv() || instr->IsRem());
+  DCHECK(instr->GetResultType() == Primitive::kPrimInt ||
+         instr->GetResultType() == Primitive::kPrimLong) << instr->GetResultType();
+  LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(instr);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  if (instr->IsRem()) {
+    // The remainder is computed from the quotient held in the output register,
+    // so the output must not share a register with the inputs.
+    locations->SetOut(Location::RequiresRegister());
+  } else {
+    locations->SetOut(Location::RequiresRegister(), Location::kNoOutputOverlap);
+  }
+}
+
+void InstructionCodeGeneratorARM64::HandleDivRem(HBinaryOperation* instr) {
+  DCHECK(instr->IsDiv() || instr->IsRem());
+
+  // sdiv does not trap: division by zero is checked beforehand, and the
+  // smallest integer divided by -1 gives the smallest integer, as in Java.
+  Register dst = OutputRegister(instr);
+  Register lhs = InputRegisterAt(instr, 0);
+  Register rhs = InputRegisterAt(instr, 1);
+  __ Sdiv(dst, lhs, rhs);
+  if (instr->IsRem()) {
+    __ Msub(dst, dst, rhs, lhs);
+  }
+}
+
+void LocationsBuilderARM64::VisitDiv(HDiv* instruction) {
+  HandleDivRem(instruction);
+}
+
+void InstructionCodeGeneratorARM64::VisitDiv(HDiv* instruction) {
+  HandleDivRem(instruction);
+}
+
+void LocationsBuilderARM64::VisitRem(HRem* instruction) {
+  HandleDivRem(instruction);
+}
+
+void InstructionCodeGeneratorARM64::VisitRem(HRem* instruction) {
+  HandleDivRem(instruction);
+}
+
+
 void LocationsBuilderARM64::VisitArrayLength(HArrayLength* instruction) {
   LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(instruction);
   locations->SetInAt(0, Location::RequiresRegister());
@@ -771,17 +1051,16 @@ void InstructionCodeGeneratorARM64::VisitIf(HIf* if_instr) {
   }
 }
 
-void LocationsBuilderARM64::VisitInstanceFieldGet(HInstanceFieldGet* instruction) {
+void LocationsBuilderARM64::HandleFieldGet(HInstruction* instruction) {
   LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(instruction);
   locations->SetInAt(0, Location::RequiresRegister());
   locations->SetOut(Location::RequiresRegister());
 }
 
-void InstructionCodeGeneratorARM64::VisitInstanceFieldGet(HInstanceFieldGet* instruction) {
+void InstructionCodeGeneratorARM64::HandleFieldGet(HInstruction* instruction, uint32_t offset) {
   Primitive::Type res_type = instruction->GetType();
   Register res = OutputRegister(instruction);
   Register obj = InputRegisterAt(instruction, 0);
-  uint32_t offset = instruction->GetFieldOffset().Uint32Value();
 
   switch (res_type) {
     case Primitive::kPrimBoolean: {
@@ -818,17 +1097,16 @@ void InstructionCodeGeneratorARM64::VisitInstanceFieldGet(HInstanceFieldGet* ins
   }
 }
 
-void LocationsBuilderARM64::VisitInstanceFieldSet(HInstanceFieldSet* instruction) {
+void LocationsBuilderARM64::HandleFieldSet(HInstruction* instruction) {
   LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(instruction);
   locations->SetInAt(0, Location::RequiresRegister());
   locations->SetInAt(1, Location::RequiresRegister());
 }
 
-void InstructionCodeGeneratorARM64::VisitInstanceFieldSet(HInstanceFieldSet* instruction) {
+void InstructionCodeGeneratorARM64::HandleFieldSet(HInstruction* instruction, uint32_t offset) {
   Register obj = InputRegisterAt(instruction, 0);
   Register value = InputRegisterAt(instruction, 1);
   Primitive::Type field_type = instruction->InputAt(1)->GetType();
-  uint32_t offset = instruction->GetFieldOffset().Uint32Value();
 
   switch (field_type) {
     case Primitive::kPrimBoolean:
@@ -865,6 +1143,38 @@ void InstructionCodeGeneratorARM64::VisitInstanceFieldSet(HInstanceFieldSet* ins
   }
 }
 
+void LocationsBuilderARM64::VisitInstanceFieldGet(HInstanceFieldGet* instruction) {
+  HandleFieldGet(instruction);
+}
+
+void InstructionCodeGeneratorARM64::VisitInstanceFieldGet(HInstanceFieldGet* instruction) {
+  HandleFieldGet(instruction, instruction->GetFieldOffset().Uint32Value());
+}
+
+void LocationsBuilderARM64::VisitInstanceFieldSet(HInstanceFieldSet* instruction) {
+  HandleFieldSet(instruction);
+}
+
+void InstructionCodeGeneratorARM64::VisitInstanceFieldSet(HInstanceFieldSet* instruction) {
+  HandleFieldSet(instruction, instruction->GetFieldOffset().Uint32Value());
+}
+
+void LocationsBuilderARM64::VisitStaticFieldGet(HStaticFieldGet* instruction) {
+  HandleFieldGet(instruction);
+}
+
+void InstructionCodeGeneratorARM64::VisitStaticFieldGet(HStaticFieldGet* instruction) {
+  HandleFieldGet(instruction, instruction->GetFieldOffset().Uint32Value());
+}
+
+void LocationsBuilderARM64::VisitStaticFieldSet(HStaticFieldSet* instruction) {
+  HandleFieldSet(instruction);
+}
+
+void InstructionCodeGeneratorARM64::VisitStaticFieldSet(HStaticFieldSet* instruction) {
+  HandleFieldSet(instruction, instruction->GetFieldOffset().Uint32Value());
+}
+
 void LocationsBuilderARM64::VisitIntConstant(HIntConstant* constant) {
   LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(constant);
   locations->SetOut(Location::ConstantLocation(constant));
@@ -956,6 +1266,41 @@ void InstructionCodeGeneratorARM64::VisitInvokeVirtual(HInvokeVirtual* invoke) {
   codegen_->RecordPcInfo(invoke, invoke->GetDexPc());
 }
 
+void LocationsBuilderARM64::VisitInvokeInterface(HInvokeInterface* invoke) {
+  HandleInvoke(invoke);
+}
+
+void InstructionCodeGeneratorARM64::VisitInvokeInterface(HInvokeInterface* invoke) {
+  LocationSummary* locations = invoke->GetLocations();
+  Location receiver = locations->InAt(0);
+  Register temp = XRegisterFrom(locations->GetTemp(0));
+  size_t method_offset = mirror::Class::EmbeddedImTableOffset().SizeValue() +
+    (invoke->GetImtIndex() % mirror::Class::kImtSize) * sizeof(mirror::Class::ImTableEntry);
+  Offset class_offset = mirror::Object::ClassOffset();
+  Offset entry_point = mirror::ArtMethod::EntryPointFromQuickCompiledCodeOffset();
+
+  // temp = object->GetClass();
+  if (receiver.IsStackSlot()) {
+    __ Ldr(temp.W(), MemOperand(sp, receiver.GetStackIndex()));
+    __ Ldr(temp.W(), MemOperand(temp, class_offset.SizeValue()));
+  } else {
+    DCHECK(receiver.IsRegister());
+    __ Ldr(temp.W(), HeapOperandFrom(receiver, Primitive::kPrimNot,
+                                     class_offset));
+  }
+  // temp = temp->GetImtEntryAt(method_offset);
+  __ Ldr(temp.W(), MemOperand(temp, method_offset));
+  // lr = temp->GetEntryPoint();
+  __ Ldr(lr, MemOperand(temp, entry_point.SizeValue()));
+  // Set the hidden argument, which the IMT conflict trampoline uses to find
+  // the interface method. ip1 is a VIXL scratch register, so set it last.
+  __ Mov(ip1, invoke->GetDexMethodIndex());
+  // lr();
+  __ Blr(lr);
+  DCHECK(!codegen_->IsLeafMethod());
+  codegen_->RecordPcInfo(invoke, invoke->GetDexPc());
+}
+
 void LocationsBuilderARM64::VisitLoadLocal(HLoadLocal* load) {
   load->SetLocations(nullptr);
 }
@@ -1201,5 +1546,310 @@ void InstructionCodeGeneratorARM64::VisitTemporary(HTemporary* temp) {
   // Nothing to do, this is driven by the code generator.
 }
 
+void LocationsBuilderARM64::VisitLoadException(HLoadException* load) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(load, LocationSummary::kNoCall);
+  locations->SetOut(Location::RequiresRegister());
+}
+
+void InstructionCodeGeneratorARM64::VisitLoadException(HLoadException* load) {
+  MemOperand exception = MemOperand(tr, Thread::ExceptionOffset<kArm64WordSize>().Int32Value());
+  __ Ldr(OutputRegister(load), exception);
+  __ Str(wzr, exception);
+}
+
+void LocationsBuilderARM64::VisitPackedSwitch(HPackedSwitch* switch_instr) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(switch_instr, LocationSummary::kNoCall);
+  locations->SetInAt(0, Location::RequiresRegister());
+}
+
+void InstructionCodeGeneratorARM64::VisitPackedSwitch(HPackedSwitch* switch_instr) {
+  int32_t start_value = switch_instr->GetStartValue();
+  uint32_t num_entries = switch_instr->GetNumEntries();
+  Register value = InputRegisterAt(switch_instr, 0);
+  HBasicBlock* default_block = switch_instr->GetDefaultBlock();
+
+  if (num_entries <= kPackedSwitchJumpTableThreshold) {
+    for (uint32_t i = 0; i < num_entries; ++i) {
+      int32_t case_value = static_cast<int32_t>(static_cast<uint32_t>(start_value) + i);
+      __ Cmp(value, case_value);
+      __ B(eq, codegen_->GetLabelOf(switch_instr->GetCaseSuccessor(i)));
+    }
+    if (!codegen_->GoesToNextBlock(switch_instr->GetBlock(), default_block)) {
+      __ B(codegen_->GetLabelOf(default_block));
+    }
+    return;
+  }
+
+  UseScratchRegisterScope temps(assembler_->vixl_masm_);
+  Register index = temps.AcquireW();
+  Register base = temps.AcquireX();
+  // Values out of the range of the cases give an unsigned index above the last entry.
+  __ Sub(index, value, start_value);
+  __ Cmp(index, num_entries - 1);
+  __ B(hi, codegen_->GetLabelOf(default_block));
+
+  // The jump table is a sequence of branches to the cases following the
+  // dispatch. Literal pools must not be emitted in between.
+  vixl::Label table;
+  vixl::InstructionAccurateScope scope(assembler_->vixl_masm_, num_entries + 3);
+  __ adr(base, &table);
+  __ add(base, base, Operand(index, UXTW, 2));
+  __ br(base);
+  __ bind(&table);
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    __ b(codegen_->GetLabelOf(switch_instr->GetCaseSuccessor(i)));
+  }
+}
+
+void LocationsBuilderARM64::VisitThrow(HThrow* instruction) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCall);
+  InvokeRuntimeCallingConvention calling_convention;
+  locations->SetInAt(0, LocationFrom(calling_convention.GetRegisterAt(0)));
+}
+
+void InstructionCodeGeneratorARM64::VisitThrow(HThrow* instruction) {
+  __ Ldr(lr, MemOperand(tr, QUICK_ENTRYPOINT_OFFSET(kArm64WordSize, pDeliverException).Int32Value()));
+  __ Blr(lr);
+  codegen_->RecordPcInfo(instruction, instruction->GetDexPc());
+}
+
+void LocationsBuilderARM64::VisitDivZeroCheck(HDivZeroCheck* instruction) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
+  locations->SetInAt(0, Location::RegisterOrConstant(instruction->InputAt(0)));
+  if (instruction->HasUses()) {
+    locations->SetOut(Location::SameAsFirstInput());
+  }
+}
+
+void InstructionCodeGeneratorARM64::VisitDivZeroCheck(HDivZeroCheck* instruction) {
+  SlowPathCodeARM64* slow_path =
+      new (GetGraph()->GetArena()) DivZeroCheckSlowPathARM64(instruction);
+  codegen_->AddSlowPath(slow_path);
+
+  Location value = instruction->GetLocations()->InAt(0);
+  if (value.IsRegister()) {
+    __ Cbz(InputRegisterAt(instruction, 0), slow_path->GetEntryLabel());
+  } else {
+    DCHECK(value.IsConstant()) << value;
+    if (Int64ConstantFrom(value) == 0) {
+      __ B(slow_path->GetEntryLabel());
+    }
+  }
+}
+
+void LocationsBuilderARM64::VisitTypeConversion(HTypeConversion* conversion) {
+  LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(conversion);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetOut(Location::RequiresRegister());
+}
+
+void InstructionCodeGeneratorARM64::VisitTypeConversion(HTypeConversion* conversion) {
+  Register dst = OutputRegister(conversion);
+  Register src = InputRegisterAt(conversion, 0);
+  switch (conversion->GetResultType()) {
+    case Primitive::kPrimLong:
+      DCHECK_EQ(conversion->GetInputType(), Primitive::kPrimInt);
+      __ Sxtw(dst, src.X());
+      break;
+
+    case Primitive::kPrimInt:
+      DCHECK_EQ(conversion->GetInputType(), Primitive::kPrimLong);
+      __ Mov(dst, src.W());
+      break;
+
+    case Primitive::kPrimByte:
+      __ Sxtb(dst, src);
+      break;
+
+    case Primitive::kPrimShort:
+      __ Sxth(dst, src);
+      break;
+
+    case Primitive::kPrimChar:
+      __ Uxth(dst, src);
+      break;
+
+    default:
+      LOG(FATAL) << "Unexpected type conversion from " << conversion->GetInputType()
+                 << " to " << conversion->GetResultType();
+  }
+}
+
+void LocationsBuilderARM64::VisitMonitorOperation(HMonitorOperation* instruction) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCall);
+  InvokeRuntimeCallingConvention calling_convention;
+  locations->SetInAt(0, LocationFrom(calling_convention.GetRegisterAt(0)));
+}
+
+void InstructionCodeGeneratorARM64::VisitMonitorOperation(HMonitorOperation* instruction) {
+  int32_t offset = instruction->IsEnter()
+      ? QUICK_ENTRYPOINT_OFFSET(kArm64WordSize, pLockObject).Int32Value()
+      : QUICK_ENTRYPOINT_OFFSET(kArm64WordSize, pUnlockObject).Int32Value();
+  __ Ldr(lr, MemOperand(tr, offset));
+  __ Blr(lr);
+  codegen_->RecordPcInfo(instruction, instruction->GetDexPc());
+}
+
+void LocationsBuilderARM64::VisitLoadString(HLoadString* load) {
+  // TODO: Use kCallOnSlowPath once live registers can be saved on ARM64.
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(load, LocationSummary::kCall);
+  InvokeRuntimeCallingConvention calling_convention;
+  locations->SetOut(calling_convention.GetReturnLocation(Primitive::kPrimNot));
+}
+
+void InstructionCodeGeneratorARM64::VisitLoadString(HLoadString* load) {
+  SlowPathCodeARM64* slow_path = new (GetGraph()->GetArena()) LoadStringSlowPathARM64(load);
+  codegen_->AddSlowPath(slow_path);
+
+  Register out = OutputRegister(load);
+  size_t index_in_cache = mirror::Array::DataOffset(kHeapRefSize).SizeValue() +
+      load->GetStringIndex() * kHeapRefSize;
+  __ Ldr(out, MemOperand(sp, kCurrentMethodStackOffset));
+  __ Ldr(out, HeapOperand(out, mirror::ArtMethod::DexCacheStringsOffset()));
+  __ Ldr(out, MemOperand(out.X(), index_in_cache));
+  __ Cbz(out, slow_path->GetEntryLabel());
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void LocationsBuilderARM64::VisitLoadClass(HLoadClass* cls) {
+  // TODO: Use kCallOnSlowPath once live registers can be saved on ARM64.
+  LocationSummary::CallKind call_kind = cls->CanThrow()
+      ? LocationSummary::kCall
+      : LocationSummary::kNoCall;
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(cls, call_kind);
+  if (cls->CanThrow()) {
+    InvokeRuntimeCallingConvention calling_convention;
+    locations->SetOut(calling_convention.GetReturnLocation(Primitive::kPrimNot));
+  } else {
+    locations->SetOut(Location::RequiresRegister());
+  }
+}
+
+void InstructionCodeGeneratorARM64::VisitLoadClass(HLoadClass* cls) {
+  Register out = OutputRegister(cls);
+  __ Ldr(out, MemOperand(sp, kCurrentMethodStackOffset));
+  if (cls->IsReferrersClass()) {
+    __ Ldr(out, HeapOperand(out, mirror::ArtMethod::DeclaringClassOffset()));
+  } else {
+    size_t index_in_cache = mirror::Array::DataOffset(kHeapRefSize).SizeValue() +
+        cls->GetTypeIndex() * kHeapRefSize;
+    __ Ldr(out, HeapOperand(out, mirror::ArtMethod::DexCacheResolvedTypesOffset()));
+    __ Ldr(out, MemOperand(out.X(), index_in_cache));
+    SlowPathCodeARM64* slow_path = new (GetGraph()->GetArena()) LoadClassSlowPathARM64(
+        cls, cls, cls->GetDexPc(), false);
+    codegen_->AddSlowPath(slow_path);
+    __ Cbz(out, slow_path->GetEntryLabel());
+    __ Bind(slow_path->GetExitLabel());
+  }
+}
+
+void LocationsBuilderARM64::VisitClinitCheck(HClinitCheck* check) {
+  // TODO: Use kCallOnSlowPath once live registers can be saved on ARM64.
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(check, LocationSummary::kCall);
+  // The runtime returns the initialized class where the class was passed.
+  InvokeRuntimeCallingConvention calling_convention;
+  locations->SetInAt(0, LocationFrom(calling_convention.GetRegisterAt(0)));
+  if (check->HasUses()) {
+    locations->SetOut(calling_convention.GetReturnLocation(Primitive::kPrimNot));
+  }
+}
+
+void InstructionCodeGeneratorARM64::VisitClinitCheck(HClinitCheck* check) {
+  // We assume the class is not null.
+  SlowPathCodeARM64* slow_path = new (GetGraph()->GetArena()) LoadClassSlowPathARM64(
+      check->GetLoadClass(), check, check->GetDexPc(), true);
+  codegen_->AddSlowPath(slow_path);
+  GenerateClassInitializationCheck(slow_path, InputRegisterAt(check, 0));
+}
+
+void InstructionCodeGeneratorARM64::GenerateClassInitializationCheck(
+    SlowPathCodeARM64* slow_path, Register class_reg) {
+  UseScratchRegisterScope temps(assembler_->vixl_masm_);
+  Register status = temps.AcquireW();
+  __ Ldr(status, HeapOperand(class_reg, mirror::Class::StatusOffset()));
+  __ Cmp(status, mirror::Class::kStatusInitialized);
+  __ B(lt, slow_path->GetEntryLabel());
+  // Even if the initialized flag is set, we need to ensure consistent memory ordering.
+  __ Dmb(InnerShareable, BarrierReads);
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void LocationsBuilderARM64::VisitInstanceOf(HInstanceOf* instruction) {
+  // TODO: Use kCallOnSlowPath once live registers can be saved on ARM64.
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCall);
+  // The class to check is already in place for the slow path, which returns
+  // its answer in the same register.
+  InvokeRuntimeCallingConvention calling_convention;
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, LocationFrom(calling_convention.GetRegisterAt(0)));
+  locations->SetOut(calling_convention.GetReturnLocation(Primitive::kPrimBoolean));
+}
+
+void InstructionCodeGeneratorARM64::VisitInstanceOf(HInstanceOf* instruction) {
+  Register obj = InputRegisterAt(instruction, 0);
+  Register cls = InputRegisterAt(instruction, 1);
+  Register out = OutputRegister(instruction);
+  // The slow path takes the class of `obj` as second argument. All registers
+  // are blocked by the call, so it can be clobbered.
+  InvokeRuntimeCallingConvention calling_convention;
+  Register obj_cls = calling_convention.GetRegisterAt(1).W();
+  vixl::Label done, zero;
+
+  // Return 0 if `obj` is null.
+  __ Cbz(obj, &zero);
+  __ Ldr(obj_cls, HeapOperand(obj, mirror::Object::ClassOffset()));
+  // Compare the class of `obj` with `cls`. If the classes are not equal, go
+  // into the slow path, which also handles the subclasses and interfaces.
+  __ Cmp(obj_cls, cls);
+  SlowPathCodeARM64* slow_path = new (GetGraph()->GetArena()) TypeCheckSlowPathARM64(
+      instruction, instruction->GetDexPc());
+  codegen_->AddSlowPath(slow_path);
+  __ B(ne, slow_path->GetEntryLabel());
+  __ Mov(out, 1);
+  __ B(&done);
+  __ Bind(&zero);
+  __ Mov(out, 0);
+  __ Bind(slow_path->GetExitLabel());
+  __ Bind(&done);
+}
+
+void LocationsBuilderARM64::VisitCheckCast(HCheckCast* instruction) {
+  // TODO: Use kCallOnSlowPath once live registers can be saved on ARM64.
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCall);
+  InvokeRuntimeCallingConvention calling_convention;
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, LocationFrom(calling_convention.GetRegisterAt(0)));
+}
+
+void InstructionCodeGeneratorARM64::VisitCheckCast(HCheckCast* instruction) {
+  Register obj = InputRegisterAt(instruction, 0);
+  Register cls = InputRegisterAt(instruction, 1);
+  // The slow path takes the class of `obj` as second argument. All registers
+  // are blocked by the call, so it can be clobbered.
+  InvokeRuntimeCallingConvention calling_convention;
+  Register obj_cls = calling_convention.GetRegisterAt(1).W();
+  SlowPathCodeARM64* slow_path = new (GetGraph()->GetArena()) TypeCheckSlowPathARM64(
+      instruction, instruction->GetDexPc());
+  codegen_->AddSlowPath(slow_path);
+
+  // A null reference can be cast to any type.
+  __ Cbz(obj, slow_path->GetExitLabel());
+  __ Ldr(obj_cls, HeapOperand(obj, mirror::Object::ClassOffset()));
+  // Compare the class of `obj` with `cls`.
+  __ Cmp(obj_cls, cls);
+  __ B(ne, slow_path->GetEntryLabel());
+  __ Bind(slow_path->GetExitLabel());
+}
+
 }  // namespace arm64
 }  // namespace art
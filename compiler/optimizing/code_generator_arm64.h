@@ -29,6 +29,7 @@ namespace art {
 namespace arm64 {
 
 class CodeGeneratorARM64;
+class SlowPathCodeARM64;
 
 static constexpr size_t kArm64WordSize = 8;
 static const vixl::Register kParameterCoreRegisters[] = {
@@ -105,6 +106,12 @@ class InstructionCodeGeneratorARM64 : public HGraphVisitor {
 
  private:
   void HandleAddSub(HBinaryOperation* instr);
+  void HandleBitwiseOperation(HBinaryOperation* instr);
+  void HandleShift(HBinaryOperation* instr);
+  void HandleDivRem(HBinaryOperation* instr);
+  void HandleFieldSet(HInstruction* instruction, uint32_t offset);
+  void HandleFieldGet(HInstruction* instruction, uint32_t offset);
+  void GenerateClassInitializationCheck(SlowPathCodeARM64* slow_path, vixl::Register class_reg);
 
   Arm64Assembler* const assembler_;
   CodeGeneratorARM64* const codegen_;
@@ -124,7 +131,12 @@ class LocationsBuilderARM64 : public HGraphVisitor {
 
  private:
   void HandleAddSub(HBinaryOperation* instr);
+  void HandleBitwiseOperation(HBinaryOperation* instr);
+  void HandleShift(HBinaryOperation* instr);
+  void HandleDivRem(HBinaryOperation* instr);
   void HandleInvoke(HInvoke* instr);
+  void HandleFieldSet(HInstruction* instruction);
+  void HandleFieldGet(HInstruction* instruction);
 
   CodeGeneratorARM64* const codegen_;
   InvokeDexCallingConventionVisitor parameter_visitor_;
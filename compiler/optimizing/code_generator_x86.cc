@@ -157,6 +157,174 @@ class SuspendCheckSlowPathX86 : public SlowPathCodeX86 {
   DISALLOW_COPY_AND_ASSIGN(SuspendCheckSlowPathX86);
 };
 
+class DivZeroCheckSlowPathX86 : public SlowPathCodeX86 {
+ public:
+  explicit DivZeroCheckSlowPathX86(HDivZeroCheck* instruction) : instruction_(instruction) {}
+
+  virtual void EmitNativeCode(CodeGenerator* codegen) OVERRIDE {
+    __ Bind(GetEntryLabel());
+    __ fs()->call(Address::Absolute(QUICK_ENTRYPOINT_OFFSET(kX86WordSize, pThrowDivZero)));
+    codegen->RecordPcInfo(instruction_, instruction_->GetDexPc());
+  }
+
+ private:
+  HDivZeroCheck* const instruction_;
+  DISALLOW_COPY_AND_ASSIGN(DivZeroCheckSlowPathX86);
+};
+
+class LoadStringSlowPathX86 : public SlowPathCodeX86 {
+ public:
+  explicit LoadStringSlowPathX86(HLoadString* instruction) : instruction_(instruction) {}
+
+  virtual void EmitNativeCode(CodeGenerator* codegen) OVERRIDE {
+    CodeGeneratorX86* x86_codegen = down_cast<CodeGeneratorX86*>(codegen);
+    LocationSummary* locations = instruction_->GetLocations();
+    __ Bind(GetEntryLabel());
+    codegen->SaveLiveRegisters(locations);
+    InvokeRuntimeCallingConvention calling_convention;
+    __ movl(calling_convention.GetRegisterAt(0), Address(ESP, kCurrentMethodStackOffset));
+    __ movl(calling_convention.GetRegisterAt(1), Immediate(instruction_->GetStringIndex()));
+    __ fs()->call(Address::Absolute(QUICK_ENTRYPOINT_OFFSET(kX86WordSize, pResolveString)));
+    codegen->RecordPcInfo(instruction_, instruction_->GetDexPc());
+    x86_codegen->Move32(locations->Out(), Location::RegisterLocation(EAX));
+    codegen->RestoreLiveRegisters(locations);
+    __ jmp(GetExitLabel());
+  }
+
+ private:
+  HLoadString* const instruction_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoadStringSlowPathX86);
+};
+
+class LoadClassSlowPathX86 : public SlowPathCodeX86 {
+ public:
+  LoadClassSlowPathX86(HLoadClass* cls,
+                       HInstruction* at,
+                       uint32_t dex_pc,
+                       bool do_clinit)
+      : cls_(cls), at_(at), dex_pc_(dex_pc), do_clinit_(do_clinit) {
+    DCHECK(at->IsLoadClass() || at->IsClinitCheck());
+  }
+
+  virtual void EmitNativeCode(CodeGenerator* codegen) OVERRIDE {
+    CodeGeneratorX86* x86_codegen = down_cast<CodeGeneratorX86*>(codegen);
+    LocationSummary* locations = at_->GetLocations();
+    __ Bind(GetEntryLabel());
+    codegen->SaveLiveRegisters(locations);
+
+    InvokeRuntimeCallingConvention calling_convention;
+    __ movl(calling_convention.GetRegisterAt(0), Immediate(cls_->GetTypeIndex()));
+    __ movl(calling_convention.GetRegisterAt(1), Address(ESP, kCurrentMethodStackOffset));
+    if (do_clinit_) {
+      __ fs()->call(
+          Address::Absolute(QUICK_ENTRYPOINT_OFFSET(kX86WordSize, pInitializeStaticStorage)));
+    } else {
+      __ fs()->call(Address::Absolute(QUICK_ENTRYPOINT_OFFSET(kX86WordSize, pInitializeType)));
+    }
+    codegen->RecordPcInfo(at_, dex_pc_);
+
+    // Move the class to the desired location.
+    if (locations->Out().IsValid()) {
+      x86_codegen->Move32(locations->Out(), Location::RegisterLocation(EAX));
+    }
+    codegen->RestoreLiveRegisters(locations);
+    __ jmp(GetExitLabel());
+  }
+
+ private:
+  // The class this slow path will load.
+  HLoadClass* const cls_;
+
+  // The instruction where this slow path is happening.
+  // (Might be the load class or an initialization check).
+  HInstruction* const at_;
+
+  // The dex PC of `at_`.
+  const uint32_t dex_pc_;
+
+  // Whether to initialize the class.
+  const bool do_clinit_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoadClassSlowPathX86);
+};
+
+// Calls the runtime for the type checks that the inline code cannot decide:
+// instance-of gets the answer in its output, check-cast throws on failure.
+class TypeCheckSlowPathX86 : public SlowPathCodeX86 {
+ public:
+  TypeCheckSlowPathX86(HInstruction* instruction,
+                       Location class_to_check,
+                       Location object_class,
+                       uint32_t dex_pc)
+      : instruction_(instruction),
+        class_to_check_(class_to_check),
+        object_class_(object_class),
+        dex_pc_(dex_pc) {}
+
+  virtual void EmitNativeCode(CodeGenerator* codegen) OVERRIDE {
+    CodeGeneratorX86* x86_codegen = down_cast<CodeGeneratorX86*>(codegen);
+    LocationSummary* locations = instruction_->GetLocations();
+    __ Bind(GetEntryLabel());
+    codegen->SaveLiveRegisters(locations);
+
+    // The two classes may be in each other's argument register, so move
+    // them with the parallel move resolver.
+    InvokeRuntimeCallingConvention calling_convention;
+    ArenaAllocator* arena = codegen->GetGraph()->GetArena();
+    HParallelMove parallel_move(arena);
+    parallel_move.AddMove(new (arena) MoveOperands(
+        class_to_check_, Location::RegisterLocation(calling_convention.GetRegisterAt(0)), nullptr));
+    parallel_move.AddMove(new (arena) MoveOperands(
+        object_class_, Location::RegisterLocation(calling_convention.GetRegisterAt(1)), nullptr));
+    x86_codegen->GetMoveResolver()->EmitNativeCode(&parallel_move);
+
+    if (instruction_->IsInstanceOf()) {
+      __ fs()->call(
+          Address::Absolute(QUICK_ENTRYPOINT_OFFSET(kX86WordSize, pInstanceofNonTrivial)));
+    } else {
+      DCHECK(instruction_->IsCheckCast());
+      __ fs()->call(Address::Absolute(QUICK_ENTRYPOINT_OFFSET(kX86WordSize, pCheckCast)));
+    }
+    codegen->RecordPcInfo(instruction_, dex_pc_);
+
+    if (instruction_->IsInstanceOf()) {
+      x86_codegen->Move32(locations->Out(), Location::RegisterLocation(EAX));
+    }
+    codegen->RestoreLiveRegisters(locations);
+    __ jmp(GetExitLabel());
+  }
+
+ private:
+  HInstruction* const instruction_;
+  const Location class_to_check_;
+  const Location object_class_;
+  const uint32_t dex_pc_;
+
+  DISALLOW_COPY_AND_ASSIGN(TypeCheckSlowPathX86);
+};
+
+// Jump table of a packed switch, emitted after the code of the method. Each
+// entry is the offset of the target of a case from the start of the table.
+class PackedSwitchTableX86 : public SlowPathCodeX86 {
+ public:
+  explicit PackedSwitchTableX86(HPackedSwitch* instruction) : instruction_(instruction) {}
+
+  virtual void EmitNativeCode(CodeGenerator* codegen) OVERRIDE {
+    CodeGeneratorX86* x86_codegen = down_cast<CodeGeneratorX86*>(codegen);
+    __ Align(4, 0);
+    __ Bind(GetEntryLabel());
+    for (uint32_t i = 0, e = instruction_->GetNumEntries(); i < e; ++i) {
+      __ EmitLabelOffset(x86_codegen->GetLabelOf(instruction_->GetCaseSuccessor(i)), GetEntryLabel());
+    }
+  }
+
+ private:
+  HPackedSwitch* const instruction_;
+
+  DISALLOW_COPY_AND_ASSIGN(PackedSwitchTableX86);
+};
+
 #undef __
 #define __ reinterpret_cast<X86Assembler*>(GetAssembler())->
 
@@ -985,6 +1153,41 @@ void InstructionCodeGeneratorX86::VisitInvokeVirtual(HInvokeVirtual* invoke) {
   codegen_->RecordPcInfo(invoke, invoke->GetDexPc());
 }
 
+void LocationsBuilderX86::VisitInvokeInterface(HInvokeInterface* invoke) {
+  HandleInvoke(invoke);
+  // Add the hidden argument.
+  invoke->GetLocations()->AddTemp(Location::FpuRegisterLocation(XMM0));
+}
+
+void InstructionCodeGeneratorX86::VisitInvokeInterface(HInvokeInterface* invoke) {
+  Register temp = invoke->GetLocations()->GetTemp(0).As<Register>();
+  uint32_t method_offset = mirror::Class::EmbeddedImTableOffset().Uint32Value() +
+          (invoke->GetImtIndex() % mirror::Class::kImtSize) * sizeof(mirror::Class::ImTableEntry);
+  LocationSummary* locations = invoke->GetLocations();
+  Location receiver = locations->InAt(0);
+  uint32_t class_offset = mirror::Object::ClassOffset().Int32Value();
+
+  // Set the hidden argument, which the IMT conflict trampoline uses to find
+  // the interface method.
+  __ movl(temp, Immediate(invoke->GetDexMethodIndex()));
+  __ movd(invoke->GetLocations()->GetTemp(1).As<XmmRegister>(), temp);
+
+  // temp = object->GetClass();
+  if (receiver.IsStackSlot()) {
+    __ movl(temp, Address(ESP, receiver.GetStackIndex()));
+    __ movl(temp, Address(temp, class_offset));
+  } else {
+    __ movl(temp, Address(receiver.As<Register>(), class_offset));
+  }
+  // temp = temp->GetImtEntryAt(method_offset);
+  __ movl(temp, Address(temp, method_offset));
+  // call temp->GetEntryPoint();
+  __ call(Address(temp, mirror::ArtMethod::EntryPointFromQuickCompiledCodeOffset().Int32Value()));
+
+  DCHECK(!codegen_->IsLeafMethod());
+  codegen_->RecordPcInfo(invoke, invoke->GetDexPc());
+}
+
 void LocationsBuilderX86::VisitNeg(HNeg* neg) {
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(neg, LocationSummary::kNoCall);
@@ -1293,6 +1496,343 @@ void InstructionCodeGeneratorX86::VisitMul(HMul* mul) {
   }
 }
 
+void LocationsBuilderX86::VisitAnd(HAnd* instruction) {
+  HandleBitwiseOperation(instruction);
+}
+
+void InstructionCodeGeneratorX86::VisitAnd(HAnd* instruction) {
+  HandleBitwiseOperation(instruction);
+}
+
+void LocationsBuilderX86::VisitOr(HOr* instruction) {
+  HandleBitwiseOperation(instruction);
+}
+
+void InstructionCodeGeneratorX86::VisitOr(HOr* instruction) {
+  HandleBitwiseOperation(instruction);
+}
+
+void LocationsBuilderX86::VisitXor(HXor* instruction) {
+  HandleBitwiseOperation(instruction);
+}
+
+void InstructionCodeGeneratorX86::VisitXor(HXor* instruction) {
+  HandleBitwiseOperation(instruction);
+}
+
+void LocationsBuilderX86::HandleBitwiseOperation(HBinaryOperation* instruction) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
+  DCHECK(instruction->GetResultType() == Primitive::kPrimInt
+         || instruction->GetResultType() == Primitive::kPrimLong);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::Any());
+  locations->SetOut(Location::SameAsFirstInput());
+}
+
+void InstructionCodeGeneratorX86::HandleBitwiseOperation(HBinaryOperation* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  Location first = locations->InAt(0);
+  Location second = locations->InAt(1);
+  DCHECK(first.Equals(locations->Out()));
+
+  if (instruction->GetResultType() == Primitive::kPrimInt) {
+    if (second.IsRegister()) {
+      if (instruction->IsAnd()) {
+        __ andl(first.As<Register>(), second.As<Register>());
+      } else if (instruction->IsOr()) {
+        __ orl(first.As<Register>(), second.As<Register>());
+      } else {
+        DCHECK(instruction->IsXor());
+        __ xorl(first.As<Register>(), second.As<Register>());
+      }
+    } else if (second.IsConstant()) {
+      Immediate imm(second.GetConstant()->AsIntConstant()->GetValue());
+      if (instruction->IsAnd()) {
+        __ andl(first.As<Register>(), imm);
+      } else if (instruction->IsOr()) {
+        __ orl(first.As<Register>(), imm);
+      } else {
+        DCHECK(instruction->IsXor());
+        __ xorl(first.As<Register>(), imm);
+      }
+    } else {
+      Address address(ESP, second.GetStackIndex());
+      if (instruction->IsAnd()) {
+        __ andl(first.As<Register>(), address);
+      } else if (instruction->IsOr()) {
+        __ orl(first.As<Register>(), address);
+      } else {
+        DCHECK(instruction->IsXor());
+        __ xorl(first.As<Register>(), address);
+      }
+    }
+  } else {
+    DCHECK_EQ(instruction->GetResultType(), Primitive::kPrimLong);
+    if (second.IsRegister()) {
+      if (instruction->IsAnd()) {
+        __ andl(first.AsRegisterPairLow<Register>(), second.AsRegisterPairLow<Register>());
+        __ andl(first.AsRegisterPairHigh<Register>(), second.AsRegisterPairHigh<Register>());
+      } else if (instruction->IsOr()) {
+        __ orl(first.AsRegisterPairLow<Register>(), second.AsRegisterPairLow<Register>());
+        __ orl(first.AsRegisterPairHigh<Register>(), second.AsRegisterPairHigh<Register>());
+      } else {
+        DCHECK(instruction->IsXor());
+        __ xorl(first.AsRegisterPairLow<Register>(), second.AsRegisterPairLow<Register>());
+        __ xorl(first.AsRegisterPairHigh<Register>(), second.AsRegisterPairHigh<Register>());
+      }
+    } else {
+      Address low(ESP, second.GetStackIndex());
+      Address high(ESP, second.GetHighStackIndex(kX86WordSize));
+      if (instruction->IsAnd()) {
+        __ andl(first.AsRegisterPairLow<Register>(), low);
+        __ andl(first.AsRegisterPairHigh<Register>(), high);
+      } else if (instruction->IsOr()) {
+        __ orl(first.AsRegisterPairLow<Register>(), low);
+        __ orl(first.AsRegisterPairHigh<Register>(), high);
+      } else {
+        DCHECK(instruction->IsXor());
+        __ xorl(first.AsRegisterPairLow<Register>(), low);
+        __ xorl(first.AsRegisterPairHigh<Register>(), high);
+      }
+    }
+  }
+}
+
+
+void LocationsBuilderX86::VisitShl(HShl* instruction) {
+  HandleShift(instruction);
+}
+
+void InstructionCodeGeneratorX86::VisitShl(HShl* instruction) {
+  HandleShift(instruction);
+}
+
+void LocationsBuilderX86::VisitShr(HShr* instruction) {
+  HandleShift(instruction);
+}
+
+void InstructionCodeGeneratorX86::VisitShr(HShr* instruction) {
+  HandleShift(instruction);
+}
+
+void LocationsBuilderX86::VisitUShr(HUShr* instruction) {
+  HandleShift(instruction);
+}
+
+void InstructionCodeGeneratorX86::VisitUShr(HUShr* instruction) {
+  HandleShift(instruction);
+}
+
+void LocationsBuilderX86::HandleShift(HBinaryOperation* instruction) {
+  DCHECK(instruction->GetResultType() == Primitive::kPrimInt
+         || instruction->GetResultType() == Primitive::kPrimLong);
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
+  locations->SetInAt(0, Location::RequiresRegister());
+  // A variable shift distance must be in CL.
+  locations->SetInAt(1, Location::ByteRegisterOrConstant(ECX, instruction->InputAt(1)));
+  locations->SetOut(Location::SameAsFirstInput());
+}
+
+void InstructionCodeGeneratorX86::HandleShift(HBinaryOperation* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  Location second = locations->InAt(1);
+  DCHECK(locations->InAt(0).Equals(locations->Out()));
+
+  if (instruction->GetResultType() == Primitive::kPrimLong) {
+    GenerateLongShift(instruction);
+    return;
+  }
+
+  Register first = locations->InAt(0).As<Register>();
+
+  if (second.IsRegister()) {
+    // The processor only uses the low 5 bits of CL, as Java does.
+    Register shifter = second.As<Register>();
+    DCHECK_EQ(ECX, shifter);
+    if (instruction->IsShl()) {
+      __ shll(first, shifter);
+    } else if (instruction->IsShr()) {
+      __ sarl(first, shifter);
+    } else {
+      DCHECK(instruction->IsUShr());
+      __ shrl(first, shifter);
+    }
+  } else {
+    Immediate imm(second.GetConstant()->AsIntConstant()->GetValue() & kMaxIntShiftValue);
+    if (instruction->IsShl()) {
+      __ shll(first, imm);
+    } else if (instruction->IsShr()) {
+      __ sarl(first, imm);
+    } else {
+      DCHECK(instruction->IsUShr());
+      __ shrl(first, imm);
+    }
+  }
+}
+
+void InstructionCodeGeneratorX86::GenerateLongShift(HBinaryOperation* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  Register low = locations->InAt(0).AsRegisterPairLow<Register>();
+  Register high = locations->InAt(0).AsRegisterPairHigh<Register>();
+  Location second = locations->InAt(1);
+
+  if (second.IsRegister()) {
+    // The double precision shifts only use the low 5 bits of CL: when bit 5
+    // is set, the result is shifted by 32 more by moving words around.
+    DCHECK_EQ(ECX, second.As<Register>());
+    Label done;
+    if (instruction->IsShl()) {
+      __ shld(high, low);
+      __ shll(low, ECX);
+      __ testl(ECX, Immediate(32));
+      __ j(kEqual, &done);
+      __ movl(high, low);
+      __ xorl(low, low);
+    } else if (instruction->IsShr()) {
+      __ shrd(low, high);
+      __ sarl(high, ECX);
+      __ testl(ECX, Immediate(32));
+      __ j(kEqual, &done);
+      __ movl(low, high);
+      __ sarl(high, Immediate(31));
+    } else {
+      DCHECK(instruction->IsUShr());
+      __ shrd(low, high);
+      __ shrl(high, ECX);
+      __ testl(ECX, Immediate(32));
+      __ j(kEqual, &done);
+      __ movl(low, high);
+      __ xorl(high, high);
+    }
+    __ Bind(&done);
+    return;
+  }
+
+  int32_t shift = second.GetConstant()->AsIntConstant()->GetValue() & kMaxLongShiftValue;
+  if (shift == 0) {
+    return;
+  }
+  if (shift < 32) {
+    Immediate imm(shift);
+    if (instruction->IsShl()) {
+      __ shld(high, low, imm);
+      __ shll(low, imm);
+    } else if (instruction->IsShr()) {
+      __ shrd(low, high, imm);
+      __ sarl(high, imm);
+    } else {
+      DCHECK(instruction->IsUShr());
+      __ shrd(low, high, imm);
+      __ shrl(high, imm);
+    }
+  } else {
+    // Shifting by 32 or more moves one word into the other.
+    Immediate imm(shift - 32);
+    if (instruction->IsShl()) {
+      __ movl(high, low);
+      if (shift != 32) {
+        __ shll(high, imm);
+      }
+      __ xorl(low, low);
+    } else if (instruction->IsShr()) {
+      __ movl(low, high);
+      if (shift != 32) {
+        __ sarl(low, imm);
+      }
+      __ sarl(high, Immediate(31));
+    } else {
+      DCHECK(instruction->IsUShr());
+      __ movl(low, high);
+      if (shift != 32) {
+        __ shrl(low, imm);
+      }
+      __ xorl(high, high);
+    }
+  }
+}
+
+void LocationsBuilderX86::VisitDiv(HDiv* instruction) {
+  HandleDivRem(instruction);
+}
+
+void InstructionCodeGeneratorX86::VisitDiv(HDiv* instruction) {
+  HandleDivRem(instruction);
+}
+
+void LocationsBuilderX86::VisitRem(HRem* instruction) {
+  HandleDivRem(instruction);
+}
+
+void InstructionCodeGeneratorX86::VisitRem(HRem* instruction) {
+  HandleDivRem(instruction);
+}
+
+void LocationsBuilderX86::HandleDivRem(HBinaryOperation* instruction) {
+  if (instruction->GetResultType() == Primitive::kPrimLong) {
+    // The runtime takes the dividend in EAX:ECX and the divisor in EDX:EBX,
+    // and returns the result in EAX:EDX.
+    LocationSummary* locations =
+        new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCall);
+    locations->SetInAt(0, Location::RegisterPairLocation(EAX, ECX));
+    locations->SetInAt(1, Location::RegisterPairLocation(EDX, EBX));
+    locations->SetOut(Location::RegisterPairLocation(EAX, EDX));
+    return;
+  }
+
+  DCHECK_EQ(instruction->GetResultType(), Primitive::kPrimInt);
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
+  // idivl divides EDX:EAX, and leaves the quotient in EAX and the remainder in EDX.
+  locations->SetInAt(0, Location::RegisterLocation(EAX));
+  locations->SetInAt(1, Location::RequiresRegister());
+  if (instruction->IsDiv()) {
+    locations->SetOut(Location::RegisterLocation(EAX));
+    locations->AddTemp(Location::RegisterLocation(EDX));
+  } else {
+    locations->SetOut(Location::RegisterLocation(EDX));
+  }
+}
+
+void InstructionCodeGeneratorX86::HandleDivRem(HBinaryOperation* instruction) {
+  if (instruction->GetResultType() == Primitive::kPrimLong) {
+    // The runtime helpers follow the Java semantics, including for the
+    // division of the smallest long by -1.
+    uint32_t dex_pc;
+    if (instruction->IsDiv()) {
+      __ fs()->call(Address::Absolute(QUICK_ENTRYPOINT_OFFSET(kX86WordSize, pLdiv)));
+      dex_pc = instruction->AsDiv()->GetDexPc();
+    } else {
+      __ fs()->call(Address::Absolute(QUICK_ENTRYPOINT_OFFSET(kX86WordSize, pLmod)));
+      dex_pc = instruction->AsRem()->GetDexPc();
+    }
+    codegen_->RecordPcInfo(instruction, dex_pc);
+    return;
+  }
+
+  LocationSummary* locations = instruction->GetLocations();
+  Register second = locations->InAt(1).As<Register>();
+  DCHECK_EQ(EAX, locations->InAt(0).As<Register>());
+
+  // The division of the smallest integer by -1 overflows and traps, so
+  // handle a divisor of -1 separately: the quotient is the negated dividend
+  // and the remainder is zero.
+  Label minus_one, done;
+  __ cmpl(second, Immediate(-1));
+  __ j(kEqual, &minus_one);
+  __ cdq();
+  __ idivl(second);
+  __ jmp(&done);
+  __ Bind(&minus_one);
+  if (instruction->IsDiv()) {
+    __ negl(EAX);
+  } else {
+    __ xorl(EDX, EDX);
+  }
+  __ Bind(&done);
+}
+
 void LocationsBuilderX86::VisitNewInstance(HNewInstance* instruction) {
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCall);
@@ -1445,11 +1985,10 @@ void InstructionCodeGeneratorX86::VisitPhi(HPhi* instruction) {
   LOG(FATAL) << "Unreachable";
 }
 
-void LocationsBuilderX86::VisitInstanceFieldSet(HInstanceFieldSet* instruction) {
+void LocationsBuilderX86::HandleFieldSet(HInstruction* instruction, Primitive::Type field_type) {
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
   locations->SetInAt(0, Location::RequiresRegister());
-  Primitive::Type field_type = instruction->GetFieldType();
   bool is_object_type = field_type == Primitive::kPrimNot;
   bool is_byte_type = (field_type == Primitive::kPrimBoolean)
       || (field_type == Primitive::kPrimByte);
@@ -1469,11 +2008,11 @@ void LocationsBuilderX86::VisitInstanceFieldSet(HInstanceFieldSet* instruction)
   }
 }
 
-void InstructionCodeGeneratorX86::VisitInstanceFieldSet(HInstanceFieldSet* instruction) {
+void InstructionCodeGeneratorX86::HandleFieldSet(HInstruction* instruction,
+                                                 Primitive::Type field_type,
+                                                 uint32_t offset) {
   LocationSummary* locations = instruction->GetLocations();
   Register obj = locations->InAt(0).As<Register>();
-  uint32_t offset = instruction->GetFieldOffset().Uint32Value();
-  Primitive::Type field_type = instruction->GetFieldType();
 
   switch (field_type) {
     case Primitive::kPrimBoolean:
@@ -1532,17 +2071,16 @@ void CodeGeneratorX86::MarkGCCard(Register temp, Register card, Register object,
   __ Bind(&is_null);
 }
 
-void LocationsBuilderX86::VisitInstanceFieldGet(HInstanceFieldGet* instruction) {
+void LocationsBuilderX86::HandleFieldGet(HInstruction* instruction) {
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
   locations->SetInAt(0, Location::RequiresRegister());
   locations->SetOut(Location::RequiresRegister(), Location::kNoOutputOverlap);
 }
 
-void InstructionCodeGeneratorX86::VisitInstanceFieldGet(HInstanceFieldGet* instruction) {
+void InstructionCodeGeneratorX86::HandleFieldGet(HInstruction* instruction, uint32_t offset) {
   LocationSummary* locations = instruction->GetLocations();
   Register obj = locations->InAt(0).As<Register>();
-  uint32_t offset = instruction->GetFieldOffset().Uint32Value();
 
   switch (instruction->GetType()) {
     case Primitive::kPrimBoolean: {
@@ -1593,6 +2131,42 @@ void InstructionCodeGeneratorX86::VisitInstanceFieldGet(HInstanceFieldGet* instr
   }
 }
 
+void LocationsBuilderX86::VisitInstanceFieldSet(HInstanceFieldSet* instruction) {
+  HandleFieldSet(instruction, instruction->GetFieldType());
+}
+
+void InstructionCodeGeneratorX86::VisitInstanceFieldSet(HInstanceFieldSet* instruction) {
+  HandleFieldSet(instruction,
+                 instruction->GetFieldType(),
+                 instruction->GetFieldOffset().Uint32Value());
+}
+
+void LocationsBuilderX86::VisitInstanceFieldGet(HInstanceFieldGet* instruction) {
+  HandleFieldGet(instruction);
+}
+
+void InstructionCodeGeneratorX86::VisitInstanceFieldGet(HInstanceFieldGet* instruction) {
+  HandleFieldGet(instruction, instruction->GetFieldOffset().Uint32Value());
+}
+
+void LocationsBuilderX86::VisitStaticFieldSet(HStaticFieldSet* instruction) {
+  HandleFieldSet(instruction, instruction->GetFieldType());
+}
+
+void InstructionCodeGeneratorX86::VisitStaticFieldSet(HStaticFieldSet* instruction) {
+  HandleFieldSet(instruction,
+                 instruction->GetFieldType(),
+                 instruction->GetFieldOffset().Uint32Value());
+}
+
+void LocationsBuilderX86::VisitStaticFieldGet(HStaticFieldGet* instruction) {
+  HandleFieldGet(instruction);
+}
+
+void InstructionCodeGeneratorX86::VisitStaticFieldGet(HStaticFieldGet* instruction) {
+  HandleFieldGet(instruction, instruction->GetFieldOffset().Uint32Value());
+}
+
 void LocationsBuilderX86::VisitNullCheck(HNullCheck* instruction) {
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
@@ -1946,6 +2520,473 @@ void InstructionCodeGeneratorX86::VisitSuspendCheck(HSuspendCheck* instruction)
   GenerateSuspendCheck(instruction, nullptr);
 }
 
+void LocationsBuilderX86::VisitLoadException(HLoadException* load) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(load, LocationSummary::kNoCall);
+  locations->SetOut(Location::RequiresRegister());
+}
+
+void InstructionCodeGeneratorX86::VisitLoadException(HLoadException* load) {
+  Address address = Address::Absolute(Thread::ExceptionOffset<kX86WordSize>());
+  __ fs()->movl(load->GetLocations()->Out().As<Register>(), address);
+  __ fs()->movl(address, Immediate(0));
+}
+
+void LocationsBuilderX86::VisitPackedSwitch(HPackedSwitch* switch_instr) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(switch_instr, LocationSummary::kNoCall);
+  locations->SetInAt(0, Location::RequiresRegister());
+  if (switch_instr->GetNumEntries() > kPackedSwitchJumpTableThreshold) {
+    locations->AddTemp(Location::RequiresRegister());
+    locations->AddTemp(Location::RequiresRegister());
+  }
+}
+
+void InstructionCodeGeneratorX86::VisitPackedSwitch(HPackedSwitch* switch_instr) {
+  int32_t start_value = switch_instr->GetStartValue();
+  uint32_t num_entries = switch_instr->GetNumEntries();
+  LocationSummary* locations = switch_instr->GetLocations();
+  Register value = locations->InAt(0).As<Register>();
+  HBasicBlock* default_block = switch_instr->GetDefaultBlock();
+
+  if (num_entries <= kPackedSwitchJumpTableThreshold) {
+    for (uint32_t i = 0; i < num_entries; ++i) {
+      int32_t case_value = static_cast<int32_t>(static_cast<uint32_t>(start_value) + i);
+      __ cmpl(value, Immediate(case_value));
+      __ j(kEqual, codegen_->GetLabelOf(switch_instr->GetCaseSuccessor(i)));
+    }
+    if (!codegen_->GoesToNextBlock(switch_instr->GetBlock(), default_block)) {
+      __ jmp(codegen_->GetLabelOf(default_block));
+    }
+    return;
+  }
+
+  Register index = locations->GetTemp(0).As<Register>();
+  Register base = locations->GetTemp(1).As<Register>();
+  // Values out of the range of the cases give an unsigned index above the last entry.
+  __ movl(index, value);
+  if (start_value != 0) {
+    __ subl(index, Immediate(start_value));
+  }
+  __ cmpl(index, Immediate(num_entries - 1));
+  __ j(kAbove, codegen_->GetLabelOf(default_block));
+
+  PackedSwitchTableX86* table =
+      new (GetGraph()->GetArena()) PackedSwitchTableX86(switch_instr);
+  codegen_->AddSlowPath(table);
+  __ LoadLabelAddress(base, table->GetEntryLabel());
+  __ addl(base, Address(base, index, TIMES_4, 0));
+  __ jmp(base);
+}
+
+void LocationsBuilderX86::VisitThrow(HThrow* instruction) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCall);
+  InvokeRuntimeCallingConvention calling_convention;
+  locations->SetInAt(0, Location::RegisterLocation(calling_convention.GetRegisterAt(0)));
+}
+
+void InstructionCodeGeneratorX86::VisitThrow(HThrow* instruction) {
+  __ fs()->call(Address::Absolute(QUICK_ENTRYPOINT_OFFSET(kX86WordSize, pDeliverException)));
+  codegen_->RecordPcInfo(instruction, instruction->GetDexPc());
+}
+
+void LocationsBuilderX86::VisitDivZeroCheck(HDivZeroCheck* instruction) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
+  locations->SetInAt(0, Location::Any());
+  if (instruction->HasUses()) {
+    locations->SetOut(Location::SameAsFirstInput());
+  }
+  if (instruction->GetType() == Primitive::kPrimLong) {
+    // Used to combine the two words of a long in registers.
+    locations->AddTemp(Location::RequiresRegister());
+  }
+}
+
+void InstructionCodeGeneratorX86::VisitDivZeroCheck(HDivZeroCheck* instruction) {
+  SlowPathCodeX86* slow_path =
+      new (GetGraph()->GetArena()) DivZeroCheckSlowPathX86(instruction);
+  codegen_->AddSlowPath(slow_path);
+
+  LocationSummary* locations = instruction->GetLocations();
+  Location value = locations->InAt(0);
+  if (value.IsRegister()) {
+    __ testl(value.As<Register>(), value.As<Register>());
+  } else if (value.IsStackSlot()) {
+    __ cmpl(Address(ESP, value.GetStackIndex()), Immediate(0));
+  } else if (value.IsRegisterPair()) {
+    Register temp = locations->GetTemp(0).As<Register>();
+    __ movl(temp, value.AsRegisterPairLow<Register>());
+    __ orl(temp, value.AsRegisterPairHigh<Register>());
+  } else if (value.IsDoubleStackSlot()) {
+    Register temp = locations->GetTemp(0).As<Register>();
+    __ movl(temp, Address(ESP, value.GetStackIndex()));
+    __ orl(temp, Address(ESP, value.GetHighStackIndex(kX86WordSize)));
+  } else {
+    DCHECK(value.IsConstant()) << value;
+    HConstant* constant = value.GetConstant();
+    bool is_zero = constant->IsIntConstant()
+        ? (constant->AsIntConstant()->GetValue() == 0)
+        : (constant->AsLongConstant()->GetValue() == 0);
+    if (is_zero) {
+      __ jmp(slow_path->GetEntryLabel());
+    }
+    return;
+  }
+  __ j(kEqual, slow_path->GetEntryLabel());
+}
+
+void LocationsBuilderX86::VisitTypeConversion(HTypeConversion* conversion) {
+  Primitive::Type input_type = conversion->GetInputType();
+  Primitive::Type result_type = conversion->GetResultType();
+  bool is_fp_input =
+      (input_type == Primitive::kPrimFloat) || (input_type == Primitive::kPrimDouble);
+
+  if (result_type == Primitive::kPrimLong && is_fp_input) {
+    // There is no 64-bit conversion instruction on x86, so call the runtime,
+    // which returns the result in EAX:EDX.
+    LocationSummary* locations =
+        new (GetGraph()->GetArena()) LocationSummary(conversion, LocationSummary::kCall);
+    locations->SetInAt(0, Location::RequiresFpuRegister());
+    locations->SetOut(Location::RegisterPairLocation(EAX, EDX));
+    if (input_type == Primitive::kPrimDouble) {
+      // The high word of the double is passed in ECX.
+      locations->AddTemp(Location::RegisterLocation(ECX));
+    }
+    return;
+  }
+
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(conversion, LocationSummary::kNoCall);
+  if (is_fp_input) {
+    locations->SetInAt(0, Location::RequiresFpuRegister());
+  } else if (input_type == Primitive::kPrimLong
+             && (result_type == Primitive::kPrimFloat || result_type == Primitive::kPrimDouble)) {
+    // The x87 unit loads the long from the stack.
+    locations->SetInAt(0, Location::Any());
+  } else {
+    locations->SetInAt(0, Location::RequiresRegister());
+  }
+
+  if (result_type == Primitive::kPrimFloat || result_type == Primitive::kPrimDouble) {
+    locations->SetOut(Location::RequiresFpuRegister(), Location::kNoOutputOverlap);
+  } else if (result_type == Primitive::kPrimLong) {
+    // The high word is computed from the low word, so they must not share
+    // a register with the input.
+    locations->SetOut(Location::RequiresRegister());
+  } else {
+    locations->SetOut(Location::RequiresRegister(), Location::kNoOutputOverlap);
+  }
+}
+
+void InstructionCodeGeneratorX86::VisitTypeConversion(HTypeConversion* conversion) {
+  LocationSummary* locations = conversion->GetLocations();
+  Location out = locations->Out();
+  Location in = locations->InAt(0);
+  Primitive::Type input_type = conversion->GetInputType();
+  switch (conversion->GetResultType()) {
+    case Primitive::kPrimLong: {
+      if (input_type == Primitive::kPrimFloat) {
+        __ movd(EAX, in.As<XmmRegister>());
+        __ fs()->call(Address::Absolute(QUICK_ENTRYPOINT_OFFSET(kX86WordSize, pF2l)));
+        codegen_->RecordPcInfo(conversion, conversion->GetDexPc());
+        break;
+      }
+      if (input_type == Primitive::kPrimDouble) {
+        DCHECK_EQ(ECX, locations->GetTemp(0).As<Register>());
+        __ subl(ESP, Immediate(2 * kX86WordSize));
+        __ movsd(Address(ESP, 0), in.As<XmmRegister>());
+        __ popl(EAX);
+        __ popl(ECX);
+        __ fs()->call(Address::Absolute(QUICK_ENTRYPOINT_OFFSET(kX86WordSize, pD2l)));
+        codegen_->RecordPcInfo(conversion, conversion->GetDexPc());
+        break;
+      }
+      DCHECK_EQ(input_type, Primitive::kPrimInt);
+      Register out_lo = out.AsRegisterPairLow<Register>();
+      Register out_hi = out.AsRegisterPairHigh<Register>();
+      __ movl(out_lo, in.As<Register>());
+      __ movl(out_hi, out_lo);
+      __ sarl(out_hi, Immediate(31));
+      break;
+    }
+
+    case Primitive::kPrimInt:
+      if (input_type == Primitive::kPrimFloat || input_type == Primitive::kPrimDouble) {
+        GenerateFpToInt(in.As<XmmRegister>(), out.As<Register>(), input_type);
+        break;
+      }
+      DCHECK_EQ(input_type, Primitive::kPrimLong);
+      __ movl(out.As<Register>(), in.AsRegisterPairLow<Register>());
+      break;
+
+    case Primitive::kPrimFloat:
+    case Primitive::kPrimDouble: {
+      XmmRegister result = out.As<XmmRegister>();
+      bool is_float = conversion->GetResultType() == Primitive::kPrimFloat;
+      if (input_type == Primitive::kPrimInt) {
+        if (is_float) {
+          __ cvtsi2ss(result, in.As<Register>());
+        } else {
+          __ cvtsi2sd(result, in.As<Register>());
+        }
+      } else if (input_type == Primitive::kPrimLong) {
+        // SSE cannot convert a 64-bit integer in 32-bit mode, but the x87 unit
+        // can, rounding only once to the result type.
+        if (in.IsRegisterPair()) {
+          __ pushl(in.AsRegisterPairHigh<Register>());
+          __ pushl(in.AsRegisterPairLow<Register>());
+        } else {
+          DCHECK(in.IsDoubleStackSlot()) << in;
+          __ pushl(Address(ESP, in.GetHighStackIndex(kX86WordSize)));
+          // The first push moved the stack pointer.
+          __ pushl(Address(ESP, in.GetStackIndex() + kX86WordSize));
+        }
+        __ fildl(Address(ESP, 0));
+        if (is_float) {
+          __ fstps(Address(ESP, 0));
+          __ movss(result, Address(ESP, 0));
+        } else {
+          __ fstpl(Address(ESP, 0));
+          __ movsd(result, Address(ESP, 0));
+        }
+        __ addl(ESP, Immediate(2 * kX86WordSize));
+      } else if (is_float) {
+        DCHECK_EQ(input_type, Primitive::kPrimDouble);
+        __ cvtsd2ss(result, in.As<XmmRegister>());
+      } else {
+        DCHECK_EQ(input_type, Primitive::kPrimFloat);
+        __ cvtss2sd(result, in.As<XmmRegister>());
+      }
+      break;
+    }
+
+    case Primitive::kPrimByte:
+      // Only EAX, ECX, EDX and EBX have a byte form, but the others are never allocated.
+      DCHECK_LT(in.As<Register>(), ESP);
+      __ movsxb(out.As<Register>(), static_cast<ByteRegister>(in.As<Register>()));
+      break;
+
+    case Primitive::kPrimShort:
+      __ movsxw(out.As<Register>(), in.As<Register>());
+      break;
+
+    case Primitive::kPrimChar:
+      __ movzxw(out.As<Register>(), in.As<Register>());
+      break;
+
+    default:
+      LOG(FATAL) << "Unexpected type conversion from " << conversion->GetInputType()
+                 << " to " << conversion->GetResultType();
+  }
+}
+
+void InstructionCodeGeneratorX86::GenerateFpToInt(XmmRegister input,
+                                                  Register output,
+                                                  Primitive::Type input_type) {
+  bool is_float = input_type == Primitive::kPrimFloat;
+  Label done, nan;
+  // The truncation returns the smallest int for NaN and for values out of
+  // range, which is only right for the negative ones.
+  if (is_float) {
+    __ cvttss2si(output, input);
+  } else {
+    __ cvttsd2si(output, input);
+  }
+  __ cmpl(output, Immediate(std::numeric_limits<int32_t>::min()));
+  __ j(kNotEqual, &done);
+  if (is_float) {
+    __ comiss(input, input);
+  } else {
+    __ comisd(input, input);
+  }
+  __ j(kParityEven, &nan);
+  // Saturate: the largest int plus the sign bit of the input wraps to the
+  // smallest int for negative values.
+  if (is_float) {
+    __ movmskps(output, input);
+  } else {
+    __ movmskpd(output, input);
+  }
+  __ andl(output, Immediate(1));
+  __ addl(output, Immediate(std::numeric_limits<int32_t>::max()));
+  __ jmp(&done);
+  __ Bind(&nan);
+  __ xorl(output, output);
+  __ Bind(&done);
+}
+
+void LocationsBuilderX86::VisitMonitorOperation(HMonitorOperation* instruction) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCall);
+  InvokeRuntimeCallingConvention calling_convention;
+  locations->SetInAt(0, Location::RegisterLocation(calling_convention.GetRegisterAt(0)));
+}
+
+void InstructionCodeGeneratorX86::VisitMonitorOperation(HMonitorOperation* instruction) {
+  if (instruction->IsEnter()) {
+    __ fs()->call(Address::Absolute(QUICK_ENTRYPOINT_OFFSET(kX86WordSize, pLockObject)));
+  } else {
+    __ fs()->call(Address::Absolute(QUICK_ENTRYPOINT_OFFSET(kX86WordSize, pUnlockObject)));
+  }
+  codegen_->RecordPcInfo(instruction, instruction->GetDexPc());
+}
+
+void LocationsBuilderX86::VisitLoadString(HLoadString* load) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(load, LocationSummary::kCallOnSlowPath);
+  locations->SetOut(Location::RequiresRegister());
+}
+
+void InstructionCodeGeneratorX86::VisitLoadString(HLoadString* load) {
+  SlowPathCodeX86* slow_path = new (GetGraph()->GetArena()) LoadStringSlowPathX86(load);
+  codegen_->AddSlowPath(slow_path);
+
+  Register out = load->GetLocations()->Out().As<Register>();
+  uint32_t heap_reference_size = sizeof(mirror::HeapReference<mirror::Object>);
+  size_t index_in_cache = mirror::Array::DataOffset(heap_reference_size).Int32Value() +
+      load->GetStringIndex() * heap_reference_size;
+  LoadCurrentMethod(out);
+  __ movl(out, Address(out, mirror::ArtMethod::DexCacheStringsOffset().Int32Value()));
+  __ movl(out, Address(out, index_in_cache));
+  __ testl(out, out);
+  __ j(kEqual, slow_path->GetEntryLabel());
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void LocationsBuilderX86::VisitLoadClass(HLoadClass* cls) {
+  LocationSummary::CallKind call_kind = cls->CanThrow()
+      ? LocationSummary::kCallOnSlowPath
+      : LocationSummary::kNoCall;
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(cls, call_kind);
+  locations->SetOut(Location::RequiresRegister());
+}
+
+void InstructionCodeGeneratorX86::VisitLoadClass(HLoadClass* cls) {
+  Register out = cls->GetLocations()->Out().As<Register>();
+  if (cls->IsReferrersClass()) {
+    LoadCurrentMethod(out);
+    __ movl(out, Address(out, mirror::ArtMethod::DeclaringClassOffset().Int32Value()));
+  } else {
+    uint32_t heap_reference_size = sizeof(mirror::HeapReference<mirror::Object>);
+    size_t index_in_cache = mirror::Array::DataOffset(heap_reference_size).Int32Value() +
+        cls->GetTypeIndex() * heap_reference_size;
+    LoadCurrentMethod(out);
+    __ movl(out, Address(out, mirror::ArtMethod::DexCacheResolvedTypesOffset().Int32Value()));
+    __ movl(out, Address(out, index_in_cache));
+    SlowPathCodeX86* slow_path = new (GetGraph()->GetArena()) LoadClassSlowPathX86(
+        cls, cls, cls->GetDexPc(), false);
+    codegen_->AddSlowPath(slow_path);
+    __ testl(out, out);
+    __ j(kEqual, slow_path->GetEntryLabel());
+    __ Bind(slow_path->GetExitLabel());
+  }
+}
+
+void LocationsBuilderX86::VisitClinitCheck(HClinitCheck* check) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(check, LocationSummary::kCallOnSlowPath);
+  locations->SetInAt(0, Location::RequiresRegister());
+  if (check->HasUses()) {
+    locations->SetOut(Location::SameAsFirstInput());
+  }
+}
+
+void InstructionCodeGeneratorX86::VisitClinitCheck(HClinitCheck* check) {
+  // We assume the class is not null.
+  SlowPathCodeX86* slow_path = new (GetGraph()->GetArena()) LoadClassSlowPathX86(
+      check->GetLoadClass(), check, check->GetDexPc(), true);
+  codegen_->AddSlowPath(slow_path);
+  GenerateClassInitializationCheck(slow_path, check->GetLocations()->InAt(0).As<Register>());
+}
+
+void InstructionCodeGeneratorX86::GenerateClassInitializationCheck(
+    SlowPathCodeX86* slow_path, Register class_reg) {
+  __ cmpl(Address(class_reg, mirror::Class::StatusOffset().Int32Value()),
+          Immediate(mirror::Class::kStatusInitialized));
+  __ j(kLess, slow_path->GetEntryLabel());
+  __ Bind(slow_path->GetExitLabel());
+  // No need for memory fence, thanks to the X86 memory model.
+}
+
+void LocationsBuilderX86::VisitInstanceOf(HInstanceOf* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(
+      instruction, LocationSummary::kCallOnSlowPath);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::Any());
+  // The output holds the class of the object while the class to check is
+  // still needed, so they must not share a register.
+  locations->SetOut(Location::RequiresRegister());
+}
+
+void InstructionCodeGeneratorX86::VisitInstanceOf(HInstanceOf* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  Register obj = locations->InAt(0).As<Register>();
+  Location cls = locations->InAt(1);
+  Register out = locations->Out().As<Register>();
+  uint32_t class_offset = mirror::Object::ClassOffset().Int32Value();
+  Label done, zero;
+
+  // Return 0 if `obj` is null.
+  __ testl(obj, obj);
+  __ j(kEqual, &zero);
+  __ movl(out, Address(obj, class_offset));
+  // Compare the class of `obj` with `cls`.
+  if (cls.IsRegister()) {
+    __ cmpl(out, cls.As<Register>());
+  } else {
+    DCHECK(cls.IsStackSlot()) << cls;
+    __ cmpl(out, Address(ESP, cls.GetStackIndex()));
+  }
+  // If the classes are not equal, go into the slow path, which also handles
+  // the subclasses and interfaces.
+  SlowPathCodeX86* slow_path = new (GetGraph()->GetArena()) TypeCheckSlowPathX86(
+      instruction, cls, locations->Out(), instruction->GetDexPc());
+  codegen_->AddSlowPath(slow_path);
+  __ j(kNotEqual, slow_path->GetEntryLabel());
+  __ movl(out, Immediate(1));
+  __ jmp(&done);
+  __ Bind(&zero);
+  __ movl(out, Immediate(0));
+  __ Bind(slow_path->GetExitLabel());
+  __ Bind(&done);
+}
+
+void LocationsBuilderX86::VisitCheckCast(HCheckCast* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(
+      instruction, LocationSummary::kCallOnSlowPath);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::Any());
+  locations->AddTemp(Location::RequiresRegister());
+}
+
+void InstructionCodeGeneratorX86::VisitCheckCast(HCheckCast* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  Register obj = locations->InAt(0).As<Register>();
+  Location cls = locations->InAt(1);
+  Register temp = locations->GetTemp(0).As<Register>();
+  uint32_t class_offset = mirror::Object::ClassOffset().Int32Value();
+  SlowPathCodeX86* slow_path = new (GetGraph()->GetArena()) TypeCheckSlowPathX86(
+      instruction, cls, locations->GetTemp(0), instruction->GetDexPc());
+  codegen_->AddSlowPath(slow_path);
+
+  // A null reference can be cast to any type.
+  __ testl(obj, obj);
+  __ j(kEqual, slow_path->GetExitLabel());
+  __ movl(temp, Address(obj, class_offset));
+  // Compare the class of `obj` with `cls`.
+  if (cls.IsRegister()) {
+    __ cmpl(temp, cls.As<Register>());
+  } else {
+    DCHECK(cls.IsStackSlot()) << cls;
+    __ cmpl(temp, Address(ESP, cls.GetStackIndex()));
+  }
+  __ j(kNotEqual, slow_path->GetEntryLabel());
+  __ Bind(slow_path->GetExitLabel());
+}
+
 void InstructionCodeGeneratorX86::GenerateSuspendCheck(HSuspendCheck* instruction,
                                                        HBasicBlock* successor) {
   SuspendCheckSlowPathX86* slow_path =
@@ -28,6 +28,7 @@ namespace x86 {
 static constexpr size_t kX86WordSize = 4;
 
 class CodeGeneratorX86;
+class SlowPathCodeX86;
 
 static constexpr Register kParameterCoreRegisters[] = { ECX, EDX, EBX };
 static constexpr RegisterPair kParameterCorePairRegisters[] = { ECX_EDX, EDX_EBX };
@@ -100,6 +101,11 @@ class LocationsBuilderX86 : public HGraphVisitor {
 #undef DECLARE_VISIT_INSTRUCTION
 
   void HandleInvoke(HInvoke* invoke);
+  void HandleBitwiseOperation(HBinaryOperation* instruction);
+  void HandleShift(HBinaryOperation* instruction);
+  void HandleDivRem(HBinaryOperation* instruction);
+  void HandleFieldSet(HInstruction* instruction, Primitive::Type field_type);
+  void HandleFieldGet(HInstruction* instruction);
 
  private:
   CodeGeneratorX86* const codegen_;
@@ -128,6 +134,18 @@ class InstructionCodeGeneratorX86 : public HGraphVisitor {
   // is the block to branch to if the suspend check is not needed, and after
   // the suspend call.
   void GenerateSuspendCheck(HSuspendCheck* check, HBasicBlock* successor);
+  void GenerateClassInitializationCheck(SlowPathCodeX86* slow_path, Register class_reg);
+  void HandleBitwiseOperation(HBinaryOperation* instruction);
+  void HandleShift(HBinaryOperation* instruction);
+  void GenerateLongShift(HBinaryOperation* instruction);
+  void HandleDivRem(HBinaryOperation* instruction);
+  // Instance and static fields share their code: input 0 is the object or
+  // the class holding the field.
+  void HandleFieldSet(HInstruction* instruction, Primitive::Type field_type, uint32_t offset);
+  void HandleFieldGet(HInstruction* instruction, uint32_t offset);
+  // Converts a float or a double to an int with the Java semantics: NaN
+  // gives zero and values out of range saturate.
+  void GenerateFpToInt(XmmRegister input, Register output, Primitive::Type input_type);
 
   X86Assembler* const assembler_;
   CodeGeneratorX86* const codegen_;
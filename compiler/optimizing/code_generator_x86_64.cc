@@ -166,6 +166,181 @@ class BoundsCheckSlowPathX86_64 : public SlowPathCodeX86_64 {
   DISALLOW_COPY_AND_ASSIGN(BoundsCheckSlowPathX86_64);
 };
 
+class DivZeroCheckSlowPathX86_64 : public SlowPathCodeX86_64 {
+ public:
+  explicit DivZeroCheckSlowPathX86_64(HDivZeroCheck* instruction) : instruction_(instruction) {}
+
+  virtual void EmitNativeCode(CodeGenerator* codegen) OVERRIDE {
+    __ Bind(GetEntryLabel());
+    __ gs()->call(
+        Address::Absolute(QUICK_ENTRYPOINT_OFFSET(kX86_64WordSize, pThrowDivZero), true));
+    codegen->RecordPcInfo(instruction_, instruction_->GetDexPc());
+  }
+
+ private:
+  HDivZeroCheck* const instruction_;
+  DISALLOW_COPY_AND_ASSIGN(DivZeroCheckSlowPathX86_64);
+};
+
+class LoadStringSlowPathX86_64 : public SlowPathCodeX86_64 {
+ public:
+  explicit LoadStringSlowPathX86_64(HLoadString* instruction) : instruction_(instruction) {}
+
+  virtual void EmitNativeCode(CodeGenerator* codegen) OVERRIDE {
+    CodeGeneratorX86_64* x64_codegen = down_cast<CodeGeneratorX86_64*>(codegen);
+    LocationSummary* locations = instruction_->GetLocations();
+    __ Bind(GetEntryLabel());
+    codegen->SaveLiveRegisters(locations);
+    InvokeRuntimeCallingConvention calling_convention;
+    __ movl(CpuRegister(calling_convention.GetRegisterAt(0)),
+            Address(CpuRegister(RSP), kCurrentMethodStackOffset));
+    __ movl(CpuRegister(calling_convention.GetRegisterAt(1)),
+            Immediate(instruction_->GetStringIndex()));
+    __ gs()->call(
+        Address::Absolute(QUICK_ENTRYPOINT_OFFSET(kX86_64WordSize, pResolveString), true));
+    codegen->RecordPcInfo(instruction_, instruction_->GetDexPc());
+    x64_codegen->Move(locations->Out(), Location::RegisterLocation(RAX));
+    codegen->RestoreLiveRegisters(locations);
+    __ jmp(GetExitLabel());
+  }
+
+ private:
+  HLoadString* const instruction_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoadStringSlowPathX86_64);
+};
+
+class LoadClassSlowPathX86_64 : public SlowPathCodeX86_64 {
+ public:
+  LoadClassSlowPathX86_64(HLoadClass* cls,
+                          HInstruction* at,
+                          uint32_t dex_pc,
+                          bool do_clinit)
+      : cls_(cls), at_(at), dex_pc_(dex_pc), do_clinit_(do_clinit) {
+    DCHECK(at->IsLoadClass() || at->IsClinitCheck());
+  }
+
+  virtual void EmitNativeCode(CodeGenerator* codegen) OVERRIDE {
+    CodeGeneratorX86_64* x64_codegen = down_cast<CodeGeneratorX86_64*>(codegen);
+    LocationSummary* locations = at_->GetLocations();
+    __ Bind(GetEntryLabel());
+    codegen->SaveLiveRegisters(locations);
+
+    InvokeRuntimeCallingConvention calling_convention;
+    __ movl(CpuRegister(calling_convention.GetRegisterAt(0)), Immediate(cls_->GetTypeIndex()));
+    __ movl(CpuRegister(calling_convention.GetRegisterAt(1)),
+            Address(CpuRegister(RSP), kCurrentMethodStackOffset));
+    if (do_clinit_) {
+      __ gs()->call(Address::Absolute(
+          QUICK_ENTRYPOINT_OFFSET(kX86_64WordSize, pInitializeStaticStorage), true));
+    } else {
+      __ gs()->call(Address::Absolute(
+          QUICK_ENTRYPOINT_OFFSET(kX86_64WordSize, pInitializeType), true));
+    }
+    codegen->RecordPcInfo(at_, dex_pc_);
+
+    // Move the class to the desired location.
+    if (locations->Out().IsValid()) {
+      x64_codegen->Move(locations->Out(), Location::RegisterLocation(RAX));
+    }
+    codegen->RestoreLiveRegisters(locations);
+    __ jmp(GetExitLabel());
+  }
+
+ private:
+  // The class this slow path will load.
+  HLoadClass* const cls_;
+
+  // The instruction where this slow path is happening.
+  // (Might be the load class or an initialization check).
+  HInstruction* const at_;
+
+  // The dex PC of `at_`.
+  const uint32_t dex_pc_;
+
+  // Whether to initialize the class.
+  const bool do_clinit_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoadClassSlowPathX86_64);
+};
+
+// Calls the runtime for the type checks that the inline code cannot decide:
+// instance-of gets the answer in its output, check-cast throws on failure.
+class TypeCheckSlowPathX86_64 : public SlowPathCodeX86_64 {
+ public:
+  TypeCheckSlowPathX86_64(HInstruction* instruction,
+                          Location class_to_check,
+                          Location object_class,
+                          uint32_t dex_pc)
+      : instruction_(instruction),
+        class_to_check_(class_to_check),
+        object_class_(object_class),
+        dex_pc_(dex_pc) {}
+
+  virtual void EmitNativeCode(CodeGenerator* codegen) OVERRIDE {
+    CodeGeneratorX86_64* x64_codegen = down_cast<CodeGeneratorX86_64*>(codegen);
+    LocationSummary* locations = instruction_->GetLocations();
+    __ Bind(GetEntryLabel());
+    codegen->SaveLiveRegisters(locations);
+
+    // The two classes may be in each other's argument register, so move
+    // them with the parallel move resolver.
+    InvokeRuntimeCallingConvention calling_convention;
+    ArenaAllocator* arena = codegen->GetGraph()->GetArena();
+    HParallelMove parallel_move(arena);
+    parallel_move.AddMove(new (arena) MoveOperands(
+        class_to_check_, Location::RegisterLocation(calling_convention.GetRegisterAt(0)), nullptr));
+    parallel_move.AddMove(new (arena) MoveOperands(
+        object_class_, Location::RegisterLocation(calling_convention.GetRegisterAt(1)), nullptr));
+    x64_codegen->GetMoveResolver()->EmitNativeCode(&parallel_move);
+
+    if (instruction_->IsInstanceOf()) {
+      __ gs()->call(Address::Absolute(
+          QUICK_ENTRYPOINT_OFFSET(kX86_64WordSize, pInstanceofNonTrivial), true));
+    } else {
+      DCHECK(instruction_->IsCheckCast());
+      __ gs()->call(
+          Address::Absolute(QUICK_ENTRYPOINT_OFFSET(kX86_64WordSize, pCheckCast), true));
+    }
+    codegen->RecordPcInfo(instruction_, dex_pc_);
+
+    if (instruction_->IsInstanceOf()) {
+      x64_codegen->Move(locations->Out(), Location::RegisterLocation(RAX));
+    }
+    codegen->RestoreLiveRegisters(locations);
+    __ jmp(GetExitLabel());
+  }
+
+ private:
+  HInstruction* const instruction_;
+  const Location class_to_check_;
+  const Location object_class_;
+  const uint32_t dex_pc_;
+
+  DISALLOW_COPY_AND_ASSIGN(TypeCheckSlowPathX86_64);
+};
+
+// Jump table of a packed switch, emitted after the code of the method. Each
+// entry is the offset of the target of a case from the start of the table.
+class PackedSwitchTableX86_64 : public SlowPathCodeX86_64 {
+ public:
+  explicit PackedSwitchTableX86_64(HPackedSwitch* instruction) : instruction_(instruction) {}
+
+  virtual void EmitNativeCode(CodeGenerator* codegen) OVERRIDE {
+    CodeGeneratorX86_64* x64_codegen = down_cast<CodeGeneratorX86_64*>(codegen);
+    __ Align(4, 0);
+    __ Bind(GetEntryLabel());
+    for (uint32_t i = 0, e = instruction_->GetNumEntries(); i < e; ++i) {
+      __ EmitLabelOffset(x64_codegen->GetLabelOf(instruction_->GetCaseSuccessor(i)), GetEntryLabel());
+    }
+  }
+
+ private:
+  HPackedSwitch* const instruction_;
+
+  DISALLOW_COPY_AND_ASSIGN(PackedSwitchTableX86_64);
+};
+
 #undef __
 #define __ reinterpret_cast<X86_64Assembler*>(GetAssembler())->
 
@@ -971,6 +1146,41 @@ void InstructionCodeGeneratorX86_64::VisitInvokeVirtual(HInvokeVirtual* invoke)
   codegen_->RecordPcInfo(invoke, invoke->GetDexPc());
 }
 
+void LocationsBuilderX86_64::VisitInvokeInterface(HInvokeInterface* invoke) {
+  HandleInvoke(invoke);
+  // Add the hidden argument.
+  invoke->GetLocations()->AddTemp(Location::RegisterLocation(RAX));
+}
+
+void InstructionCodeGeneratorX86_64::VisitInvokeInterface(HInvokeInterface* invoke) {
+  CpuRegister temp = invoke->GetLocations()->GetTemp(0).As<CpuRegister>();
+  uint32_t method_offset = mirror::Class::EmbeddedImTableOffset().Uint32Value() +
+          (invoke->GetImtIndex() % mirror::Class::kImtSize) * sizeof(mirror::Class::ImTableEntry);
+  LocationSummary* locations = invoke->GetLocations();
+  Location receiver = locations->InAt(0);
+  size_t class_offset = mirror::Object::ClassOffset().SizeValue();
+
+  // Set the hidden argument, which the IMT conflict trampoline uses to find
+  // the interface method.
+  __ movq(invoke->GetLocations()->GetTemp(1).As<CpuRegister>(),
+          Immediate(invoke->GetDexMethodIndex()));
+
+  // temp = object->GetClass();
+  if (receiver.IsStackSlot()) {
+    __ movl(temp, Address(CpuRegister(RSP), receiver.GetStackIndex()));
+    __ movl(temp, Address(temp, class_offset));
+  } else {
+    __ movl(temp, Address(receiver.As<CpuRegister>(), class_offset));
+  }
+  // temp = temp->GetImtEntryAt(method_offset);
+  __ movl(temp, Address(temp, method_offset));
+  // call temp->GetEntryPoint();
+  __ call(Address(temp, mirror::ArtMethod::EntryPointFromQuickCompiledCodeOffset().SizeValue()));
+
+  DCHECK(!codegen_->IsLeafMethod());
+  codegen_->RecordPcInfo(invoke, invoke->GetDexPc());
+}
+
 void LocationsBuilderX86_64::VisitNeg(HNeg* neg) {
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(neg, LocationSummary::kNoCall);
@@ -1218,6 +1428,258 @@ void InstructionCodeGeneratorX86_64::VisitMul(HMul* mul) {
   }
 }
 
+void LocationsBuilderX86_64::VisitAnd(HAnd* instruction) {
+  HandleBitwiseOperation(instruction);
+}
+
+void InstructionCodeGeneratorX86_64::VisitAnd(HAnd* instruction) {
+  HandleBitwiseOperation(instruction);
+}
+
+void LocationsBuilderX86_64::VisitOr(HOr* instruction) {
+  HandleBitwiseOperation(instruction);
+}
+
+void InstructionCodeGeneratorX86_64::VisitOr(HOr* instruction) {
+  HandleBitwiseOperation(instruction);
+}
+
+void LocationsBuilderX86_64::VisitXor(HXor* instruction) {
+  HandleBitwiseOperation(instruction);
+}
+
+void InstructionCodeGeneratorX86_64::VisitXor(HXor* instruction) {
+  HandleBitwiseOperation(instruction);
+}
+
+void LocationsBuilderX86_64::HandleBitwiseOperation(HBinaryOperation* instruction) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
+  locations->SetInAt(0, Location::RequiresRegister());
+  if (instruction->GetResultType() == Primitive::kPrimInt) {
+    locations->SetInAt(1, Location::Any());
+  } else {
+    DCHECK_EQ(instruction->GetResultType(), Primitive::kPrimLong);
+    locations->SetInAt(1, Location::RequiresRegister());
+  }
+  locations->SetOut(Location::SameAsFirstInput());
+}
+
+void InstructionCodeGeneratorX86_64::HandleBitwiseOperation(HBinaryOperation* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  Location first = locations->InAt(0);
+  Location second = locations->InAt(1);
+  DCHECK(first.Equals(locations->Out()));
+
+  if (instruction->GetResultType() == Primitive::kPrimInt) {
+    if (second.IsRegister()) {
+      if (instruction->IsAnd()) {
+        __ andl(first.As<CpuRegister>(), second.As<CpuRegister>());
+      } else if (instruction->IsOr()) {
+        __ orl(first.As<CpuRegister>(), second.As<CpuRegister>());
+      } else {
+        DCHECK(instruction->IsXor());
+        __ xorl(first.As<CpuRegister>(), second.As<CpuRegister>());
+      }
+    } else if (second.IsConstant()) {
+      Immediate imm(second.GetConstant()->AsIntConstant()->GetValue());
+      if (instruction->IsAnd()) {
+        __ andl(first.As<CpuRegister>(), imm);
+      } else if (instruction->IsOr()) {
+        __ orl(first.As<CpuRegister>(), imm);
+      } else {
+        DCHECK(instruction->IsXor());
+        __ xorl(first.As<CpuRegister>(), imm);
+      }
+    } else {
+      Address address(CpuRegister(RSP), second.GetStackIndex());
+      if (instruction->IsAnd()) {
+        __ andl(first.As<CpuRegister>(), address);
+      } else if (instruction->IsOr()) {
+        __ orl(first.As<CpuRegister>(), address);
+      } else {
+        DCHECK(instruction->IsXor());
+        __ xorl(first.As<CpuRegister>(), address);
+      }
+    }
+  } else {
+    DCHECK_EQ(instruction->GetResultType(), Primitive::kPrimLong);
+    if (instruction->IsAnd()) {
+      __ andq(first.As<CpuRegister>(), second.As<CpuRegister>());
+    } else if (instruction->IsOr()) {
+      __ orq(first.As<CpuRegister>(), second.As<CpuRegister>());
+    } else {
+      DCHECK(instruction->IsXor());
+      __ xorq(first.As<CpuRegister>(), second.As<CpuRegister>());
+    }
+  }
+}
+
+
+void LocationsBuilderX86_64::VisitShl(HShl* instruction) {
+  HandleShift(instruction);
+}
+
+void InstructionCodeGeneratorX86_64::VisitShl(HShl* instruction) {
+  HandleShift(instruction);
+}
+
+void LocationsBuilderX86_64::VisitShr(HShr* instruction) {
+  HandleShift(instruction);
+}
+
+void InstructionCodeGeneratorX86_64::VisitShr(HShr* instruction) {
+  HandleShift(instruction);
+}
+
+void LocationsBuilderX86_64::VisitUShr(HUShr* instruction) {
+  HandleShift(instruction);
+}
+
+void InstructionCodeGeneratorX86_64::VisitUShr(HUShr* instruction) {
+  HandleShift(instruction);
+}
+
+void LocationsBuilderX86_64::HandleShift(HBinaryOperation* instruction) {
+  DCHECK(instruction->GetResultType() == Primitive::kPrimInt
+         || instruction->GetResultType() == Primitive::kPrimLong);
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
+  locations->SetInAt(0, Location::RequiresRegister());
+  // A variable shift distance must be in CL.
+  locations->SetInAt(1, Location::ByteRegisterOrConstant(RCX, instruction->InputAt(1)));
+  locations->SetOut(Location::SameAsFirstInput());
+}
+
+void InstructionCodeGeneratorX86_64::HandleShift(HBinaryOperation* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  CpuRegister first = locations->InAt(0).As<CpuRegister>();
+  Location second = locations->InAt(1);
+  DCHECK(locations->InAt(0).Equals(locations->Out()));
+  bool is_long = instruction->GetResultType() == Primitive::kPrimLong;
+
+  if (second.IsRegister()) {
+    // The processor only uses the low 5 bits of CL for an int, and the low
+    // 6 bits for a long, as Java does.
+    CpuRegister shifter = second.As<CpuRegister>();
+    DCHECK_EQ(RCX, shifter.AsRegister());
+    if (instruction->IsShl()) {
+      if (is_long) {
+        __ shlq(first, shifter);
+      } else {
+        __ shll(first, shifter);
+      }
+    } else if (instruction->IsShr()) {
+      if (is_long) {
+        __ sarq(first, shifter);
+      } else {
+        __ sarl(first, shifter);
+      }
+    } else {
+      DCHECK(instruction->IsUShr());
+      if (is_long) {
+        __ shrq(first, shifter);
+      } else {
+        __ shrl(first, shifter);
+      }
+    }
+  } else {
+    int32_t value = second.GetConstant()->AsIntConstant()->GetValue();
+    Immediate imm(value & (is_long ? kMaxLongShiftValue : kMaxIntShiftValue));
+    if (instruction->IsShl()) {
+      if (is_long) {
+        __ shlq(first, imm);
+      } else {
+        __ shll(first, imm);
+      }
+    } else if (instruction->IsShr()) {
+      if (is_long) {
+        __ sarq(first, imm);
+      } else {
+        __ sarl(first, imm);
+      }
+    } else {
+      DCHECK(instruction->IsUShr());
+      if (is_long) {
+        __ shrq(first, imm);
+      } else {
+        __ shrl(first, imm);
+      }
+    }
+  }
+}
+
+void LocationsBuilderX86_64::VisitDiv(HDiv* instruction) {
+  HandleDivRem(instruction);
+}
+
+void InstructionCodeGeneratorX86_64::VisitDiv(HDiv* instruction) {
+  HandleDivRem(instruction);
+}
+
+void LocationsBuilderX86_64::VisitRem(HRem* instruction) {
+  HandleDivRem(instruction);
+}
+
+void InstructionCodeGeneratorX86_64::VisitRem(HRem* instruction) {
+  HandleDivRem(instruction);
+}
+
+void LocationsBuilderX86_64::HandleDivRem(HBinaryOperation* instruction) {
+  DCHECK(instruction->GetResultType() == Primitive::kPrimInt
+         || instruction->GetResultType() == Primitive::kPrimLong);
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
+  // idivl and idivq divide RDX:RAX, and leave the quotient in RAX and the
+  // remainder in RDX.
+  locations->SetInAt(0, Location::RegisterLocation(RAX));
+  locations->SetInAt(1, Location::RequiresRegister());
+  if (instruction->IsDiv()) {
+    locations->SetOut(Location::RegisterLocation(RAX));
+    locations->AddTemp(Location::RegisterLocation(RDX));
+  } else {
+    locations->SetOut(Location::RegisterLocation(RDX));
+  }
+}
+
+void InstructionCodeGeneratorX86_64::HandleDivRem(HBinaryOperation* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  CpuRegister second = locations->InAt(1).As<CpuRegister>();
+  DCHECK_EQ(RAX, locations->InAt(0).As<CpuRegister>().AsRegister());
+
+  bool is_long = instruction->GetResultType() == Primitive::kPrimLong;
+
+  // The division of the smallest integer by -1 overflows and traps, so
+  // handle a divisor of -1 separately: the quotient is the negated dividend
+  // and the remainder is zero.
+  Label minus_one, done;
+  if (is_long) {
+    __ cmpq(second, Immediate(-1));
+  } else {
+    __ cmpl(second, Immediate(-1));
+  }
+  __ j(kEqual, &minus_one);
+  if (is_long) {
+    __ cqo();
+    __ idivq(second);
+  } else {
+    __ cdq();
+    __ idivl(second);
+  }
+  __ jmp(&done);
+  __ Bind(&minus_one);
+  if (instruction->IsDiv()) {
+    if (is_long) {
+      __ negq(CpuRegister(RAX));
+    } else {
+      __ negl(CpuRegister(RAX));
+    }
+  } else {
+    __ xorl(CpuRegister(RDX), CpuRegister(RDX));
+  }
+  __ Bind(&done);
+}
+
 void LocationsBuilderX86_64::VisitNewInstance(HNewInstance* instruction) {
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCall);
@@ -1320,10 +1782,10 @@ void InstructionCodeGeneratorX86_64::VisitPhi(HPhi* instruction) {
   LOG(FATAL) << "Unimplemented";
 }
 
-void LocationsBuilderX86_64::VisitInstanceFieldSet(HInstanceFieldSet* instruction) {
+void LocationsBuilderX86_64::HandleFieldSet(HInstruction* instruction,
+                                            Primitive::Type field_type) {
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
-  Primitive::Type field_type = instruction->GetFieldType();
   bool is_object_type = field_type == Primitive::kPrimNot;
   locations->SetInAt(0, Location::RequiresRegister());
   locations->SetInAt(1, Location::RequiresRegister());
@@ -1334,12 +1796,12 @@ void LocationsBuilderX86_64::VisitInstanceFieldSet(HInstanceFieldSet* instructio
   }
 }
 
-void InstructionCodeGeneratorX86_64::VisitInstanceFieldSet(HInstanceFieldSet* instruction) {
+void InstructionCodeGeneratorX86_64::HandleFieldSet(HInstruction* instruction,
+                                                    Primitive::Type field_type,
+                                                    uint32_t offset) {
   LocationSummary* locations = instruction->GetLocations();
   CpuRegister obj = locations->InAt(0).As<CpuRegister>();
   CpuRegister value = locations->InAt(1).As<CpuRegister>();
-  size_t offset = instruction->GetFieldOffset().SizeValue();
-  Primitive::Type field_type = instruction->GetFieldType();
 
   switch (field_type) {
     case Primitive::kPrimBoolean:
@@ -1380,18 +1842,17 @@ void InstructionCodeGeneratorX86_64::VisitInstanceFieldSet(HInstanceFieldSet* in
   }
 }
 
-void LocationsBuilderX86_64::VisitInstanceFieldGet(HInstanceFieldGet* instruction) {
+void LocationsBuilderX86_64::HandleFieldGet(HInstruction* instruction) {
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
   locations->SetInAt(0, Location::RequiresRegister());
   locations->SetOut(Location::RequiresRegister(), Location::kNoOutputOverlap);
 }
 
-void InstructionCodeGeneratorX86_64::VisitInstanceFieldGet(HInstanceFieldGet* instruction) {
+void InstructionCodeGeneratorX86_64::HandleFieldGet(HInstruction* instruction, uint32_t offset) {
   LocationSummary* locations = instruction->GetLocations();
   CpuRegister obj = locations->InAt(0).As<CpuRegister>();
   CpuRegister out = locations->Out().As<CpuRegister>();
-  size_t offset = instruction->GetFieldOffset().SizeValue();
 
   switch (instruction->GetType()) {
     case Primitive::kPrimBoolean: {
@@ -1435,6 +1896,42 @@ void InstructionCodeGeneratorX86_64::VisitInstanceFieldGet(HInstanceFieldGet* in
   }
 }
 
+void LocationsBuilderX86_64::VisitInstanceFieldSet(HInstanceFieldSet* instruction) {
+  HandleFieldSet(instruction, instruction->GetFieldType());
+}
+
+void InstructionCodeGeneratorX86_64::VisitInstanceFieldSet(HInstanceFieldSet* instruction) {
+  HandleFieldSet(instruction,
+                 instruction->GetFieldType(),
+                 instruction->GetFieldOffset().Uint32Value());
+}
+
+void LocationsBuilderX86_64::VisitInstanceFieldGet(HInstanceFieldGet* instruction) {
+  HandleFieldGet(instruction);
+}
+
+void InstructionCodeGeneratorX86_64::VisitInstanceFieldGet(HInstanceFieldGet* instruction) {
+  HandleFieldGet(instruction, instruction->GetFieldOffset().Uint32Value());
+}
+
+void LocationsBuilderX86_64::VisitStaticFieldSet(HStaticFieldSet* instruction) {
+  HandleFieldSet(instruction, instruction->GetFieldType());
+}
+
+void InstructionCodeGeneratorX86_64::VisitStaticFieldSet(HStaticFieldSet* instruction) {
+  HandleFieldSet(instruction,
+                 instruction->GetFieldType(),
+                 instruction->GetFieldOffset().Uint32Value());
+}
+
+void LocationsBuilderX86_64::VisitStaticFieldGet(HStaticFieldGet* instruction) {
+  HandleFieldGet(instruction);
+}
+
+void InstructionCodeGeneratorX86_64::VisitStaticFieldGet(HStaticFieldGet* instruction) {
+  HandleFieldGet(instruction, instruction->GetFieldOffset().Uint32Value());
+}
+
 void LocationsBuilderX86_64::VisitNullCheck(HNullCheck* instruction) {
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
@@ -1824,6 +2321,427 @@ void InstructionCodeGeneratorX86_64::VisitSuspendCheck(HSuspendCheck* instructio
   GenerateSuspendCheck(instruction, nullptr);
 }
 
+void LocationsBuilderX86_64::VisitLoadException(HLoadException* load) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(load, LocationSummary::kNoCall);
+  locations->SetOut(Location::RequiresRegister());
+}
+
+void InstructionCodeGeneratorX86_64::VisitLoadException(HLoadException* load) {
+  Address address = Address::Absolute(Thread::ExceptionOffset<kX86_64WordSize>(), true);
+  __ gs()->movl(load->GetLocations()->Out().As<CpuRegister>(), address);
+  __ gs()->movl(address, Immediate(0));
+}
+
+void LocationsBuilderX86_64::VisitPackedSwitch(HPackedSwitch* switch_instr) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(switch_instr, LocationSummary::kNoCall);
+  locations->SetInAt(0, Location::RequiresRegister());
+  if (switch_instr->GetNumEntries() > kPackedSwitchJumpTableThreshold) {
+    locations->AddTemp(Location::RequiresRegister());
+    locations->AddTemp(Location::RequiresRegister());
+  }
+}
+
+void InstructionCodeGeneratorX86_64::VisitPackedSwitch(HPackedSwitch* switch_instr) {
+  int32_t start_value = switch_instr->GetStartValue();
+  uint32_t num_entries = switch_instr->GetNumEntries();
+  LocationSummary* locations = switch_instr->GetLocations();
+  CpuRegister value = locations->InAt(0).As<CpuRegister>();
+  HBasicBlock* default_block = switch_instr->GetDefaultBlock();
+
+  if (num_entries <= kPackedSwitchJumpTableThreshold) {
+    for (uint32_t i = 0; i < num_entries; ++i) {
+      int32_t case_value = static_cast<int32_t>(static_cast<uint32_t>(start_value) + i);
+      __ cmpl(value, Immediate(case_value));
+      __ j(kEqual, codegen_->GetLabelOf(switch_instr->GetCaseSuccessor(i)));
+    }
+    if (!codegen_->GoesToNextBlock(switch_instr->GetBlock(), default_block)) {
+      __ jmp(codegen_->GetLabelOf(default_block));
+    }
+    return;
+  }
+
+  CpuRegister index = locations->GetTemp(0).As<CpuRegister>();
+  CpuRegister base = locations->GetTemp(1).As<CpuRegister>();
+  // Values out of the range of the cases give an unsigned index above the last entry.
+  __ movl(index, value);
+  if (start_value != 0) {
+    __ subl(index, Immediate(start_value));
+  }
+  __ cmpl(index, Immediate(num_entries - 1));
+  __ j(kAbove, codegen_->GetLabelOf(default_block));
+
+  PackedSwitchTableX86_64* table =
+      new (GetGraph()->GetArena()) PackedSwitchTableX86_64(switch_instr);
+  codegen_->AddSlowPath(table);
+  __ leaq(base, table->GetEntryLabel());
+  __ movsxd(index, Address(base, index, TIMES_4, 0));
+  __ addq(base, index);
+  __ jmp(base);
+}
+
+void LocationsBuilderX86_64::VisitThrow(HThrow* instruction) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCall);
+  InvokeRuntimeCallingConvention calling_convention;
+  locations->SetInAt(0, Location::RegisterLocation(calling_convention.GetRegisterAt(0)));
+}
+
+void InstructionCodeGeneratorX86_64::VisitThrow(HThrow* instruction) {
+  __ gs()->call(
+      Address::Absolute(QUICK_ENTRYPOINT_OFFSET(kX86_64WordSize, pDeliverException), true));
+  codegen_->RecordPcInfo(instruction, instruction->GetDexPc());
+}
+
+void LocationsBuilderX86_64::VisitDivZeroCheck(HDivZeroCheck* instruction) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
+  locations->SetInAt(0, Location::Any());
+  if (instruction->HasUses()) {
+    locations->SetOut(Location::SameAsFirstInput());
+  }
+}
+
+void InstructionCodeGeneratorX86_64::VisitDivZeroCheck(HDivZeroCheck* instruction) {
+  SlowPathCodeX86_64* slow_path =
+      new (GetGraph()->GetArena()) DivZeroCheckSlowPathX86_64(instruction);
+  codegen_->AddSlowPath(slow_path);
+
+  Location value = instruction->GetLocations()->InAt(0);
+  bool is_long = instruction->GetType() == Primitive::kPrimLong;
+  if (value.IsRegister()) {
+    if (is_long) {
+      __ testq(value.As<CpuRegister>(), value.As<CpuRegister>());
+    } else {
+      __ testl(value.As<CpuRegister>(), value.As<CpuRegister>());
+    }
+  } else if (value.IsStackSlot()) {
+    __ cmpl(Address(CpuRegister(RSP), value.GetStackIndex()), Immediate(0));
+  } else if (value.IsDoubleStackSlot()) {
+    __ cmpq(Address(CpuRegister(RSP), value.GetStackIndex()), Immediate(0));
+  } else {
+    DCHECK(value.IsConstant()) << value;
+    HConstant* constant = value.GetConstant();
+    bool is_zero = constant->IsIntConstant()
+        ? (constant->AsIntConstant()->GetValue() == 0)
+        : (constant->AsLongConstant()->GetValue() == 0);
+    if (is_zero) {
+      __ jmp(slow_path->GetEntryLabel());
+    }
+    return;
+  }
+  __ j(kEqual, slow_path->GetEntryLabel());
+}
+
+void LocationsBuilderX86_64::VisitTypeConversion(HTypeConversion* conversion) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(conversion, LocationSummary::kNoCall);
+  Primitive::Type input_type = conversion->GetInputType();
+  Primitive::Type result_type = conversion->GetResultType();
+  bool is_fp_input =
+      (input_type == Primitive::kPrimFloat) || (input_type == Primitive::kPrimDouble);
+  if (is_fp_input) {
+    locations->SetInAt(0, Location::RequiresFpuRegister());
+  } else {
+    locations->SetInAt(0, Location::RequiresRegister());
+  }
+  if (result_type == Primitive::kPrimFloat || result_type == Primitive::kPrimDouble) {
+    locations->SetOut(Location::RequiresFpuRegister(), Location::kNoOutputOverlap);
+  } else if (is_fp_input && result_type == Primitive::kPrimLong) {
+    // The temporary holds the sign of the input when saturating. The output
+    // overlaps so that it does not share the temporary's register.
+    locations->SetOut(Location::RequiresRegister());
+    locations->AddTemp(Location::RequiresRegister());
+  } else {
+    locations->SetOut(Location::RequiresRegister(), Location::kNoOutputOverlap);
+  }
+}
+
+void InstructionCodeGeneratorX86_64::VisitTypeConversion(HTypeConversion* conversion) {
+  LocationSummary* locations = conversion->GetLocations();
+  Location out = locations->Out();
+  Location in = locations->InAt(0);
+  Primitive::Type input_type = conversion->GetInputType();
+  switch (conversion->GetResultType()) {
+    case Primitive::kPrimLong:
+      if (input_type == Primitive::kPrimFloat || input_type == Primitive::kPrimDouble) {
+        GenerateFpToInt(conversion);
+        break;
+      }
+      DCHECK_EQ(input_type, Primitive::kPrimInt);
+      __ movsxd(out.As<CpuRegister>(), in.As<CpuRegister>());
+      break;
+
+    case Primitive::kPrimInt:
+      if (input_type == Primitive::kPrimFloat || input_type == Primitive::kPrimDouble) {
+        GenerateFpToInt(conversion);
+        break;
+      }
+      DCHECK_EQ(input_type, Primitive::kPrimLong);
+      __ movl(out.As<CpuRegister>(), in.As<CpuRegister>());
+      break;
+
+    case Primitive::kPrimFloat:
+    case Primitive::kPrimDouble: {
+      XmmRegister result = out.As<XmmRegister>();
+      bool is_float = conversion->GetResultType() == Primitive::kPrimFloat;
+      if (input_type == Primitive::kPrimInt || input_type == Primitive::kPrimLong) {
+        bool is_long = input_type == Primitive::kPrimLong;
+        if (is_float) {
+          __ cvtsi2ss(result, in.As<CpuRegister>(), is_long);
+        } else {
+          __ cvtsi2sd(result, in.As<CpuRegister>(), is_long);
+        }
+      } else if (is_float) {
+        DCHECK_EQ(input_type, Primitive::kPrimDouble);
+        __ cvtsd2ss(result, in.As<XmmRegister>());
+      } else {
+        DCHECK_EQ(input_type, Primitive::kPrimFloat);
+        __ cvtss2sd(result, in.As<XmmRegister>());
+      }
+      break;
+    }
+
+    case Primitive::kPrimByte:
+      __ movsxb(out.As<CpuRegister>(), in.As<CpuRegister>());
+      break;
+
+    case Primitive::kPrimShort:
+      __ movsxw(out.As<CpuRegister>(), in.As<CpuRegister>());
+      break;
+
+    case Primitive::kPrimChar:
+      __ movzxw(out.As<CpuRegister>(), in.As<CpuRegister>());
+      break;
+
+    default:
+      LOG(FATAL) << "Unexpected type conversion from " << conversion->GetInputType()
+                 << " to " << conversion->GetResultType();
+  }
+}
+
+void InstructionCodeGeneratorX86_64::GenerateFpToInt(HTypeConversion* conversion) {
+  LocationSummary* locations = conversion->GetLocations();
+  XmmRegister input = locations->InAt(0).As<XmmRegister>();
+  CpuRegister output = locations->Out().As<CpuRegister>();
+  bool is_float = conversion->GetInputType() == Primitive::kPrimFloat;
+  bool is_long = conversion->GetResultType() == Primitive::kPrimLong;
+  Label done, nan;
+  // The truncation returns the smallest integer for NaN and for values out
+  // of range, which is only right for the negative ones.
+  if (is_float) {
+    __ cvttss2si(output, input, is_long);
+  } else {
+    __ cvttsd2si(output, input, is_long);
+  }
+  if (is_long) {
+    // Only the smallest long overflows when decremented.
+    __ cmpq(output, Immediate(1));
+    __ j(kNoOverflow, &done);
+  } else {
+    __ cmpl(output, Immediate(std::numeric_limits<int32_t>::min()));
+    __ j(kNotEqual, &done);
+  }
+  if (is_float) {
+    __ comiss(input, input);
+  } else {
+    __ comisd(input, input);
+  }
+  __ j(kParityEven, &nan);
+  // Saturate: the largest value plus the sign bit of the input wraps to the
+  // smallest value for negative inputs.
+  CpuRegister sign = is_long ? locations->GetTemp(0).As<CpuRegister>() : output;
+  if (is_float) {
+    __ movmskps(sign, input);
+  } else {
+    __ movmskpd(sign, input);
+  }
+  __ andl(sign, Immediate(1));
+  if (is_long) {
+    __ subq(output, Immediate(1));
+    __ addq(output, sign);
+  } else {
+    __ addl(output, Immediate(std::numeric_limits<int32_t>::max()));
+  }
+  __ jmp(&done);
+  __ Bind(&nan);
+  __ xorl(output, output);
+  __ Bind(&done);
+}
+
+void LocationsBuilderX86_64::VisitMonitorOperation(HMonitorOperation* instruction) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCall);
+  InvokeRuntimeCallingConvention calling_convention;
+  locations->SetInAt(0, Location::RegisterLocation(calling_convention.GetRegisterAt(0)));
+}
+
+void InstructionCodeGeneratorX86_64::VisitMonitorOperation(HMonitorOperation* instruction) {
+  if (instruction->IsEnter()) {
+    __ gs()->call(
+        Address::Absolute(QUICK_ENTRYPOINT_OFFSET(kX86_64WordSize, pLockObject), true));
+  } else {
+    __ gs()->call(
+        Address::Absolute(QUICK_ENTRYPOINT_OFFSET(kX86_64WordSize, pUnlockObject), true));
+  }
+  codegen_->RecordPcInfo(instruction, instruction->GetDexPc());
+}
+
+void LocationsBuilderX86_64::VisitLoadString(HLoadString* load) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(load, LocationSummary::kCallOnSlowPath);
+  locations->SetOut(Location::RequiresRegister());
+}
+
+void InstructionCodeGeneratorX86_64::VisitLoadString(HLoadString* load) {
+  SlowPathCodeX86_64* slow_path = new (GetGraph()->GetArena()) LoadStringSlowPathX86_64(load);
+  codegen_->AddSlowPath(slow_path);
+
+  CpuRegister out = load->GetLocations()->Out().As<CpuRegister>();
+  uint32_t heap_reference_size = sizeof(mirror::HeapReference<mirror::Object>);
+  size_t index_in_cache = mirror::Array::DataOffset(heap_reference_size).Int32Value() +
+      load->GetStringIndex() * heap_reference_size;
+  LoadCurrentMethod(out);
+  __ movl(out, Address(out, mirror::ArtMethod::DexCacheStringsOffset().Int32Value()));
+  __ movl(out, Address(out, index_in_cache));
+  __ testl(out, out);
+  __ j(kEqual, slow_path->GetEntryLabel());
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void LocationsBuilderX86_64::VisitLoadClass(HLoadClass* cls) {
+  LocationSummary::CallKind call_kind = cls->CanThrow()
+      ? LocationSummary::kCallOnSlowPath
+      : LocationSummary::kNoCall;
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(cls, call_kind);
+  locations->SetOut(Location::RequiresRegister());
+}
+
+void InstructionCodeGeneratorX86_64::VisitLoadClass(HLoadClass* cls) {
+  CpuRegister out = cls->GetLocations()->Out().As<CpuRegister>();
+  if (cls->IsReferrersClass()) {
+    LoadCurrentMethod(out);
+    __ movl(out, Address(out, mirror::ArtMethod::DeclaringClassOffset().Int32Value()));
+  } else {
+    uint32_t heap_reference_size = sizeof(mirror::HeapReference<mirror::Object>);
+    size_t index_in_cache = mirror::Array::DataOffset(heap_reference_size).Int32Value() +
+        cls->GetTypeIndex() * heap_reference_size;
+    LoadCurrentMethod(out);
+    __ movl(out, Address(out, mirror::ArtMethod::DexCacheResolvedTypesOffset().Int32Value()));
+    __ movl(out, Address(out, index_in_cache));
+    SlowPathCodeX86_64* slow_path = new (GetGraph()->GetArena()) LoadClassSlowPathX86_64(
+        cls, cls, cls->GetDexPc(), false);
+    codegen_->AddSlowPath(slow_path);
+    __ testl(out, out);
+    __ j(kEqual, slow_path->GetEntryLabel());
+    __ Bind(slow_path->GetExitLabel());
+  }
+}
+
+void LocationsBuilderX86_64::VisitClinitCheck(HClinitCheck* check) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(check, LocationSummary::kCallOnSlowPath);
+  locations->SetInAt(0, Location::RequiresRegister());
+  if (check->HasUses()) {
+    locations->SetOut(Location::SameAsFirstInput());
+  }
+}
+
+void InstructionCodeGeneratorX86_64::VisitClinitCheck(HClinitCheck* check) {
+  // We assume the class is not null.
+  SlowPathCodeX86_64* slow_path = new (GetGraph()->GetArena()) LoadClassSlowPathX86_64(
+      check->GetLoadClass(), check, check->GetDexPc(), true);
+  codegen_->AddSlowPath(slow_path);
+  GenerateClassInitializationCheck(slow_path, check->GetLocations()->InAt(0).As<CpuRegister>());
+}
+
+void InstructionCodeGeneratorX86_64::GenerateClassInitializationCheck(
+    SlowPathCodeX86_64* slow_path, CpuRegister class_reg) {
+  __ cmpl(Address(class_reg, mirror::Class::StatusOffset().Int32Value()),
+          Immediate(mirror::Class::kStatusInitialized));
+  __ j(kLess, slow_path->GetEntryLabel());
+  __ Bind(slow_path->GetExitLabel());
+  // No need for memory fence, thanks to the X86_64 memory model.
+}
+
+void LocationsBuilderX86_64::VisitInstanceOf(HInstanceOf* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(
+      instruction, LocationSummary::kCallOnSlowPath);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::Any());
+  // The output holds the class of the object while the class to check is
+  // still needed, so they must not share a register.
+  locations->SetOut(Location::RequiresRegister());
+}
+
+void InstructionCodeGeneratorX86_64::VisitInstanceOf(HInstanceOf* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  CpuRegister obj = locations->InAt(0).As<CpuRegister>();
+  Location cls = locations->InAt(1);
+  CpuRegister out = locations->Out().As<CpuRegister>();
+  uint32_t class_offset = mirror::Object::ClassOffset().Int32Value();
+  Label done, zero;
+
+  // Return 0 if `obj` is null.
+  __ testl(obj, obj);
+  __ j(kEqual, &zero);
+  __ movl(out, Address(obj, class_offset));
+  // Compare the class of `obj` with `cls`.
+  if (cls.IsRegister()) {
+    __ cmpl(out, cls.As<CpuRegister>());
+  } else {
+    DCHECK(cls.IsStackSlot()) << cls;
+    __ cmpl(out, Address(CpuRegister(RSP), cls.GetStackIndex()));
+  }
+  // If the classes are not equal, go into the slow path, which also handles
+  // the subclasses and interfaces.
+  SlowPathCodeX86_64* slow_path = new (GetGraph()->GetArena()) TypeCheckSlowPathX86_64(
+      instruction, cls, locations->Out(), instruction->GetDexPc());
+  codegen_->AddSlowPath(slow_path);
+  __ j(kNotEqual, slow_path->GetEntryLabel());
+  __ movl(out, Immediate(1));
+  __ jmp(&done);
+  __ Bind(&zero);
+  __ movl(out, Immediate(0));
+  __ Bind(slow_path->GetExitLabel());
+  __ Bind(&done);
+}
+
+void LocationsBuilderX86_64::VisitCheckCast(HCheckCast* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(
+      instruction, LocationSummary::kCallOnSlowPath);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::Any());
+  locations->AddTemp(Location::RequiresRegister());
+}
+
+void InstructionCodeGeneratorX86_64::VisitCheckCast(HCheckCast* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  CpuRegister obj = locations->InAt(0).As<CpuRegister>();
+  Location cls = locations->InAt(1);
+  CpuRegister temp = locations->GetTemp(0).As<CpuRegister>();
+  uint32_t class_offset = mirror::Object::ClassOffset().Int32Value();
+  SlowPathCodeX86_64* slow_path = new (GetGraph()->GetArena()) TypeCheckSlowPathX86_64(
+      instruction, cls, locations->GetTemp(0), instruction->GetDexPc());
+  codegen_->AddSlowPath(slow_path);
+
+  // A null reference can be cast to any type.
+  __ testl(obj, obj);
+  __ j(kEqual, slow_path->GetExitLabel());
+  __ movl(temp, Address(obj, class_offset));
+  // Compare the class of `obj` with `cls`.
+  if (cls.IsRegister()) {
+    __ cmpl(temp, cls.As<CpuRegister>());
+  } else {
+    DCHECK(cls.IsStackSlot()) << cls;
+    __ cmpl(temp, Address(CpuRegister(RSP), cls.GetStackIndex()));
+  }
+  __ j(kNotEqual, slow_path->GetEntryLabel());
+  __ Bind(slow_path->GetExitLabel());
+}
+
 void InstructionCodeGeneratorX86_64::GenerateSuspendCheck(HSuspendCheck* instruction,
                                                           HBasicBlock* successor) {
   SuspendCheckSlowPathX86_64* slow_path =
@@ -65,6 +65,7 @@ class InvokeDexCallingConventionVisitor {
 };
 
 class CodeGeneratorX86_64;
+class SlowPathCodeX86_64;
 
 class ParallelMoveResolverX86_64 : public ParallelMoveResolver {
  public:
@@ -104,6 +105,11 @@ class LocationsBuilderX86_64 : public HGraphVisitor {
 #undef DECLARE_VISIT_INSTRUCTION
 
   void HandleInvoke(HInvoke* invoke);
+  void HandleBitwiseOperation(HBinaryOperation* instruction);
+  void HandleShift(HBinaryOperation* instruction);
+  void HandleDivRem(HBinaryOperation* instruction);
+  void HandleFieldSet(HInstruction* instruction, Primitive::Type field_type);
+  void HandleFieldGet(HInstruction* instruction);
 
  private:
   CodeGeneratorX86_64* const codegen_;
@@ -132,6 +138,17 @@ class InstructionCodeGeneratorX86_64 : public HGraphVisitor {
   // is the block to branch to if the suspend check is not needed, and after
   // the suspend call.
   void GenerateSuspendCheck(HSuspendCheck* instruction, HBasicBlock* successor);
+  void GenerateClassInitializationCheck(SlowPathCodeX86_64* slow_path, CpuRegister class_reg);
+  void HandleBitwiseOperation(HBinaryOperation* instruction);
+  void HandleShift(HBinaryOperation* instruction);
+  void HandleDivRem(HBinaryOperation* instruction);
+  // Instance and static fields share their code: input 0 is the object or
+  // the class holding the field.
+  void HandleFieldSet(HInstruction* instruction, Primitive::Type field_type, uint32_t offset);
+  void HandleFieldGet(HInstruction* instruction, uint32_t offset);
+  // Converts a float or a double to an int or a long with the Java
+  // semantics: NaN gives zero and values out of range saturate.
+  void GenerateFpToInt(HTypeConversion* conversion);
 
   X86_64Assembler* const assembler_;
   CodeGeneratorX86_64* const codegen_;
@@ -15,6 +15,7 @@
  */
 
 #include <functional>
+#include <limits>
 
 #include "base/macros.h"
 #include "builder.h"
@@ -26,6 +27,7 @@
 #include "dex_file.h"
 #include "dex_instruction.h"
 #include "instruction_set.h"
+#include "mapping_table.h"
 #include "nodes.h"
 #include "optimizing_unit_test.h"
 #include "prepare_for_register_allocation.h"
@@ -434,6 +436,154 @@ TEST(CodegenTest, ReturnMulIntLit16) {
   TestCode(data, true, 12);
 }
 
+#define BITWISE_TEST(OPCODE, TYPE, TEST_NAME, EXPECTED)         \
+  TEST(CodegenTest, Return ## TEST_NAME) {                      \
+    const uint16_t data[] = TWO_REGISTERS_CODE_ITEM(            \
+      Instruction::CONST_4 | 3 << 12 | 0,                       \
+      Instruction::CONST_4 | 5 << 12 | 1 << 8,                  \
+      Instruction::OPCODE ## _ ## TYPE, 1 << 8 | 0,             \
+      Instruction::RETURN);                                     \
+                                                                \
+    TestCode(data, true, EXPECTED);                             \
+  }                                                             \
+                                                                \
+  TEST(CodegenTest, Return ## TEST_NAME ## 2addr) {             \
+    const uint16_t data[] = TWO_REGISTERS_CODE_ITEM(            \
+      Instruction::CONST_4 | 3 << 12 | 0,                       \
+      Instruction::CONST_4 | 5 << 12 | 1 << 8,                  \
+      Instruction::OPCODE ## _ ## TYPE ## _2ADDR | 1 << 12,     \
+      Instruction::RETURN);                                     \
+                                                                \
+    TestCode(data, true, EXPECTED);                             \
+  }
+
+BITWISE_TEST(AND, INT, AndInt, 1)
+BITWISE_TEST(AND, LONG, AndLong, 1)
+BITWISE_TEST(OR, INT, OrInt, 7)
+BITWISE_TEST(OR, LONG, OrLong, 7)
+BITWISE_TEST(XOR, INT, XorInt, 6)
+BITWISE_TEST(XOR, LONG, XorLong, 6)
+
+#undef BITWISE_TEST
+
+TEST(CodegenTest, ReturnBitwiseIntLit8) {
+  const uint16_t data[] = ONE_REGISTER_CODE_ITEM(
+    Instruction::CONST_4 | 6 << 12 | 0 << 8,
+    Instruction::AND_INT_LIT8, 3 << 8 | 0,
+    Instruction::OR_INT_LIT8, 8 << 8 | 0,
+    Instruction::XOR_INT_LIT8, 1 << 8 | 0,
+    Instruction::RETURN);
+
+  TestCode(data, true, 11);
+}
+
+TEST(CodegenTest, ReturnBitwiseIntLit16) {
+  const uint16_t data[] = ONE_REGISTER_CODE_ITEM(
+    Instruction::CONST_4 | 6 << 12 | 0 << 8,
+    Instruction::AND_INT_LIT16, 3,
+    Instruction::OR_INT_LIT16, 0x100,
+    Instruction::XOR_INT_LIT16, 1,
+    Instruction::RETURN);
+
+  TestCode(data, true, 0x103);
+}
+
+TEST(CodegenTest, ReturnShiftIntLit8) {
+  const uint16_t data[] = ONE_REGISTER_CODE_ITEM(
+    Instruction::CONST_4 | 8 << 12 | 0 << 8,
+    Instruction::SHR_INT_LIT8, 1 << 8 | 0,
+    Instruction::USHR_INT_LIT8, 28 << 8 | 0,
+    Instruction::SHL_INT_LIT8, 33 << 8 | 0,
+    Instruction::RETURN);
+
+  // ((-8 >> 1) >>> 28) << (33 & 0x1f).
+  TestCode(data, true, 30);
+}
+
+#define SHIFT_TEST(OPCODE, TEST_NAME, EXPECTED)                 \
+  TEST(CodegenTest, Return ## TEST_NAME) {                      \
+    const uint16_t data[] = TWO_REGISTERS_CODE_ITEM(            \
+      Instruction::CONST_4 | 8 << 12 | 0,                       \
+      Instruction::CONST_16 | 1 << 8, 34,                       \
+      Instruction::OPCODE ## _INT, 1 << 8 | 0,                  \
+      Instruction::RETURN);                                     \
+                                                                \
+    TestCode(data, true, EXPECTED);                             \
+  }                                                             \
+                                                                \
+  TEST(CodegenTest, Return ## TEST_NAME ## 2addr) {             \
+    const uint16_t data[] = TWO_REGISTERS_CODE_ITEM(            \
+      Instruction::CONST_4 | 8 << 12 | 0,                       \
+      Instruction::CONST_16 | 1 << 8, 34,                       \
+      Instruction::OPCODE ## _INT_2ADDR | 1 << 12,              \
+      Instruction::RETURN);                                     \
+                                                                \
+    TestCode(data, true, EXPECTED);                             \
+  }
+
+// The shift distance of 34 is taken modulo 32.
+SHIFT_TEST(SHL, ShlInt, -32)
+SHIFT_TEST(SHR, ShrInt, -2)
+SHIFT_TEST(USHR, UShrInt, 0x3ffffffe)
+
+#undef SHIFT_TEST
+
+TEST(CodegenTest, ReturnIntConversions) {
+  const uint16_t data[] = TWO_REGISTERS_CODE_ITEM(
+    Instruction::CONST_16 | 0 << 8, 0x1ff,
+    Instruction::INT_TO_BYTE | 0 << 8 | 0 << 12,
+    Instruction::INT_TO_CHAR | 0 << 8 | 0 << 12,
+    Instruction::INT_TO_SHORT | 0 << 8 | 0 << 12,
+    Instruction::INT_TO_LONG | 0 << 8 | 0 << 12,
+    Instruction::LONG_TO_INT | 0 << 8 | 0 << 12,
+    Instruction::RETURN);
+
+  // (short) (char) (byte) 0x1ff, through a long.
+  TestCode(data, true, -1);
+}
+
+// Division calls the runtime on ARM, which these tests do not set up.
+#if !defined(__arm__)
+TEST(CodegenTest, ReturnDivRemIntLit) {
+  const uint16_t data[] = ONE_REGISTER_CODE_ITEM(
+    Instruction::CONST_4 | 9 << 12 | 0 << 8,
+    Instruction::DIV_INT_LIT8, 2 << 8 | 0,
+    Instruction::REM_INT_LIT16 | 0 << 8 | 0 << 12, 2,
+    Instruction::RETURN);
+
+  // (-7 / 2) % 2.
+  TestCode(data, true, -1);
+}
+
+#define DIV_REM_TEST(OPCODE, TEST_NAME, DIVISOR, EXPECTED)      \
+  TEST(CodegenTest, Return ## TEST_NAME) {                      \
+    const uint16_t data[] = TWO_REGISTERS_CODE_ITEM(            \
+      Instruction::CONST_4 | 7 << 12 | 0,                       \
+      Instruction::CONST_4 | ((DIVISOR) & 0xf) << 12 | 1 << 8,  \
+      Instruction::OPCODE ## _INT, 1 << 8 | 0,                  \
+      Instruction::RETURN);                                     \
+                                                                \
+    TestCode(data, true, EXPECTED);                             \
+  }                                                             \
+                                                                \
+  TEST(CodegenTest, Return ## TEST_NAME ## 2addr) {             \
+    const uint16_t data[] = TWO_REGISTERS_CODE_ITEM(            \
+      Instruction::CONST_4 | 7 << 12 | 0,                       \
+      Instruction::CONST_4 | ((DIVISOR) & 0xf) << 12 | 1 << 8,  \
+      Instruction::OPCODE ## _INT_2ADDR | 1 << 12,              \
+      Instruction::RETURN);                                     \
+                                                                \
+    TestCode(data, true, EXPECTED);                             \
+  }
+
+DIV_REM_TEST(DIV, DivInt, 2, 3)
+DIV_REM_TEST(REM, RemInt, 2, 1)
+DIV_REM_TEST(DIV, DivIntByMinusOne, -1, -7)
+DIV_REM_TEST(REM, RemIntByMinusOne, -1, 0)
+
+#undef DIV_REM_TEST
+#endif
+
 TEST(CodegenTest, MaterializedCondition1) {
   // Check that condition are materialized correctly. A materialized condition
   // should yield `1` if it evaluated to true, and `0` otherwise.
@@ -551,4 +701,170 @@ TEST(CodegenTest, MaterializedCondition2) {
   }
 }
 
+TEST(CodegenTest, ReturnWithTryCatch) {
+  // The code item is followed by one try item covering the first three
+  // instructions, and by a catch-all handler at dex pc 3. The division is
+  // what links the try block to the handler.
+  alignas(4) const uint16_t data[] = {
+    1, 0, 0, 1, 0, 0, 6, 0,
+    Instruction::CONST_4 | 3 << 12,
+    Instruction::DIV_INT_2ADDR,
+    Instruction::RETURN,
+    Instruction::MOVE_EXCEPTION,
+    Instruction::CONST_4 | 4 << 12,
+    Instruction::RETURN,
+    0, 0, 3, 1,  // start_addr = 0, insn_count = 3, handler_off = 1.
+    0x0001,  // One handler list, made of...
+    0x0003   // ...one catch-all handler at dex pc 3.
+  };
+
+  ArenaPool pool;
+  ArenaAllocator arena(&pool);
+  HGraphBuilder builder(&arena);
+  const DexFile::CodeItem* item = reinterpret_cast<const DexFile::CodeItem*>(data);
+  HGraph* graph = builder.BuildGraph(*item);
+  ASSERT_NE(graph, nullptr);
+  ASSERT_TRUE(graph->HasTryCatch());
+
+  // Entry block, try block, catch block.
+  HBasicBlock* try_block = graph->GetBlocks().Get(1);
+  HBasicBlock* catch_block = graph->GetBlocks().Get(2);
+  ASSERT_FALSE(try_block->IsCatchBlock());
+  ASSERT_TRUE(catch_block->IsCatchBlock());
+  ASSERT_EQ(catch_block->GetDexPc(), 3u);
+  ASSERT_TRUE(catch_block->GetFirstInstruction()->IsLoadException());
+  ASSERT_EQ(try_block->GetSuccessors().Size(), 2u);
+  ASSERT_EQ(try_block->NumberOfNormalSuccessors(), 1u);
+  ASSERT_EQ(try_block->GetSuccessors().Get(0), graph->GetExitBlock());
+  ASSERT_EQ(try_block->GetSuccessors().Get(1), catch_block);
+  ASSERT_EQ(catch_block->GetPredecessors().Size(), 1u);
+
+  RemoveSuspendChecks(graph);
+  RunCodeBaseline(graph, true, 1);
+
+  // The entry of the catch block must be found by the runtime.
+  InternalCodeAllocator allocator;
+  x86::CodeGeneratorX86 codegen(graph);
+  codegen.CompileBaseline(&allocator, true);
+  std::vector<uint8_t> mapping_table;
+  codegen.BuildMappingTable(&mapping_table, nullptr);
+  MappingTable table(mapping_table.data());
+  ASSERT_EQ(table.DexToPcSize(), 1u);
+  ASSERT_EQ(table.DexToPcBegin().DexPc(), 3u);
+  ASSERT_LT(table.DexToPcBegin().NativePcOffset(), allocator.GetSize());
+
+  // The optimizing pipeline must accept the catch block as well.
+  HGraphBuilder optimized_builder(&arena);
+  HGraph* optimized_graph = optimized_builder.BuildGraph(*item);
+  ASSERT_NE(optimized_graph, nullptr);
+  RemoveSuspendChecks(optimized_graph);
+  ASSERT_TRUE(optimized_graph->BuildDominatorTree());
+  optimized_graph->TransformToSSA();
+  optimized_graph->FindNaturalLoops();
+  PrepareForRegisterAllocation(optimized_graph).Run();
+  RunCodeOptimized(optimized_graph, [](HGraph*) {}, true, 1);
+}
+
+// Switches on `input` with `opcode`, whose cases return 10, 20 or 30 and
+// whose default returns 100. The switch is at dex pc 3, its cases at dex pc
+// 9, 12 and 15, and its payload, given as the remaining arguments, at dex pc 18.
+#define SWITCH_CODE_ITEM(input, opcode, ...)          \
+  ONE_REGISTER_CODE_ITEM(                             \
+    Instruction::CONST | 0 << 8,                      \
+    Low16Bits(input), High16Bits(input),              \
+    opcode | 0 << 8, 15, 0,                           \
+    Instruction::CONST_16 | 0 << 8, 100,              \
+    Instruction::RETURN | 0 << 8,                     \
+    Instruction::CONST_16 | 0 << 8, 10,               \
+    Instruction::RETURN | 0 << 8,                     \
+    Instruction::CONST_16 | 0 << 8, 20,               \
+    Instruction::RETURN | 0 << 8,                     \
+    Instruction::CONST_16 | 0 << 8, 30,               \
+    Instruction::RETURN | 0 << 8,                     \
+    __VA_ARGS__)
+
+static void TestSwitch(const uint16_t* data, int32_t expected) {
+  TestCode(data, true, expected);
+
+  ArenaPool pool;
+  ArenaAllocator arena(&pool);
+  HGraphBuilder builder(&arena);
+  const DexFile::CodeItem* item = reinterpret_cast<const DexFile::CodeItem*>(data);
+  HGraph* graph = builder.BuildGraph(*item);
+  ASSERT_NE(graph, nullptr);
+  RemoveSuspendChecks(graph);
+  graph->BuildDominatorTree();
+  graph->TransformToSSA();
+  graph->FindNaturalLoops();
+  PrepareForRegisterAllocation(graph).Run();
+  RunCodeOptimized(graph, [](HGraph*) {}, true, expected);
+}
+
+static void TestPackedSwitch(int32_t input, int32_t expected) {
+  // Seven entries starting at -2, dispatched with a jump table.
+  alignas(4) const uint16_t data[] = SWITCH_CODE_ITEM(
+    input,
+    Instruction::PACKED_SWITCH,
+    Instruction::kPackedSwitchSignature, 7, Low16Bits(-2), High16Bits(-2),
+    6, 0, 9, 0, 12, 0, 6, 0, 9, 0, 12, 0, 9, 0);
+  TestSwitch(data, expected);
+}
+
+static void TestSmallPackedSwitch(int32_t input, int32_t expected) {
+  // Three entries starting at 0x7ffffffe, dispatched with compares.
+  alignas(4) const uint16_t data[] = SWITCH_CODE_ITEM(
+    input,
+    Instruction::PACKED_SWITCH,
+    Instruction::kPackedSwitchSignature, 3, 0xfffe, 0x7fff,
+    6, 0, 9, 0, 12, 0);
+  TestSwitch(data, expected);
+}
+
+static void TestSparseSwitch(int32_t input, int32_t expected) {
+  // Keys -1000, -1, 7, 8, 1000, 65536, dispatched with a binary search.
+  alignas(4) const uint16_t data[] = SWITCH_CODE_ITEM(
+    input,
+    Instruction::SPARSE_SWITCH,
+    Instruction::kSparseSwitchSignature, 6,
+    Low16Bits(-1000), High16Bits(-1000), 0xffff, 0xffff, 7, 0, 8, 0, 1000, 0, 0, 1,
+    6, 0, 9, 0, 12, 0, 12, 0, 6, 0, 9, 0);
+  TestSwitch(data, expected);
+}
+
+TEST(CodegenTest, PackedSwitch) {
+  TestPackedSwitch(-3, 100);
+  TestPackedSwitch(-2, 10);
+  TestPackedSwitch(-1, 20);
+  TestPackedSwitch(0, 30);
+  TestPackedSwitch(1, 10);
+  TestPackedSwitch(2, 20);
+  TestPackedSwitch(3, 30);
+  TestPackedSwitch(4, 20);
+  TestPackedSwitch(5, 100);
+  TestPackedSwitch(std::numeric_limits<int32_t>::min(), 100);
+  TestPackedSwitch(std::numeric_limits<int32_t>::max(), 100);
+}
+
+TEST(CodegenTest, SmallPackedSwitch) {
+  TestSmallPackedSwitch(0x7ffffffd, 100);
+  TestSmallPackedSwitch(0x7ffffffe, 10);
+  TestSmallPackedSwitch(0x7fffffff, 20);
+  // The last case wraps around.
+  TestSmallPackedSwitch(std::numeric_limits<int32_t>::min(), 30);
+  TestSmallPackedSwitch(0, 100);
+}
+
+TEST(CodegenTest, SparseSwitch) {
+  TestSparseSwitch(-1001, 100);
+  TestSparseSwitch(-1000, 10);
+  TestSparseSwitch(-1, 20);
+  TestSparseSwitch(0, 100);
+  TestSparseSwitch(7, 30);
+  TestSparseSwitch(8, 30);
+  TestSparseSwitch(9, 100);
+  TestSparseSwitch(1000, 10);
+  TestSparseSwitch(65536, 20);
+  TestSparseSwitch(std::numeric_limits<int32_t>::max(), 100);
+}
+
 }  // namespace art
@@ -180,9 +180,9 @@ void SSAChecker::VisitBasicBlock(HBasicBlock* block) {
 
   // Ensure there is no critical edge (i.e., an edge connecting a
   // block with multiple successors to a block with multiple
-  // predecessors).
-  if (block->GetSuccessors().Size() > 1) {
-    for (size_t j = 0; j < block->GetSuccessors().Size(); ++j) {
+  // predecessors). Edges to catch blocks are not split.
+  if (block->NumberOfNormalSuccessors() > 1) {
+    for (size_t j = 0; j < block->NumberOfNormalSuccessors(); ++j) {
       HBasicBlock* successor = block->GetSuccessors().Get(j);
       if (successor->GetPredecessors().Size() > 1) {
         std::stringstream error;
@@ -310,6 +310,11 @@ void SSAChecker::VisitPhi(HPhi* phi) {
       errors_.Insert(error.str());
   }
 
+  if (phi->IsCatchPhi()) {
+    CheckCatchPhi(phi);
+    return;
+  }
+
   // Ensure the number of phi inputs is the same as the number of
   // its predecessors.
   const GrowableArray<HBasicBlock*>& predecessors =
@@ -342,4 +347,38 @@ void SSAChecker::VisitPhi(HPhi* phi) {
   }
 }
 
+void SSAChecker::CheckCatchPhi(HPhi* phi) {
+  // Ensure the number of catch phi inputs is the same as the number of
+  // instructions throwing to its block.
+  const GrowableArray<HInstruction*>& throwing_instructions =
+    phi->GetBlock()->GetThrowingInstructions();
+  if (phi->InputCount() != throwing_instructions.Size()) {
+    std::stringstream error;
+    error << "Catch phi " << phi->GetId()
+          << " in block " << phi->GetBlock()->GetBlockId()
+          << " has " << phi->InputCount() << " inputs, but block "
+          << phi->GetBlock()->GetBlockId() << " has "
+          << throwing_instructions.Size() << " throwing instructions.";
+    errors_.Insert(error.str());
+    return;
+  }
+
+  // Ensure catch phi input at index I dominates the Ith throwing
+  // instruction, unless that instruction has been removed.
+  for (size_t i = 0, e = phi->InputCount(); i < e; ++i) {
+    HInstruction* input = phi->InputAt(i);
+    HInstruction* throwing_instruction = throwing_instructions.Get(i);
+    if (throwing_instruction->IsInBlock()
+        && !input->StrictlyDominates(throwing_instruction)) {
+      std::stringstream error;
+      error << "Input " << input->GetId() << " at index " << i
+            << " of catch phi " << phi->GetId()
+            << " from block " << phi->GetBlock()->GetBlockId()
+            << " does not dominate throwing instruction "
+            << throwing_instruction->GetId() << ".";
+      errors_.Insert(error.str());
+    }
+  }
+}
+
 }  // namespace art
@@ -94,6 +94,8 @@ class SSAChecker : public GraphChecker {
   virtual void VisitBasicBlock(HBasicBlock* block) OVERRIDE;
   // Loop-related checks from block `loop_header`.
   void CheckLoop(HBasicBlock* loop_header);
+  // Checks of the inputs of a phi of a catch block.
+  void CheckCatchPhi(HPhi* phi);
 
   // Perform SSA form checks on instructions.
   virtual void VisitInstruction(HInstruction* instruction) OVERRIDE;
@@ -20,6 +20,7 @@ namespace art {
 
 void GlobalValueNumberer::Run() {
   ComputeSideEffects();
+  ComputeReachableFromCatch();
 
   sets_.Put(graph_->GetEntryBlock()->GetBlockId(), new (allocator_) ValueSet(allocator_));
 
@@ -30,6 +31,29 @@ void GlobalValueNumberer::Run() {
   }
 }
 
+void GlobalValueNumberer::ComputeReachableFromCatch() {
+  if (!graph_->HasTryCatch()) {
+    return;
+  }
+  GrowableArray<HBasicBlock*> worklist(allocator_, graph_->GetBlocks().Size());
+  for (HReversePostOrderIterator it(*graph_); !it.Done(); it.Advance()) {
+    if (it.Current()->IsCatchBlock()) {
+      reachable_from_catch_.Put(it.Current()->GetBlockId(), true);
+      worklist.Add(it.Current());
+    }
+  }
+  while (!worklist.IsEmpty()) {
+    HBasicBlock* block = worklist.Pop();
+    for (size_t i = 0, e = block->GetSuccessors().Size(); i < e; ++i) {
+      HBasicBlock* successor = block->GetSuccessors().Get(i);
+      if (!reachable_from_catch_.Get(successor->GetBlockId())) {
+        reachable_from_catch_.Put(successor->GetBlockId(), true);
+        worklist.Add(successor);
+      }
+    }
+  }
+}
+
 void GlobalValueNumberer::UpdateLoopEffects(HLoopInformation* info, SideEffects effects) {
   int id = info->GetHeader()->GetBlockId();
   loop_effects_.Put(id, loop_effects_.Get(id).Union(effects));
@@ -109,6 +133,11 @@ void GlobalValueNumberer::VisitBasicBlock(HBasicBlock* block) {
   }
 
   ValueSet* set = sets_.Get(block->GetBlockId());
+  if (reachable_from_catch_.Get(block->GetBlockId())) {
+    // Reusing a value computed by a dominator would make it live in a catch
+    // block, which only gets its phis and constants.
+    set = new (allocator_) ValueSet(allocator_);
+  }
 
   if (block->IsLoopHeader()) {
     set->Kill(GetLoopEffects(block));
@@ -173,16 +173,19 @@ class GlobalValueNumberer : public ValueObject {
         block_effects_(allocator, graph->GetBlocks().Size()),
         loop_effects_(allocator, graph->GetBlocks().Size()),
         sets_(allocator, graph->GetBlocks().Size()),
+        reachable_from_catch_(allocator, graph->GetBlocks().Size()),
         visited_(allocator, graph->GetBlocks().Size()) {
     size_t number_of_blocks = graph->GetBlocks().Size();
     block_effects_.SetSize(number_of_blocks);
     loop_effects_.SetSize(number_of_blocks);
     sets_.SetSize(number_of_blocks);
+    reachable_from_catch_.SetSize(number_of_blocks);
     visited_.SetSize(number_of_blocks);
 
     for (size_t i = 0; i < number_of_blocks; ++i) {
       block_effects_.Put(i, SideEffects::None());
       loop_effects_.Put(i, SideEffects::None());
+      reachable_from_catch_.Put(i, false);
     }
   }
 
@@ -197,6 +200,9 @@ class GlobalValueNumberer : public ValueObject {
   // will use these side effects to update the ValueSet of individual blocks.
   void ComputeSideEffects();
 
+  // Mark the blocks reachable from a catch block.
+  void ComputeReachableFromCatch();
+
   void UpdateLoopEffects(HLoopInformation* info, SideEffects effects);
   SideEffects GetLoopEffects(HBasicBlock* block) const;
   SideEffects GetBlockEffects(HBasicBlock* block) const;
@@ -217,6 +223,11 @@ class GlobalValueNumberer : public ValueObject {
   // in the path from the dominator to the block.
   GrowableArray<ValueSet*> sets_;
 
+  // Blocks reachable from a catch block. The only values live when entering a
+  // catch block are its phis and constants, so these blocks cannot reuse values
+  // computed by their dominators.
+  GrowableArray<bool> reachable_from_catch_;
+
   // Mark visisted blocks. Only used for debugging.
   GrowableArray<bool> visited_;
 
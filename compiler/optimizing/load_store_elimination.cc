@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "load_store_elimination.h"
+
+namespace art {
+
+// Returns the object accessed through `instruction`, looking through null checks.
+static HInstruction* GetReference(HInstruction* instruction) {
+  while (instruction->IsNullCheck()) {
+    instruction = instruction->InputAt(0);
+  }
+  return instruction;
+}
+
+// Values of narrower types may need to be truncated when stored into a field,
+// so we only forward values whose type matches the field storage.
+static bool IsForwardableType(Primitive::Type type) {
+  return type == Primitive::kPrimInt
+      || type == Primitive::kPrimLong
+      || type == Primitive::kPrimNot;
+}
+
+void LoadStoreElimination::Run() {
+  RemoveNullChecksOfAllocations();
+  FindNonEscapingAllocations();
+  for (HReversePostOrderIterator it(*graph_); !it.Done(); it.Advance()) {
+    VisitBasicBlock(it.Current());
+  }
+}
+
+void LoadStoreElimination::RemoveNullChecksOfAllocations() {
+  for (HReversePostOrderIterator it(*graph_); !it.Done(); it.Advance()) {
+    HBasicBlock* block = it.Current();
+    for (HInstructionIterator inst_it(block->GetInstructions()); !inst_it.Done(); inst_it.Advance()) {
+      HInstruction* instruction = inst_it.Current();
+      if (instruction->IsNullCheck() && instruction->InputAt(0)->IsNewInstance()) {
+        instruction->ReplaceWith(instruction->InputAt(0));
+        block->RemoveInstruction(instruction);
+      }
+    }
+  }
+}
+
+void LoadStoreElimination::FindNonEscapingAllocations() {
+  for (HReversePostOrderIterator it(*graph_); !it.Done(); it.Advance()) {
+    HBasicBlock* block = it.Current();
+    for (HInstructionIterator inst_it(block->GetInstructions()); !inst_it.Done(); inst_it.Advance()) {
+      HInstruction* instruction = inst_it.Current();
+      if (!instruction->IsNewInstance() || !instruction->AsNewInstance()->CanBeRemoved()) {
+        continue;
+      }
+      // The object escapes if it is used for anything other than accessing its
+      // fields, or if its fields are accessed in other blocks.
+      bool escapes = false;
+      for (HUseIterator<HInstruction> use_it(instruction->GetUses());
+           !use_it.Done() && !escapes;
+           use_it.Advance()) {
+        HInstruction* user = use_it.Current()->GetUser();
+        if (use_it.Current()->GetIndex() != 0 || user->GetBlock() != block) {
+          escapes = true;
+        } else if (user->IsInstanceFieldGet()) {
+          escapes = !IsForwardableType(user->AsInstanceFieldGet()->GetFieldType());
+        } else if (user->IsInstanceFieldSet()) {
+          escapes = !IsForwardableType(user->AsInstanceFieldSet()->GetFieldType());
+        } else {
+          escapes = true;
+        }
+      }
+      if (!escapes) {
+        non_escaping_allocations_.Add(instruction->AsNewInstance());
+      }
+    }
+  }
+}
+
+bool LoadStoreElimination::IsNonEscaping(HInstruction* reference) const {
+  if (!reference->IsNewInstance()) {
+    return false;
+  }
+  for (size_t i = 0, e = non_escaping_allocations_.Size(); i < e; ++i) {
+    if (non_escaping_allocations_.Get(i) == reference) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool LoadStoreElimination::MayAlias(HInstruction* first, HInstruction* second) const {
+  if (first == second) {
+    return true;
+  }
+  if (IsNonEscaping(first) || IsNonEscaping(second)) {
+    return false;
+  }
+  // Two different allocations in the same block are different objects.
+  return !(first->IsNewInstance() && second->IsNewInstance());
+}
+
+void LoadStoreElimination::VisitBasicBlock(HBasicBlock* block) {
+  heap_values_.Reset();
+  for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+    HInstruction* instruction = it.Current();
+    if (instruction->IsInstanceFieldGet()) {
+      VisitInstanceFieldGet(instruction->AsInstanceFieldGet());
+    } else if (instruction->IsInstanceFieldSet()) {
+      VisitInstanceFieldSet(instruction->AsInstanceFieldSet());
+    } else {
+      // Array stores cannot write to instance fields.
+      if (instruction->HasSideEffects() && !instruction->IsArraySet()) {
+        KillEscapingValues();
+      }
+      // Anything that calls into the runtime or throws gives other code a
+      // chance to read the heap.
+      if (instruction->NeedsEnvironment() || instruction->CanThrow()) {
+        ObserveAllPendingStores();
+      }
+    }
+  }
+
+  for (size_t i = 0, e = non_escaping_allocations_.Size(); i < e; ++i) {
+    HNewInstance* allocation = non_escaping_allocations_.Get(i);
+    if (allocation->GetBlock() == block) {
+      RemoveAllocation(allocation);
+    }
+  }
+}
+
+void LoadStoreElimination::VisitInstanceFieldGet(HInstanceFieldGet* instruction) {
+  HInstruction* reference = GetReference(instruction->InputAt(0));
+  size_t offset = instruction->GetFieldOffset().SizeValue();
+  HeapValue* heap_value = FindHeapValue(reference, offset);
+
+  HInstruction* value = nullptr;
+  if (heap_value != nullptr) {
+    value = heap_value->GetValue();
+  } else if (IsNonEscaping(reference)) {
+    value = GetDefaultValue(instruction->GetType());
+  }
+
+  if (value != nullptr && IsForwardableType(instruction->GetType())) {
+    instruction->ReplaceWith(value);
+    instruction->GetBlock()->RemoveInstruction(instruction);
+    ++number_of_removed_loads_;
+    return;
+  }
+
+  ObservePendingStores(reference, offset);
+  if (heap_value == nullptr) {
+    heap_values_.Add(new (graph_->GetArena()) HeapValue(reference, offset, instruction, nullptr));
+  }
+}
+
+void LoadStoreElimination::VisitInstanceFieldSet(HInstanceFieldSet* instruction) {
+  HInstruction* reference = GetReference(instruction->InputAt(0));
+  size_t offset = instruction->GetFieldOffset().SizeValue();
+  HInstruction* value = instruction->InputAt(1);
+  HeapValue* heap_value = FindHeapValue(reference, offset);
+
+  if (heap_value != nullptr && heap_value->GetValue() == value) {
+    // The field already holds the value.
+    instruction->GetBlock()->RemoveInstruction(instruction);
+    ++number_of_removed_stores_;
+    return;
+  }
+
+  if (heap_value != nullptr && heap_value->GetStore() != nullptr) {
+    // The previous store has not been observed and is now overwritten.
+    HInstruction* store = heap_value->GetStore();
+    store->GetBlock()->RemoveInstruction(store);
+    ++number_of_removed_stores_;
+  }
+
+  KillAliases(reference, offset);
+  if (heap_value == nullptr) {
+    heap_values_.Add(new (graph_->GetArena()) HeapValue(reference, offset, value, instruction));
+  } else {
+    heap_value->SetValue(value);
+    heap_value->SetStore(instruction);
+  }
+}
+
+void LoadStoreElimination::RemoveAllocation(HNewInstance* allocation) {
+  // The loads have all been replaced, only stores are left.
+  for (HUseIterator<HInstruction> it(allocation->GetUses()); !it.Done(); it.Advance()) {
+    HInstruction* user = it.Current()->GetUser();
+    DCHECK(user->IsInstanceFieldSet()) << user->DebugName();
+    user->GetBlock()->RemoveInstruction(user);
+    ++number_of_removed_stores_;
+  }
+  DCHECK(!allocation->HasUses());
+  if (allocation->GetEnvUses() != nullptr) {
+    // Environments only need the object for stack maps, use null instead.
+    allocation->ReplaceWith(GetDefaultValue(Primitive::kPrimNot));
+  }
+  allocation->GetBlock()->RemoveInstruction(allocation);
+  ++number_of_removed_allocations_;
+}
+
+HeapValue* LoadStoreElimination::FindHeapValue(HInstruction* reference, size_t offset) const {
+  for (size_t i = 0, e = heap_values_.Size(); i < e; ++i) {
+    HeapValue* heap_value = heap_values_.Get(i);
+    if (heap_value->GetReference() == reference && heap_value->GetOffset() == offset) {
+      return heap_value;
+    }
+  }
+  return nullptr;
+}
+
+void LoadStoreElimination::KillAliases(HInstruction* reference, size_t offset) {
+  for (size_t i = heap_values_.Size(); i > 0; --i) {
+    HeapValue* heap_value = heap_values_.Get(i - 1);
+    if (heap_value->GetOffset() == offset
+        && heap_value->GetReference() != reference
+        && MayAlias(heap_value->GetReference(), reference)) {
+      heap_values_.DeleteAt(i - 1);
+    }
+  }
+}
+
+void LoadStoreElimination::KillEscapingValues() {
+  for (size_t i = heap_values_.Size(); i > 0; --i) {
+    if (!IsNonEscaping(heap_values_.Get(i - 1)->GetReference())) {
+      heap_values_.DeleteAt(i - 1);
+    }
+  }
+}
+
+void LoadStoreElimination::ObservePendingStores(HInstruction* reference, size_t offset) {
+  for (size_t i = 0, e = heap_values_.Size(); i < e; ++i) {
+    HeapValue* heap_value = heap_values_.Get(i);
+    if (heap_value->GetOffset() == offset && MayAlias(heap_value->GetReference(), reference)) {
+      heap_value->SetStore(nullptr);
+    }
+  }
+}
+
+void LoadStoreElimination::ObserveAllPendingStores() {
+  for (size_t i = 0, e = heap_values_.Size(); i < e; ++i) {
+    heap_values_.Get(i)->SetStore(nullptr);
+  }
+}
+
+HInstruction* LoadStoreElimination::GetDefaultValue(Primitive::Type type) {
+  HBasicBlock* entry = graph_->GetEntryBlock();
+  if (type == Primitive::kPrimLong) {
+    if (long_zero_ == nullptr) {
+      long_zero_ = new (graph_->GetArena()) HLongConstant(0);
+      entry->InsertInstructionBefore(long_zero_, entry->GetLastInstruction());
+    }
+    return long_zero_;
+  } else {
+    if (int_zero_ == nullptr) {
+      int_zero_ = new (graph_->GetArena()) HIntConstant(0);
+      entry->InsertInstructionBefore(int_zero_, entry->GetLastInstruction());
+    }
+    return int_zero_;
+  }
+}
+
+}  // namespace art
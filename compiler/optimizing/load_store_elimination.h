@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_OPTIMIZING_LOAD_STORE_ELIMINATION_H_
+#define ART_COMPILER_OPTIMIZING_LOAD_STORE_ELIMINATION_H_
+
+#include "nodes.h"
+#include "optimization.h"
+
+namespace art {
+
+/**
+ * The value known to be held by an instance field of an object, and the
+ * last store to that field that has not been observed yet.
+ */
+class HeapValue : public ArenaObject {
+ public:
+  HeapValue(HInstruction* reference, size_t offset, HInstruction* value, HInstruction* store)
+      : reference_(reference), offset_(offset), value_(value), store_(store) {}
+
+  HInstruction* GetReference() const { return reference_; }
+  size_t GetOffset() const { return offset_; }
+  HInstruction* GetValue() const { return value_; }
+  HInstruction* GetStore() const { return store_; }
+
+  void SetValue(HInstruction* value) { value_ = value; }
+  void SetStore(HInstruction* store) { store_ = store; }
+
+ private:
+  HInstruction* const reference_;
+  const size_t offset_;
+  HInstruction* value_;
+  // An `HInstanceFieldSet` whose value has not been read yet, or null.
+  HInstruction* store_;
+
+  DISALLOW_COPY_AND_ASSIGN(HeapValue);
+};
+
+/**
+ * Optimization pass eliminating redundant instance field accesses:
+ * - A load of a field whose value is known is replaced by that value.
+ * - A store overwritten before its value can be observed is removed.
+ * - An allocation that does not escape the block it is defined in, and
+ *   whose fields are only accessed in that block, is removed and its
+ *   fields are replaced by the values stored into them.
+ *
+ * The analysis is local to each basic block.
+ */
+class LoadStoreElimination : public HOptimization {
+ public:
+  LoadStoreElimination(HGraph* graph, const HGraphVisualizer& visualizer)
+      : HOptimization(graph, true, kLoadStoreEliminationPassName, visualizer),
+        heap_values_(graph->GetArena(), kDefaultNumberOfHeapValues),
+        non_escaping_allocations_(graph->GetArena(), 0),
+        int_zero_(nullptr),
+        long_zero_(nullptr),
+        number_of_removed_loads_(0),
+        number_of_removed_stores_(0),
+        number_of_removed_allocations_(0) {}
+
+  virtual void Run() OVERRIDE;
+
+  size_t GetNumberOfRemovedLoads() const { return number_of_removed_loads_; }
+  size_t GetNumberOfRemovedStores() const { return number_of_removed_stores_; }
+  size_t GetNumberOfRemovedAllocations() const { return number_of_removed_allocations_; }
+
+  static constexpr const char* kLoadStoreEliminationPassName = "load_store_elimination";
+
+ private:
+  // Replaces null checks on freshly allocated objects with the allocation.
+  void RemoveNullChecksOfAllocations();
+
+  // Collects the allocations that can be replaced by their fields.
+  void FindNonEscapingAllocations();
+  bool IsNonEscaping(HInstruction* reference) const;
+
+  void VisitBasicBlock(HBasicBlock* block);
+  void VisitInstanceFieldGet(HInstanceFieldGet* instruction);
+  void VisitInstanceFieldSet(HInstanceFieldSet* instruction);
+  void RemoveAllocation(HNewInstance* allocation);
+
+  HeapValue* FindHeapValue(HInstruction* reference, size_t offset) const;
+
+  // Forgets the values of fields at `offset` of objects that may be `reference`.
+  void KillAliases(HInstruction* reference, size_t offset);
+
+  // Forgets the values of all fields that may be written to by other code.
+  void KillEscapingValues();
+
+  // Marks the pending stores to fields at `offset` of objects that may be
+  // `reference` as observed.
+  void ObservePendingStores(HInstruction* reference, size_t offset);
+
+  // Marks all pending stores as observed.
+  void ObserveAllPendingStores();
+
+  bool MayAlias(HInstruction* first, HInstruction* second) const;
+
+  // Returns the value of a field of type `type` in a newly allocated object.
+  HInstruction* GetDefaultValue(Primitive::Type type);
+
+  static constexpr size_t kDefaultNumberOfHeapValues = 8;
+
+  // Values known for the block currently visited.
+  GrowableArray<HeapValue*> heap_values_;
+  GrowableArray<HNewInstance*> non_escaping_allocations_;
+
+  HIntConstant* int_zero_;
+  HLongConstant* long_zero_;
+
+  size_t number_of_removed_loads_;
+  size_t number_of_removed_stores_;
+  size_t number_of_removed_allocations_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoadStoreElimination);
+};
+
+}  // namespace art
+
+#endif  // ART_COMPILER_OPTIMIZING_LOAD_STORE_ELIMINATION_H_
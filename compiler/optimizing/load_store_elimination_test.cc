@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "code_generator_x86.h"
+#include "graph_visualizer.h"
+#include "load_store_elimination.h"
+#include "nodes.h"
+#include "optimizing_unit_test.h"
+#include "utils/arena_allocator.h"
+
+#include "gtest/gtest.h"
+
+namespace art {
+
+/**
+ * Creates a graph with an entry block holding two object parameters and two
+ * integer parameters, followed by `*body` and the exit block.
+ */
+static HGraph* CreateGraph(ArenaAllocator* allocator,
+                           HBasicBlock** body,
+                           HInstruction** object,
+                           HInstruction** other,
+                           HInstruction** first,
+                           HInstruction** second) {
+  HGraph* graph = new (allocator) HGraph(allocator);
+  HBasicBlock* entry = new (allocator) HBasicBlock(graph);
+  graph->AddBlock(entry);
+  graph->SetEntryBlock(entry);
+  *object = new (allocator) HParameterValue(0, Primitive::kPrimNot);
+  entry->AddInstruction(*object);
+  *other = new (allocator) HParameterValue(1, Primitive::kPrimNot);
+  entry->AddInstruction(*other);
+  *first = new (allocator) HParameterValue(2, Primitive::kPrimInt);
+  entry->AddInstruction(*first);
+  *second = new (allocator) HParameterValue(3, Primitive::kPrimInt);
+  entry->AddInstruction(*second);
+  entry->AddInstruction(new (allocator) HGoto());
+
+  *body = new (allocator) HBasicBlock(graph);
+  graph->AddBlock(*body);
+  entry->AddSuccessor(*body);
+
+  HBasicBlock* exit = new (allocator) HBasicBlock(graph);
+  graph->AddBlock(exit);
+  graph->SetExitBlock(exit);
+  (*body)->AddSuccessor(exit);
+  exit->AddInstruction(new (allocator) HExit());
+  return graph;
+}
+
+TEST(LoadStoreEliminationTest, StoreToLoadForwarding) {
+  ArenaPool pool;
+  ArenaAllocator allocator(&pool);
+  HBasicBlock* block;
+  HInstruction* object;
+  HInstruction* other;
+  HInstruction* first;
+  HInstruction* second;
+  HGraph* graph = CreateGraph(&allocator, &block, &object, &other, &first, &second);
+
+  block->AddInstruction(
+      new (&allocator) HInstanceFieldSet(object, first, Primitive::kPrimInt, MemberOffset(42)));
+  // A store to another field does not kill the value.
+  block->AddInstruction(
+      new (&allocator) HInstanceFieldSet(object, second, Primitive::kPrimInt, MemberOffset(43)));
+  HInstruction* load = new (&allocator) HInstanceFieldGet(
+      object, Primitive::kPrimInt, MemberOffset(42));
+  block->AddInstruction(load);
+  HInstruction* ret = new (&allocator) HReturn(load);
+  block->AddInstruction(ret);
+
+  graph->BuildDominatorTree();
+  graph->TransformToSSA();
+  x86::CodeGeneratorX86 codegen(graph);
+  HGraphVisualizer visualizer(nullptr, graph, codegen, "");
+  LoadStoreElimination lse(graph, visualizer);
+  lse.Execute();
+
+  ASSERT_TRUE(load->GetBlock() == nullptr);
+  ASSERT_EQ(ret->InputAt(0), first);
+  ASSERT_EQ(lse.GetNumberOfRemovedLoads(), 1u);
+  ASSERT_EQ(lse.GetNumberOfRemovedStores(), 0u);
+}
+
+TEST(LoadStoreEliminationTest, DeadStore) {
+  ArenaPool pool;
+  ArenaAllocator allocator(&pool);
+  HBasicBlock* block;
+  HInstruction* object;
+  HInstruction* other;
+  HInstruction* first;
+  HInstruction* second;
+  HGraph* graph = CreateGraph(&allocator, &block, &object, &other, &first, &second);
+
+  HInstruction* dead_store = new (&allocator) HInstanceFieldSet(
+      object, first, Primitive::kPrimInt, MemberOffset(42));
+  block->AddInstruction(dead_store);
+  HInstruction* overwriting_store = new (&allocator) HInstanceFieldSet(
+      object, second, Primitive::kPrimInt, MemberOffset(42));
+  block->AddInstruction(overwriting_store);
+  // The load from another object may read the value stored, keep the store.
+  block->AddInstruction(new (&allocator) HInstanceFieldGet(
+      other, Primitive::kPrimInt, MemberOffset(42)));
+  HInstruction* observed_store = new (&allocator) HInstanceFieldSet(
+      object, first, Primitive::kPrimInt, MemberOffset(42));
+  block->AddInstruction(observed_store);
+  // The null check may throw, and the caller may then read the value stored.
+  block->AddInstruction(new (&allocator) HNullCheck(other, 0));
+  HInstruction* last_store = new (&allocator) HInstanceFieldSet(
+      object, second, Primitive::kPrimInt, MemberOffset(42));
+  block->AddInstruction(last_store);
+  block->AddInstruction(new (&allocator) HReturnVoid());
+
+  graph->BuildDominatorTree();
+  graph->TransformToSSA();
+  x86::CodeGeneratorX86 codegen(graph);
+  HGraphVisualizer visualizer(nullptr, graph, codegen, "");
+  LoadStoreElimination lse(graph, visualizer);
+  lse.Execute();
+
+  ASSERT_TRUE(dead_store->GetBlock() == nullptr);
+  ASSERT_EQ(overwriting_store->GetBlock(), block);
+  ASSERT_EQ(observed_store->GetBlock(), block);
+  ASSERT_EQ(last_store->GetBlock(), block);
+  ASSERT_EQ(lse.GetNumberOfRemovedStores(), 1u);
+}
+
+TEST(LoadStoreEliminationTest, ScalarReplacement) {
+  ArenaPool pool;
+  ArenaAllocator allocator(&pool);
+  HBasicBlock* block;
+  HInstruction* object;
+  HInstruction* other;
+  HInstruction* first;
+  HInstruction* second;
+  HGraph* graph = CreateGraph(&allocator, &block, &object, &other, &first, &second);
+
+  HInstruction* allocation = new (&allocator) HNewInstance(0, 0, true);
+  block->AddInstruction(allocation);
+  HInstruction* null_check = new (&allocator) HNullCheck(allocation, 0);
+  block->AddInstruction(null_check);
+  block->AddInstruction(
+      new (&allocator) HInstanceFieldSet(null_check, first, Primitive::kPrimInt, MemberOffset(8)));
+  // Writes to other objects cannot change the fields of the allocation.
+  block->AddInstruction(
+      new (&allocator) HInstanceFieldSet(object, second, Primitive::kPrimInt, MemberOffset(8)));
+  HInstruction* load = new (&allocator) HInstanceFieldGet(
+      allocation, Primitive::kPrimInt, MemberOffset(8));
+  block->AddInstruction(load);
+  HInstruction* default_load = new (&allocator) HInstanceFieldGet(
+      allocation, Primitive::kPrimInt, MemberOffset(12));
+  block->AddInstruction(default_load);
+  HInstruction* add = new (&allocator) HAdd(Primitive::kPrimInt, load, default_load);
+  block->AddInstruction(add);
+  block->AddInstruction(new (&allocator) HReturn(add));
+
+  graph->BuildDominatorTree();
+  graph->TransformToSSA();
+  x86::CodeGeneratorX86 codegen(graph);
+  HGraphVisualizer visualizer(nullptr, graph, codegen, "");
+  LoadStoreElimination lse(graph, visualizer);
+  lse.Execute();
+
+  ASSERT_TRUE(allocation->GetBlock() == nullptr);
+  ASSERT_TRUE(null_check->GetBlock() == nullptr);
+  ASSERT_TRUE(load->GetBlock() == nullptr);
+  ASSERT_TRUE(default_load->GetBlock() == nullptr);
+  ASSERT_EQ(add->InputAt(0), first);
+  ASSERT_TRUE(add->InputAt(1)->IsIntConstant());
+  ASSERT_EQ(add->InputAt(1)->AsIntConstant()->GetValue(), 0);
+  ASSERT_EQ(lse.GetNumberOfRemovedAllocations(), 1u);
+  ASSERT_EQ(lse.GetNumberOfRemovedLoads(), 2u);
+  ASSERT_EQ(lse.GetNumberOfRemovedStores(), 1u);
+}
+
+TEST(LoadStoreEliminationTest, EscapingAllocation) {
+  ArenaPool pool;
+  ArenaAllocator allocator(&pool);
+  HBasicBlock* block;
+  HInstruction* object;
+  HInstruction* other;
+  HInstruction* first;
+  HInstruction* second;
+  HGraph* graph = CreateGraph(&allocator, &block, &object, &other, &first, &second);
+
+  HInstruction* escaping = new (&allocator) HNewInstance(0, 0, true);
+  block->AddInstruction(escaping);
+  block->AddInstruction(
+      new (&allocator) HInstanceFieldSet(escaping, first, Primitive::kPrimInt, MemberOffset(8)));
+  // Storing the allocation into another object makes it escape.
+  block->AddInstruction(
+      new (&allocator) HInstanceFieldSet(object, escaping, Primitive::kPrimNot, MemberOffset(8)));
+
+  // An allocation that may have observable effects is not removed.
+  HInstruction* not_removable = new (&allocator) HNewInstance(0, 1, false);
+  block->AddInstruction(not_removable);
+  block->AddInstruction(new (&allocator) HInstanceFieldSet(
+      not_removable, first, Primitive::kPrimInt, MemberOffset(8)));
+  block->AddInstruction(new (&allocator) HReturnVoid());
+
+  graph->BuildDominatorTree();
+  graph->TransformToSSA();
+  x86::CodeGeneratorX86 codegen(graph);
+  HGraphVisualizer visualizer(nullptr, graph, codegen, "");
+  LoadStoreElimination lse(graph, visualizer);
+  lse.Execute();
+
+  ASSERT_EQ(escaping->GetBlock(), block);
+  ASSERT_EQ(not_removable->GetBlock(), block);
+  ASSERT_EQ(lse.GetNumberOfRemovedAllocations(), 0u);
+  ASSERT_EQ(lse.GetNumberOfRemovedStores(), 0u);
+}
+
+}  // namespace art
@@ -66,12 +66,23 @@ void HGraph::VisitBlockForBackEdges(HBasicBlock* block,
   visiting->ClearBit(id);
 }
 
-void HGraph::BuildDominatorTree() {
+bool HGraph::BuildDominatorTree() {
   ArenaBitVector visited(arena_, blocks_.Size(), false);
 
   // (1) Find the back edges in the graph doing a DFS traversal.
   FindBackEdges(&visited);
 
+  // A catch block can only be a loop header through an exceptional back edge, for
+  // example when a handler covers its own instructions, like the handler of a
+  // synchronized block. The values of its phis would then depend on the throwing
+  // instructions of the loop, which we do not model.
+  for (size_t i = 0; i < blocks_.Size(); ++i) {
+    HBasicBlock* block = blocks_.Get(i);
+    if (visited.IsBitSet(i) && block->IsCatchBlock() && block->IsLoopHeader()) {
+      return false;
+    }
+  }
+
   // (2) Remove blocks not visited during the initial DFS.
   //     Step (3) requires dead blocks to be removed from the
   //     predecessors list of live blocks.
@@ -90,6 +101,7 @@ void HGraph::BuildDominatorTree() {
   for (size_t i = 0; i < entry_block_->GetSuccessors().Size(); i++) {
     VisitBlockForDominatorTree(entry_block_->GetSuccessors().Get(i), entry_block_, &visits);
   }
+  return true;
 }
 
 HBasicBlock* HGraph::FindCommonDominator(HBasicBlock* first, HBasicBlock* second) const {
@@ -162,9 +174,10 @@ void HGraph::SimplifyLoop(HBasicBlock* header) {
   // If there are more than one back edge, make them branch to the same block that
   // will become the only back edge. This simplifies finding natural loops in the
   // graph.
-  // Also, if the loop is a do/while (that is the back edge is an if), change the
-  // back edge to be a goto. This simplifies code generation of suspend cheks.
-  if (info->NumberOfBackEdges() > 1 || info->GetBackEdges().Get(0)->GetLastInstruction()->IsIf()) {
+  // Also, if the loop is a do/while (that is the back edge is an if or a switch),
+  // change the back edge to be a goto. This simplifies code generation of suspend cheks.
+  if (info->NumberOfBackEdges() > 1
+      || !info->GetBackEdges().Get(0)->GetLastInstruction()->IsGoto()) {
     HBasicBlock* new_back_edge = new (arena_) HBasicBlock(this, header->GetDexPc());
     AddBlock(new_back_edge);
     new_back_edge->AddInstruction(new (arena_) HGoto());
@@ -218,12 +231,13 @@ void HGraph::SimplifyLoop(HBasicBlock* header) {
 
 void HGraph::SimplifyCFG() {
   // Simplify the CFG for future analysis, and code generation:
-  // (1): Split critical edges.
+  // (1): Split critical edges. Edges to catch blocks are not split: the runtime
+  //      enters the catch block itself when delivering an exception.
   // (2): Simplify loops by having only one back edge, and one preheader.
   for (size_t i = 0; i < blocks_.Size(); ++i) {
     HBasicBlock* block = blocks_.Get(i);
-    if (block->GetSuccessors().Size() > 1) {
-      for (size_t j = 0; j < block->GetSuccessors().Size(); ++j) {
+    if (block->NumberOfNormalSuccessors() > 1) {
+      for (size_t j = 0; j < block->NumberOfNormalSuccessors(); ++j) {
         HBasicBlock* successor = block->GetSuccessors().Get(j);
         if (successor->GetPredecessors().Size() > 1) {
           SplitCriticalEdge(block, successor);
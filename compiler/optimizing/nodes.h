@@ -42,6 +42,9 @@ static const int kDefaultNumberOfPredecessors = 2;
 static const int kDefaultNumberOfDominatedBlocks = 1;
 static const int kDefaultNumberOfBackEdges = 1;
 
+static const int kMaxIntShiftValue = 0x1f;
+static const int kMaxLongShiftValue = 0x3f;
+
 enum IfCondition {
   kCondEQ,
   kCondNE,
@@ -89,7 +92,8 @@ class HGraph : public ArenaObject {
         number_of_vregs_(0),
         number_of_in_vregs_(0),
         number_of_temporaries_(0),
-        current_instruction_id_(0) {}
+        current_instruction_id_(0),
+        has_try_catch_(false) {}
 
   ArenaAllocator* GetArena() const { return arena_; }
   const GrowableArray<HBasicBlock*>& GetBlocks() const { return blocks_; }
@@ -103,7 +107,10 @@ class HGraph : public ArenaObject {
 
   void AddBlock(HBasicBlock* block);
 
-  void BuildDominatorTree();
+  // Computes the dominator tree and the reverse post order of the graph, and
+  // simplifies its control flow. Returns false, without simplifying, if a
+  // catch block is the header of a loop, which the SSA form does not support.
+  bool BuildDominatorTree();
   void TransformToSSA();
   void SimplifyCFG();
 
@@ -159,6 +166,9 @@ class HGraph : public ArenaObject {
     return reverse_post_order_;
   }
 
+  bool HasTryCatch() const { return has_try_catch_; }
+  void SetHasTryCatch(bool value) { has_try_catch_ = value; }
+
  private:
   HBasicBlock* FindCommonDominator(HBasicBlock* first, HBasicBlock* second) const;
   void VisitBlockForDominatorTree(HBasicBlock* block,
@@ -196,6 +206,10 @@ class HGraph : public ArenaObject {
   // The current id to assign to a newly added instruction. See HInstruction.id_.
   int current_instruction_id_;
 
+  // Whether the method has try items. Blocks covered by a try item have the
+  // catch blocks of its handlers as successors, after their normal successors.
+  bool has_try_catch_;
+
   DISALLOW_COPY_AND_ASSIGN(HGraph);
 };
 
@@ -290,7 +304,10 @@ class HBasicBlock : public ArenaObject {
         block_id_(-1),
         dex_pc_(dex_pc),
         lifetime_start_(kNoLifetime),
-        lifetime_end_(kNoLifetime) {}
+        lifetime_end_(kNoLifetime),
+        is_catch_block_(false),
+        catch_handlers_(graph->GetArena(), 0),
+        throwing_instructions_(graph->GetArena(), 0) {}
 
   const GrowableArray<HBasicBlock*>& GetPredecessors() const {
     return predecessors_;
@@ -358,6 +375,15 @@ class HBasicBlock : public ArenaObject {
     predecessors_.Delete(block);
   }
 
+  // Returns the number of successors reached by normal control flow. They come
+  // before the catch blocks this block may throw to.
+  size_t NumberOfNormalSuccessors() const {
+    size_t number_of_normal_successors = successors_.Size() - catch_handlers_.Size();
+    DCHECK(catch_handlers_.IsEmpty()
+           || successors_.Get(number_of_normal_successors) == catch_handlers_.Get(0));
+    return number_of_normal_successors;
+  }
+
   void ClearAllPredecessors() {
     predecessors_.Reset();
   }
@@ -448,6 +474,37 @@ class HBasicBlock : public ArenaObject {
 
   uint32_t GetDexPc() const { return dex_pc_; }
 
+  // Whether this block starts an exception handler. Such a block is entered
+  // by the runtime when delivering an exception, and its dex pc must be
+  // mapped to a native pc.
+  bool IsCatchBlock() const { return is_catch_block_; }
+  void SetIsCatchBlock() { is_catch_block_ = true; }
+  void ClearIsCatchBlock() { is_catch_block_ = false; }
+
+  // Adds an edge to `catch_block`, which handles the exceptions thrown by the
+  // instructions of this block. Must be called after the normal successors
+  // have been added.
+  void AddCatchHandler(HBasicBlock* catch_block) {
+    DCHECK(catch_block->IsCatchBlock());
+    catch_handlers_.Add(catch_block);
+    AddSuccessor(catch_block);
+  }
+
+  // The catch blocks this block may throw to. Also in the successors of the block.
+  const GrowableArray<HBasicBlock*>& GetCatchHandlers() const { return catch_handlers_; }
+  bool IsInTry() const { return !catch_handlers_.IsEmpty(); }
+
+  // For a catch block, the instructions that may throw to it. The phis of the
+  // catch block have one input per throwing instruction, in that order: the
+  // value of the dex register when the instruction throws.
+  void AddThrowingInstruction(HInstruction* instruction) {
+    DCHECK(IsCatchBlock());
+    throwing_instructions_.Add(instruction);
+  }
+  const GrowableArray<HInstruction*>& GetThrowingInstructions() const {
+    return throwing_instructions_;
+  }
+
  private:
   HGraph* const graph_;
   GrowableArray<HBasicBlock*> predecessors_;
@@ -462,6 +519,9 @@ class HBasicBlock : public ArenaObject {
   const uint32_t dex_pc_;
   size_t lifetime_start_;
   size_t lifetime_end_;
+  bool is_catch_block_;
+  GrowableArray<HBasicBlock*> catch_handlers_;
+  GrowableArray<HInstruction*> throwing_instructions_;
 
   DISALLOW_COPY_AND_ASSIGN(HBasicBlock);
 };
@@ -508,6 +568,28 @@ class HBasicBlock : public ArenaObject {
   M(FloatConstant, Constant)                                            \
   M(DoubleConstant, Constant)                                           \
   M(NewArray, Instruction)                                              \
+  M(And, BinaryOperation)                                               \
+  M(Or, BinaryOperation)                                                \
+  M(Xor, BinaryOperation)                                               \
+  M(LoadException, Instruction)                                         \
+  M(Throw, Instruction)                                                 \
+  M(PackedSwitch, Instruction)                                          \
+  M(Div, BinaryOperation)                                               \
+  M(Rem, BinaryOperation)                                               \
+  M(DivZeroCheck, Instruction)                                          \
+  M(Shl, BinaryOperation)                                               \
+  M(Shr, BinaryOperation)                                               \
+  M(UShr, BinaryOperation)                                              \
+  M(TypeConversion, Instruction)                                        \
+  M(MonitorOperation, Instruction)                                      \
+  M(LoadString, Instruction)                                            \
+  M(InvokeInterface, Invoke)                                            \
+  M(LoadClass, Instruction)                                             \
+  M(ClinitCheck, Instruction)                                           \
+  M(StaticFieldGet, Instruction)                                        \
+  M(StaticFieldSet, Instruction)                                        \
+  M(InstanceOf, Instruction)                                            \
+  M(CheckCast, Instruction)                                             \
 
 #define FOR_EACH_INSTRUCTION(M)                                         \
   FOR_EACH_CONCRETE_INSTRUCTION(M)                                      \
@@ -1093,6 +1175,43 @@ class HIf : public HTemplateInstruction<1> {
   DISALLOW_COPY_AND_ASSIGN(HIf);
 };
 
+// Multi-way branch on an int value. A block ending with an HPackedSwitch has
+// `num_entries + 1` successors: the block at index `i` is the target for the
+// value `start_value + i`, and the last one is the target for any value out
+// of that range. Several entries may branch to the same block.
+class HPackedSwitch : public HTemplateInstruction<1> {
+ public:
+  HPackedSwitch(int32_t start_value, uint32_t num_entries, HInstruction* input)
+      : HTemplateInstruction(SideEffects::None()),
+        start_value_(start_value),
+        num_entries_(num_entries) {
+    SetRawInputAt(0, input);
+  }
+
+  virtual bool IsControlFlow() const { return true; }
+
+  int32_t GetStartValue() const { return start_value_; }
+
+  uint32_t GetNumEntries() const { return num_entries_; }
+
+  HBasicBlock* GetCaseSuccessor(uint32_t index) const {
+    DCHECK_LT(index, num_entries_);
+    return GetBlock()->GetSuccessors().Get(index);
+  }
+
+  HBasicBlock* GetDefaultBlock() const {
+    return GetBlock()->GetSuccessors().Get(num_entries_);
+  }
+
+  DECLARE_INSTRUCTION(PackedSwitch);
+
+ private:
+  const int32_t start_value_;
+  const uint32_t num_entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(HPackedSwitch);
+};
+
 class HUnaryOperation : public HExpression<1> {
  public:
   HUnaryOperation(Primitive::Type result_type, HInstruction* input)
@@ -1510,6 +1629,9 @@ class HInvoke : public HInstruction {
   // know their environment.
   virtual bool NeedsEnvironment() const { return true; }
 
+  // The callee may throw.
+  virtual bool CanThrow() const { return true; }
+
   void SetArgumentAt(size_t index, HInstruction* argument) {
     SetRawInputAt(index, argument);
   }
@@ -1573,24 +1695,60 @@ class HInvokeVirtual : public HInvoke {
   DISALLOW_COPY_AND_ASSIGN(HInvokeVirtual);
 };
 
+// Calls an interface method through the interface method table of the
+// receiver's class. Conflicting entries of that table are resolved by the
+// runtime with the dex method index, passed as a hidden argument.
+class HInvokeInterface : public HInvoke {
+ public:
+  HInvokeInterface(ArenaAllocator* arena,
+                   uint32_t number_of_arguments,
+                   Primitive::Type return_type,
+                   uint32_t dex_pc,
+                   uint32_t dex_method_index,
+                   uint32_t imt_index)
+      : HInvoke(arena, number_of_arguments, return_type, dex_pc),
+        dex_method_index_(dex_method_index),
+        imt_index_(imt_index) {}
+
+  uint32_t GetDexMethodIndex() const { return dex_method_index_; }
+  uint32_t GetImtIndex() const { return imt_index_; }
+
+  DECLARE_INSTRUCTION(InvokeInterface);
+
+ private:
+  const uint32_t dex_method_index_;
+  const uint32_t imt_index_;
+
+  DISALLOW_COPY_AND_ASSIGN(HInvokeInterface);
+};
+
 class HNewInstance : public HExpression<0> {
  public:
-  HNewInstance(uint32_t dex_pc, uint16_t type_index)
+  HNewInstance(uint32_t dex_pc, uint16_t type_index, bool can_be_removed)
       : HExpression(Primitive::kPrimNot, SideEffects::None()),
         dex_pc_(dex_pc),
-        type_index_(type_index) {}
+        type_index_(type_index),
+        can_be_removed_(can_be_removed) {}
 
   uint32_t GetDexPc() const { return dex_pc_; }
   uint16_t GetTypeIndex() const { return type_index_; }
 
+  // Whether the allocation has no observable effect besides creating the
+  // object, and can therefore be removed if the object does not escape.
+  bool CanBeRemoved() const { return can_be_removed_; }
+
   // Calls runtime so needs an environment.
   virtual bool NeedsEnvironment() const { return true; }
 
+  // The allocation may throw, for example an OutOfMemoryError.
+  virtual bool CanThrow() const { return true; }
+
   DECLARE_INSTRUCTION(NewInstance);
 
  private:
   const uint32_t dex_pc_;
   const uint16_t type_index_;
+  const bool can_be_removed_;
 
   DISALLOW_COPY_AND_ASSIGN(HNewInstance);
 };
@@ -1624,6 +1782,9 @@ class HNewArray : public HExpression<1> {
   // Calls runtime so needs an environment.
   virtual bool NeedsEnvironment() const { return true; }
 
+  // The allocation may throw, for example a NegativeArraySizeException.
+  virtual bool CanThrow() const { return true; }
+
   DECLARE_INSTRUCTION(NewArray);
 
  private:
@@ -1633,6 +1794,41 @@ class HNewArray : public HExpression<1> {
   DISALLOW_COPY_AND_ASSIGN(HNewArray);
 };
 
+// Implements move-exception: reads the pending exception of the current
+// thread and clears it. Must be the first instruction of a catch block.
+class HLoadException : public HExpression<0> {
+ public:
+  HLoadException() : HExpression(Primitive::kPrimNot, SideEffects::ChangesSomething()) {}
+
+  DECLARE_INSTRUCTION(LoadException);
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(HLoadException);
+};
+
+class HThrow : public HTemplateInstruction<1> {
+ public:
+  HThrow(HInstruction* exception, uint32_t dex_pc)
+      : HTemplateInstruction(SideEffects::None()), dex_pc_(dex_pc) {
+    SetRawInputAt(0, exception);
+  }
+
+  virtual bool IsControlFlow() const { return true; }
+
+  virtual bool NeedsEnvironment() const { return true; }
+
+  virtual bool CanThrow() const { return true; }
+
+  uint32_t GetDexPc() const { return dex_pc_; }
+
+  DECLARE_INSTRUCTION(Throw);
+
+ private:
+  const uint32_t dex_pc_;
+
+  DISALLOW_COPY_AND_ASSIGN(HThrow);
+};
+
 class HAdd : public HBinaryOperation {
  public:
   HAdd(Primitive::Type result_type, HInstruction* left, HInstruction* right)
@@ -1689,6 +1885,394 @@ class HMul : public HBinaryOperation {
   DISALLOW_COPY_AND_ASSIGN(HMul);
 };
 
+class HAnd : public HBinaryOperation {
+ public:
+  HAnd(Primitive::Type result_type, HInstruction* left, HInstruction* right)
+      : HBinaryOperation(result_type, left, right) {}
+
+  virtual bool IsCommutative() { return true; }
+
+  virtual int32_t Evaluate(int32_t x, int32_t y) const { return x & y; }
+  virtual int64_t Evaluate(int64_t x, int64_t y) const { return x & y; }
+
+  DECLARE_INSTRUCTION(And);
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(HAnd);
+};
+
+class HOr : public HBinaryOperation {
+ public:
+  HOr(Primitive::Type result_type, HInstruction* left, HInstruction* right)
+      : HBinaryOperation(result_type, left, right) {}
+
+  virtual bool IsCommutative() { return true; }
+
+  virtual int32_t Evaluate(int32_t x, int32_t y) const { return x | y; }
+  virtual int64_t Evaluate(int64_t x, int64_t y) const { return x | y; }
+
+  DECLARE_INSTRUCTION(Or);
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(HOr);
+};
+
+class HXor : public HBinaryOperation {
+ public:
+  HXor(Primitive::Type result_type, HInstruction* left, HInstruction* right)
+      : HBinaryOperation(result_type, left, right) {}
+
+  virtual bool IsCommutative() { return true; }
+
+  virtual int32_t Evaluate(int32_t x, int32_t y) const { return x ^ y; }
+  virtual int64_t Evaluate(int64_t x, int64_t y) const { return x ^ y; }
+
+  DECLARE_INSTRUCTION(Xor);
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(HXor);
+};
+
+// Integer division. The divisor is checked against zero by a HDivZeroCheck
+// before the division, so the code generators only need to handle the
+// overflow of the smallest value divided by -1.
+class HDiv : public HBinaryOperation {
+ public:
+  HDiv(Primitive::Type result_type, HInstruction* left, HInstruction* right, uint32_t dex_pc)
+      : HBinaryOperation(result_type, left, right), dex_pc_(dex_pc) {}
+
+  virtual int32_t Evaluate(int32_t x, int32_t y) const {
+    // Java semantics: the division of the smallest value by -1 overflows to
+    // that value, and must not trap in the compiler.
+    DCHECK_NE(y, 0);
+    return (y == -1) ? static_cast<int32_t>(0u - static_cast<uint32_t>(x)) : x / y;
+  }
+  virtual int64_t Evaluate(int64_t x, int64_t y) const {
+    DCHECK_NE(y, 0);
+    return (y == -1) ? static_cast<int64_t>(0u - static_cast<uint64_t>(x)) : x / y;
+  }
+
+  uint32_t GetDexPc() const { return dex_pc_; }
+
+  DECLARE_INSTRUCTION(Div);
+
+ private:
+  const uint32_t dex_pc_;
+
+  DISALLOW_COPY_AND_ASSIGN(HDiv);
+};
+
+class HRem : public HBinaryOperation {
+ public:
+  HRem(Primitive::Type result_type, HInstruction* left, HInstruction* right, uint32_t dex_pc)
+      : HBinaryOperation(result_type, left, right), dex_pc_(dex_pc) {}
+
+  virtual int32_t Evaluate(int32_t x, int32_t y) const {
+    DCHECK_NE(y, 0);
+    return (y == -1) ? 0 : x % y;
+  }
+  virtual int64_t Evaluate(int64_t x, int64_t y) const {
+    DCHECK_NE(y, 0);
+    return (y == -1) ? 0 : x % y;
+  }
+
+  uint32_t GetDexPc() const { return dex_pc_; }
+
+  DECLARE_INSTRUCTION(Rem);
+
+ private:
+  const uint32_t dex_pc_;
+
+  DISALLOW_COPY_AND_ASSIGN(HRem);
+};
+
+// Throws an ArithmeticException if its input is zero, and otherwise
+// returns its input.
+class HDivZeroCheck : public HExpression<1> {
+ public:
+  HDivZeroCheck(HInstruction* value, uint32_t dex_pc)
+      : HExpression(value->GetType(), SideEffects::None()), dex_pc_(dex_pc) {
+    SetRawInputAt(0, value);
+  }
+
+  virtual bool CanBeMoved() const { return true; }
+  virtual bool InstructionDataEquals(HInstruction* other) const { return true; }
+
+  virtual bool NeedsEnvironment() const { return true; }
+
+  virtual bool CanThrow() const { return true; }
+
+  uint32_t GetDexPc() const { return dex_pc_; }
+
+  DECLARE_INSTRUCTION(DivZeroCheck);
+
+ private:
+  const uint32_t dex_pc_;
+
+  DISALLOW_COPY_AND_ASSIGN(HDivZeroCheck);
+};
+
+// Shifts only use the low 5 bits (6 bits for longs) of their distance,
+// like the Java operators.
+class HShl : public HBinaryOperation {
+ public:
+  HShl(Primitive::Type result_type, HInstruction* left, HInstruction* right)
+      : HBinaryOperation(result_type, left, right) {}
+
+  virtual int32_t Evaluate(int32_t x, int32_t y) const {
+    return static_cast<int32_t>(static_cast<uint32_t>(x) << (y & kMaxIntShiftValue));
+  }
+  virtual int64_t Evaluate(int64_t x, int64_t y) const {
+    return static_cast<int64_t>(static_cast<uint64_t>(x) << (y & kMaxLongShiftValue));
+  }
+
+  DECLARE_INSTRUCTION(Shl);
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(HShl);
+};
+
+class HShr : public HBinaryOperation {
+ public:
+  HShr(Primitive::Type result_type, HInstruction* left, HInstruction* right)
+      : HBinaryOperation(result_type, left, right) {}
+
+  virtual int32_t Evaluate(int32_t x, int32_t y) const { return x >> (y & kMaxIntShiftValue); }
+  virtual int64_t Evaluate(int64_t x, int64_t y) const { return x >> (y & kMaxLongShiftValue); }
+
+  DECLARE_INSTRUCTION(Shr);
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(HShr);
+};
+
+class HUShr : public HBinaryOperation {
+ public:
+  HUShr(Primitive::Type result_type, HInstruction* left, HInstruction* right)
+      : HBinaryOperation(result_type, left, right) {}
+
+  virtual int32_t Evaluate(int32_t x, int32_t y) const {
+    return static_cast<int32_t>(static_cast<uint32_t>(x) >> (y & kMaxIntShiftValue));
+  }
+  virtual int64_t Evaluate(int64_t x, int64_t y) const {
+    return static_cast<int64_t>(static_cast<uint64_t>(x) >> (y & kMaxLongShiftValue));
+  }
+
+  DECLARE_INSTRUCTION(UShr);
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(HUShr);
+};
+
+// Converts its input to `result_type`, following the rules of the dex
+// conversion instructions: int-to-byte/short/char and the conversions between
+// int, long, float and double.
+class HTypeConversion : public HExpression<1> {
+ public:
+  HTypeConversion(Primitive::Type result_type, HInstruction* input, uint32_t dex_pc)
+      : HExpression(result_type, SideEffects::None()), dex_pc_(dex_pc) {
+    SetRawInputAt(0, input);
+    DCHECK_NE(input->GetType(), result_type);
+  }
+
+  HInstruction* GetInput() const { return InputAt(0); }
+  Primitive::Type GetInputType() const { return GetInput()->GetType(); }
+  Primitive::Type GetResultType() const { return GetType(); }
+
+  // Some conversions are implemented with a runtime call.
+  uint32_t GetDexPc() const { return dex_pc_; }
+
+  virtual bool CanBeMoved() const { return true; }
+  virtual bool InstructionDataEquals(HInstruction* other) const { return true; }
+
+  DECLARE_INSTRUCTION(TypeConversion);
+
+ private:
+  const uint32_t dex_pc_;
+
+  DISALLOW_COPY_AND_ASSIGN(HTypeConversion);
+};
+
+// Implements monitor-enter and monitor-exit through the runtime, which
+// also throws the NullPointerException for a null object.
+class HMonitorOperation : public HTemplateInstruction<1> {
+ public:
+  enum OperationKind {
+    kEnter,
+    kExit,
+  };
+
+  HMonitorOperation(HInstruction* object, OperationKind kind, uint32_t dex_pc)
+      : HTemplateInstruction(SideEffects::ChangesSomething()), kind_(kind), dex_pc_(dex_pc) {
+    SetRawInputAt(0, object);
+  }
+
+  virtual bool NeedsEnvironment() const { return true; }
+
+  virtual bool CanThrow() const { return true; }
+
+  bool IsEnter() const { return kind_ == kEnter; }
+
+  uint32_t GetDexPc() const { return dex_pc_; }
+
+  DECLARE_INSTRUCTION(MonitorOperation);
+
+ private:
+  const OperationKind kind_;
+  const uint32_t dex_pc_;
+
+  DISALLOW_COPY_AND_ASSIGN(HMonitorOperation);
+};
+
+// Loads a string from the dex cache of the current method, and resolves it
+// through the runtime when the cache entry is still null.
+class HLoadString : public HExpression<0> {
+ public:
+  HLoadString(uint32_t string_index, uint32_t dex_pc)
+      : HExpression(Primitive::kPrimNot, SideEffects::None()),
+        string_index_(string_index),
+        dex_pc_(dex_pc) {}
+
+  virtual bool CanBeMoved() const { return true; }
+  virtual bool InstructionDataEquals(HInstruction* other) const {
+    return other->AsLoadString()->string_index_ == string_index_;
+  }
+
+  // Calls the runtime on the slow path, so needs an environment.
+  virtual bool NeedsEnvironment() const { return true; }
+
+  // Resolving the string may throw.
+  virtual bool CanThrow() const { return true; }
+
+  uint32_t GetStringIndex() const { return string_index_; }
+  uint32_t GetDexPc() const { return dex_pc_; }
+
+  DECLARE_INSTRUCTION(LoadString);
+
+ private:
+  const uint32_t string_index_;
+  const uint32_t dex_pc_;
+
+  DISALLOW_COPY_AND_ASSIGN(HLoadString);
+};
+
+// Loads a class. The class of the current method is read from that method,
+// and any other class from its dex cache, calling the runtime to resolve the
+// class when the cache entry is still null.
+class HLoadClass : public HExpression<0> {
+ public:
+  HLoadClass(uint16_t type_index, bool is_referrers_class, uint32_t dex_pc)
+      : HExpression(Primitive::kPrimNot, SideEffects::None()),
+        type_index_(type_index),
+        is_referrers_class_(is_referrers_class),
+        dex_pc_(dex_pc) {}
+
+  virtual bool CanBeMoved() const { return true; }
+  virtual bool InstructionDataEquals(HInstruction* other) const {
+    return other->AsLoadClass()->type_index_ == type_index_;
+  }
+
+  // Only a class read from the dex cache may need to be resolved.
+  virtual bool NeedsEnvironment() const { return !is_referrers_class_; }
+  virtual bool CanThrow() const { return !is_referrers_class_; }
+
+  uint16_t GetTypeIndex() const { return type_index_; }
+  bool IsReferrersClass() const { return is_referrers_class_; }
+  uint32_t GetDexPc() const { return dex_pc_; }
+
+  DECLARE_INSTRUCTION(LoadClass);
+
+ private:
+  const uint16_t type_index_;
+  const bool is_referrers_class_;
+  const uint32_t dex_pc_;
+
+  DISALLOW_COPY_AND_ASSIGN(HLoadClass);
+};
+
+// Initializes the class given as input if it is not initialized yet, and
+// returns that class.
+class HClinitCheck : public HExpression<1> {
+ public:
+  HClinitCheck(HLoadClass* load_class, uint32_t dex_pc)
+      // Running the static initializer may change anything.
+      : HExpression(Primitive::kPrimNot, SideEffects::ChangesSomething()),
+        dex_pc_(dex_pc) {
+    SetRawInputAt(0, load_class);
+  }
+
+  virtual bool CanBeMoved() const { return true; }
+  virtual bool InstructionDataEquals(HInstruction* other) const { return true; }
+
+  virtual bool NeedsEnvironment() const { return true; }
+
+  virtual bool CanThrow() const { return true; }
+
+  HLoadClass* GetLoadClass() const { return InputAt(0)->AsLoadClass(); }
+  uint32_t GetDexPc() const { return dex_pc_; }
+
+  DECLARE_INSTRUCTION(ClinitCheck);
+
+ private:
+  const uint32_t dex_pc_;
+
+  DISALLOW_COPY_AND_ASSIGN(HClinitCheck);
+};
+
+// Returns whether its object input is an instance of its class input. Null
+// is an instance of no class. Unless both classes are the same, the runtime
+// is called to walk the class hierarchy.
+class HInstanceOf : public HExpression<2> {
+ public:
+  HInstanceOf(HInstruction* object, HLoadClass* load_class, uint32_t dex_pc)
+      : HExpression(Primitive::kPrimBoolean, SideEffects::None()), dex_pc_(dex_pc) {
+    SetRawInputAt(0, object);
+    SetRawInputAt(1, load_class);
+  }
+
+  virtual bool CanBeMoved() const { return true; }
+  virtual bool InstructionDataEquals(HInstruction* other) const { return true; }
+
+  // Calls the runtime on the slow path, so needs an environment.
+  virtual bool NeedsEnvironment() const { return true; }
+
+  uint32_t GetDexPc() const { return dex_pc_; }
+
+  DECLARE_INSTRUCTION(InstanceOf);
+
+ private:
+  const uint32_t dex_pc_;
+
+  DISALLOW_COPY_AND_ASSIGN(HInstanceOf);
+};
+
+// Throws a ClassCastException if its object input is neither null nor an
+// instance of its class input.
+class HCheckCast : public HTemplateInstruction<2> {
+ public:
+  HCheckCast(HInstruction* object, HLoadClass* load_class, uint32_t dex_pc)
+      : HTemplateInstruction(SideEffects::None()), dex_pc_(dex_pc) {
+    SetRawInputAt(0, object);
+    SetRawInputAt(1, load_class);
+  }
+
+  virtual bool CanBeMoved() const { return true; }
+  virtual bool InstructionDataEquals(HInstruction* other) const { return true; }
+
+  virtual bool NeedsEnvironment() const { return true; }
+
+  virtual bool CanThrow() const { return true; }
+
+  uint32_t GetDexPc() const { return dex_pc_; }
+
+  DECLARE_INSTRUCTION(CheckCast);
+
+ private:
+  const uint32_t dex_pc_;
+
+  DISALLOW_COPY_AND_ASSIGN(HCheckCast);
+};
+
 // The value of a parameter in this method. Its location depends on
 // the calling convention.
 class HParameterValue : public HExpression<0> {
@@ -1750,6 +2334,10 @@ class HPhi : public HInstruction {
 
   uint32_t GetRegNumber() const { return reg_number_; }
 
+  // A catch phi merges the values of its dex register at the instructions
+  // throwing to the catch block, see HBasicBlock::GetThrowingInstructions.
+  bool IsCatchPhi() const { return GetBlock()->IsCatchBlock(); }
+
   void SetDead() { is_live_ = false; }
   void SetLive() { is_live_ = true; }
   bool IsDead() const { return !is_live_; }
@@ -1857,6 +2445,61 @@ class HInstanceFieldSet : public HTemplateInstruction<2> {
   DISALLOW_COPY_AND_ASSIGN(HInstanceFieldSet);
 };
 
+// Reads a static field. Its input is the class holding the field.
+class HStaticFieldGet : public HExpression<1> {
+ public:
+  HStaticFieldGet(HInstruction* cls,
+                  Primitive::Type field_type,
+                  MemberOffset field_offset)
+      : HExpression(field_type, SideEffects::DependsOnSomething()),
+        field_info_(field_offset, field_type) {
+    SetRawInputAt(0, cls);
+  }
+
+  virtual bool CanBeMoved() const { return true; }
+  virtual bool InstructionDataEquals(HInstruction* other) const {
+    size_t other_offset = other->AsStaticFieldGet()->GetFieldOffset().SizeValue();
+    return other_offset == GetFieldOffset().SizeValue();
+  }
+
+  virtual size_t ComputeHashCode() const {
+    return (HInstruction::ComputeHashCode() << 7) | GetFieldOffset().SizeValue();
+  }
+
+  MemberOffset GetFieldOffset() const { return field_info_.GetFieldOffset(); }
+  Primitive::Type GetFieldType() const { return field_info_.GetFieldType(); }
+
+  DECLARE_INSTRUCTION(StaticFieldGet);
+
+ private:
+  const FieldInfo field_info_;
+
+  DISALLOW_COPY_AND_ASSIGN(HStaticFieldGet);
+};
+
+class HStaticFieldSet : public HTemplateInstruction<2> {
+ public:
+  HStaticFieldSet(HInstruction* cls,
+                  HInstruction* value,
+                  Primitive::Type field_type,
+                  MemberOffset field_offset)
+      : HTemplateInstruction(SideEffects::ChangesSomething()),
+        field_info_(field_offset, field_type) {
+    SetRawInputAt(0, cls);
+    SetRawInputAt(1, value);
+  }
+
+  MemberOffset GetFieldOffset() const { return field_info_.GetFieldOffset(); }
+  Primitive::Type GetFieldType() const { return field_info_.GetFieldType(); }
+
+  DECLARE_INSTRUCTION(StaticFieldSet);
+
+ private:
+  const FieldInfo field_info_;
+
+  DISALLOW_COPY_AND_ASSIGN(HStaticFieldSet);
+};
+
 class HArrayGet : public HExpression<2> {
  public:
   HArrayGet(HInstruction* array, HInstruction* index, Primitive::Type type)
@@ -1893,9 +2536,11 @@ class HArraySet : public HTemplateInstruction<3> {
   virtual bool NeedsEnvironment() const {
     // We currently always call a runtime method to catch array store
     // exceptions.
-    return InputAt(2)->GetType() == Primitive::kPrimNot;
+    return GetComponentType() == Primitive::kPrimNot;
   }
 
+  virtual bool CanThrow() const { return NeedsEnvironment(); }
+
   uint32_t GetDexPc() const { return dex_pc_; }
 
   HInstruction* GetValue() const { return InputAt(2); }
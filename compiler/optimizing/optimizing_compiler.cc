@@ -24,11 +24,13 @@
 #include "compiler.h"
 #include "constant_folding.h"
 #include "dead_code_elimination.h"
+#include "dex_instruction.h"
 #include "driver/compiler_driver.h"
 #include "driver/dex_compilation_unit.h"
 #include "graph_visualizer.h"
 #include "gvn.h"
 #include "instruction_simplifier.h"
+#include "load_store_elimination.h"
 #include "nodes.h"
 #include "prepare_for_register_allocation.h"
 #include "register_allocator.h"
@@ -125,6 +127,10 @@ class OptimizingCompiler FINAL : public Compiler {
   mutable AtomicInteger total_compiled_methods_;
   mutable AtomicInteger unoptimized_compiled_methods_;
   mutable AtomicInteger optimized_compiled_methods_;
+  mutable AtomicInteger graph_colored_methods_;
+  // Number of methods the graph builder gave up on, indexed by the opcode
+  // of the first instruction it could not handle.
+  mutable AtomicInteger bailouts_per_opcode_[kNumPackedOpcodes];
 
   std::unique_ptr<std::ostream> visualizer_output_;
 
@@ -144,6 +150,7 @@ OptimizingCompiler::OptimizingCompiler(CompilerDriver* driver)
       total_compiled_methods_(0),
       unoptimized_compiled_methods_(0),
       optimized_compiled_methods_(0),
+      graph_colored_methods_(0),
       delegate_(Create(driver, Compiler::Kind::kQuick)) {
   if (kIsVisualizerEnabled) {
     visualizer_output_.reset(new std::ofstream("art.cfg"));
@@ -166,7 +173,14 @@ OptimizingCompiler::~OptimizingCompiler() {
     size_t optimized_percent = (optimized_compiled_methods_ * 100 / total_compiled_methods_);
     LOG(INFO) << "Compiled " << total_compiled_methods_ << " methods: "
               << unoptimized_percent << "% (" << unoptimized_compiled_methods_ << ") unoptimized, "
-              << optimized_percent << "% (" << optimized_compiled_methods_ << ") optimized.";
+              << optimized_percent << "% (" << optimized_compiled_methods_ << ") optimized, "
+              << graph_colored_methods_ << " with graph coloring.";
+  }
+  for (size_t i = 0; i < kNumPackedOpcodes; ++i) {
+    if (bailouts_per_opcode_[i] != 0) {
+      LOG(INFO) << "Bailed out on " << bailouts_per_opcode_[i] << " methods using "
+                << Instruction::Name(static_cast<Instruction::Code>(i));
+    }
   }
 }
 
@@ -250,6 +264,10 @@ CompiledMethod* OptimizingCompiler::TryCompile(const DexFile::CodeItem* code_ite
 
   HGraph* graph = builder.BuildGraph(*code_item);
   if (graph == nullptr) {
+    const Instruction* unsupported_instruction = builder.GetUnsupportedInstruction();
+    if (unsupported_instruction != nullptr) {
+      bailouts_per_opcode_[unsupported_instruction->Opcode()]++;
+    }
     CHECK(!shouldCompile) << "Could not build graph in optimizing compiler";
     return nullptr;
   }
@@ -266,9 +284,15 @@ CompiledMethod* OptimizingCompiler::TryCompile(const DexFile::CodeItem* code_ite
 
   CodeVectorAllocator allocator;
 
-  if (run_optimizations_ && RegisterAllocator::CanAllocateRegistersFor(*graph, instruction_set)) {
+  bool can_optimize = run_optimizations_
+      && RegisterAllocator::CanAllocateRegistersFor(*graph, instruction_set);
+  // Building the dominator tree fails for a catch block throwing to itself, like
+  // the handler of a synchronized block covering its own monitor-exit: the phis
+  // of the catch block cannot be built. The baseline compiler handles it.
+  bool has_dominator_tree = can_optimize && graph->BuildDominatorTree();
+
+  if (has_dominator_tree) {
     optimized_compiled_methods_++;
-    graph->BuildDominatorTree();
     graph->TransformToSSA();
     visualizer.DumpGraph("ssa");
     graph->FindNaturalLoops();
@@ -281,13 +305,18 @@ CompiledMethod* OptimizingCompiler::TryCompile(const DexFile::CodeItem* code_ite
     InstructionSimplifier(graph).Run();
     GlobalValueNumberer(graph->GetArena(), graph).Run();
     visualizer.DumpGraph(kGVNPassName);
+    LoadStoreElimination(graph, visualizer).Execute();
     PrepareForRegisterAllocation(graph).Run();
 
     SsaLivenessAnalysis liveness(*graph, codegen);
     liveness.Analyze();
     visualizer.DumpGraph(kLivenessPassName);
 
-    RegisterAllocator register_allocator(graph->GetArena(), codegen, liveness);
+    RegisterAllocator::Strategy strategy = RegisterAllocator::SelectStrategy(*graph, liveness);
+    if (strategy == RegisterAllocator::kGraphColor) {
+      graph_colored_methods_++;
+    }
+    RegisterAllocator register_allocator(graph->GetArena(), codegen, liveness, strategy);
     register_allocator.AllocateRegisters();
 
     visualizer.DumpGraph(kRegisterAllocatorPassName);
@@ -318,16 +347,17 @@ CompiledMethod* OptimizingCompiler::TryCompile(const DexFile::CodeItem* code_ite
     codegen->CompileBaseline(&allocator);
 
     // Run these phases to get some test coverage.
-    graph->BuildDominatorTree();
-    graph->TransformToSSA();
-    visualizer.DumpGraph("ssa");
-    graph->FindNaturalLoops();
-    SsaRedundantPhiElimination(graph).Run();
-    SsaDeadPhiElimination(graph).Run();
-    GlobalValueNumberer(graph->GetArena(), graph).Run();
-    SsaLivenessAnalysis liveness(*graph, codegen);
-    liveness.Analyze();
-    visualizer.DumpGraph(kLivenessPassName);
+    if (!can_optimize && graph->BuildDominatorTree()) {
+      graph->TransformToSSA();
+      visualizer.DumpGraph("ssa");
+      graph->FindNaturalLoops();
+      SsaRedundantPhiElimination(graph).Run();
+      SsaDeadPhiElimination(graph).Run();
+      GlobalValueNumberer(graph->GetArena(), graph).Run();
+      SsaLivenessAnalysis liveness(*graph, codegen);
+      liveness.Analyze();
+      visualizer.DumpGraph(kLivenessPassName);
+    }
 
     std::vector<uint8_t> mapping_table;
     SrcMap src_mapping_table;
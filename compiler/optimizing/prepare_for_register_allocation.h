@@ -23,8 +23,9 @@ namespace art {
 
 /**
  * A simplification pass over the graph before doing register allocation.
- * For example it changes uses of null checks and bounds checks to the original
- * objects, to avoid creating a live range for these checks.
+ * For example it changes uses of null checks, bounds checks and class
+ * initialization checks to the original objects, to avoid creating a live
+ * range for these checks.
  */
 class PrepareForRegisterAllocation : public HGraphDelegateVisitor {
  public:
@@ -35,6 +36,8 @@ class PrepareForRegisterAllocation : public HGraphDelegateVisitor {
  private:
   virtual void VisitNullCheck(HNullCheck* check) OVERRIDE;
   virtual void VisitBoundsCheck(HBoundsCheck* check) OVERRIDE;
+  virtual void VisitDivZeroCheck(HDivZeroCheck* check) OVERRIDE;
+  virtual void VisitClinitCheck(HClinitCheck* check) OVERRIDE;
   virtual void VisitCondition(HCondition* condition) OVERRIDE;
 
   DISALLOW_COPY_AND_ASSIGN(PrepareForRegisterAllocation);
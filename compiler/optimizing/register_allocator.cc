@@ -27,9 +27,14 @@ namespace art {
 static constexpr size_t kMaxLifetimePosition = -1;
 static constexpr size_t kDefaultNumberOfSpillSlots = 4;
 
+// Above this number of SSA values, building the interference graph is deemed
+// too expensive and we stick to the linear scan.
+static constexpr size_t kMaxSsaValuesForGraphColoring = 512;
+
 RegisterAllocator::RegisterAllocator(ArenaAllocator* allocator,
                                      CodeGenerator* codegen,
-                                     const SsaLivenessAnalysis& liveness)
+                                     const SsaLivenessAnalysis& liveness,
+                                     Strategy strategy)
       : allocator_(allocator),
         codegen_(codegen),
         liveness_(liveness),
@@ -50,13 +55,25 @@ RegisterAllocator::RegisterAllocator(ArenaAllocator* allocator,
         blocked_core_registers_(codegen->GetBlockedCoreRegisters()),
         blocked_fp_registers_(codegen->GetBlockedFloatingPointRegisters()),
         reserved_out_slots_(0),
-        maximum_number_of_live_registers_(0) {
+        number_of_catch_slots_(0),
+        maximum_number_of_live_registers_(0),
+        strategy_(strategy),
+        number_of_colored_intervals_(0),
+        number_of_uncolored_intervals_(0) {
   codegen->SetupBlockedRegisters();
   physical_core_register_intervals_.SetSize(codegen->GetNumberOfCoreRegisters());
   physical_fp_register_intervals_.SetSize(codegen->GetNumberOfFloatingPointRegisters());
   // Always reserve for the current method and the graph's max out registers.
   // TODO: compute it instead.
   reserved_out_slots_ = 1 + codegen->GetGraph()->GetMaximumNumberOfOutVRegs();
+  for (size_t i = 0, e = liveness.GetNumberOfSsaValues(); i < e; ++i) {
+    HInstruction* instruction = liveness.GetInstructionFromSsaIndex(i);
+    if (instruction->IsPhi() && instruction->AsPhi()->IsCatchPhi()) {
+      size_t end = instruction->AsPhi()->GetRegNumber()
+          + (instruction->GetLiveInterval()->NeedsTwoSpillSlots() ? 2 : 1);
+      number_of_catch_slots_ = std::max(number_of_catch_slots_, end);
+    }
+  }
 }
 
 bool RegisterAllocator::CanAllocateRegistersFor(const HGraph& graph,
@@ -79,6 +96,21 @@ bool RegisterAllocator::CanAllocateRegistersFor(const HGraph& graph,
   return true;
 }
 
+RegisterAllocator::Strategy RegisterAllocator::SelectStrategy(const HGraph& graph,
+                                                              const SsaLivenessAnalysis& liveness) {
+  if (liveness.GetNumberOfSsaValues() > kMaxSsaValuesForGraphColoring) {
+    return kLinearScan;
+  }
+  // Spill and split moves inside loops is where the linear scan hurts the most.
+  for (size_t i = 0, e = graph.GetBlocks().Size(); i < e; ++i) {
+    HBasicBlock* block = graph.GetBlocks().Get(i);
+    if (block != nullptr && block->IsLoopHeader()) {
+      return kGraphColor;
+    }
+  }
+  return kLinearScan;
+}
+
 static bool ShouldProcess(bool processing_core_registers, LiveInterval* interval) {
   if (interval == nullptr) return false;
   bool is_core_register = (interval->GetType() != Primitive::kPrimDouble)
@@ -144,6 +176,9 @@ void RegisterAllocator::AllocateRegistersInternal() {
       inactive_.Add(fixed);
     }
   }
+  if (strategy_ == kGraphColor) {
+    ColorGraph();
+  }
   LinearScan();
 
   size_t saved_maximum_number_of_live_registers = maximum_number_of_live_registers_;
@@ -163,6 +198,9 @@ void RegisterAllocator::AllocateRegistersInternal() {
       inactive_.Add(fixed);
     }
   }
+  if (strategy_ == kGraphColor) {
+    ColorGraph();
+  }
   LinearScan();
   maximum_number_of_live_registers_ += saved_maximum_number_of_live_registers;
 }
@@ -173,10 +211,11 @@ void RegisterAllocator::ProcessInstruction(HInstruction* instruction) {
 
   if (locations == nullptr) return;
 
-  // Create synthesized intervals for temporaries.
+  // Create synthesized intervals for temporaries. Unallocated temps are
+  // assigned in order, so they must come before any fixed temp.
   for (size_t i = 0; i < locations->GetTempCount(); ++i) {
     Location temp = locations->GetTemp(i);
-    if (temp.IsRegister()) {
+    if (temp.IsRegister() || temp.IsFpuRegister()) {
       BlockRegister(temp, position, position + 1);
     } else {
       DCHECK(temp.IsUnallocated());
@@ -339,7 +378,8 @@ bool RegisterAllocator::ValidateInternal(bool log_fatal_on_failure) const {
     }
   }
 
-  return ValidateIntervals(intervals, spill_slots_.Size(), reserved_out_slots_, *codegen_,
+  return ValidateIntervals(intervals, spill_slots_.Size(),
+                           reserved_out_slots_ + number_of_catch_slots_, *codegen_,
                            allocator_, processing_core_registers_, log_fatal_on_failure);
 }
 
@@ -668,6 +708,14 @@ bool RegisterAllocator::AllocateBlockedReg(LiveInterval* current) {
           if (inactive->IsFixed()) {
             LiveInterval* split = Split(current, next_intersection);
             AddSorted(unhandled_, split);
+          } else if (inactive->StartsAfter(current)) {
+            // Only intervals colored ahead of time can start after `current`. Give
+            // the interval back to the linear scan.
+            DCHECK_EQ(strategy_, kGraphColor);
+            inactive->ClearRegister();
+            inactive_.DeleteAt(i);
+            AddSorted(unhandled_, inactive);
+            --i;
           } else {
             LiveInterval* split = Split(inactive, current->GetStart());
             inactive_.DeleteAt(i);
@@ -683,6 +731,184 @@ bool RegisterAllocator::AllocateBlockedReg(LiveInterval* current) {
   }
 }
 
+// Returns the number of uses of `interval` that are within its live range.
+static size_t NumberOfUses(LiveInterval* interval) {
+  size_t count = 0;
+  size_t start = interval->GetStart();
+  size_t end = interval->GetEnd();
+  for (UsePosition* use = interval->GetFirstUse();
+       use != nullptr && use->GetPosition() <= end;
+       use = use->GetNext()) {
+    if (use->GetPosition() >= start) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+// Returns whether spilling `lhs` is cheaper than spilling `rhs`: intervals with
+// fewer uses per lifetime position are spilled first.
+static bool IsCheaperToSpill(LiveInterval* lhs, LiveInterval* rhs) {
+  size_t lhs_weight = (NumberOfUses(lhs) + 1) * (rhs->GetEnd() - rhs->GetStart());
+  size_t rhs_weight = (NumberOfUses(rhs) + 1) * (lhs->GetEnd() - lhs->GetStart());
+  return lhs_weight < rhs_weight;
+}
+
+// Color the interference graph of the intervals in `unhandled_`. Intervals that get a
+// color are assigned that register for their whole lifetime, and moved to `inactive_`:
+// the linear scan will treat them like intervals already allocated. The remaining
+// intervals are left in `unhandled_` for the linear scan to split and spill.
+void RegisterAllocator::ColorGraph() {
+  GrowableArray<LiveInterval*> nodes(allocator_, unhandled_->Size());
+  GrowableArray<LiveInterval*> uncolored(allocator_, 0);
+  for (size_t i = 0, e = unhandled_->Size(); i < e; ++i) {
+    LiveInterval* interval = unhandled_->Get(i);
+    if (interval->IsSlowPathSafepoint()) {
+      // Not a value, the linear scan uses it to compute the live registers at slow paths.
+      uncolored.Add(interval);
+    } else {
+      nodes.Add(interval);
+    }
+  }
+  size_t number_of_slow_paths = uncolored.Size();
+
+  size_t number_of_nodes = nodes.Size();
+  size_t number_of_available_registers = 0;
+  for (size_t reg = 0; reg < number_of_registers_; ++reg) {
+    if (!IsBlocked(reg)) {
+      ++number_of_available_registers;
+    }
+  }
+
+  // (1) Build the interference graph. Fixed intervals are not nodes of the graph:
+  //     they are taken into account when picking a color.
+  ArenaBitVector** interferences = allocator_->AllocArray<ArenaBitVector*>(number_of_nodes);
+  size_t* degrees = allocator_->AllocArray<size_t>(number_of_nodes);
+  for (size_t i = 0; i < number_of_nodes; ++i) {
+    interferences[i] = new (allocator_) ArenaBitVector(allocator_, number_of_nodes, false);
+    degrees[i] = 0;
+  }
+  for (size_t i = 0; i < number_of_nodes; ++i) {
+    for (size_t j = i + 1; j < number_of_nodes; ++j) {
+      if (nodes.Get(i)->FirstIntersectionWith(nodes.Get(j)) != kNoLifetime) {
+        interferences[i]->SetBit(j);
+        interferences[j]->SetBit(i);
+        ++degrees[i];
+        ++degrees[j];
+      }
+    }
+  }
+
+  // (2) Simplify: repeatedly remove a node with fewer neighbors than available
+  //     registers. If there is none, optimistically remove the cheapest node to spill:
+  //     it may still get a color when selecting.
+  bool* removed = allocator_->AllocArray<bool>(number_of_nodes);
+  for (size_t i = 0; i < number_of_nodes; ++i) {
+    removed[i] = false;
+  }
+  GrowableArray<size_t> select_stack(allocator_, number_of_nodes);
+  for (size_t count = 0; count < number_of_nodes; ++count) {
+    size_t candidate = number_of_nodes;
+    for (size_t i = 0; i < number_of_nodes; ++i) {
+      if (removed[i]) continue;
+      if (degrees[i] < number_of_available_registers) {
+        candidate = i;
+        break;
+      }
+      if (candidate == number_of_nodes
+          || IsCheaperToSpill(nodes.Get(i), nodes.Get(candidate))) {
+        candidate = i;
+      }
+    }
+    DCHECK_NE(candidate, number_of_nodes);
+    removed[candidate] = true;
+    select_stack.Add(candidate);
+    for (uint32_t neighbor : interferences[candidate]->Indexes()) {
+      if (!removed[neighbor]) {
+        --degrees[neighbor];
+      }
+    }
+  }
+
+  // (3) Select: give colors in the reverse order of removal. Intervals that have
+  //     a fixed register output are precolored and handled first, so that no
+  //     neighbor takes their register.
+  GrowableArray<size_t> color_order(allocator_, number_of_nodes);
+  for (size_t i = 0; i < number_of_nodes; ++i) {
+    if (nodes.Get(i)->HasRegister()) {
+      color_order.Add(i);
+    }
+  }
+  while (!select_stack.IsEmpty()) {
+    size_t node = select_stack.Pop();
+    if (!nodes.Get(node)->HasRegister()) {
+      color_order.Add(node);
+    }
+  }
+
+  GrowableArray<LiveInterval*>& fixed_intervals = processing_core_registers_
+      ? physical_core_register_intervals_
+      : physical_fp_register_intervals_;
+  size_t* free_until = registers_array_;
+  for (size_t i = 0, e = color_order.Size(); i < e; ++i) {
+    size_t node = color_order.Get(i);
+    LiveInterval* current = nodes.Get(node);
+
+    // A register is free if it is free for the whole lifetime of `current`.
+    for (size_t reg = 0; reg < number_of_registers_; ++reg) {
+      free_until[reg] = IsBlocked(reg) ? 0 : kMaxLifetimePosition;
+    }
+    for (size_t j = 0, f = fixed_intervals.Size(); j < f; ++j) {
+      LiveInterval* fixed = fixed_intervals.Get(j);
+      if (fixed != nullptr && fixed->FirstIntersectionWith(current) != kNoLifetime) {
+        free_until[fixed->GetRegister()] = 0;
+      }
+    }
+    for (uint32_t neighbor : interferences[node]->Indexes()) {
+      LiveInterval* other = nodes.Get(neighbor);
+      if (other->HasRegister()) {
+        free_until[other->GetRegister()] = 0;
+      }
+    }
+
+    int reg = kNoRegister;
+    if (current->HasRegister()) {
+      if (free_until[current->GetRegister()] != 0) {
+        reg = current->GetRegister();
+      }
+    } else {
+      // Biasing the color with the hints coalesces phis with their inputs, and
+      // instructions with their expected input and output registers.
+      reg = current->FindFirstRegisterHint(free_until);
+      if (reg == kNoRegister) {
+        for (size_t r = 0; r < number_of_registers_; ++r) {
+          if (free_until[r] != 0) {
+            reg = r;
+            break;
+          }
+        }
+      }
+    }
+
+    if (reg == kNoRegister) {
+      uncolored.Add(current);
+    } else {
+      current->SetRegister(reg);
+      inactive_.Add(current);
+    }
+  }
+
+  size_t number_of_uncolored_nodes = uncolored.Size() - number_of_slow_paths;
+  number_of_colored_intervals_ += number_of_nodes - number_of_uncolored_nodes;
+  number_of_uncolored_intervals_ += number_of_uncolored_nodes;
+
+  // (4) Give the remaining intervals to the linear scan.
+  unhandled_->Reset();
+  for (size_t i = 0, e = uncolored.Size(); i < e; ++i) {
+    AddSorted(unhandled_, uncolored.Get(i));
+  }
+}
+
 void RegisterAllocator::AddSorted(GrowableArray<LiveInterval*>* array, LiveInterval* interval) {
   DCHECK(!interval->IsFixed() && !interval->HasSpillSlot());
   size_t insert_at = 0;
@@ -770,7 +996,7 @@ void RegisterAllocator::AllocateSpillSlotFor(LiveInterval* interval) {
     }
   }
 
-  parent->SetSpillSlot((slot + reserved_out_slots_) * kVRegSize);
+  parent->SetSpillSlot((slot + reserved_out_slots_ + number_of_catch_slots_) * kVRegSize);
 }
 
 static bool IsValidDestination(Location destination) {
@@ -857,7 +1083,7 @@ void RegisterAllocator::InsertParallelMoveAtExitOf(HBasicBlock* block,
   DCHECK(IsValidDestination(destination));
   if (source.Equals(destination)) return;
 
-  DCHECK_EQ(block->GetSuccessors().Size(), 1u);
+  DCHECK_EQ(block->NumberOfNormalSuccessors(), 1u);
   HInstruction* last = block->GetLastInstruction();
   // We insert moves at exit for phi predecessors and connecting blocks.
   // A block ending with an if cannot branch to a block with phis because
@@ -924,8 +1150,11 @@ void RegisterAllocator::InsertMoveAfter(HInstruction* instruction,
 
 void RegisterAllocator::ConnectSiblings(LiveInterval* interval) {
   LiveInterval* current = interval;
-  if (current->HasSpillSlot() && current->HasRegister()) {
-    // We spill eagerly, so move must be at definition.
+  HInstruction* defined_by = interval->GetDefinedBy();
+  bool is_catch_phi = defined_by->IsPhi() && defined_by->AsPhi()->IsCatchPhi();
+  if (current->HasSpillSlot() && current->HasRegister() && !is_catch_phi) {
+    // We spill eagerly, so move must be at definition. Catch phis are spilled
+    // from their catch slot, see `ResolveCatchBlock`.
     InsertMoveAfter(interval->GetDefinedBy(),
                     interval->IsFloatingPoint()
                         ? Location::FpuRegisterLocation(interval->GetRegister())
@@ -1055,7 +1284,7 @@ void RegisterAllocator::ConnectSplitSiblings(LiveInterval* interval,
 
   // If `from` has only one successor, we can put the moves at the exit of it. Otherwise
   // we need to put the moves at the entry of `to`.
-  if (from->GetSuccessors().Size() == 1) {
+  if (from->NumberOfNormalSuccessors() == 1) {
     InsertParallelMoveAtExitOf(from,
                                interval->GetParent()->GetDefinedBy(),
                                source->ToLocation(),
@@ -1069,9 +1298,92 @@ void RegisterAllocator::ConnectSplitSiblings(LiveInterval* interval,
   }
 }
 
+Location RegisterAllocator::GetCatchSlotOf(HPhi* phi) const {
+  DCHECK(phi->IsCatchPhi());
+  size_t stack_index = (reserved_out_slots_ + phi->GetRegNumber()) * kVRegSize;
+  return phi->GetLiveInterval()->NeedsTwoSpillSlots()
+      ? Location::DoubleStackSlot(stack_index)
+      : Location::StackSlot(stack_index);
+}
+
+void RegisterAllocator::ResolveThrowingInstructionsOf(HBasicBlock* block,
+                                                      ArenaBitVector* stored_slots) {
+  const GrowableArray<HBasicBlock*>& catch_handlers = block->GetCatchHandlers();
+  for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+    HInstruction* instruction = it.Current();
+    if (!instruction->CanThrow()) {
+      continue;
+    }
+    // Nested catch blocks, and floating point equivalents of phis, have phis for
+    // the same dex register. They all hold the same value, store it once.
+    stored_slots->ClearAllBits();
+    for (size_t i = 0, e = catch_handlers.Size(); i < e; ++i) {
+      HBasicBlock* catch_block = catch_handlers.Get(i);
+      const GrowableArray<HInstruction*>& throwing_instructions =
+          catch_block->GetThrowingInstructions();
+      size_t input_index = 0;
+      while (throwing_instructions.Get(input_index) != instruction) {
+        ++input_index;
+      }
+      for (HInstructionIterator phi_it(catch_block->GetPhis()); !phi_it.Done(); phi_it.Advance()) {
+        HPhi* phi = phi_it.Current()->AsPhi();
+        if (!phi->HasSsaIndex() || stored_slots->IsBitSet(phi->GetRegNumber())) {
+          continue;
+        }
+        stored_slots->SetBit(phi->GetRegNumber());
+        Location catch_slot = GetCatchSlotOf(phi);
+        InsertParallelMoveAt(instruction->GetLifetimePosition(),
+                             nullptr,
+                             phi->GetLocations()->InAt(input_index),
+                             catch_slot);
+        if (phi->GetType() == Primitive::kPrimNot && instruction->GetLocations()->CanCall()) {
+          // The runtime may collect garbage before entering the catch block.
+          instruction->GetLocations()->SetStackBit(catch_slot.GetStackIndex() / kVRegSize);
+        }
+      }
+    }
+  }
+}
+
+void RegisterAllocator::ResolveCatchBlock(HBasicBlock* catch_block) const {
+  for (HInstructionIterator it(catch_block->GetPhis()); !it.Done(); it.Advance()) {
+    HPhi* phi = it.Current()->AsPhi();
+    if (!phi->HasSsaIndex()) {
+      continue;
+    }
+    LiveInterval* interval = phi->GetLiveInterval();
+    Location catch_slot = GetCatchSlotOf(phi);
+    InsertParallelMoveAtEntryOf(catch_block, phi, catch_slot, interval->ToLocation());
+    if (interval->HasRegister() && interval->HasSpillSlot()) {
+      InsertParallelMoveAtEntryOf(catch_block,
+                                  phi,
+                                  catch_slot,
+                                  interval->NeedsTwoSpillSlots()
+                                      ? Location::DoubleStackSlot(interval->GetSpillSlot())
+                                      : Location::StackSlot(interval->GetSpillSlot()));
+    }
+  }
+
+  // The only other values live when entering a catch block are constants.
+  BitVector* live = liveness_.GetLiveInSet(*catch_block);
+  for (uint32_t idx : live->Indexes()) {
+    HInstruction* current = liveness_.GetInstructionFromSsaIndex(idx);
+    DCHECK(current->IsConstant()) << current->DebugName();
+    const LiveInterval& interval =
+        current->GetLiveInterval()->GetIntervalAt(catch_block->GetLifetimeStart() + 1);
+    if (interval.HasRegister()) {
+      InsertParallelMoveAtEntryOf(catch_block,
+                                  current,
+                                  current->GetLocations()->Out(),
+                                  interval.ToLocation());
+    }
+  }
+}
+
 void RegisterAllocator::Resolve() {
-  codegen_->ComputeFrameSize(
-      spill_slots_.Size(), maximum_number_of_live_registers_, reserved_out_slots_);
+  codegen_->ComputeFrameSize(spill_slots_.Size() + number_of_catch_slots_,
+                             maximum_number_of_live_registers_,
+                             reserved_out_slots_);
 
   // Adjust the Out Location of instructions.
   // TODO: Use pointers of Location inside LiveInterval to avoid doing another iteration.
@@ -1113,9 +1425,30 @@ void RegisterAllocator::Resolve() {
     ConnectSiblings(instruction->GetLiveInterval());
   }
 
+  // Resolve exceptional control flow. The runtime enters a catch block with
+  // the values of its phis in their catch slots.
+  if (number_of_catch_slots_ != 0) {
+    ArenaBitVector stored_slots(allocator_, number_of_catch_slots_, false);
+    for (HLinearOrderIterator it(liveness_); !it.Done(); it.Advance()) {
+      HBasicBlock* block = it.Current();
+      if (block->IsInTry()) {
+        ResolveThrowingInstructionsOf(block, &stored_slots);
+      }
+    }
+  }
+  for (HLinearOrderIterator it(liveness_); !it.Done(); it.Advance()) {
+    if (it.Current()->IsCatchBlock()) {
+      ResolveCatchBlock(it.Current());
+    }
+  }
+
   // Resolve non-linear control flow across branches. Order does not matter.
   for (HLinearOrderIterator it(liveness_); !it.Done(); it.Advance()) {
     HBasicBlock* block = it.Current();
+    if (block->IsCatchBlock()) {
+      // Resolved above, the predecessors are throwing instructions.
+      continue;
+    }
     BitVector* live = liveness_.GetLiveInSet(*block);
     for (uint32_t idx : live->Indexes()) {
       HInstruction* current = liveness_.GetInstructionFromSsaIndex(idx);
@@ -1129,11 +1462,14 @@ void RegisterAllocator::Resolve() {
   // Resolve phi inputs. Order does not matter.
   for (HLinearOrderIterator it(liveness_); !it.Done(); it.Advance()) {
     HBasicBlock* current = it.Current();
+    if (current->IsCatchBlock()) {
+      continue;
+    }
     for (HInstructionIterator it(current->GetPhis()); !it.Done(); it.Advance()) {
       HInstruction* phi = it.Current();
       for (size_t i = 0, e = current->GetPredecessors().Size(); i < e; ++i) {
         HBasicBlock* predecessor = current->GetPredecessors().Get(i);
-        DCHECK_EQ(predecessor->GetSuccessors().Size(), 1u);
+        DCHECK_EQ(predecessor->NumberOfNormalSuccessors(), 1u);
         HInstruction* input = phi->InputAt(i);
         Location source = input->GetLiveInterval()->GetLocationAt(
             predecessor->GetLifetimeEnd() - 1);
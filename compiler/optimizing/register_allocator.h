@@ -23,23 +23,36 @@
 
 namespace art {
 
+class ArenaBitVector;
 class CodeGenerator;
 class HBasicBlock;
 class HGraph;
 class HInstruction;
 class HParallelMove;
+class HPhi;
 class LiveInterval;
 class Location;
 class SsaLivenessAnalysis;
 
 /**
  * An implementation of a linear scan register allocator on an `HGraph` with SSA form.
+ *
+ * With the `kGraphColor` strategy, intervals are first assigned a register for their
+ * whole lifetime by coloring an interference graph (Chaitin-Briggs style, with optimistic
+ * spilling and coloring biased by the register hints). Only the intervals that could not
+ * be colored go through the linear scan, which is then in charge of splitting and spilling.
  */
 class RegisterAllocator {
  public:
+  enum Strategy {
+    kLinearScan,
+    kGraphColor,
+  };
+
   RegisterAllocator(ArenaAllocator* allocator,
                     CodeGenerator* codegen,
-                    const SsaLivenessAnalysis& analysis);
+                    const SsaLivenessAnalysis& analysis,
+                    Strategy strategy = kLinearScan);
 
   // Main entry point for the register allocator. Given the liveness analysis,
   // allocates registers to live intervals.
@@ -73,13 +86,23 @@ class RegisterAllocator {
         || instruction_set == kThumb2;
   }
 
+  // Returns the strategy to use for `graph`. Graph coloring is used for methods
+  // with loops, as long as the interference graph stays reasonably small.
+  static Strategy SelectStrategy(const HGraph& graph, const SsaLivenessAnalysis& liveness);
+
   size_t GetNumberOfSpillSlots() const {
     return spill_slots_.Size();
   }
 
+  // Number of intervals that got a register from the graph coloring, and number of
+  // intervals left to the linear scan.
+  size_t GetNumberOfColoredIntervals() const { return number_of_colored_intervals_; }
+  size_t GetNumberOfUncoloredIntervals() const { return number_of_uncolored_intervals_; }
+
  private:
   // Main methods of the allocator.
   void LinearScan();
+  void ColorGraph();
   bool TryAllocateFreeReg(LiveInterval* interval);
   bool AllocateBlockedReg(LiveInterval* interval);
   void Resolve();
@@ -105,6 +128,17 @@ class RegisterAllocator {
   // Connect siblings between block entries and exits.
   void ConnectSplitSiblings(LiveInterval* interval, HBasicBlock* from, HBasicBlock* to) const;
 
+  // Returns the stack slot where the runtime finds the value of `phi` when
+  // entering its catch block.
+  Location GetCatchSlotOf(HPhi* phi) const;
+
+  // Store the inputs of catch phis to their catch slots before the throwing
+  // instructions of `block`.
+  void ResolveThrowingInstructionsOf(HBasicBlock* block, ArenaBitVector* stored_slots);
+
+  // Load the phis and constants live at the entry of `catch_block`.
+  void ResolveCatchBlock(HBasicBlock* catch_block) const;
+
   // Helper methods to insert parallel moves in the graph.
   void InsertParallelMoveAtExitOf(HBasicBlock* block,
                                   HInstruction* instruction,
@@ -186,9 +220,19 @@ class RegisterAllocator {
   // Slots reserved for out arguments.
   size_t reserved_out_slots_;
 
+  // Slots reserved, after the out slots, for the values of catch phis: the
+  // catch phis of dex register `r` are found in slot `r` when entering a catch block.
+  size_t number_of_catch_slots_;
+
   // The maximum live registers at safepoints.
   size_t maximum_number_of_live_registers_;
 
+  const Strategy strategy_;
+
+  // Statistics of the graph coloring.
+  size_t number_of_colored_intervals_;
+  size_t number_of_uncolored_intervals_;
+
   ART_FRIEND_TEST(RegisterAllocatorTest, FreeUntil);
 
   DISALLOW_COPY_AND_ASSIGN(RegisterAllocator);
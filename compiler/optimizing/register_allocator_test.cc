@@ -33,7 +33,7 @@ namespace art {
 // Note: the register allocator tests rely on the fact that constants have live
 // intervals and registers get allocated to them.
 
-static bool Check(const uint16_t* data) {
+static bool Check(const uint16_t* data, RegisterAllocator::Strategy strategy) {
   ArenaPool pool;
   ArenaAllocator allocator(&pool);
   HGraphBuilder builder(&allocator);
@@ -45,11 +45,16 @@ static bool Check(const uint16_t* data) {
   x86::CodeGeneratorX86 codegen(graph);
   SsaLivenessAnalysis liveness(*graph, &codegen);
   liveness.Analyze();
-  RegisterAllocator register_allocator(&allocator, &codegen, liveness);
+  RegisterAllocator register_allocator(&allocator, &codegen, liveness, strategy);
   register_allocator.AllocateRegisters();
   return register_allocator.Validate(false);
 }
 
+static bool Check(const uint16_t* data) {
+  return Check(data, RegisterAllocator::kLinearScan)
+      && Check(data, RegisterAllocator::kGraphColor);
+}
+
 /**
  * Unit testing of RegisterAllocator::ValidateIntervals. Register allocator
  * tests are based on this validation method.
@@ -320,6 +325,45 @@ TEST(RegisterAllocatorTest, Loop3) {
   ASSERT_EQ(phi_interval->GetRegister(), ret->InputAt(0)->GetLiveInterval()->GetRegister());
 }
 
+TEST(RegisterAllocatorTest, Loop3GraphColor) {
+  /*
+   * Same snippet as Loop3. With graph coloring, the intervals of the loop
+   * get a register for their whole lifetime: none of them is split.
+   */
+  const uint16_t data[] = THREE_REGISTERS_CODE_ITEM(
+    Instruction::CONST_4 | 0 | 0,
+    Instruction::ADD_INT_LIT8 | 1 << 8, 1 << 8,
+    Instruction::CONST_4 | 5 << 12 | 2 << 8,
+    Instruction::IF_NE | 1 << 8 | 2 << 12, 3,
+    Instruction::RETURN | 0 << 8,
+    Instruction::MOVE | 1 << 12 | 0 << 8,
+    Instruction::GOTO | 0xF900);
+
+  ArenaPool pool;
+  ArenaAllocator allocator(&pool);
+  HGraph* graph = BuildSSAGraph(data, &allocator);
+  x86::CodeGeneratorX86 codegen(graph);
+  SsaLivenessAnalysis liveness(*graph, &codegen);
+  liveness.Analyze();
+  ASSERT_EQ(RegisterAllocator::kGraphColor, RegisterAllocator::SelectStrategy(*graph, liveness));
+  RegisterAllocator register_allocator(
+      &allocator, &codegen, liveness, RegisterAllocator::kGraphColor);
+  register_allocator.AllocateRegisters();
+  ASSERT_TRUE(register_allocator.Validate(false));
+  ASSERT_EQ(0u, register_allocator.GetNumberOfUncoloredIntervals());
+
+  HBasicBlock* loop_header = graph->GetBlocks().Get(2);
+  HPhi* phi = loop_header->GetFirstPhi()->AsPhi();
+
+  LiveInterval* phi_interval = phi->GetLiveInterval();
+  LiveInterval* loop_update = phi->InputAt(1)->GetLiveInterval();
+  ASSERT_TRUE(phi_interval->HasRegister());
+  ASSERT_TRUE(loop_update->HasRegister());
+  ASSERT_NE(phi_interval->GetRegister(), loop_update->GetRegister());
+  ASSERT_TRUE(phi_interval->GetNextSibling() == nullptr);
+  ASSERT_TRUE(loop_update->GetNextSibling() == nullptr);
+}
+
 TEST(RegisterAllocatorTest, FirstRegisterUse) {
   const uint16_t data[] = THREE_REGISTERS_CODE_ITEM(
     Instruction::CONST_4 | 0 | 0,
@@ -81,6 +81,49 @@ void SsaBuilder::VisitBasicBlock(HBasicBlock* block) {
     // Save the loop header so that the last phase of the analysis knows which
     // blocks need to be updated.
     loop_headers_.Add(block);
+  } else if (block->IsCatchBlock()) {
+    // The predecessors of a catch block are the blocks with instructions that may
+    // throw to it, and the value of a local when entering the catch block is its
+    // value at the instruction that threw. We create a phi for each local, with
+    // one input per throwing instruction, taken from its environment. The phi is
+    // needed even if all inputs are the same value: the catch block is entered
+    // with the locals in the frame, not in the locations of the inputs.
+    for (size_t i = 0, e = block->GetPredecessors().Size(); i < e; ++i) {
+      HBasicBlock* predecessor = block->GetPredecessors().Get(i);
+      for (HInstructionIterator it(predecessor->GetInstructions()); !it.Done(); it.Advance()) {
+        if (it.Current()->CanThrow()) {
+          block->AddThrowingInstruction(it.Current());
+        }
+      }
+    }
+    const GrowableArray<HInstruction*>& throwing_instructions = block->GetThrowingInstructions();
+    DCHECK(!throwing_instructions.IsEmpty());
+    for (size_t local = 0; local < current_locals_->Size(); local++) {
+      bool one_instruction_has_no_value = false;
+      for (size_t i = 0, e = throwing_instructions.Size(); i < e; ++i) {
+        HEnvironment* environment = throwing_instructions.Get(i)->GetEnvironment();
+        DCHECK(environment != nullptr);
+        if (environment->GetInstructionAt(local) == nullptr) {
+          one_instruction_has_no_value = true;
+          break;
+        }
+      }
+
+      if (one_instruction_has_no_value) {
+        // Like for other merges, we trust the verifier that the local is not read
+        // in the catch block.
+        continue;
+      }
+
+      HPhi* phi = new (GetGraph()->GetArena()) HPhi(
+          GetGraph()->GetArena(), local, throwing_instructions.Size(), Primitive::kPrimVoid);
+      for (size_t i = 0, e = throwing_instructions.Size(); i < e; ++i) {
+        HEnvironment* environment = throwing_instructions.Get(i)->GetEnvironment();
+        phi->SetRawInputAt(i, environment->GetInstructionAt(local));
+      }
+      block->AddPhi(phi);
+      current_locals_->Put(local, phi);
+    }
   } else if (block->GetPredecessors().Size() > 0) {
     // All predecessors have already been visited because we are visiting in reverse post order.
     // We merge the values of all locals, creating phis if those values differ.
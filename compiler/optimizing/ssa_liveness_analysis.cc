@@ -55,13 +55,22 @@ static void VisitBlockForLinearization(HBasicBlock* block,
     return;
   }
   visited->SetBit(block->GetBlockId());
-  size_t number_of_successors = block->GetSuccessors().Size();
+  // Visit the catch blocks first in post order: they are only entered when an
+  // exception is thrown, and the heuristics below only apply to normal control flow.
+  size_t number_of_successors = block->NumberOfNormalSuccessors();
+  for (size_t i = number_of_successors, e = block->GetSuccessors().Size(); i < e; ++i) {
+    VisitBlockForLinearization(block->GetSuccessors().Get(i), order, visited);
+  }
   if (number_of_successors == 0) {
     // Nothing to do.
   } else if (number_of_successors == 1) {
     VisitBlockForLinearization(block->GetSuccessors().Get(0), order, visited);
+  } else if (number_of_successors > 2) {
+    // Switches: keep the order of the cases.
+    for (size_t i = 0; i < number_of_successors; ++i) {
+      VisitBlockForLinearization(block->GetSuccessors().Get(i), order, visited);
+    }
   } else {
-    DCHECK_EQ(number_of_successors, 2u);
     HBasicBlock* first_successor = block->GetSuccessors().Get(0);
     HBasicBlock* second_successor = block->GetSuccessors().Get(1);
     HLoopInformation* my_loop = block->GetLoopInformation();
@@ -173,8 +182,10 @@ void SsaLivenessAnalysis::ComputeLiveRanges() {
     BitVector* live_in = GetLiveInSet(*block);
 
     // Set phi inputs of successors of this block corresponding to this block
-    // as live_in.
-    for (size_t i = 0, e = block->GetSuccessors().Size(); i < e; ++i) {
+    // as live_in. Catch blocks are not part of the loop: the inputs of their phis
+    // are used at the throwing instructions, and their other live_in values are
+    // constants.
+    for (size_t i = 0, e = block->NumberOfNormalSuccessors(); i < e; ++i) {
       HBasicBlock* successor = block->GetSuccessors().Get(i);
       live_in->Union(GetLiveInSet(*successor));
       size_t phi_input_index = successor->GetPredecessorIndexOf(block);
@@ -227,6 +238,11 @@ void SsaLivenessAnalysis::ComputeLiveRanges() {
           }
         }
       }
+
+      if (current->CanThrow()) {
+        // The inputs of catch phis must be live at the instructions that throw to them.
+        AddCatchPhiUses(current, block, live_in);
+      }
     }
 
     // Kill phis defined in this block.
@@ -255,6 +271,33 @@ void SsaLivenessAnalysis::ComputeLiveRanges() {
   }
 }
 
+void SsaLivenessAnalysis::AddCatchPhiUses(HInstruction* instruction,
+                                           HBasicBlock* block,
+                                           BitVector* live_in) {
+  const GrowableArray<HBasicBlock*>& catch_handlers = block->GetCatchHandlers();
+  for (size_t i = 0, e = catch_handlers.Size(); i < e; ++i) {
+    HBasicBlock* catch_block = catch_handlers.Get(i);
+    const GrowableArray<HInstruction*>& throwing_instructions =
+        catch_block->GetThrowingInstructions();
+    for (size_t input_index = 0, f = throwing_instructions.Size(); input_index < f; ++input_index) {
+      if (throwing_instructions.Get(input_index) != instruction) {
+        continue;
+      }
+      for (HInstructionIterator it(catch_block->GetPhis()); !it.Done(); it.Advance()) {
+        HPhi* phi = it.Current()->AsPhi();
+        if (!phi->HasSsaIndex()) {
+          continue;
+        }
+        HInstruction* input = phi->InputAt(input_index);
+        DCHECK(input->HasSsaIndex());
+        live_in->SetBit(input->GetSsaIndex());
+        input->GetLiveInterval()->AddCatchPhiUse(phi, input_index, instruction);
+      }
+      break;
+    }
+  }
+}
+
 void SsaLivenessAnalysis::ComputeLiveInAndLiveOutSets() {
   bool changed;
   do {
@@ -277,7 +320,9 @@ bool SsaLivenessAnalysis::UpdateLiveOut(const HBasicBlock& block) {
   BitVector* live_out = GetLiveOutSet(block);
   bool changed = false;
   // The live_out set of a block is the union of live_in sets of its successors.
-  for (size_t i = 0, e = block.GetSuccessors().Size(); i < e; ++i) {
+  // The live_in values of catch blocks are constants, and do not need to be live
+  // in the blocks throwing to them.
+  for (size_t i = 0, e = block.NumberOfNormalSuccessors(); i < e; ++i) {
     HBasicBlock* successor = block.GetSuccessors().Get(i);
     if (live_out->Union(GetLiveInSet(*successor))) {
       changed = true;
@@ -313,7 +358,9 @@ int LiveInterval::FindFirstRegisterHint(size_t* free_until) const {
   size_t end = GetEnd();
   while (use != nullptr && use->GetPosition() <= end) {
     size_t use_position = use->GetPosition();
-    if (use_position >= start && !use->GetIsEnvironment()) {
+    // The value of a catch phi is stored in its catch slot: the phi's register
+    // is not a useful hint.
+    if (use_position >= start && !use->GetIsEnvironment() && !use->IsCatchPhiUse()) {
       HInstruction* user = use->GetUser();
       size_t input_index = use->GetInputIndex();
       if (user->IsPhi()) {
@@ -357,7 +404,11 @@ int LiveInterval::FindFirstRegisterHint(size_t* free_until) const {
 }
 
 int LiveInterval::FindHintAtDefinition() const {
-  if (defined_by_->IsPhi()) {
+  if (defined_by_->IsPhi() && defined_by_->AsPhi()->IsCatchPhi()) {
+    // A catch phi is loaded from its catch slot, its inputs are not in registers
+    // when entering the catch block.
+    return kNoRegister;
+  } else if (defined_by_->IsPhi()) {
     // Try to use the same register as one of the inputs.
     const GrowableArray<HBasicBlock*>& predecessors = defined_by_->GetBlock()->GetPredecessors();
     for (size_t i = 0, e = defined_by_->InputCount(); i < e; ++i) {
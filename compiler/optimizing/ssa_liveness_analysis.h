@@ -119,6 +119,8 @@ class UsePosition : public ArenaObject {
 
   size_t GetInputIndex() const { return input_index_; }
 
+  bool IsCatchPhiUse() const { return user_->IsPhi() && user_->AsPhi()->IsCatchPhi(); }
+
   void Dump(std::ostream& stream) const {
     stream << position_;
   }
@@ -234,6 +236,26 @@ class LiveInterval : public ArenaObject {
         instruction, input_index, false, block->GetLifetimeEnd(), first_use_);
   }
 
+  // Adds a use by the catch phi `phi`, for the throwing instruction `instruction`.
+  // The value must be live at the instruction, where it is stored in the catch
+  // slot of the phi.
+  void AddCatchPhiUse(HInstruction* phi, size_t input_index, HInstruction* instruction) {
+    DCHECK(phi->IsPhi());
+    size_t position = instruction->GetLifetimePosition();
+    size_t start_block_position = instruction->GetBlock()->GetLifetimeStart();
+    if (first_range_ == nullptr) {
+      first_range_ = last_range_ = new (allocator_) LiveRange(
+          start_block_position, position, nullptr);
+    } else if (first_range_->GetStart() == start_block_position) {
+      // The value is also used later in the block, or in a following block.
+      DCHECK_LE(position, first_range_->GetEnd());
+    } else {
+      DCHECK(first_range_->GetStart() > position);
+      first_range_ = new (allocator_) LiveRange(start_block_position, position, first_range_);
+    }
+    first_use_ = new (allocator_) UsePosition(phi, input_index, false, position, first_use_);
+  }
+
   void AddRange(size_t start, size_t end) {
     if (first_range_ == nullptr) {
       first_range_ = last_range_ = new (allocator_) LiveRange(start, end, first_range_);
@@ -651,6 +673,10 @@ class SsaLivenessAnalysis : public ValueObject {
   // Update the live_out set of the block and returns whether it has changed.
   bool UpdateLiveOut(const HBasicBlock& block);
 
+  // Add the uses, at the throwing `instruction` of `block`, of the inputs of
+  // the catch phis it throws to.
+  void AddCatchPhiUses(HInstruction* instruction, HBasicBlock* block, BitVector* live_in);
+
   const HGraph& graph_;
   CodeGenerator* const codegen_;
   GrowableArray<HBasicBlock*> linear_post_order_;
@@ -103,6 +103,12 @@ void SsaRedundantPhiElimination::Run() {
       continue;
     }
 
+    // A catch phi is needed even if all its inputs are the same: the code
+    // generator expects the live-ins of a catch block to be phis or constants.
+    if (phi->IsCatchPhi()) {
+      continue;
+    }
+
     // Find if the inputs of the phi are the same instruction.
     HInstruction* candidate = phi->InputAt(0);
     // A loop phi cannot have itself as the first phi. Note that this
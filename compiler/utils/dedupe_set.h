@@ -17,31 +17,39 @@
 #ifndef ART_COMPILER_UTILS_DEDUPE_SET_H_
 #define ART_COMPILER_UTILS_DEDUPE_SET_H_
 
-#include <set>
+#include <sstream>
 #include <string>
 
+#include "atomic.h"
 #include "base/mutex.h"
-#include "base/stl_util.h"
 #include "base/stringprintf.h"
+#include "utils/arena_allocator.h"
 
 namespace art {
 
 // A set of Keys that support a HashFunc returning HashType. Used to find duplicates of Key in the
-// Add method. The data-structure is thread-safe through the use of internal locks, it also
-// supports the lock being sharded.
+// Add method. The data-structure is thread-safe: each shard is an open-addressing hash table that
+// is searched without locking, only the insertion of new keys takes the lock of the shard. The
+// copies of the keys and the tables are allocated in arenas and are never moved, so a reader
+// probing a table that has since been replaced by a larger one still sees valid keys.
 template <typename Key, typename HashType, typename HashFunc, HashType kShard = 1>
 class DedupeSet {
-  typedef std::pair<HashType, Key*> HashedKey;
-
-  class Comparator {
-   public:
-    bool operator()(const HashedKey& a, const HashedKey& b) const {
-      if (a.first != b.first) {
-        return a.first < b.first;
-      } else {
-        return *a.second < *b.second;
-      }
+  struct Entry {
+    Entry(HashType hash_in, const Key& key_in) : hash(hash_in), key(key_in) {}
+
+    const HashType hash;
+    Key key;
+  };
+
+  // A table header, followed by `capacity` slots.
+  struct Table {
+    explicit Table(size_t capacity_in) : capacity(capacity_in) {}
+
+    Atomic<Entry*>* Entries() {
+      return reinterpret_cast<Atomic<Entry*>*>(this + 1);
     }
+
+    const size_t capacity;  // A power of two.
   };
 
  public:
@@ -49,36 +57,132 @@ class DedupeSet {
     HashType raw_hash = HashFunc()(key);
     HashType shard_hash = raw_hash / kShard;
     HashType shard_bin = raw_hash % kShard;
-    HashedKey hashed_key(shard_hash, const_cast<Key*>(&key));
-    MutexLock lock(self, *lock_[shard_bin]);
-    auto it = keys_[shard_bin].find(hashed_key);
-    if (it != keys_[shard_bin].end()) {
-      return it->second;
+    Entry* entry = Find(tables_[shard_bin].LoadAcquire(), shard_hash, key);
+    if (entry == nullptr) {
+      MutexLock lock(self, *lock_[shard_bin]);
+      // Look again as the key may have been added since the lock-free lookup.
+      entry = Find(tables_[shard_bin].LoadRelaxed(), shard_hash, key);
+      if (entry == nullptr) {
+        entry = Insert(shard_bin, shard_hash, key);
+        misses_.FetchAndAddRelaxed(1u);
+        return &entry->key;
+      }
     }
-    hashed_key.second = new Key(key);
-    keys_[shard_bin].insert(hashed_key);
-    return hashed_key.second;
+    hits_.FetchAndAddRelaxed(1u);
+    deduplicated_bytes_.FetchAndAddRelaxed(
+        key.size() * sizeof(typename Key::value_type));
+    return &entry->key;
   }
 
-  explicit DedupeSet(const char* set_name) {
+  // Returns the number of calls to Add() that found an existing copy of the key, and the total.
+  size_t NumberOfHits() const { return hits_.LoadRelaxed(); }
+  size_t NumberOfAdds() const { return hits_.LoadRelaxed() + misses_.LoadRelaxed(); }
+
+  std::string DumpStats() const {
+    size_t adds = NumberOfAdds();
+    return StringPrintf("%s: %zu adds, %zu hits (%.1f%%), %zu bytes deduplicated",
+                        set_name_.c_str(), adds, NumberOfHits(),
+                        adds == 0u ? 0.0 : 100.0 * NumberOfHits() / adds,
+                        deduplicated_bytes_.LoadRelaxed());
+  }
+
+  explicit DedupeSet(const char* set_name) : set_name_(set_name) {
     for (HashType i = 0; i < kShard; ++i) {
       std::ostringstream oss;
       oss << set_name << " lock " << i;
       lock_name_[i] = oss.str();
       lock_[i].reset(new Mutex(lock_name_[i].c_str()));
+      allocator_[i].reset(new ArenaAllocator(&pool_));
+      tables_[i].StoreRelaxed(AllocateTable(i, kInitialCapacity));
+      sizes_[i] = 0u;
     }
   }
 
   ~DedupeSet() {
+    // The arenas do not run destructors, release the storage owned by the keys.
     for (HashType i = 0; i < kShard; ++i) {
-      STLDeleteValues(&keys_[i]);
+      Table* table = tables_[i].LoadRelaxed();
+      for (size_t j = 0; j != table->capacity; ++j) {
+        Entry* entry = table->Entries()[j].LoadRelaxed();
+        if (entry != nullptr) {
+          entry->~Entry();
+        }
+      }
     }
   }
 
  private:
+  static constexpr size_t kInitialCapacity = 1024u;
+
+  static Entry* Find(Table* table, HashType hash, const Key& key) {
+    size_t mask = table->capacity - 1u;
+    for (size_t index = hash & mask; ; index = (index + 1u) & mask) {
+      Entry* entry = table->Entries()[index].LoadAcquire();
+      if (entry == nullptr) {
+        return nullptr;
+      }
+      if (entry->hash == hash && entry->key == key) {
+        return entry;
+      }
+    }
+  }
+
+  // Copies the key into the table of the shard, growing the table if needed.
+  // Requires the lock of the shard.
+  Entry* Insert(HashType shard_bin, HashType hash, const Key& key) {
+    Table* table = tables_[shard_bin].LoadRelaxed();
+    // Keep the load factor under 3/4 so that probe sequences stay short.
+    if ((sizes_[shard_bin] + 1u) * 4u > table->capacity * 3u) {
+      Table* new_table = AllocateTable(shard_bin, table->capacity * 2u);
+      for (size_t i = 0; i != table->capacity; ++i) {
+        Entry* entry = table->Entries()[i].LoadRelaxed();
+        if (entry != nullptr) {
+          Store(new_table, entry);
+        }
+      }
+      // Publish the filled table to the lock-free readers.
+      tables_[shard_bin].StoreRelease(new_table);
+      table = new_table;
+    }
+    void* storage = allocator_[shard_bin]->Alloc(sizeof(Entry), kArenaAllocMisc);
+    Entry* entry = new (storage) Entry(hash, key);
+    Store(table, entry);
+    ++sizes_[shard_bin];
+    return entry;
+  }
+
+  static void Store(Table* table, Entry* entry) {
+    size_t mask = table->capacity - 1u;
+    size_t index = entry->hash & mask;
+    while (table->Entries()[index].LoadRelaxed() != nullptr) {
+      index = (index + 1u) & mask;
+    }
+    // Release the contents of the entry to the lock-free readers.
+    table->Entries()[index].StoreRelease(entry);
+  }
+
+  Table* AllocateTable(HashType shard_bin, size_t capacity) {
+    DCHECK(IsPowerOfTwo(capacity));
+    size_t size = sizeof(Table) + capacity * sizeof(Atomic<Entry*>);
+    void* storage = allocator_[shard_bin]->Alloc(size, kArenaAllocMisc);
+    Table* table = new (storage) Table(capacity);
+    for (size_t i = 0; i != capacity; ++i) {
+      new (&table->Entries()[i]) Atomic<Entry*>(nullptr);
+    }
+    return table;
+  }
+
+  const std::string set_name_;
   std::string lock_name_[kShard];
   std::unique_ptr<Mutex> lock_[kShard];
-  std::set<HashedKey, Comparator> keys_[kShard];
+  ArenaPool pool_;
+  std::unique_ptr<ArenaAllocator> allocator_[kShard];  // Guarded by the lock of the shard.
+  Atomic<Table*> tables_[kShard];
+  size_t sizes_[kShard];  // Guarded by the lock of the shard.
+
+  Atomic<size_t> hits_;
+  Atomic<size_t> misses_;
+  Atomic<size_t> deduplicated_bytes_;
 
   DISALLOW_COPY_AND_ASSIGN(DedupeSet);
 };
@@ -70,6 +70,33 @@ TEST(DedupeSetTest, Test) {
     ASSERT_NE(array3, &test1);
     ASSERT_EQ(test1, *array3);
   }
+
+  ASSERT_EQ(3u, deduplicator.NumberOfAdds());
+  ASSERT_EQ(1u, deduplicator.NumberOfHits());
+}
+
+TEST(DedupeSetTest, Grow) {
+  Thread* self = Thread::Current();
+  typedef std::vector<uint8_t> ByteArray;
+  DedupeSet<ByteArray, size_t, DedupeHashFunc, 4> deduplicator("test");
+  // Add enough keys for the tables to grow a few times.
+  static constexpr size_t kNumberOfKeys = 10000u;
+  std::vector<ByteArray*> arrays;
+  for (size_t i = 0; i != kNumberOfKeys; ++i) {
+    ByteArray test;
+    test.push_back(i & 0xffu);
+    test.push_back(i >> 8);
+    arrays.push_back(deduplicator.Add(self, test));
+    ASSERT_EQ(test, *arrays.back());
+  }
+  for (size_t i = 0; i != kNumberOfKeys; ++i) {
+    ByteArray test;
+    test.push_back(i & 0xffu);
+    test.push_back(i >> 8);
+    ASSERT_EQ(arrays[i], deduplicator.Add(self, test));
+  }
+  ASSERT_EQ(2 * kNumberOfKeys, deduplicator.NumberOfAdds());
+  ASSERT_EQ(kNumberOfKeys, deduplicator.NumberOfHits());
 }
 
 }  // namespace art
@@ -613,6 +613,23 @@ void X86Assembler::comisd(XmmRegister a, XmmRegister b) {
 }
 
 
+void X86Assembler::movmskps(Register dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(0x0F);
+  EmitUint8(0x50);
+  EmitXmmRegisterOperand(dst, src);
+}
+
+
+void X86Assembler::movmskpd(Register dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(0x66);
+  EmitUint8(0x0F);
+  EmitUint8(0x50);
+  EmitXmmRegisterOperand(dst, src);
+}
+
+
 void X86Assembler::sqrtsd(XmmRegister dst, XmmRegister src) {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
   EmitUint8(0xF2);
@@ -879,6 +896,13 @@ void X86Assembler::andl(Register dst, const Immediate& imm) {
 }
 
 
+void X86Assembler::andl(Register dst, const Address& address) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(0x23);
+  EmitOperand(dst, address);
+}
+
+
 void X86Assembler::orl(Register dst, Register src) {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
   EmitUint8(0x0B);
@@ -892,6 +916,13 @@ void X86Assembler::orl(Register dst, const Immediate& imm) {
 }
 
 
+void X86Assembler::orl(Register dst, const Address& address) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(0x0B);
+  EmitOperand(dst, address);
+}
+
+
 void X86Assembler::xorl(Register dst, Register src) {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
   EmitUint8(0x33);
@@ -903,6 +934,13 @@ void X86Assembler::xorl(Register dst, const Immediate& imm) {
   EmitComplex(6, Operand(dst), imm);
 }
 
+
+void X86Assembler::xorl(Register dst, const Address& address) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(0x33);
+  EmitOperand(dst, address);
+}
+
 void X86Assembler::addl(Register reg, const Immediate& imm) {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
   EmitComplex(0, Operand(reg), imm);
@@ -1111,6 +1149,34 @@ void X86Assembler::shld(Register dst, Register src) {
 }
 
 
+void X86Assembler::shld(Register dst, Register src, const Immediate& imm) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  CHECK(imm.is_int8());
+  EmitUint8(0x0F);
+  EmitUint8(0xA4);
+  EmitRegisterOperand(src, dst);
+  EmitUint8(imm.value() & 0xFF);
+}
+
+
+void X86Assembler::shrd(Register dst, Register src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(0x0F);
+  EmitUint8(0xAD);
+  EmitRegisterOperand(src, dst);
+}
+
+
+void X86Assembler::shrd(Register dst, Register src, const Immediate& imm) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  CHECK(imm.is_int8());
+  EmitUint8(0x0F);
+  EmitUint8(0xAC);
+  EmitRegisterOperand(src, dst);
+  EmitUint8(imm.value() & 0xFF);
+}
+
+
 void X86Assembler::negl(Register reg) {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
   EmitUint8(0xF7);
@@ -1295,6 +1361,29 @@ void X86Assembler::LoadDoubleConstant(XmmRegister dst, double value) {
 }
 
 
+void X86Assembler::LoadLabelAddress(Register dst, Label* label) {
+  int pc_position;
+  int end_position;
+  {
+    AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+    // Call the next instruction to get its address in `dst`.
+    EmitUint8(0xE8);
+    EmitInt32(0);
+    pc_position = buffer_.Size();
+    EmitUint8(0x58 + dst);
+    // Add the offset of the label from the end of this addl.
+    EmitUint8(0x81);
+    EmitRegisterOperand(0, dst);
+    end_position = buffer_.Size() + 4;
+    static const int kImmediateSize = 4;
+    EmitLabel(label, kImmediateSize);
+  }
+  // Correct for the offset being relative to the end of the addl rather than
+  // to the address popped.
+  addl(dst, Immediate(end_position - pc_position));
+}
+
+
 void X86Assembler::FloatNegate(XmmRegister f) {
   static const struct {
     uint32_t a;
@@ -1336,6 +1425,14 @@ void X86Assembler::Align(int alignment, int offset) {
 }
 
 
+void X86Assembler::EmitLabelOffset(Label* label, Label* base) {
+  CHECK(label->IsBound());
+  CHECK(base->IsBound());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitInt32(label->Position() - base->Position());
+}
+
+
 void X86Assembler::Bind(Label* label) {
   int bound = buffer_.Size();
   CHECK(!label->IsBound());  // Labels can only be bound once.
@@ -302,6 +302,9 @@ class X86Assembler FINAL : public Assembler {
   void comiss(XmmRegister a, XmmRegister b);
   void comisd(XmmRegister a, XmmRegister b);
 
+  void movmskps(Register dst, XmmRegister src);
+  void movmskpd(Register dst, XmmRegister src);
+
   void sqrtsd(XmmRegister dst, XmmRegister src);
   void sqrtss(XmmRegister dst, XmmRegister src);
 
@@ -350,12 +353,15 @@ class X86Assembler FINAL : public Assembler {
 
   void andl(Register dst, const Immediate& imm);
   void andl(Register dst, Register src);
+  void andl(Register dst, const Address& address);
 
   void orl(Register dst, const Immediate& imm);
   void orl(Register dst, Register src);
+  void orl(Register dst, const Address& address);
 
   void xorl(Register dst, Register src);
   void xorl(Register dst, const Immediate& imm);
+  void xorl(Register dst, const Address& address);
 
   void addl(Register dst, Register src);
   void addl(Register reg, const Immediate& imm);
@@ -403,6 +409,9 @@ class X86Assembler FINAL : public Assembler {
   void sarl(Register reg, const Immediate& imm);
   void sarl(Register operand, Register shifter);
   void shld(Register dst, Register src);
+  void shld(Register dst, Register src, const Immediate& imm);
+  void shrd(Register dst, Register src);
+  void shrd(Register dst, Register src, const Immediate& imm);
 
   void negl(Register reg);
   void notl(Register reg);
@@ -439,6 +448,10 @@ class X86Assembler FINAL : public Assembler {
 
   void LoadDoubleConstant(XmmRegister dst, double value);
 
+  // Loads the address of `label`. There is no PC-relative addressing on x86,
+  // so this goes through a call to the next instruction.
+  void LoadLabelAddress(Register dst, Label* label);
+
   void DoubleNegate(XmmRegister d);
   void FloatNegate(XmmRegister f);
 
@@ -455,6 +468,10 @@ class X86Assembler FINAL : public Assembler {
   void Align(int alignment, int offset);
   void Bind(Label* label);
 
+  // Emits the 32-bit offset of `label` from `base`, both bound, as data in the
+  // instruction stream. Used for jump tables.
+  void EmitLabelOffset(Label* label, Label* base);
+
   //
   // Overridden common assembler high-level functionality
   //
@@ -130,6 +130,18 @@ TEST_F(AssemblerX86_64Test, CmpqRegs) {
 }
 
 
+TEST_F(AssemblerX86_64Test, AndqRegs) {
+  DriverStr(RepeatRR(&x86_64::X86_64Assembler::andq, "andq %{reg2}, %{reg1}"), "andq");
+}
+
+TEST_F(AssemblerX86_64Test, OrqRegs) {
+  DriverStr(RepeatRR(&x86_64::X86_64Assembler::orq, "orq %{reg2}, %{reg1}"), "orq");
+}
+
+TEST_F(AssemblerX86_64Test, XorqRegs) {
+  DriverStr(RepeatRR(&x86_64::X86_64Assembler::xorq, "xorq %{reg2}, %{reg1}"), "xorq");
+}
+
 TEST_F(AssemblerX86_64Test, XorqImm) {
   DriverStr(RepeatRI(&x86_64::X86_64Assembler::xorq, 4U, "xorq ${imm}, %{reg}"), "xorqi");
 }
@@ -179,6 +191,107 @@ TEST_F(AssemblerX86_64Test, Movl) {
   DriverStr(expected, "movl");
 }
 
+TEST_F(AssemblerX86_64Test, Movsxd) {
+  GetAssembler()->movsxd(x86_64::CpuRegister(x86_64::RAX), x86_64::CpuRegister(x86_64::RBX));
+  GetAssembler()->movsxd(x86_64::CpuRegister(x86_64::R8), x86_64::CpuRegister(x86_64::R11));
+  GetAssembler()->movsxd(x86_64::CpuRegister(x86_64::RDI), x86_64::CpuRegister(x86_64::R9));
+  const char* expected =
+    "movslq %EBX, %RAX\n"
+    "movslq %R11d, %R8\n"
+    "movslq %R9d, %RDI\n";
+
+  DriverStr(expected, "movsxd");
+}
+
+TEST_F(AssemblerX86_64Test, ShiftsByCl) {
+  GetAssembler()->shll(x86_64::CpuRegister(x86_64::RAX), x86_64::CpuRegister(x86_64::RCX));
+  GetAssembler()->shll(x86_64::CpuRegister(x86_64::R9), x86_64::CpuRegister(x86_64::RCX));
+  GetAssembler()->sarl(x86_64::CpuRegister(x86_64::R12), x86_64::CpuRegister(x86_64::RCX));
+  GetAssembler()->shrl(x86_64::CpuRegister(x86_64::RDX), x86_64::CpuRegister(x86_64::RCX));
+  const char* expected =
+    "shll %CL, %EAX\n"
+    "shll %CL, %R9d\n"
+    "sarl %CL, %R12d\n"
+    "shrl %CL, %EDX\n";
+
+  DriverStr(expected, "shifts_cl");
+}
+
+TEST_F(AssemblerX86_64Test, WideShiftsByCl) {
+  GetAssembler()->shlq(x86_64::CpuRegister(x86_64::RAX), x86_64::CpuRegister(x86_64::RCX));
+  GetAssembler()->shlq(x86_64::CpuRegister(x86_64::R9), x86_64::CpuRegister(x86_64::RCX));
+  GetAssembler()->sarq(x86_64::CpuRegister(x86_64::R12), x86_64::CpuRegister(x86_64::RCX));
+  GetAssembler()->shrq(x86_64::CpuRegister(x86_64::RDX), x86_64::CpuRegister(x86_64::RCX));
+  const char* expected =
+    "shlq %CL, %RAX\n"
+    "shlq %CL, %R9\n"
+    "sarq %CL, %R12\n"
+    "shrq %CL, %RDX\n";
+
+  DriverStr(expected, "wide_shifts_cl");
+}
+
+TEST_F(AssemblerX86_64Test, WideShiftsByImm) {
+  GetAssembler()->shlq(x86_64::CpuRegister(x86_64::RAX), x86_64::Immediate(1));
+  GetAssembler()->shlq(x86_64::CpuRegister(x86_64::R9), x86_64::Immediate(33));
+  GetAssembler()->sarq(x86_64::CpuRegister(x86_64::R12), x86_64::Immediate(63));
+  GetAssembler()->shrq(x86_64::CpuRegister(x86_64::RDX), x86_64::Immediate(40));
+  const char* expected =
+    "shlq $1, %RAX\n"
+    "shlq $33, %R9\n"
+    "sarq $63, %R12\n"
+    "shrq $40, %RDX\n";
+
+  DriverStr(expected, "wide_shifts_imm");
+}
+
+TEST_F(AssemblerX86_64Test, TestqRegs) {
+  DriverStr(RepeatRR(&x86_64::X86_64Assembler::testq, "testq %{reg2}, %{reg1}"), "testq");
+}
+
+TEST_F(AssemblerX86_64Test, Idivq) {
+  GetAssembler()->cqo();
+  GetAssembler()->idivq(x86_64::CpuRegister(x86_64::RCX));
+  GetAssembler()->idivq(x86_64::CpuRegister(x86_64::R10));
+  const char* expected =
+    "cqto\n"
+    "idivq %RCX\n"
+    "idivq %R10\n";
+
+  DriverStr(expected, "idivq");
+}
+
+TEST_F(AssemblerX86_64Test, Conversions) {
+  GetAssembler()->cvtsi2ss(x86_64::XmmRegister(x86_64::XMM0), x86_64::CpuRegister(x86_64::R9),
+                           true);
+  GetAssembler()->cvtsi2sd(x86_64::XmmRegister(x86_64::XMM8), x86_64::CpuRegister(x86_64::RAX),
+                           true);
+  GetAssembler()->cvttss2si(x86_64::CpuRegister(x86_64::R9), x86_64::XmmRegister(x86_64::XMM0),
+                            true);
+  GetAssembler()->cvttsd2si(x86_64::CpuRegister(x86_64::RAX), x86_64::XmmRegister(x86_64::XMM8),
+                            true);
+  GetAssembler()->cvttsd2si(x86_64::CpuRegister(x86_64::RAX), x86_64::XmmRegister(x86_64::XMM8),
+                            false);
+  const char* expected =
+    "cvtsi2ssq %R9, %xmm0\n"
+    "cvtsi2sdq %RAX, %xmm8\n"
+    "cvttss2si %xmm0, %R9\n"
+    "cvttsd2si %xmm8, %RAX\n"
+    "cvttsd2si %xmm8, %EAX\n";
+
+  DriverStr(expected, "conversions");
+}
+
+TEST_F(AssemblerX86_64Test, Movmsk) {
+  GetAssembler()->movmskps(x86_64::CpuRegister(x86_64::RAX), x86_64::XmmRegister(x86_64::XMM8));
+  GetAssembler()->movmskpd(x86_64::CpuRegister(x86_64::R9), x86_64::XmmRegister(x86_64::XMM0));
+  const char* expected =
+    "movmskps %xmm8, %EAX\n"
+    "movmskpd %xmm0, %R9d\n";
+
+  DriverStr(expected, "movmsk");
+}
+
 TEST_F(AssemblerX86_64Test, Movw) {
   GetAssembler()->movw(x86_64::Address(x86_64::CpuRegister(x86_64::RAX), 0),
                        x86_64::CpuRegister(x86_64::R9));
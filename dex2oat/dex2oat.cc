@@ -169,9 +169,12 @@ static void UsageError(const char* fmt, ...) {
                 "|balanced"
                 "|speed"
                 "|everything"
-                "|time):");
+                "|time"
+                "|profiled):");
   UsageError("      select compiler filter.");
   UsageError("      Example: --compiler-filter=everything");
+  UsageError("      profiled compiles the methods making up the top samples of --profile-file");
+  UsageError("      (see --top-k-profile-threshold) and leaves the others to the interpreter.");
 #if ART_SMALL_MODE
   UsageError("      Default: interpret-only");
 #else
@@ -297,6 +300,10 @@ class Dex2Oat {
               << " (threads: " << thread_count_ << ")";
   }
 
+  void LogDedupeStats() {
+    LOG(INFO) << "Deduplication:\n" << driver_->GetDedupeStatsString();
+  }
+
 
   // Reads the class names (java.lang.Object) and returns a set of descriptors (Ljava/lang/Object;)
   std::set<std::string>* ReadImageClassesFromFile(const char* image_classes_filename) {
@@ -829,6 +836,7 @@ static int dex2oat(int argc, char** argv) {
   Compiler::Kind compiler_kind = kUsePortableCompiler
       ? Compiler::kPortable
       : Compiler::kQuick;
+  bool compiler_kind_set = false;
   const char* compiler_filter_string = nullptr;
   bool compile_pic = false;
   int huge_method_threshold = CompilerOptions::kDefaultHugeMethodThreshold;
@@ -962,6 +970,7 @@ static int dex2oat(int argc, char** argv) {
       }
     } else if (option.starts_with("--compiler-backend=")) {
       StringPiece backend_str = option.substr(strlen("--compiler-backend=")).data();
+      compiler_kind_set = true;
       if (backend_str == "Quick") {
         compiler_kind = Compiler::kQuick;
       } else if (backend_str == "Optimizing") {
@@ -1199,6 +1208,15 @@ static int dex2oat(int argc, char** argv) {
     compiler_filter = CompilerOptions::kEverything;
   } else if (strcmp(compiler_filter_string, "time") == 0) {
     compiler_filter = CompilerOptions::kTime;
+  } else if (strcmp(compiler_filter_string, "profiled") == 0) {
+    compiler_filter = CompilerOptions::kProfiled;
+    if (profile_file.empty()) {
+      Usage("--compiler-filter=profiled requires --profile-file");
+    }
+    // Hot methods get the optimizing compiler unless a backend was requested.
+    if (!compiler_kind_set) {
+      compiler_kind = Compiler::kOptimizing;
+    }
   } else {
     Usage("Unknown --compiler-filter value %s", compiler_filter_string);
   }
@@ -1396,7 +1414,8 @@ static int dex2oat(int argc, char** argv) {
    * If we're not in interpret-only or verify-none mode, go ahead and compile small applications.
    * Don't bother to check if we're doing the image.
    */
-  if (!image && compiler_options->IsCompilationEnabled() && compiler_kind == Compiler::kQuick) {
+  if (!image && compiler_options->IsCompilationEnabled() && compiler_kind == Compiler::kQuick
+      && compiler_filter != CompilerOptions::kProfiled) {
     size_t num_methods = 0;
     for (size_t i = 0; i != dex_files.size(); ++i) {
       const DexFile* dex_file = dex_files[i];
@@ -1530,6 +1549,7 @@ static int dex2oat(int argc, char** argv) {
     timings.EndTiming();
     if (dump_timing || (dump_slow_timing && timings.GetTotalNs() > MsToNs(1000))) {
       LOG(INFO) << Dumpable<TimingLogger>(timings);
+      dex2oat->LogDedupeStats();
     }
     if (dump_passes) {
       LOG(INFO) << Dumpable<CumulativeLogger>(compiler_phases_timings);
@@ -1579,6 +1599,7 @@ static int dex2oat(int argc, char** argv) {
 
   if (dump_timing || (dump_slow_timing && timings.GetTotalNs() > MsToNs(1000))) {
     LOG(INFO) << Dumpable<TimingLogger>(timings);
+    dex2oat->LogDedupeStats();
   }
   if (dump_passes) {
     LOG(INFO) << Dumpable<CumulativeLogger>(compiler_phases_timings);
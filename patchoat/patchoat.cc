@@ -25,6 +25,7 @@
 #include <vector>
 
 #include "base/dumpable.h"
+#include "base/stl_util.h"
 #include "base/scoped_flock.h"
 #include "base/stringpiece.h"
 #include "base/stringprintf.h"
@@ -112,7 +113,7 @@ static bool LocationToFilename(const std::string& location, InstructionSet isa,
 }
 
 bool PatchOat::Patch(const std::string& image_location, off_t delta,
-                     File* output_image, InstructionSet isa,
+                     File* output_image, InstructionSet isa, size_t thread_count,
                      TimingLogger* timings) {
   CHECK(Runtime::Current() == nullptr);
   CHECK(output_image != nullptr);
@@ -159,6 +160,9 @@ bool PatchOat::Patch(const std::string& image_location, off_t delta,
   // Runtime::Create acquired the mutator_lock_ that is normally given away when we Runtime::Start,
   // give it away now and then switch to a more manageable ScopedObjectAccess.
   Thread::Current()->TransitionFromRunnableToSuspended(kNative);
+  // The workers attach to the runtime, so create them before taking the mutator lock.
+  std::unique_ptr<ThreadPool> thread_pool(new ThreadPool("patchoat thread pool",
+                                                         thread_count - 1));
   ScopedObjectAccess soa(Thread::Current());
 
   t.NewTiming("Image and oat Patching setup");
@@ -175,7 +179,7 @@ bool PatchOat::Patch(const std::string& image_location, off_t delta,
   gc::space::ImageSpace* ispc = Runtime::Current()->GetHeap()->GetImageSpace();
 
   PatchOat p(image.release(), ispc->GetLiveBitmap(), ispc->GetMemMap(),
-             delta, timings);
+             delta, thread_pool.get(), timings);
   t.NewTiming("Patching files");
   if (!p.PatchImage()) {
     LOG(ERROR) << "Failed to patch image file " << input_image->GetPath();
@@ -191,7 +195,7 @@ bool PatchOat::Patch(const std::string& image_location, off_t delta,
 
 bool PatchOat::Patch(const File* input_oat, const std::string& image_location, off_t delta,
                      File* output_oat, File* output_image, InstructionSet isa,
-                     TimingLogger* timings) {
+                     size_t thread_count, TimingLogger* timings) {
   CHECK(Runtime::Current() == nullptr);
   CHECK(output_image != nullptr);
   CHECK_GE(output_image->Fd(), 0);
@@ -248,6 +252,9 @@ bool PatchOat::Patch(const File* input_oat, const std::string& image_location, o
   // Runtime::Create acquired the mutator_lock_ that is normally given away when we Runtime::Start,
   // give it away now and then switch to a more manageable ScopedObjectAccess.
   Thread::Current()->TransitionFromRunnableToSuspended(kNative);
+  // The workers attach to the runtime, so create them before taking the mutator lock.
+  std::unique_ptr<ThreadPool> thread_pool(new ThreadPool("patchoat thread pool",
+                                                         thread_count - 1));
   ScopedObjectAccess soa(Thread::Current());
 
   t.NewTiming("Image and oat Patching setup");
@@ -271,7 +278,7 @@ bool PatchOat::Patch(const File* input_oat, const std::string& image_location, o
   }
 
   PatchOat p(elf.release(), image.release(), ispc->GetLiveBitmap(), ispc->GetMemMap(),
-             delta, timings);
+             delta, thread_pool.get(), timings);
   t.NewTiming("Patching files");
   if (!p.PatchElf()) {
     LOG(ERROR) << "Failed to patch oat file " << input_oat->GetPath();
@@ -326,6 +333,54 @@ bool PatchOat::WriteImage(File* out) {
   }
 }
 
+class PatchOat::PatchObjectsTask : public Task {
+ public:
+  PatchObjectsTask(PatchOat* patcher, uintptr_t begin, uintptr_t end)
+      : patcher_(patcher), begin_(begin), end_(end) {
+  }
+
+  void Run(Thread* self) OVERRIDE {
+    ScopedObjectAccess soa(self);
+    patcher_->bitmap_->VisitMarkedRange(begin_, end_, *this);
+  }
+
+  void operator()(mirror::Object* obj) const SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
+    patcher_->VisitObject(obj);
+  }
+
+ private:
+  PatchOat* const patcher_;
+  const uintptr_t begin_;
+  const uintptr_t end_;
+};
+
+template <typename patch_loc_t>
+class PatchOat::PatchTextTask : public Task {
+ public:
+  PatchTextTask(const patch_loc_t* patches, const patch_loc_t* patches_end, uint8_t* to_patch,
+                size_t text_size, uintptr_t to_patch_end, off_t delta)
+      : patches_(patches), patches_end_(patches_end), to_patch_(to_patch), text_size_(text_size),
+        to_patch_end_(to_patch_end), delta_(delta) {
+  }
+
+  void Run(Thread* /* self */) OVERRIDE {
+    for (const patch_loc_t* patches = patches_; patches < patches_end_; patches++) {
+      CHECK_LT(*patches, text_size_) << "Bad Patch";
+      uint32_t* patch_loc = reinterpret_cast<uint32_t*>(to_patch_ + *patches);
+      CHECK_LT(reinterpret_cast<uintptr_t>(patch_loc), to_patch_end_);
+      *patch_loc += delta_;
+    }
+  }
+
+ private:
+  const patch_loc_t* const patches_;
+  const patch_loc_t* const patches_end_;
+  uint8_t* const to_patch_;
+  const size_t text_size_;
+  const uintptr_t to_patch_end_;
+  const off_t delta_;
+};
+
 bool PatchOat::PatchImage() {
   ImageHeader* image_header = reinterpret_cast<ImageHeader*>(image_->Begin());
   CHECK_GT(image_->Size(), sizeof(ImageHeader));
@@ -341,13 +396,41 @@ bool PatchOat::PatchImage() {
 
   {
     TimingLogger::ScopedTiming t("Walk Bitmap", timings_);
-    // Walk the bitmap.
-    WriterMutexLock mu(Thread::Current(), *Locks::heap_bitmap_lock_);
-    bitmap_->Walk(PatchOat::BitmapCallback, this);
+    // Each object is only written to by the task owning the slice it starts in, so the slices can
+    // be patched concurrently. Use more slices than threads to even out the dense parts.
+    ReaderMutexLock mu(Thread::Current(), *Locks::heap_bitmap_lock_);
+    const uintptr_t begin = bitmap_->HeapBegin();
+    const uintptr_t end = static_cast<uintptr_t>(bitmap_->HeapLimit());
+    const size_t num_slices = (thread_pool_ != nullptr) ? 4 * (thread_pool_->GetThreadCount() + 1)
+                                                        : 1;
+    const uintptr_t slice_size = RoundUp((end - begin + num_slices - 1) / num_slices, kPageSize);
+    std::vector<Task*> tasks;
+    for (uintptr_t slice_begin = begin; slice_begin < end; slice_begin += slice_size) {
+      tasks.push_back(new PatchObjectsTask(this, slice_begin,
+                                           std::min(slice_begin + slice_size, end)));
+    }
+    RunTasks(tasks);
+    STLDeleteElements(&tasks);
   }
   return true;
 }
 
+void PatchOat::RunTasks(const std::vector<Task*>& tasks) {
+  Thread* self = Thread::Current();
+  if (thread_pool_ == nullptr) {
+    for (Task* task : tasks) {
+      task->Run(self);
+    }
+    return;
+  }
+  for (Task* task : tasks) {
+    thread_pool_->AddTask(self, task);
+  }
+  thread_pool_->StartWorkers(self);
+  thread_pool_->Wait(self, true, true);
+  thread_pool_->StopWorkers(self);
+}
+
 bool PatchOat::InHeap(mirror::Object* o) {
   uintptr_t begin = reinterpret_cast<uintptr_t>(heap_->Begin());
   uintptr_t end = reinterpret_cast<uintptr_t>(heap_->End());
@@ -612,12 +695,19 @@ bool PatchOat::PatchTextSection(ElfFileImpl* oat_file) {
   uint8_t* to_patch = oat_file->Begin() + oat_text_sec->sh_offset;
   uintptr_t to_patch_end = reinterpret_cast<uintptr_t>(to_patch) + oat_text_sec->sh_size;
 
-  for (; patches < patches_end; patches++) {
-    CHECK_LT(*patches, oat_text_sec->sh_size) << "Bad Patch";
-    uint32_t* patch_loc = reinterpret_cast<uint32_t*>(to_patch + *patches);
-    CHECK_LT(reinterpret_cast<uintptr_t>(patch_loc), to_patch_end);
-    *patch_loc += delta_;
-  }
+  // The patches don't overlap, so slices of them can be applied concurrently.
+  const size_t num_patches = patches_end - patches;
+  const size_t num_slices = (thread_pool_ != nullptr) ? 4 * (thread_pool_->GetThreadCount() + 1)
+                                                      : 1;
+  const size_t slice_size = std::max<size_t>((num_patches + num_slices - 1) / num_slices, 1);
+  std::vector<Task*> tasks;
+  for (patch_loc_t* slice = patches; slice < patches_end; slice += slice_size) {
+    tasks.push_back(new PatchTextTask<patch_loc_t>(
+        slice, std::min(slice + slice_size, patches_end), to_patch, oat_text_sec->sh_size,
+        to_patch_end, delta_));
+  }
+  RunTasks(tasks);
+  STLDeleteElements(&tasks);
   return true;
 }
 
@@ -703,6 +793,10 @@ static void UsageError(const char* fmt, ...) {
   UsageError("");
   UsageError("  --no-lock-output: Do not attempt to obtain a flock on output oat file.");
   UsageError("");
+  UsageError("  -j<number>: specifies the number of threads used for patching an image.");
+  UsageError("      Example: -j4");
+  UsageError("      Default: the number of processors");
+  UsageError("");
   UsageError("  --dump-timings: dump out patch timing information");
   UsageError("");
   UsageError("  --no-dump-timings: do not dump out patch timing information");
@@ -801,6 +895,7 @@ static int patchoat(int argc, char **argv) {
   std::string patched_image_location;
   bool dump_timings = kIsDebugBuild;
   bool lock_output = true;
+  int thread_count = sysconf(_SC_NPROCESSORS_CONF);
 
   for (int i = 0; i < argc; ++i) {
     const StringPiece option(argv[i]);
@@ -900,6 +995,11 @@ static int patchoat(int argc, char **argv) {
       patched_image_location = option.substr(strlen("--patched-image-location=")).data();
     } else if (option.starts_with("--patched-image-file=")) {
       patched_image_filename = option.substr(strlen("--patched-image-file=")).data();
+    } else if (option.starts_with("-j")) {
+      const char* thread_count_str = option.substr(strlen("-j")).data();
+      if (!ParseInt(thread_count_str, &thread_count) || thread_count < 1) {
+        Usage("Failed to parse -j argument '%s' as a positive integer", thread_count_str);
+      }
     } else if (option == "--lock-output") {
       lock_output = true;
     } else if (option == "--no-lock-output") {
@@ -1106,14 +1206,15 @@ static int patchoat(int argc, char **argv) {
   if (have_image_files && have_oat_files) {
     TimingLogger::ScopedTiming pt("patch image and oat", &timings);
     ret = PatchOat::Patch(input_oat.get(), input_image_location, base_delta,
-                          output_oat.get(), output_image.get(), isa, &timings);
+                          output_oat.get(), output_image.get(), isa, thread_count, &timings);
   } else if (have_oat_files) {
     TimingLogger::ScopedTiming pt("patch oat", &timings);
     ret = PatchOat::Patch(input_oat.get(), base_delta, output_oat.get(), &timings);
   } else {
     TimingLogger::ScopedTiming pt("patch image", &timings);
     CHECK(have_image_files);
-    ret = PatchOat::Patch(input_image_location, base_delta, output_image.get(), isa, &timings);
+    ret = PatchOat::Patch(input_image_location, base_delta, output_image.get(), isa,
+                          thread_count, &timings);
   }
   cleanup(ret);
   return (ret) ? EXIT_SUCCESS : EXIT_FAILURE;
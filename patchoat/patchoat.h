@@ -25,6 +25,7 @@
 #include "elf_utils.h"
 #include "gc/accounting/space_bitmap.h"
 #include "gc/heap.h"
+#include "thread_pool.h"
 #include "utils.h"
 
 namespace art {
@@ -42,33 +43,30 @@ class PatchOat {
  public:
   static bool Patch(File* oat_in, off_t delta, File* oat_out, TimingLogger* timings);
 
+  // The image patching variants split the work across thread_count threads.
   static bool Patch(const std::string& art_location, off_t delta, File* art_out, InstructionSet isa,
-                    TimingLogger* timings);
+                    size_t thread_count, TimingLogger* timings);
 
   static bool Patch(const File* oat_in, const std::string& art_location,
                     off_t delta, File* oat_out, File* art_out, InstructionSet isa,
-                    TimingLogger* timings);
+                    size_t thread_count, TimingLogger* timings);
 
  private:
   // Takes ownership only of the ElfFile. All other pointers are only borrowed.
+  // A null thread_pool patches everything on the calling thread.
   PatchOat(ElfFile* oat_file, off_t delta, TimingLogger* timings)
       : oat_file_(oat_file), image_(nullptr), bitmap_(nullptr), heap_(nullptr), delta_(delta),
-        timings_(timings) {}
+        thread_pool_(nullptr), timings_(timings) {}
   PatchOat(MemMap* image, gc::accounting::ContinuousSpaceBitmap* bitmap,
-           MemMap* heap, off_t delta, TimingLogger* timings)
+           MemMap* heap, off_t delta, ThreadPool* thread_pool, TimingLogger* timings)
       : image_(image), bitmap_(bitmap), heap_(heap),
-        delta_(delta), timings_(timings) {}
+        delta_(delta), thread_pool_(thread_pool), timings_(timings) {}
   PatchOat(ElfFile* oat_file, MemMap* image, gc::accounting::ContinuousSpaceBitmap* bitmap,
-           MemMap* heap, off_t delta, TimingLogger* timings)
+           MemMap* heap, off_t delta, ThreadPool* thread_pool, TimingLogger* timings)
       : oat_file_(oat_file), image_(image), bitmap_(bitmap), heap_(heap),
-        delta_(delta), timings_(timings) {}
+        delta_(delta), thread_pool_(thread_pool), timings_(timings) {}
   ~PatchOat() {}
 
-  static void BitmapCallback(mirror::Object* obj, void* arg)
-      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
-    reinterpret_cast<PatchOat*>(arg)->VisitObject(obj);
-  }
-
   void VisitObject(mirror::Object* obj)
       SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
   void FixupMethod(mirror::ArtMethod* object, mirror::ArtMethod* copy)
@@ -89,12 +87,21 @@ class PatchOat {
 
   bool PatchImage() SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
 
+  // Run the tasks on the thread pool, helping out from the calling thread, or on the calling
+  // thread alone if there is no pool.
+  void RunTasks(const std::vector<Task*>& tasks);
+
   bool WriteElf(File* out);
   bool WriteImage(File* out);
 
   mirror::Object* RelocatedCopyOf(mirror::Object*);
   mirror::Object* RelocatedAddressOf(mirror::Object* obj);
 
+  // Patches the copies of the objects that start in a slice of the image.
+  class PatchObjectsTask;
+  // Applies a slice of the .oat_patches to the text section.
+  template <typename patch_loc_t> class PatchTextTask;
+
   // Walks through the old image and patches the mmap'd copy of it to the new offset. It does not
   // change the heap.
   class PatchVisitor {
@@ -121,6 +128,8 @@ class PatchOat {
   const MemMap* const heap_;
   // The amount we are changing the offset by.
   const off_t delta_;
+  // The workers sharing the patching, borrowed. May be null.
+  ThreadPool* const thread_pool_;
   // Timing splits.
   TimingLogger* const timings_;
 
@@ -74,11 +74,13 @@ LIBART_COMMON_SRC_FILES := \
   hprof/hprof.cc \
   image.cc \
   indirect_reference_table.cc \
+  inline_cache.cc \
   instruction_set.cc \
   instrumentation.cc \
   intern_table.cc \
   interpreter/interpreter.cc \
   interpreter/interpreter_common.cc \
+  interpreter/interpreter_mterp.cc \
   interpreter/interpreter_switch_impl.cc \
   java_vm_ext.cc \
   jdwp/jdwp_event.cc \
@@ -91,6 +93,7 @@ LIBART_COMMON_SRC_FILES := \
   jni_env_ext.cc \
   jni_internal.cc \
   jobject_comparator.cc \
+  lock_contention_profiler.cc \
   mem_map.cc \
   memory_region.cc \
   method_helper.cc \
@@ -140,6 +143,7 @@ LIBART_COMMON_SRC_FILES := \
   primitive.cc \
   quick_exception_handler.cc \
   quick/inline_method_analyser.cc \
+  quickener.cc \
   reference_table.cc \
   reflection.cc \
   runtime.cc \
@@ -151,6 +155,7 @@ LIBART_COMMON_SRC_FILES := \
   throw_location.cc \
   trace.cc \
   transaction.cc \
+  type_lookup_table.cc \
   profiler.cc \
   fault_handler.cc \
   utf.cc \
@@ -231,6 +236,7 @@ LIBART_TARGET_SRC_FILES_arm64 := \
   arch/arm64/entrypoints_init_arm64.cc \
   arch/arm64/jni_entrypoints_arm64.S \
   arch/arm64/memcmp16_arm64.S \
+  arch/arm64/mterp_arm64.S \
   arch/arm64/portable_entrypoints_arm64.S \
   arch/arm64/quick_entrypoints_arm64.S \
   arch/arm64/thread_arm64.cc \
@@ -257,6 +263,7 @@ LIBART_SRC_FILES_x86_64 := \
   arch/x86_64/entrypoints_init_x86_64.cc \
   arch/x86_64/jni_entrypoints_x86_64.S \
   arch/x86_64/memcmp16_x86_64.S \
+  arch/x86_64/mterp_x86_64.S \
   arch/x86_64/portable_entrypoints_x86_64.S \
   arch/x86_64/quick_entrypoints_x86_64.S \
   arch/x86_64/thread_x86_64.cc \
@@ -128,6 +128,26 @@ ADD_TEST_EQ(MIRROR_ARRAY_LENGTH_OFFSET, art::mirror::Array::LengthOffset().Int32
 ADD_TEST_EQ(MIRROR_CHAR_ARRAY_DATA_OFFSET,
             art::mirror::Array::DataOffset(sizeof(uint16_t)).Int32Value())
 
+#define MIRROR_BOOLEAN_ARRAY_DATA_OFFSET (4 + MIRROR_OBJECT_HEADER_SIZE)
+ADD_TEST_EQ(MIRROR_BOOLEAN_ARRAY_DATA_OFFSET,
+            art::mirror::Array::DataOffset(sizeof(uint8_t)).Int32Value())
+
+#define MIRROR_BYTE_ARRAY_DATA_OFFSET   (4 + MIRROR_OBJECT_HEADER_SIZE)
+ADD_TEST_EQ(MIRROR_BYTE_ARRAY_DATA_OFFSET,
+            art::mirror::Array::DataOffset(sizeof(int8_t)).Int32Value())
+
+#define MIRROR_SHORT_ARRAY_DATA_OFFSET  (4 + MIRROR_OBJECT_HEADER_SIZE)
+ADD_TEST_EQ(MIRROR_SHORT_ARRAY_DATA_OFFSET,
+            art::mirror::Array::DataOffset(sizeof(int16_t)).Int32Value())
+
+#define MIRROR_INT_ARRAY_DATA_OFFSET    (4 + MIRROR_OBJECT_HEADER_SIZE)
+ADD_TEST_EQ(MIRROR_INT_ARRAY_DATA_OFFSET,
+            art::mirror::Array::DataOffset(sizeof(int32_t)).Int32Value())
+
+#define MIRROR_WIDE_ARRAY_DATA_OFFSET   (8 + MIRROR_OBJECT_HEADER_SIZE)
+ADD_TEST_EQ(MIRROR_WIDE_ARRAY_DATA_OFFSET,
+            art::mirror::Array::DataOffset(sizeof(uint64_t)).Int32Value())
+
 #define MIRROR_OBJECT_ARRAY_DATA_OFFSET (4 + MIRROR_OBJECT_HEADER_SIZE)
 ADD_TEST_EQ(MIRROR_OBJECT_ARRAY_DATA_OFFSET,
     art::mirror::Array::DataOffset(
@@ -156,6 +176,17 @@ ADD_TEST_EQ(MIRROR_ART_METHOD_PORTABLE_CODE_OFFSET,
 ADD_TEST_EQ(MIRROR_ART_METHOD_QUICK_CODE_OFFSET,
             art::mirror::ArtMethod::EntryPointFromQuickCompiledCodeOffset().Int32Value())
 
+// Offsets within ShadowFrame.
+#define SHADOWFRAME_NUMBER_OF_VREGS_OFFSET 0
+ADD_TEST_EQ(static_cast<size_t>(SHADOWFRAME_NUMBER_OF_VREGS_OFFSET),
+            art::ShadowFrame::NumberOfVRegsOffset())
+
+#define SHADOWFRAME_DEX_PC_OFFSET (3 * __SIZEOF_POINTER__)
+ADD_TEST_EQ(static_cast<size_t>(SHADOWFRAME_DEX_PC_OFFSET), art::ShadowFrame::DexPCOffset())
+
+#define SHADOWFRAME_VREGS_OFFSET (SHADOWFRAME_DEX_PC_OFFSET + 4)
+ADD_TEST_EQ(static_cast<size_t>(SHADOWFRAME_VREGS_OFFSET), art::ShadowFrame::VRegsOffset())
+
 #if defined(__cplusplus)
 }  // End of CheckAsmSupportOffsets.
 #endif
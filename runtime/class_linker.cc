@@ -791,6 +791,16 @@ static bool LoadMultiDexFilesFromOatFile(const OatFile* oat_file,
 
   size_t old_size = dex_files->size();  // To rollback on error.
 
+  // Read the checksums of all the multidex entries at once rather than reopening the container
+  // for each of them. Pre-opted files have no dex files left to read them from.
+  std::vector<uint32_t> location_checksums;
+  if (dex_location_checksum != nullptr) {
+    std::string error_msg;
+    if (!DexFile::GetMultiDexChecksums(dex_location, &location_checksums, &error_msg)) {
+      location_checksums.clear();
+    }
+  }
+
   bool success = true;
   for (size_t i = 0; success; ++i) {
     std::string next_name_str = DexFile::GetMultiDexClassesDexName(i, dex_location);
@@ -799,16 +809,17 @@ static bool LoadMultiDexFilesFromOatFile(const OatFile* oat_file,
     uint32_t next_location_checksum;
     uint32_t* next_location_checksum_pointer = &next_location_checksum;
     std::string error_msg;
-    if ((i == 0) && (strcmp(next_name, dex_location) == 0)) {
-      // When i=0 the multidex name should be the same as the location name. We already have the
-      // checksum it so we don't need to recompute it.
+    if (i == 0) {
+      // When i=0 the multidex name is the location name. We already have the checksum so we don't
+      // need to recompute it.
       if (dex_location_checksum == nullptr) {
         next_location_checksum_pointer = nullptr;
       } else {
         next_location_checksum = *dex_location_checksum;
       }
-    } else if (!DexFile::GetChecksum(next_name, next_location_checksum_pointer, &error_msg)) {
-      DCHECK_EQ(false, i == 0 && generated);
+    } else if (i < location_checksums.size()) {
+      next_location_checksum = location_checksums[i];
+    } else {
       next_location_checksum_pointer = nullptr;
     }
 
@@ -1207,29 +1218,35 @@ bool ClassLinker::VerifyOatWithDexFile(const OatFile* oat_file,
                                        std::string* error_msg) {
   CHECK(oat_file != nullptr);
   CHECK(dex_location != nullptr);
-  std::unique_ptr<const DexFile> dex_file;
+  const OatFile::OatDexFile* oat_dex_file;
   if (dex_location_checksum == nullptr) {
     // If no classes.dex found in dex_location, it has been stripped or is corrupt, assume oat is
     // up-to-date. This is the common case in user builds for jar's and apk's in the /system
     // directory.
-    const OatFile::OatDexFile* oat_dex_file = oat_file->GetOatDexFile(dex_location, nullptr);
+    oat_dex_file = oat_file->GetOatDexFile(dex_location, nullptr);
     if (oat_dex_file == nullptr) {
       *error_msg = StringPrintf("Dex checksum mismatch for location '%s' and failed to find oat "
                                 "dex file '%s': %s", oat_file->GetLocation().c_str(), dex_location,
                                 error_msg->c_str());
       return false;
     }
-    dex_file.reset(oat_dex_file->OpenDexFile(error_msg));
   } else {
     bool verified = VerifyOatAndDexFileChecksums(oat_file, dex_location, *dex_location_checksum,
                                                  kRuntimeISA, error_msg);
     if (!verified) {
       return false;
     }
-    dex_file.reset(oat_file->GetOatDexFile(dex_location,
-                                           dex_location_checksum)->OpenDexFile(error_msg));
+    oat_dex_file = oat_file->GetOatDexFile(dex_location, dex_location_checksum);
+  }
+  // The dex file was checked when the oat file was written and opening it from the oat file only
+  // checks its magic and version, so check those without creating a DexFile that is thrown away.
+  const uint8_t* dex_file_pointer = oat_dex_file->GetDexFilePointer();
+  if (!DexFile::IsMagicValid(dex_file_pointer) || !DexFile::IsVersionValid(dex_file_pointer)) {
+    *error_msg = StringPrintf("Invalid dex file header for '%s' in oat file '%s'", dex_location,
+                              oat_file->GetLocation().c_str());
+    return false;
   }
-  return dex_file.get() != nullptr;
+  return true;
 }
 
 const OatFile* ClassLinker::FindOatFileContainingDexFileFromDexLocation(
@@ -1488,6 +1505,14 @@ const OatFile* ClassLinker::PatchAndRetrieveOat(const std::string& input_oat,
   output_oat_filename_arg += output_oat;
   std::string patched_image_arg("--patched-image-location=");
   patched_image_arg += image_location;
+  if (Runtime::Current()->ShouldRelocateInMemory()) {
+    // There may be no relocated image file for patchoat to look at, give it the delta the image
+    // was relocated by directly.
+    const ImageHeader& image_header =
+        Runtime::Current()->GetHeap()->GetImageSpace()->GetImageHeader();
+    patched_image_arg = StringPrintf("--base-offset-delta=%d",
+                                     static_cast<int>(image_header.GetPatchDelta()));
+  }
 
   std::vector<std::string> argv;
   argv.push_back(patchoat);
@@ -2040,9 +2065,10 @@ typedef std::pair<const DexFile*, const DexFile::ClassDef*> ClassPathEntry;
 // Search a collection of DexFiles for a descriptor
 ClassPathEntry FindInClassPath(const char* descriptor,
                                const std::vector<const DexFile*>& class_path) {
+  const uint32_t hash = ComputeUtf8Hash(descriptor);
   for (size_t i = 0; i != class_path.size(); ++i) {
     const DexFile* dex_file = class_path[i];
-    const DexFile::ClassDef* dex_class_def = dex_file->FindClassDef(descriptor);
+    const DexFile::ClassDef* dex_class_def = dex_file->FindClassDef(descriptor, hash);
     if (dex_class_def != nullptr) {
       return ClassPathEntry(dex_file, dex_class_def);
     }
@@ -2055,10 +2081,7 @@ ClassPathEntry FindInClassPath(const char* descriptor,
 mirror::Class* ClassLinker::FindClassInPathClassLoader(ScopedObjectAccessAlreadyRunnable& soa,
                                                        Thread* self, const char* descriptor,
                                                        Handle<mirror::ClassLoader> class_loader) {
-  if (class_loader->GetClass() !=
-      soa.Decode<mirror::Class*>(WellKnownClasses::dalvik_system_PathClassLoader) ||
-      class_loader->GetParent()->GetClass() !=
-          soa.Decode<mirror::Class*>(WellKnownClasses::java_lang_BootClassLoader)) {
+  if (!IsPathClassLoaderOverBootClassLoader(soa, class_loader.Get())) {
     return nullptr;
   }
   ClassPathEntry pair = FindInClassPath(descriptor, boot_class_path_);
@@ -2097,6 +2120,7 @@ mirror::Class* ClassLinker::FindClassInPathClassLoader(ScopedObjectAccessAlready
       // Loop through each dalvik.system.DexPathList$Element's dalvik.system.DexFile and look
       // at the mCookie which is a DexFile vector.
       if (dex_elements_obj != nullptr) {
+        const uint32_t hash = ComputeUtf8Hash(descriptor);
         Handle<mirror::ObjectArray<mirror::Object>> dex_elements =
             hs.NewHandle(dex_elements_obj->AsObjectArray<mirror::Object>());
         for (int32_t i = 0; i < dex_elements->GetLength(); ++i) {
@@ -2116,9 +2140,9 @@ mirror::Class* ClassLinker::FindClassInPathClassLoader(ScopedObjectAccessAlready
               break;
             }
             for (const DexFile* dex_file : *dex_files) {
-              const DexFile::ClassDef* dex_class_def = dex_file->FindClassDef(descriptor);
+              const DexFile::ClassDef* dex_class_def = dex_file->FindClassDef(descriptor, hash);
               if (dex_class_def != nullptr) {
-                RegisterDexFile(*dex_file);
+                RegisterDexFile(*dex_file, class_loader);
                 mirror::Class* klass =
                     DefineClass(self, descriptor, class_loader, *dex_file, *dex_class_def);
                 if (klass == nullptr) {
@@ -2969,11 +2993,40 @@ mirror::ArtMethod* ClassLinker::LoadMethod(Thread* self, const DexFile& dex_file
       }
     }
   }
+  if (UNLIKELY((access_flags & kAccNative) != 0)) {
+    access_flags |= GetNativeMethodAnnotationFlags(
+        dex_file, dex_file.GetClassDef(klass->GetDexClassDefIndex()), dex_method_idx, access_flags);
+  }
   dst->SetAccessFlags(access_flags);
 
   return dst;
 }
 
+uint32_t ClassLinker::GetNativeMethodAnnotationFlags(const DexFile& dex_file,
+                                                     const DexFile::ClassDef& class_def,
+                                                     uint32_t method_idx, uint32_t access_flags) {
+  DCHECK_NE(access_flags & kAccNative, 0u);
+  if (class_def.annotations_off_ == 0) {
+    return 0;
+  }
+  if (dex_file.IsMethodAnnotationPresent(class_def, method_idx,
+                                         "Ldalvik/annotation/optimization/CriticalNative;")) {
+    const char* shorty = dex_file.GetMethodShorty(dex_file.GetMethodId(method_idx));
+    bool has_references = strchr(shorty, 'L') != nullptr;
+    if ((access_flags & kAccStatic) != 0 && (access_flags & kAccSynchronized) == 0 &&
+        !has_references) {
+      return kAccCriticalNative;
+    }
+    LOG(WARNING) << "Ignoring @CriticalNative on " << PrettyMethod(method_idx, dex_file)
+                 << ": must be static, not synchronized and only use primitive types";
+  }
+  if (dex_file.IsMethodAnnotationPresent(class_def, method_idx,
+                                         "Ldalvik/annotation/optimization/FastNative;")) {
+    return kAccFastNative;
+  }
+  return 0;
+}
+
 void ClassLinker::AppendToBootClassPath(Thread* self, const DexFile& dex_file) {
   StackHandleScope<1> hs(self);
   Handle<mirror::DexCache> dex_cache(hs.NewHandle(AllocDexCache(self, dex_file)));
@@ -3020,6 +3073,11 @@ void ClassLinker::RegisterDexFileLocked(const DexFile& dex_file,
 }
 
 void ClassLinker::RegisterDexFile(const DexFile& dex_file) {
+  RegisterDexFile(dex_file, NullHandle<mirror::ClassLoader>());
+}
+
+void ClassLinker::RegisterDexFile(const DexFile& dex_file,
+                                  Handle<mirror::ClassLoader> class_loader) {
   Thread* self = Thread::Current();
   {
     ReaderMutexLock mu(self, dex_lock_);
@@ -3034,6 +3092,10 @@ void ClassLinker::RegisterDexFile(const DexFile& dex_file) {
   Handle<mirror::DexCache> dex_cache(hs.NewHandle(AllocDexCache(self, dex_file)));
   CHECK(dex_cache.Get() != nullptr) << "Failed to allocate dex cache for "
                                     << dex_file.GetLocation();
+  if (class_loader.Get() != nullptr) {
+    // Nothing else sees the dex cache yet, so it can be filled without racing with resolution.
+    PrefillBootClassPathTypes(dex_file, class_loader.Get(), dex_cache.Get());
+  }
   {
     WriterMutexLock mu(self, dex_lock_);
     if (IsDexFileRegisteredLocked(dex_file)) {
@@ -3043,6 +3105,46 @@ void ClassLinker::RegisterDexFile(const DexFile& dex_file) {
   }
 }
 
+void ClassLinker::PrefillBootClassPathTypes(const DexFile& dex_file,
+                                            mirror::ClassLoader* class_loader,
+                                            mirror::DexCache* dex_cache) {
+  // A PathClassLoader over the boot class loader resolves every boot class path type to the boot
+  // class, so the ones already loaded can be stored now rather than on their first resolution.
+  // Other class loader chains may define those types themselves and are left alone.
+  Thread* self = Thread::Current();
+  ScopedObjectAccessUnchecked soa(self);
+  if (!IsPathClassLoaderOverBootClassLoader(soa, class_loader)) {
+    return;
+  }
+  size_t filled = 0;
+  for (size_t type_idx = 0; type_idx < dex_file.NumTypeIds(); ++type_idx) {
+    const char* descriptor = dex_file.StringByTypeIdx(type_idx);
+    if (descriptor[1] == '\0') {
+      continue;  // Primitive types are resolved through FindPrimitiveClass.
+    }
+    // Only the boot classes are looked up, so no class is defined here. Classes that are still
+    // being loaded or failed to load must go through ResolveType to wait or throw.
+    mirror::Class* klass = LookupClass(self, descriptor, nullptr);
+    if (klass != nullptr && klass->IsResolved()) {
+      dex_cache->SetResolvedType(type_idx, klass);
+      ++filled;
+    }
+  }
+  VLOG(class_linker) << "Prefilled " << filled << " boot class path types of "
+                     << dex_file.GetLocation();
+}
+
+bool ClassLinker::IsPathClassLoaderOverBootClassLoader(ScopedObjectAccessAlreadyRunnable& soa,
+                                                       mirror::ClassLoader* class_loader) {
+  if (class_loader->GetClass() !=
+      soa.Decode<mirror::Class*>(WellKnownClasses::dalvik_system_PathClassLoader)) {
+    return false;
+  }
+  mirror::ClassLoader* parent = class_loader->GetParent();
+  return parent != nullptr &&
+      parent->GetClass() == soa.Decode<mirror::Class*>(WellKnownClasses::java_lang_BootClassLoader);
+}
+
 void ClassLinker::RegisterDexFile(const DexFile& dex_file,
                                   Handle<mirror::DexCache> dex_cache) {
   WriterMutexLock mu(Thread::Current(), dex_lock_);
@@ -3989,6 +4091,8 @@ mirror::ArtMethod* ClassLinker::CreateProxyConstructor(Thread* self,
     CHECK(self->IsExceptionPending());  // OOME.
     return nullptr;
   }
+  // The interpreter's inline caches of the cloned constructor stay with it.
+  constructor->SetInlineCaches(nullptr);
   // Make this constructor public and fix the class to be our Proxy version
   constructor->SetAccessFlags((constructor->GetAccessFlags() & ~kAccProtected) | kAccPublic);
   constructor->SetDeclaringClass(klass.Get());
@@ -4607,6 +4711,79 @@ bool ClassLinker::LinkMethods(Thread* self, Handle<mirror::Class> klass,
   return true;
 }
 
+// Open addressing hash table of methods keyed by the hash of their name, used while linking to
+// match methods by name and signature without comparing against every candidate. Entries are
+// indices into a method array held in a handle, as the array may move. Methods with equal names
+// are found in the order they were added.
+class LinkMethodHashTable {
+ public:
+  static constexpr uint32_t kNotFound = 0xFFFFFFFF;
+
+  LinkMethodHashTable(Handle<mirror::ObjectArray<mirror::ArtMethod>> methods, size_t max_entries)
+      : methods_(methods), hash_size_(max_entries * 2 + 1), entries_(new Entry[hash_size_]) {
+    for (size_t i = 0; i < hash_size_; ++i) {
+      entries_[i].index = kEmpty;
+    }
+  }
+
+  void Add(uint32_t method_index) SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
+    uint32_t hash = ComputeUtf8Hash(methods_->Get(method_index)->GetName());
+    size_t slot = hash % hash_size_;
+    while (entries_[slot].index != kEmpty) {
+      slot = (slot + 1) % hash_size_;
+    }
+    entries_[slot].hash = hash;
+    entries_[slot].index = method_index;
+  }
+
+  // Returns the index of the first added method with the name and signature of mh's method, or
+  // kNotFound. On success candidate_mh is left on the found method.
+  uint32_t Find(MutableMethodHelper* mh, MutableMethodHelper* candidate_mh)
+      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
+    uint32_t hash = ComputeUtf8Hash(mh->GetMethod()->GetName());
+    for (size_t slot = hash % hash_size_; entries_[slot].index != kEmpty;
+         slot = (slot + 1) % hash_size_) {
+      const Entry& entry = entries_[slot];
+      if (entry.hash == hash && entry.index != kRemoved) {
+        candidate_mh->ChangeMethod(methods_->Get(entry.index));
+        if (mh->HasSameNameAndSignature(candidate_mh)) {
+          return entry.index;
+        }
+      }
+    }
+    return kNotFound;
+  }
+
+  // Stop finding the method at method_index.
+  void Remove(uint32_t method_index) SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
+    uint32_t hash = ComputeUtf8Hash(methods_->Get(method_index)->GetName());
+    for (size_t slot = hash % hash_size_; entries_[slot].index != kEmpty;
+         slot = (slot + 1) % hash_size_) {
+      if (entries_[slot].index == method_index) {
+        // Keep the slot occupied so that probing continues past it.
+        entries_[slot].index = kRemoved;
+        return;
+      }
+    }
+    LOG(FATAL) << "Method " << method_index << " not in table";
+  }
+
+ private:
+  static constexpr uint32_t kEmpty = 0xFFFFFFFF;
+  static constexpr uint32_t kRemoved = 0xFFFFFFFE;
+
+  struct Entry {
+    uint32_t hash;
+    uint32_t index;
+  };
+
+  Handle<mirror::ObjectArray<mirror::ArtMethod>> methods_;
+  const size_t hash_size_;
+  std::unique_ptr<Entry[]> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(LinkMethodHashTable);
+};
+
 bool ClassLinker::LinkVirtualMethods(Thread* self, Handle<mirror::Class> klass) {
   if (klass->HasSuperClass()) {
     uint32_t max_count = klass->NumVirtualMethods() +
@@ -4635,40 +4812,56 @@ bool ClassLinker::LinkVirtualMethods(Thread* self, Handle<mirror::Class> klass)
       }
     }
 
-    // See if any of our virtual methods override the superclass.
-    MutableMethodHelper local_mh(hs.NewHandle<mirror::ArtMethod>(nullptr));
-    MutableMethodHelper super_mh(hs.NewHandle<mirror::ArtMethod>(nullptr));
-    for (size_t i = 0; i < klass->NumVirtualMethods(); ++i) {
-      mirror::ArtMethod* local_method = klass->GetVirtualMethodDuringLinking(i);
-      local_mh.ChangeMethod(local_method);
-      size_t j = 0;
-      for (; j < actual_count; ++j) {
+    // See if any of our virtual methods override the superclass. Walk the superclass vtable in
+    // order, looking up our methods by name and signature, so that a method overrides the first
+    // accessible superclass method it matches.
+    const size_t num_virtual_methods = klass->NumVirtualMethods();
+    if (num_virtual_methods != 0) {
+      MutableMethodHelper local_mh(hs.NewHandle<mirror::ArtMethod>(nullptr));
+      MutableMethodHelper super_mh(hs.NewHandle<mirror::ArtMethod>(nullptr));
+      StackHandleScope<1> hs2(self);
+      LinkMethodHashTable local_methods(hs2.NewHandle(klass->GetVirtualMethods()),
+                                        num_virtual_methods);
+      for (size_t i = 0; i < num_virtual_methods; ++i) {
+        local_methods.Add(i);
+      }
+      std::vector<bool> overriding(num_virtual_methods, false);
+      const size_t super_vtable_length = actual_count;
+      for (size_t j = 0; j < super_vtable_length; ++j) {
         mirror::ArtMethod* super_method = vtable->Get(j);
         super_mh.ChangeMethod(super_method);
-        if (local_mh.HasSameNameAndSignature(&super_mh)) {
-          if (klass->CanAccessMember(super_method->GetDeclaringClass(),
-                                     super_method->GetAccessFlags())) {
-            if (super_method->IsFinal()) {
-              ThrowLinkageError(klass.Get(), "Method %s overrides final method in class %s",
-                                PrettyMethod(local_method).c_str(),
-                                super_method->GetDeclaringClassDescriptor());
-              return false;
-            }
-            vtable->Set<false>(j, local_method);
-            local_method->SetMethodIndex(j);
-            break;
-          } else {
-            LOG(WARNING) << "Before Android 4.1, method " << PrettyMethod(local_method)
-                         << " would have incorrectly overridden the package-private method in "
-                         << PrettyDescriptor(super_method->GetDeclaringClassDescriptor());
+        uint32_t i = local_methods.Find(&super_mh, &local_mh);
+        if (i == LinkMethodHashTable::kNotFound) {
+          continue;
+        }
+        mirror::ArtMethod* local_method = local_mh.GetMethod();
+        if (klass->CanAccessMember(super_method->GetDeclaringClass(),
+                                   super_method->GetAccessFlags())) {
+          if (super_method->IsFinal()) {
+            ThrowLinkageError(klass.Get(), "Method %s overrides final method in class %s",
+                              PrettyMethod(local_method).c_str(),
+                              super_method->GetDeclaringClassDescriptor());
+            return false;
           }
+          vtable->Set<false>(j, local_method);
+          local_method->SetMethodIndex(j);
+          overriding[i] = true;
+          // Only override the first accessible match.
+          local_methods.Remove(i);
+        } else {
+          LOG(WARNING) << "Before Android 4.1, method " << PrettyMethod(local_method)
+                       << " would have incorrectly overridden the package-private method in "
+                       << PrettyDescriptor(super_method->GetDeclaringClassDescriptor());
         }
       }
-      if (j == actual_count) {
-        // Not overriding, append.
-        vtable->Set<false>(actual_count, local_method);
-        local_method->SetMethodIndex(actual_count);
-        actual_count += 1;
+      for (size_t i = 0; i < num_virtual_methods; ++i) {
+        if (!overriding[i]) {
+          // Not overriding, append.
+          mirror::ArtMethod* local_method = klass->GetVirtualMethodDuringLinking(i);
+          vtable->Set<false>(actual_count, local_method);
+          local_method->SetMethodIndex(actual_count);
+          actual_count += 1;
+        }
       }
     }
     if (!IsUint(16, actual_count)) {
@@ -4752,7 +4945,7 @@ bool ClassLinker::LinkInterfaceMethods(Handle<mirror::Class> klass,
       return true;
     }
   }
-  StackHandleScope<5> hs(self);
+  StackHandleScope<6> hs(self);
   MutableHandle<mirror::IfTable> iftable(hs.NewHandle(AllocIfTable(self, ifcount)));
   if (UNLIKELY(iftable.Get() == nullptr)) {
     CHECK(self->IsExceptionPending());  // OOME.
@@ -4845,11 +5038,26 @@ bool ClassLinker::LinkInterfaceMethods(Handle<mirror::Class> klass,
   Handle<mirror::ObjectArray<mirror::ArtMethod>>
       miranda_list(hs.NewHandle(AllocArtMethodArray(self, max_miranda_methods)));
   size_t miranda_list_size = 0;  // The current size of miranda_list.
+  // For each method listed in the interface's method list, we find the matching method in our
+  // class's vtable. We want to favor the subclass over the superclass, which just requires
+  // favoring the end of the vtable, so its methods are added to the table from the end. (This only
+  // matters if the superclass defines a private method and this class redefines it -- otherwise it
+  // would use the same vtable slot. In .dex files those don't end up in the virtual method table,
+  // so it shouldn't matter which one we pick. We favor the end anyway.)
+  Handle<mirror::ObjectArray<mirror::ArtMethod>> current_vtable(
+      hs.NewHandle(klass->GetVTableDuringLinking()));
+  std::unique_ptr<LinkMethodHashTable> vtable_methods;
+  if (max_miranda_methods != 0) {
+    vtable_methods.reset(new LinkMethodHashTable(current_vtable, current_vtable->GetLength()));
+    for (int32_t k = current_vtable->GetLength() - 1; k >= 0; --k) {
+      vtable_methods->Add(k);
+    }
+  }
   for (size_t i = 0; i < ifcount; ++i) {
     self->AllowThreadSuspension();
     size_t num_methods = iftable->GetInterface(i)->NumVirtualMethods();
     if (num_methods > 0) {
-      StackHandleScope<2> hs(self);
+      StackHandleScope<1> hs(self);
       Handle<mirror::ObjectArray<mirror::ArtMethod>>
           method_array(hs.NewHandle(AllocArtMethodArray(self, num_methods)));
       if (UNLIKELY(method_array.Get() == nullptr)) {
@@ -4857,43 +5065,27 @@ bool ClassLinker::LinkInterfaceMethods(Handle<mirror::Class> klass,
         return false;
       }
       iftable->SetMethodArray(i, method_array.Get());
-      Handle<mirror::ObjectArray<mirror::ArtMethod>> vtable(
-          hs.NewHandle(klass->GetVTableDuringLinking()));
       for (size_t j = 0; j < num_methods; ++j) {
         interface_mh.ChangeMethod(iftable->GetInterface(i)->GetVirtualMethod(j));
-        int32_t k;
-        // For each method listed in the interface's method list, find the
-        // matching method in our class's method list.  We want to favor the
-        // subclass over the superclass, which just requires walking
-        // back from the end of the vtable.  (This only matters if the
-        // superclass defines a private method and this class redefines
-        // it -- otherwise it would use the same vtable slot.  In .dex files
-        // those don't end up in the virtual method table, so it shouldn't
-        // matter which direction we go.  We walk it backward anyway.)
-        for (k = vtable->GetLength() - 1; k >= 0; --k) {
-          vtable_mh.ChangeMethod(vtable->Get(k));
-          if (interface_mh.HasSameNameAndSignature(&vtable_mh)) {
-            if (!vtable_mh.Get()->IsAbstract() && !vtable_mh.Get()->IsPublic()) {
-              ThrowIllegalAccessError(
-                  klass.Get(),
-                  "Method '%s' implementing interface method '%s' is not public",
-                  PrettyMethod(vtable_mh.Get()).c_str(),
-                  PrettyMethod(interface_mh.Get()).c_str());
-              return false;
-            }
-            method_array->Set<false>(j, vtable_mh.Get());
-            // Place method in imt if entry is empty, place conflict otherwise.
-            uint32_t imt_index = interface_mh.Get()->GetDexMethodIndex() % mirror::Class::kImtSize;
-            if (imtable->Get(imt_index) == nullptr) {
-              imtable->Set<false>(imt_index, vtable_mh.Get());
-              imtable_changed = true;
-            } else {
-              imtable->Set<false>(imt_index, runtime->GetImtConflictMethod());
-            }
-            break;
+        if (vtable_methods->Find(&interface_mh, &vtable_mh) != LinkMethodHashTable::kNotFound) {
+          if (!vtable_mh.Get()->IsAbstract() && !vtable_mh.Get()->IsPublic()) {
+            ThrowIllegalAccessError(
+                klass.Get(),
+                "Method '%s' implementing interface method '%s' is not public",
+                PrettyMethod(vtable_mh.Get()).c_str(),
+                PrettyMethod(interface_mh.Get()).c_str());
+            return false;
           }
-        }
-        if (k < 0) {
+          method_array->Set<false>(j, vtable_mh.Get());
+          // Place method in imt if entry is empty, place conflict otherwise.
+          uint32_t imt_index = interface_mh.Get()->GetDexMethodIndex() % mirror::Class::kImtSize;
+          if (imtable->Get(imt_index) == nullptr) {
+            imtable->Set<false>(imt_index, vtable_mh.Get());
+            imtable_changed = true;
+          } else {
+            imtable->Set<false>(imt_index, runtime->GetImtConflictMethod());
+          }
+        } else {
           StackHandleScope<1> hs(self);
           auto miranda_method = hs.NewHandle<mirror::ArtMethod>(nullptr);
           for (size_t l = 0; l < miranda_list_size; ++l) {
@@ -4928,6 +5120,11 @@ bool ClassLinker::LinkInterfaceMethods(Handle<mirror::Class> klass,
         imtable->Set<false>(i, imt_conflict_method);
       }
     }
+    // Only classes with an embedded imt dispatch through it.
+    if (klass->ShouldHaveEmbeddedImtAndVTable() &&
+        !SetupImtConflictTables(self, klass, iftable, imtable)) {
+      return false;
+    }
     klass->SetImTable(imtable.Get());
   }
   if (miranda_list_size > 0) {
@@ -4978,6 +5175,71 @@ bool ClassLinker::LinkInterfaceMethods(Handle<mirror::Class> klass,
   return true;
 }
 
+bool ClassLinker::SetupImtConflictTables(Thread* self, Handle<mirror::Class> klass,
+                                         Handle<mirror::IfTable> iftable,
+                                         Handle<mirror::ObjectArray<mirror::ArtMethod>> imtable) {
+  mirror::ArtMethod* imt_conflict_method = Runtime::Current()->GetImtConflictMethod();
+  // Collect the (interface method, implementation) pairs of each conflicting slot. Methods are
+  // never moved, so they may be held across the allocations below.
+  std::vector<std::vector<mirror::ArtMethod*>> conflicts(mirror::Class::kImtSize);
+  for (size_t i = 0; i < iftable->Count(); ++i) {
+    mirror::Class* interface = iftable->GetInterface(i);
+    size_t num_methods = interface->NumVirtualMethods();
+    for (size_t j = 0; j < num_methods; ++j) {
+      mirror::ArtMethod* interface_method = interface->GetVirtualMethod(j);
+      uint32_t imt_index = interface_method->GetDexMethodIndex() % mirror::Class::kImtSize;
+      if (imtable->Get(imt_index) == imt_conflict_method) {
+        conflicts[imt_index].push_back(interface_method);
+        conflicts[imt_index].push_back(iftable->GetMethodArray(i)->Get(j));
+      }
+    }
+  }
+  mirror::Class* super_class = klass->GetSuperClass();
+  bool super_has_imt = super_class != nullptr && super_class->ShouldHaveEmbeddedImtAndVTable();
+  for (size_t i = 0; i < mirror::Class::kImtSize; ++i) {
+    const std::vector<mirror::ArtMethod*>& pairs = conflicts[i];
+    if (pairs.empty()) {
+      continue;
+    }
+    // Subclasses that don't override any of the methods in the slot share the table.
+    if (super_has_imt) {
+      mirror::ArtMethod* super_method = klass->GetSuperClass()->GetEmbeddedImTableEntry(i);
+      if (super_method->IsImtConflictMethod()) {
+        mirror::ObjectArray<mirror::ArtMethod>* super_table = super_method->GetImtConflictTable();
+        if (super_table != nullptr && static_cast<size_t>(super_table->GetLength()) == pairs.size()) {
+          size_t j = 0;
+          while (j < pairs.size() && super_table->Get(j) == pairs[j]) {
+            ++j;
+          }
+          if (j == pairs.size()) {
+            imtable->Set<false>(i, super_method);
+            continue;
+          }
+        }
+      }
+    }
+    StackHandleScope<1> hs(self);
+    Handle<mirror::ObjectArray<mirror::ArtMethod>> table(
+        hs.NewHandle(AllocArtMethodArray(self, pairs.size())));
+    if (UNLIKELY(table.Get() == nullptr)) {
+      CHECK(self->IsExceptionPending());  // OOME.
+      return false;
+    }
+    for (size_t j = 0; j < pairs.size(); ++j) {
+      table->Set<false>(j, pairs[j]);
+    }
+    mirror::ArtMethod* conflict_method =
+        down_cast<mirror::ArtMethod*>(Runtime::Current()->GetImtConflictMethod()->Clone(self));
+    if (UNLIKELY(conflict_method == nullptr)) {
+      CHECK(self->IsExceptionPending());  // OOME.
+      return false;
+    }
+    conflict_method->SetImtConflictTable(table.Get());
+    imtable->Set<false>(i, conflict_method);
+  }
+  return true;
+}
+
 bool ClassLinker::LinkInstanceFields(Thread* self, Handle<mirror::Class> klass) {
   CHECK(klass.Get() != nullptr);
   return LinkFields(self, klass, false, nullptr);
@@ -273,6 +273,11 @@ class ClassLinker {
   void RegisterDexFile(const DexFile& dex_file)
       LOCKS_EXCLUDED(dex_lock_)
       SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
+  // Register dex_file, which class_loader loads classes from. The dex cache starts out with the
+  // boot classes already loaded for its types if class_loader resolves them to boot classes.
+  void RegisterDexFile(const DexFile& dex_file, Handle<mirror::ClassLoader> class_loader)
+      LOCKS_EXCLUDED(dex_lock_)
+      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
   void RegisterDexFile(const DexFile& dex_file, Handle<mirror::DexCache> dex_cache)
       LOCKS_EXCLUDED(dex_lock_)
       SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
@@ -414,6 +419,14 @@ class ClassLinker {
 
   static const char* GetClassRootDescriptor(ClassRoot class_root);
 
+  // Returns the kAccFastNative or kAccCriticalNative flag implied by the optimization
+  // annotations of the native method method_idx declared by class_def, or 0 if there are none.
+  // @CriticalNative is ignored unless the method is static, unsynchronized and has no reference
+  // arguments or return value.
+  static uint32_t GetNativeMethodAnnotationFlags(const DexFile& dex_file,
+                                                 const DexFile::ClassDef& class_def,
+                                                 uint32_t method_idx, uint32_t access_flags);
+
   // Is the given entry point portable code to run the resolution stub?
   bool IsPortableResolutionStub(const void* entry_point) const;
 
@@ -531,6 +544,19 @@ class ClassLinker {
   bool IsDexFileRegisteredLocked(const DexFile& dex_file)
       SHARED_LOCKS_REQUIRED(dex_lock_, Locks::mutator_lock_);
 
+  // Store in dex_cache the boot classes already loaded for the types of dex_file, if class_loader
+  // is a PathClassLoader whose parent is the boot class loader.
+  void PrefillBootClassPathTypes(const DexFile& dex_file, mirror::ClassLoader* class_loader,
+                                 mirror::DexCache* dex_cache)
+      LOCKS_EXCLUDED(dex_lock_)
+      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
+
+  // Whether class_loader is a PathClassLoader whose parent is the boot class loader. Such a class
+  // loader finds the classes of the boot class path before its own.
+  bool IsPathClassLoaderOverBootClassLoader(ScopedObjectAccessAlreadyRunnable& soa,
+                                            mirror::ClassLoader* class_loader)
+      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
+
   bool InitializeClass(Thread* self, Handle<mirror::Class> klass, bool can_run_clinit,
                        bool can_init_parents)
       SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
@@ -571,6 +597,13 @@ class ClassLinker {
                             Handle<mirror::ObjectArray<mirror::Class>> interfaces)
       SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
 
+  // Replace the runtime's imt conflict method in the slots of imtable that interface methods of
+  // klass share with conflict methods whose tables map them to their implementations.
+  bool SetupImtConflictTables(Thread* self, Handle<mirror::Class> klass,
+                              Handle<mirror::IfTable> iftable,
+                              Handle<mirror::ObjectArray<mirror::ArtMethod>> imtable)
+      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
+
   bool LinkStaticFields(Thread* self, Handle<mirror::Class> klass, size_t* class_size)
       SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
   bool LinkInstanceFields(Thread* self, Handle<mirror::Class> klass)
@@ -663,7 +696,7 @@ class ClassLinker {
   // file was pre-opted)
   //  - the checksums of the oat file (against the image space)
   //  - the checksum of the dex file against dex_location_checksum
-  //  - that the dex file can be opened
+  //  - that the dex file header in the oat file is valid
   // Returns true iff all verification succeed.
   //
   // The dex_location is the dex location as stored in the oat file header.
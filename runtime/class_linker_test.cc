@@ -19,6 +19,7 @@
 #include <memory>
 #include <string>
 
+#include "base/histogram-inl.h"
 #include "class_linker-inl.h"
 #include "common_runtime_test.h"
 #include "dex_file.h"
@@ -39,6 +40,7 @@
 #include "handle_scope-inl.h"
 #include "scoped_thread_state_change.h"
 #include "thread-inl.h"
+#include "well_known_classes.h"
 
 namespace art {
 
@@ -1001,6 +1003,93 @@ TEST_F(ClassLinkerTest, Interfaces) {
   EXPECT_EQ(Afoo, Kfoo);
 }
 
+TEST_F(ClassLinkerTest, DeepHierarchy) {
+  static constexpr size_t kLevels = 12;
+  static constexpr size_t kBaseMethods = 8;
+  static constexpr size_t kNewMethodsPerLevel = 24;
+  static constexpr size_t kIterations = 16;
+  ScopedObjectAccess soa(Thread::Current());
+  mirror::Class* object_class = class_linker_->FindSystemClass(soa.Self(), "Ljava/lang/Object;");
+  ASSERT_TRUE(object_class != nullptr);
+  const size_t object_vtable_length = object_class->GetVTableLength();
+  // Times of linking the whole hierarchy with a fresh class loader, in microseconds.
+  Histogram<uint64_t> link_hist("DeepHierarchy link", 50);
+  for (size_t iteration = 0; iteration < kIterations; ++iteration) {
+    StackHandleScope<4> hs(soa.Self());
+    Handle<mirror::ClassLoader> class_loader(
+        hs.NewHandle(soa.Decode<mirror::ClassLoader*>(LoadDex("DeepHierarchy"))));
+    uint64_t start_time = NanoTime();
+    Handle<mirror::Class> leaf(hs.NewHandle(
+        class_linker_->FindClass(soa.Self(), "LDeepHierarchy$Level11;", class_loader)));
+    link_hist.AddValue((NanoTime() - start_time) / 1000);
+    ASSERT_TRUE(leaf.Get() != nullptr);
+    Handle<mirror::Class> root(hs.NewHandle(
+        class_linker_->FindClass(soa.Self(), "LDeepHierarchy$Level0;", class_loader)));
+    Handle<mirror::Class> base(hs.NewHandle(
+        class_linker_->FindClass(soa.Self(), "LDeepHierarchy$Base;", class_loader)));
+    ASSERT_TRUE(root.Get() != nullptr);
+    ASSERT_TRUE(base.Get() != nullptr);
+    EXPECT_TRUE(base->IsAssignableFrom(leaf.Get()));
+
+    // Overrides reuse the vtable slots of Level0, everything else is appended.
+    EXPECT_EQ(object_vtable_length + kBaseMethods + kLevels * kNewMethodsPerLevel,
+              static_cast<size_t>(leaf->GetVTableLength()));
+    const Signature void_sig = leaf->GetDexCache()->GetDexFile()->CreateSignature("()V");
+    for (size_t i = 0; i < kBaseMethods; ++i) {
+      std::string name = StringPrintf("b%zd", i);
+      mirror::ArtMethod* root_method = root->FindDeclaredVirtualMethod(name, void_sig);
+      mirror::ArtMethod* leaf_method = leaf->FindDeclaredVirtualMethod(name, void_sig);
+      mirror::ArtMethod* base_method = base->FindDeclaredVirtualMethod(name, void_sig);
+      ASSERT_TRUE(root_method != nullptr);
+      ASSERT_TRUE(leaf_method != nullptr);
+      ASSERT_TRUE(base_method != nullptr);
+      EXPECT_EQ(root_method->GetMethodIndex(), leaf_method->GetMethodIndex());
+      EXPECT_EQ(leaf_method, leaf->GetVTableEntry(leaf_method->GetMethodIndex()));
+      EXPECT_EQ(leaf_method, leaf->FindVirtualMethodForInterface(base_method));
+    }
+    for (size_t i = 0; i < kNewMethodsPerLevel; ++i) {
+      mirror::ArtMethod* method =
+          leaf->FindDeclaredVirtualMethod(StringPrintf("m11_%zd", i), void_sig);
+      ASSERT_TRUE(method != nullptr);
+      EXPECT_EQ(object_vtable_length + kBaseMethods + (kLevels - 1) * kNewMethodsPerLevel + i,
+                static_cast<size_t>(method->GetMethodIndex()));
+    }
+  }
+  Histogram<uint64_t>::CumulativeData data;
+  link_hist.CreateHistogram(&data);
+  link_hist.PrintConfidenceIntervals(std::cout, 0.99, data);
+}
+
+TEST_F(ClassLinkerTest, ImtConflictTables) {
+  ScopedObjectAccess soa(Thread::Current());
+  // ArrayList implements enough interface methods that some share a slot of its imt.
+  mirror::Class* array_list = class_linker_->FindSystemClass(soa.Self(), "Ljava/util/ArrayList;");
+  ASSERT_TRUE(array_list != nullptr);
+  ASSERT_TRUE(array_list->ShouldHaveEmbeddedImtAndVTable());
+  size_t num_tables = 0;
+  for (size_t i = 0; i < mirror::Class::kImtSize; ++i) {
+    mirror::ArtMethod* imt_method = array_list->GetEmbeddedImTableEntry(i);
+    if (!imt_method->IsImtConflictMethod()) {
+      continue;
+    }
+    mirror::ObjectArray<mirror::ArtMethod>* table = imt_method->GetImtConflictTable();
+    if (table == nullptr) {
+      EXPECT_EQ(Runtime::Current()->GetImtConflictMethod(), imt_method);
+      continue;
+    }
+    ++num_tables;
+    EXPECT_GE(table->GetLength(), 4);
+    for (int32_t j = 0; j < table->GetLength(); j += 2) {
+      mirror::ArtMethod* interface_method = table->Get(j);
+      EXPECT_TRUE(interface_method->GetDeclaringClass()->IsInterface());
+      EXPECT_EQ(i, interface_method->GetDexMethodIndex() % mirror::Class::kImtSize);
+      EXPECT_EQ(array_list->FindVirtualMethodForInterface(interface_method), table->Get(j + 1));
+      EXPECT_EQ(table->Get(j + 1), imt_method->FindImtConflictTarget(interface_method));
+    }
+  }
+  EXPECT_NE(0U, num_tables);
+}
+
 TEST_F(ClassLinkerTest, ResolveVerifyAndClinit) {
   // pretend we are trying to get the static storage for the StaticsFromCode class.
 
@@ -1160,4 +1249,37 @@ TEST_F(ClassLinkerTest, Preverified_App) {
   CheckPreverified(statics.Get(), true);
 }
 
+TEST_F(ClassLinkerTest, PrefillBootClassPathTypes) {
+  ScopedObjectAccess soa(Thread::Current());
+
+  StackHandleScope<3> hs(soa.Self());
+  Handle<mirror::ClassLoader> class_loader(hs.NewHandle(down_cast<mirror::ClassLoader*>(
+      soa.Decode<mirror::Class*>(WellKnownClasses::dalvik_system_PathClassLoader)->
+      AllocObject(soa.Self()))));
+  ASSERT_TRUE(class_loader.Get() != nullptr);
+  Handle<mirror::Object> boot_class_loader(hs.NewHandle(
+      soa.Decode<mirror::Class*>(WellKnownClasses::java_lang_BootClassLoader)->
+      AllocObject(soa.Self())));
+  ASSERT_TRUE(boot_class_loader.Get() != nullptr);
+  mirror::ArtField* parent_field =
+      class_linker_->FindSystemClass(soa.Self(), "Ljava/lang/ClassLoader;")->
+      FindDeclaredInstanceField("parent", "Ljava/lang/ClassLoader;");
+  ASSERT_TRUE(parent_field != nullptr);
+  parent_field->SetObject<false>(class_loader.Get(), boot_class_loader.Get());
+
+  const DexFile* dex_file = OpenTestDexFile("Statics");
+  ASSERT_TRUE(dex_file != nullptr);
+  class_linker_->RegisterDexFile(*dex_file, class_loader);
+  Handle<mirror::DexCache> dex_cache(hs.NewHandle(class_linker_->FindDexCache(*dex_file)));
+
+  // Boot classes that are already loaded are filled in, the classes of the dex file are not.
+  const DexFile::TypeId* object_type_id = dex_file->FindTypeId("Ljava/lang/Object;");
+  ASSERT_TRUE(object_type_id != nullptr);
+  EXPECT_EQ(class_linker_->FindSystemClass(soa.Self(), "Ljava/lang/Object;"),
+            dex_cache->GetResolvedType(dex_file->GetIndexForTypeId(*object_type_id)));
+  const DexFile::TypeId* statics_type_id = dex_file->FindTypeId("LStatics;");
+  ASSERT_TRUE(statics_type_id != nullptr);
+  EXPECT_TRUE(dex_cache->GetResolvedType(dex_file->GetIndexForTypeId(*statics_type_id)) == nullptr);
+}
+
 }  // namespace art
@@ -23,6 +23,7 @@
 #include <string.h>
 #include <sys/file.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 #include <memory>
 #include <sstream>
@@ -42,6 +43,7 @@
 #include "ScopedFd.h"
 #include "handle_scope-inl.h"
 #include "thread.h"
+#include "type_lookup_table.h"
 #include "utf-inl.h"
 #include "utils.h"
 #include "well_known_classes.h"
@@ -109,17 +111,74 @@ bool DexFile::GetChecksum(const char* filename, uint32_t* checksum, std::string*
     return true;
   }
   if (IsDexMagic(magic)) {
-    std::unique_ptr<const DexFile> dex_file(DexFile::OpenFile(fd.release(), filename, false, error_msg));
-    if (dex_file.get() == NULL) {
+    return ReadHeaderChecksum(fd.get(), filename, checksum, error_msg);
+  }
+  *error_msg = StringPrintf("Expected valid zip or dex file: '%s'", filename);
+  return false;
+}
+
+bool DexFile::GetMultiDexChecksums(const char* filename, std::vector<uint32_t>* checksums,
+                                   std::string* error_msg) {
+  CHECK(checksums != nullptr);
+  uint32_t magic;
+  ScopedFd fd(OpenAndReadMagic(filename, &magic, error_msg));
+  if (fd.get() == -1) {
+    DCHECK(!error_msg->empty());
+    return false;
+  }
+  if (IsZipMagic(magic)) {
+    std::unique_ptr<ZipArchive> zip_archive(ZipArchive::OpenFromFd(fd.release(), filename,
+                                                                   error_msg));
+    if (zip_archive.get() == nullptr) {
+      *error_msg = StringPrintf("Failed to open zip archive '%s'", filename);
+      return false;
+    }
+    // Look up the entries in the same order as OpenFromZip, from the archive opened once.
+    for (size_t i = 0; ; ++i) {
+      std::string entry_name = (i == 0) ? kClassesDex : StringPrintf("classes%zu.dex", i + 1);
+      std::string find_error_msg;
+      std::unique_ptr<ZipEntry> zip_entry(zip_archive->Find(entry_name.c_str(), &find_error_msg));
+      if (zip_entry.get() == nullptr) {
+        if (i == 0) {
+          *error_msg = StringPrintf("Zip archive '%s' doesn't contain %s (error msg: %s)", filename,
+                                    kClassesDex, find_error_msg.c_str());
+          return false;
+        }
+        return true;
+      }
+      checksums->push_back(zip_entry->GetCrc32());
+    }
+  }
+  if (IsDexMagic(magic)) {
+    uint32_t checksum;
+    if (!ReadHeaderChecksum(fd.get(), filename, &checksum, error_msg)) {
       return false;
     }
-    *checksum = dex_file->GetHeader().checksum_;
+    checksums->push_back(checksum);
     return true;
   }
   *error_msg = StringPrintf("Expected valid zip or dex file: '%s'", filename);
   return false;
 }
 
+bool DexFile::ReadHeaderChecksum(int fd, const char* filename, uint32_t* checksum,
+                                 std::string* error_msg) {
+  // Only the header is needed, don't map the whole file.
+  uint32_t buffer[sizeof(Header) / sizeof(uint32_t)];
+  ssize_t n = TEMP_FAILURE_RETRY(pread(fd, buffer, sizeof(buffer), 0));
+  if (n != sizeof(buffer)) {
+    *error_msg = StringPrintf("Failed to read dex header of '%s'", filename);
+    return false;
+  }
+  const Header* header = reinterpret_cast<const Header*>(buffer);
+  if (!IsMagicValid(header->magic_) || !IsVersionValid(header->magic_)) {
+    *error_msg = StringPrintf("Invalid dex header in '%s'", filename);
+    return false;
+  }
+  *checksum = header->checksum_;
+  return true;
+}
+
 bool DexFile::Open(const char* filename, const char* location, std::string* error_msg,
                    std::vector<const DexFile*>* dex_files) {
   uint32_t magic;
@@ -244,6 +303,7 @@ const DexFile* DexFile::OpenMemory(const std::string& location,
                     location,
                     location_checksum,
                     mem_map,
+                    nullptr,
                     error_msg);
 }
 
@@ -256,12 +316,26 @@ const DexFile* DexFile::Open(const ZipArchive& zip_archive, const char* entry_na
     *error_code = ZipOpenErrorCode::kEntryNotFound;
     return nullptr;
   }
-  std::unique_ptr<MemMap> map(zip_entry->ExtractToMemMap(location.c_str(), entry_name, error_msg));
-  if (map.get() == NULL) {
-    *error_msg = StringPrintf("Failed to extract '%s' from '%s': %s", entry_name, location.c_str(),
-                              error_msg->c_str());
-    *error_code = ZipOpenErrorCode::kExtractToMemoryError;
-    return nullptr;
+  std::unique_ptr<MemMap> map;
+  if (zip_entry->IsUncompressed() && zip_entry->IsAlignedTo(4) &&
+      zip_entry->GetUncompressedLength() >= sizeof(Header)) {
+    // A stored dex file with its data word aligned in the zip file can be used in place. This
+    // saves copying it and lets processes opening the same zip file share its pages.
+    std::string map_error_msg;
+    map.reset(zip_entry->MapDirectlyFromFile(location.c_str(), &map_error_msg));
+    if (map.get() == nullptr) {
+      LOG(WARNING) << "Failed to map '" << entry_name << "' directly from '" << location
+                   << "', extracting it instead: " << map_error_msg;
+    }
+  }
+  if (map.get() == nullptr) {
+    map.reset(zip_entry->ExtractToMemMap(location.c_str(), entry_name, error_msg));
+    if (map.get() == NULL) {
+      *error_msg = StringPrintf("Failed to extract '%s' from '%s': %s", entry_name,
+                                location.c_str(), error_msg->c_str());
+      *error_code = ZipOpenErrorCode::kExtractToMemoryError;
+      return nullptr;
+    }
   }
   std::unique_ptr<const DexFile> dex_file(OpenMemory(location, zip_entry->GetCrc32(), map.release(),
                                                error_msg));
@@ -271,7 +345,8 @@ const DexFile* DexFile::Open(const ZipArchive& zip_archive, const char* entry_na
     *error_code = ZipOpenErrorCode::kDexFileError;
     return nullptr;
   }
-  if (!dex_file->DisableWrite()) {
+  // Only extracted dex files are writable.
+  if (!dex_file->IsReadOnly() && !dex_file->DisableWrite()) {
     *error_msg = StringPrintf("Failed to make dex file '%s' read only", location.c_str());
     *error_code = ZipOpenErrorCode::kMakeReadOnlyError;
     return nullptr;
@@ -329,14 +404,19 @@ const DexFile* DexFile::OpenMemory(const uint8_t* base,
                                    size_t size,
                                    const std::string& location,
                                    uint32_t location_checksum,
-                                   MemMap* mem_map, std::string* error_msg) {
+                                   MemMap* mem_map,
+                                   const uint8_t* type_lookup_table_data,
+                                   std::string* error_msg) {
   CHECK_ALIGNED(base, 4);  // various dex file structures must be word aligned
   std::unique_ptr<DexFile> dex_file(new DexFile(base, size, location, location_checksum, mem_map));
   if (!dex_file->Init(error_msg)) {
     return nullptr;
-  } else {
-    return dex_file.release();
   }
+  if (type_lookup_table_data != nullptr) {
+    dex_file->lookup_table_.StoreRelaxed(TypeLookupTable::Open(type_lookup_table_data,
+                                                                *dex_file));
+  }
+  return dex_file.release();
 }
 
 DexFile::DexFile(const uint8_t* base, size_t size,
@@ -356,7 +436,7 @@ DexFile::DexFile(const uint8_t* base, size_t size,
       proto_ids_(reinterpret_cast<const ProtoId*>(base + header_->proto_ids_off_)),
       class_defs_(reinterpret_cast<const ClassDef*>(base + header_->class_defs_off_)),
       find_class_def_misses_(0),
-      class_def_index_(nullptr) {
+      lookup_table_(nullptr) {
   CHECK(begin_ != NULL) << GetLocation();
   CHECK_GT(size_, 0U) << GetLocation();
 }
@@ -366,8 +446,8 @@ DexFile::~DexFile() {
   // that's only called after DetachCurrentThread, which means there's no JNIEnv. We could
   // re-attach, but cleaning up these global references is not obviously useful. It's not as if
   // the global reference table is otherwise empty!
-  // Remove the index if one were created.
-  delete class_def_index_.LoadRelaxed();
+  // Remove the lookup table if one were created.
+  delete lookup_table_.LoadRelaxed();
 }
 
 bool DexFile::Init(std::string* error_msg) {
@@ -415,12 +495,13 @@ uint32_t DexFile::GetVersion() const {
   return atoi(version);
 }
 
-const DexFile::ClassDef* DexFile::FindClassDef(const char* descriptor) const {
-  // If we have an index lookup the descriptor via that as its constant time to search.
-  Index* index = class_def_index_.LoadSequentiallyConsistent();
-  if (index != nullptr) {
-    auto it = index->find(descriptor);
-    return (it == index->end()) ? nullptr : it->second;
+const DexFile::ClassDef* DexFile::FindClassDef(const char* descriptor, uint32_t hash) const {
+  DCHECK_EQ(static_cast<uint32_t>(ComputeUtf8Hash(descriptor)), hash);
+  // If we have a lookup table look up the descriptor via that as its constant time to search.
+  TypeLookupTable* lookup_table = lookup_table_.LoadSequentiallyConsistent();
+  if (lookup_table != nullptr) {
+    uint32_t class_def_idx = lookup_table->Lookup(descriptor, hash);
+    return (class_def_idx == kDexNoIndex) ? nullptr : &GetClassDef(class_def_idx);
   }
   // Fast path for rate no class defs case.
   uint32_t num_class_defs = NumClassDefs();
@@ -441,25 +522,21 @@ const DexFile::ClassDef* DexFile::FindClassDef(const char* descriptor) const {
       }
     }
   }
-  // A miss. If we've had kMaxFailedDexClassDefLookups misses then build an index to speed things
-  // up. This isn't done eagerly at construction as construction is not performed in multi-threaded
-  // sections of tools like dex2oat. If we're lazy we hopefully increase the chance of balancing
-  // out which thread builds the index.
+  // A miss. If we've had kMaxFailedDexClassDefLookups misses then build a lookup table to speed
+  // things up. Dex files opened from oat files come with one. This isn't done eagerly at
+  // construction as construction is not performed in multi-threaded sections of tools like
+  // dex2oat. If we're lazy we hopefully increase the chance of balancing out which thread builds
+  // the table.
   const uint32_t kMaxFailedDexClassDefLookups = 100;
   uint32_t old_misses = find_class_def_misses_.FetchAndAddSequentiallyConsistent(1);
-  if (old_misses == kMaxFailedDexClassDefLookups) {
-    // Are we the ones moving the miss count past the max? Sanity check the index doesn't exist.
-    CHECK(class_def_index_.LoadSequentiallyConsistent() == nullptr);
-    // Build the index.
-    index = new Index(num_class_defs);
-    for (uint32_t i = 0; i < num_class_defs;  ++i) {
-      const ClassDef& class_def = GetClassDef(i);
-      const char* descriptor = GetClassDescriptor(class_def);
-      index->insert(std::make_pair(descriptor, &class_def));
-    }
-    // Sanity check the index still doesn't exist, only 1 thread should build it.
-    CHECK(class_def_index_.LoadSequentiallyConsistent() == nullptr);
-    class_def_index_.StoreSequentiallyConsistent(index);
+  if (old_misses == kMaxFailedDexClassDefLookups &&
+      TypeLookupTable::SupportedSize(num_class_defs)) {
+    // Are we the ones moving the miss count past the max? Sanity check the table doesn't exist.
+    CHECK(lookup_table_.LoadSequentiallyConsistent() == nullptr);
+    lookup_table = TypeLookupTable::Create(*this);
+    // Sanity check the table still doesn't exist, only 1 thread should build it.
+    CHECK(lookup_table_.LoadSequentiallyConsistent() == nullptr);
+    lookup_table_.StoreSequentiallyConsistent(lookup_table);
   }
   return nullptr;
 }
@@ -721,6 +798,41 @@ int32_t DexFile::GetLineNumFromPC(mirror::ArtMethod* method, uint32_t rel_pc) co
   return context.line_num_;
 }
 
+bool DexFile::IsMethodAnnotationPresent(const ClassDef& class_def, uint32_t method_idx,
+                                        const char* descriptor) const {
+  if (class_def.annotations_off_ == 0) {
+    return false;
+  }
+  const AnnotationsDirectoryItem* directory =
+      reinterpret_cast<const AnnotationsDirectoryItem*>(begin_ + class_def.annotations_off_);
+  // Method annotations follow the field annotations and are sorted by method index.
+  const FieldAnnotationsItem* fields =
+      reinterpret_cast<const FieldAnnotationsItem*>(directory + 1);
+  const MethodAnnotationsItem* methods =
+      reinterpret_cast<const MethodAnnotationsItem*>(fields + directory->fields_size_);
+  for (uint32_t i = 0; i < directory->methods_size_; ++i) {
+    if (methods[i].method_idx_ < method_idx) {
+      continue;
+    }
+    if (methods[i].method_idx_ > method_idx) {
+      break;
+    }
+    const AnnotationSetItem* set =
+        reinterpret_cast<const AnnotationSetItem*>(begin_ + methods[i].annotations_off_);
+    for (uint32_t j = 0; j < set->size_; ++j) {
+      const AnnotationItem* item =
+          reinterpret_cast<const AnnotationItem*>(begin_ + set->entries_[j]);
+      const uint8_t* annotation = item->annotation_;
+      uint32_t type_idx = DecodeUnsignedLeb128(&annotation);
+      if (strcmp(StringByTypeIdx(type_idx), descriptor) == 0) {
+        return true;
+      }
+    }
+    break;
+  }
+  return false;
+}
+
 int32_t DexFile::FindTryItem(const CodeItem &code_item, uint32_t address) {
   // Note: Signed type is important for max and min.
   int32_t min = 0;
@@ -45,6 +45,7 @@ class MemMap;
 class Signature;
 template<class T> class Handle;
 class StringPiece;
+class TypeLookupTable;
 class ZipArchive;
 
 // TODO: move all of the macro functionality into the DexCache class.
@@ -381,16 +382,25 @@ class DexFile {
   // Return true if the checksum could be found, false otherwise.
   static bool GetChecksum(const char* filename, uint32_t* checksum, std::string* error_msg);
 
+  // Appends the checksums of classes.dex, classes2.dex, ... in filename to checksums, opening the
+  // container only once. A .dex file has a single checksum.
+  // Return true if at least the classes.dex checksum could be found, false otherwise.
+  static bool GetMultiDexChecksums(const char* filename, std::vector<uint32_t>* checksums,
+                                   std::string* error_msg);
+
   // Opens .dex files found in the container, guessing the container format based on file extension.
   static bool Open(const char* filename, const char* location, std::string* error_msg,
                    std::vector<const DexFile*>* dex_files);
 
-  // Opens .dex file, backed by existing memory
+  // Opens .dex file, backed by existing memory. type_lookup_table_data is the TypeLookupTable
+  // written for the dex file along with it, or nullptr if there is none.
   static const DexFile* Open(const uint8_t* base, size_t size,
                              const std::string& location,
                              uint32_t location_checksum,
+                             const uint8_t* type_lookup_table_data,
                              std::string* error_msg) {
-    return OpenMemory(base, size, location, location_checksum, NULL, error_msg);
+    return OpenMemory(base, size, location, location_checksum, NULL, type_lookup_table_data,
+                      error_msg);
   }
 
   // Open all classesXXX.dex files from a zip archive.
@@ -648,8 +658,13 @@ class DexFile {
     return StringByTypeIdx(class_def.class_idx_);
   }
 
-  // Looks up a class definition by its class descriptor.
-  const ClassDef* FindClassDef(const char* descriptor) const;
+  // Looks up a class definition by its class descriptor. Hash must be
+  // ComputeUtf8Hash(descriptor), callers searching several dex files compute it once.
+  const ClassDef* FindClassDef(const char* descriptor, uint32_t hash) const;
+
+  const ClassDef* FindClassDef(const char* descriptor) const {
+    return FindClassDef(descriptor, ComputeUtf8Hash(descriptor));
+  }
 
   // Looks up a class definition by its type index.
   const ClassDef* FindClassDef(uint16_t type_idx) const;
@@ -672,6 +687,11 @@ class DexFile {
     }
   }
 
+  // Returns true if the method method_idx of class_def is annotated with the annotation type
+  // given by descriptor, regardless of the annotation's visibility.
+  bool IsMethodAnnotationPresent(const ClassDef& class_def, uint32_t method_idx,
+                                 const char* descriptor) const;
+
   //
   const CodeItem* GetCodeItem(const uint32_t code_off) const {
     if (code_off == 0) {
@@ -891,6 +911,10 @@ class DexFile {
   // Opens a .dex file
   static const DexFile* OpenFile(int fd, const char* location, bool verify, std::string* error_msg);
 
+  // Reads the header checksum of the .dex file open as fd, without mapping the file.
+  static bool ReadHeaderChecksum(int fd, const char* filename, uint32_t* checksum,
+                                 std::string* error_msg);
+
   // Opens dex files from within a .jar, .zip, or .apk file
   static bool OpenZip(int fd, const std::string& location, std::string* error_msg,
                       std::vector<const DexFile*>* dex_files);
@@ -916,12 +940,14 @@ class DexFile {
                                    MemMap* mem_map,
                                    std::string* error_msg);
 
-  // Opens a .dex file at the given address, optionally backed by a MemMap
+  // Opens a .dex file at the given address, optionally backed by a MemMap and optionally with
+  // the data of its TypeLookupTable
   static const DexFile* OpenMemory(const uint8_t* dex_file,
                                    size_t size,
                                    const std::string& location,
                                    uint32_t location_checksum,
                                    MemMap* mem_map,
+                                   const uint8_t* type_lookup_table_data,
                                    std::string* error_msg);
 
   DexFile(const uint8_t* base, size_t size,
@@ -985,18 +1011,8 @@ class DexFile {
   // Number of misses finding a class def from a descriptor.
   mutable Atomic<uint32_t> find_class_def_misses_;
 
-  struct UTF16HashCmp {
-    // Hash function.
-    size_t operator()(const char* key) const {
-      return ComputeUtf8Hash(key);
-    }
-    // std::equal function.
-    bool operator()(const char* a, const char* b) const {
-      return CompareModifiedUtf8ToModifiedUtf8AsUtf16CodePointValues(a, b) == 0;
-    }
-  };
-  typedef std::unordered_map<const char*, const ClassDef*, UTF16HashCmp, UTF16HashCmp> Index;
-  mutable Atomic<Index*> class_def_index_;
+  // Class def lookup table, mapped from the oat file or built after enough misses.
+  mutable Atomic<TypeLookupTable*> lookup_table_;
 };
 std::ostream& operator<<(std::ostream& os, const DexFile& dex_file);
 
@@ -207,6 +207,21 @@ TEST_F(DexFileTest, GetChecksum) {
   EXPECT_EQ(java_lang_dex_file_->GetLocationChecksum(), checksum);
 }
 
+TEST_F(DexFileTest, GetMultiDexChecksums) {
+  std::vector<uint32_t> checksums;
+  ScopedObjectAccess soa(Thread::Current());
+  std::string error_msg;
+  EXPECT_TRUE(DexFile::GetMultiDexChecksums(GetLibCoreDexFileName().c_str(), &checksums,
+                                            &error_msg))
+      << error_msg;
+  ASSERT_LE(1U, checksums.size());
+  EXPECT_EQ(java_lang_dex_file_->GetLocationChecksum(), checksums[0]);
+
+  checksums.clear();
+  EXPECT_FALSE(DexFile::GetMultiDexChecksums("/does/not/exist.jar", &checksums, &error_msg));
+  EXPECT_TRUE(checksums.empty());
+}
+
 TEST_F(DexFileTest, ClassDefs) {
   ScopedObjectAccess soa(Thread::Current());
   const DexFile* raw(OpenTestDexFile("Nested"));
@@ -440,8 +440,11 @@ static inline mirror::ArtMethod* FindMethodFromCode(uint32_t method_idx,
       if (!imt_method->IsImtConflictMethod()) {
         return imt_method;
       } else {
-        mirror::ArtMethod* interface_method =
-            (*this_object)->GetClass()->FindVirtualMethodForInterface(resolved_method);
+        mirror::ArtMethod* interface_method = imt_method->FindImtConflictTarget(resolved_method);
+        if (interface_method == nullptr) {
+          interface_method =
+              (*this_object)->GetClass()->FindVirtualMethodForInterface(resolved_method);
+        }
         if (UNLIKELY(interface_method == nullptr)) {
           ThrowIncompatibleClassChangeErrorClassForInterfaceDispatch(resolved_method,
                                                                      *this_object, *referrer);
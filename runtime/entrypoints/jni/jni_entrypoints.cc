@@ -31,11 +31,18 @@ extern "C" void* artFindNativeMethod() {
 extern "C" void* artFindNativeMethod(Thread* self) {
   DCHECK_EQ(self, Thread::Current());
 #endif
-  Locks::mutator_lock_->AssertNotHeld(self);  // We come here as Native.
+  // We come here as Native, or still Runnable for fast and critical native methods which
+  // skipped the transition, in which case the scoped access below is a no-op.
+  const bool was_runnable = self->GetState() == kRunnable;
+  if (!was_runnable) {
+    Locks::mutator_lock_->AssertNotHeld(self);
+  }
   ScopedObjectAccess soa(self);
 
   mirror::ArtMethod* method = self->GetCurrentMethod(NULL);
   DCHECK(method != NULL);
+  DCHECK(!was_runnable || method->IsFastNative() || method->IsCriticalNative())
+      << PrettyMethod(method);
 
   // Lookup symbol address for method, on failure we'll return NULL with an exception set,
   // otherwise we return the address of the method we found.
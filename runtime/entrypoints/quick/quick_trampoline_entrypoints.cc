@@ -1300,7 +1300,8 @@ class ComputeNativeCallFrameSize {
 
 class ComputeGenericJniFrameSize FINAL : public ComputeNativeCallFrameSize {
  public:
-  ComputeGenericJniFrameSize() : num_handle_scope_references_(0) {}
+  explicit ComputeGenericJniFrameSize(bool critical_native)
+      : num_handle_scope_references_(0), critical_native_(critical_native) {}
 
   // Lays out the callee-save frame. Assumes that the incorrect frame corresponding to RefsAndArgs
   // is at *m = sp. Will update to point to the bottom of the save frame.
@@ -1389,6 +1390,8 @@ class ComputeGenericJniFrameSize FINAL : public ComputeNativeCallFrameSize {
 
  private:
   uint32_t num_handle_scope_references_;
+  // Critical natives take neither the JNIEnv* nor the jclass.
+  const bool critical_native_;
 };
 
 uintptr_t ComputeGenericJniFrameSize::PushHandle(mirror::Object* /* ptr */) {
@@ -1398,6 +1401,10 @@ uintptr_t ComputeGenericJniFrameSize::PushHandle(mirror::Object* /* ptr */) {
 
 void ComputeGenericJniFrameSize::WalkHeader(
     BuildNativeCallFrameStateMachine<ComputeNativeCallFrameSize>* sm) {
+  if (critical_native_) {
+    return;
+  }
+
   // JNIEnv
   sm->AdvancePointer(nullptr);
 
@@ -1456,11 +1463,12 @@ class FillNativeCall {
 // of transitioning into native code.
 class BuildGenericJniFrameVisitor FINAL : public QuickArgumentVisitor {
  public:
-  BuildGenericJniFrameVisitor(Thread* self, bool is_static, const char* shorty, uint32_t shorty_len,
+  BuildGenericJniFrameVisitor(Thread* self, bool is_static, bool critical_native,
+                              const char* shorty, uint32_t shorty_len,
                               StackReference<mirror::ArtMethod>** sp)
      : QuickArgumentVisitor(*sp, is_static, shorty, shorty_len),
        jni_call_(nullptr, nullptr, nullptr, nullptr), sm_(&jni_call_) {
-    ComputeGenericJniFrameSize fsc;
+    ComputeGenericJniFrameSize fsc(critical_native);
     uintptr_t* start_gpr_reg;
     uint32_t* start_fpr_reg;
     uintptr_t* start_stack_arg;
@@ -1471,6 +1479,10 @@ class BuildGenericJniFrameVisitor FINAL : public QuickArgumentVisitor {
 
     jni_call_.Reset(start_gpr_reg, start_fpr_reg, start_stack_arg, handle_scope_);
 
+    if (critical_native) {
+      return;  // Only the declared arguments are passed.
+    }
+
     // jni environment is always first argument
     sm_.AdvancePointer(self->GetJniEnv());
 
@@ -1640,7 +1652,9 @@ extern "C" TwoWordReturn artQuickGenericJniTrampoline(Thread* self,
   const char* shorty = called->GetShorty(&shorty_len);
 
   // Run the visitor and update sp.
-  BuildGenericJniFrameVisitor visitor(self, called->IsStatic(), shorty, shorty_len, &sp);
+  const bool critical_native = called->IsCriticalNative();
+  BuildGenericJniFrameVisitor visitor(self, called->IsStatic(), critical_native, shorty,
+                                      shorty_len, &sp);
   visitor.VisitArguments();
   visitor.FinalizeHandleScope(self);
 
@@ -1649,9 +1663,11 @@ extern "C" TwoWordReturn artQuickGenericJniTrampoline(Thread* self,
 
   self->VerifyStack();
 
-  // Start JNI, save the cookie.
-  uint32_t cookie;
-  if (called->IsSynchronized()) {
+  // Start JNI, save the cookie. Critical natives stay Runnable and create no local references.
+  uint32_t cookie = 0;
+  if (critical_native) {
+    // Nothing to do.
+  } else if (called->IsSynchronized()) {
     cookie = JniMethodStartSynchronized(visitor.GetFirstHandleScopeJObject(), self);
     if (self->IsExceptionPending()) {
       self->PopHandleScope();
@@ -1683,6 +1699,11 @@ extern "C" TwoWordReturn artQuickGenericJniTrampoline(Thread* self,
     if (nativeCode == nullptr) {
       DCHECK(self->IsExceptionPending());    // There should be an exception pending now.
 
+      if (critical_native) {
+        self->PopHandleScope();
+        return GetTwoWordFailureValue();
+      }
+
       // End JNI, as the assembly will move to deliver the exception.
       jobject lock = called->IsSynchronized() ? visitor.GetFirstHandleScopeJObject() : nullptr;
       if (shorty[0] == 'L') {
@@ -1724,7 +1745,12 @@ extern "C" uint64_t artQuickGenericJniEndTrampoline(Thread* self, jvalue result,
   if (return_shorty_char == 'L') {
     return artQuickGenericJniEndJNIRef(self, cookie, result.l, lock);
   } else {
-    artQuickGenericJniEndJNINonRef(self, cookie, lock);
+    if (called->IsCriticalNative()) {
+      // No thread state transition and no local references to pop, only the handle scope.
+      self->PopHandleScope();
+    } else {
+      artQuickGenericJniEndJNINonRef(self, cookie, lock);
+    }
 
     switch (return_shorty_char) {
       case 'F': {
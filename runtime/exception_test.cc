@@ -55,9 +55,9 @@ class ExceptionTest : public CommonRuntimeTest {
       fake_code_.push_back(0x70 | i);
     }
 
-    fake_mapping_data_.PushBackUnsigned(4);  // first element is count
-    fake_mapping_data_.PushBackUnsigned(4);  // total (non-length) elements
-    fake_mapping_data_.PushBackUnsigned(2);  // count of pc to dex elements
+    fake_mapping_data_.PushBackUnsigned(2);  // total elements
+    fake_mapping_data_.PushBackUnsigned(1);  // count of pc to dex elements
+    fake_mapping_data_.PushBackUnsigned(0);  // count of pc to dex index elements
                                       // ---  pc to dex table
     fake_mapping_data_.PushBackUnsigned(3 - 0);  // offset 3
     fake_mapping_data_.PushBackSigned(3 - 0);    // maps to dex offset 3
@@ -17,7 +17,9 @@
 #include "image_space.h"
 
 #include <dirent.h>
+#include <sys/syscall.h>
 #include <sys/types.h>
+#include <unistd.h>
 
 #include <random>
 
@@ -225,29 +227,19 @@ static bool ReadSpecificImageHeader(const char* filename, ImageHeader* image_hea
     return true;
 }
 
-// Relocate the image at image_location to dest_filename and relocate it by a random amount.
-static bool RelocateImage(const char* image_location, const char* dest_filename,
-                               InstructionSet isa, std::string* error_msg) {
-  // We should clean up so we are more likely to have room for the image.
-  if (Runtime::Current()->IsZygote()) {
-    LOG(INFO) << "Pruning dalvik-cache since we are relocating an image and will need to recompile";
-    PruneDexCache(isa);
-  }
-
+// Run patchoat to relocate the image at image_location and its oat file by a random amount,
+// writing them out as the output arguments say.
+static bool ExecPatchoat(const char* image_location, const std::string& output_image_arg,
+                         const std::string& output_oat_arg, InstructionSet isa,
+                         std::string* error_msg) {
   std::string patchoat(Runtime::Current()->GetPatchoatExecutable());
 
   std::string input_image_location_arg("--input-image-location=");
   input_image_location_arg += image_location;
 
-  std::string output_image_filename_arg("--output-image-file=");
-  output_image_filename_arg += dest_filename;
-
   std::string input_oat_location_arg("--input-oat-location=");
   input_oat_location_arg += ImageHeader::GetOatLocationFromImageLocation(image_location);
 
-  std::string output_oat_filename_arg("--output-oat-file=");
-  output_oat_filename_arg += ImageHeader::GetOatLocationFromImageLocation(dest_filename);
-
   std::string instruction_set_arg("--instruction-set=");
   instruction_set_arg += GetInstructionSetString(isa);
 
@@ -259,10 +251,10 @@ static bool RelocateImage(const char* image_location, const char* dest_filename,
   argv.push_back(patchoat);
 
   argv.push_back(input_image_location_arg);
-  argv.push_back(output_image_filename_arg);
+  argv.push_back(output_image_arg);
 
   argv.push_back(input_oat_location_arg);
-  argv.push_back(output_oat_filename_arg);
+  argv.push_back(output_oat_arg);
 
   argv.push_back(instruction_set_arg);
   argv.push_back(base_offset_arg);
@@ -272,6 +264,58 @@ static bool RelocateImage(const char* image_location, const char* dest_filename,
   return Exec(argv, error_msg);
 }
 
+// Relocate the image at image_location to dest_filename and relocate it by a random amount.
+static bool RelocateImage(const char* image_location, const char* dest_filename,
+                               InstructionSet isa, std::string* error_msg) {
+  // We should clean up so we are more likely to have room for the image.
+  if (Runtime::Current()->IsZygote()) {
+    LOG(INFO) << "Pruning dalvik-cache since we are relocating an image and will need to recompile";
+    PruneDexCache(isa);
+  }
+
+  std::string output_image_filename_arg("--output-image-file=");
+  output_image_filename_arg += dest_filename;
+
+  std::string output_oat_filename_arg("--output-oat-file=");
+  output_oat_filename_arg += ImageHeader::GetOatLocationFromImageLocation(dest_filename);
+
+  return ExecPatchoat(image_location, output_image_filename_arg, output_oat_filename_arg, isa,
+                      error_msg);
+}
+
+// Returns an anonymous file living in memory, or nullptr with errno set.
+static File* CreateMemoryFile(const char* name) {
+#if defined(__NR_memfd_create)
+  // Not close-on-exec, patchoat writes to it.
+  int fd = syscall(__NR_memfd_create, name, 0);
+  if (fd == -1) {
+    return nullptr;
+  }
+  return new File(fd, StringPrintf("/proc/self/fd/%d", fd));
+#else
+  errno = ENOSYS;
+  return nullptr;
+#endif
+}
+
+// Relocate the image at image_location by a random amount into files in memory instead of the
+// dalvik-cache. Their pages are shared by all the processes mapping them, in particular the ones
+// forked from the zygote, and nothing is written to storage.
+static bool RelocateImageInMemory(const char* image_location, InstructionSet isa,
+                                  std::unique_ptr<File>* image_file,
+                                  std::unique_ptr<File>* oat_file, std::string* error_msg) {
+  image_file->reset(CreateMemoryFile("relocated boot image"));
+  oat_file->reset(CreateMemoryFile("relocated boot oat"));
+  if (image_file->get() == nullptr || oat_file->get() == nullptr) {
+    *error_msg = StringPrintf("Failed to create memory files for relocation: %s",
+                              strerror(errno));
+    return false;
+  }
+  std::string output_image_fd_arg(StringPrintf("--output-image-fd=%d", (*image_file)->Fd()));
+  std::string output_oat_fd_arg(StringPrintf("--output-oat-fd=%d", (*oat_file)->Fd()));
+  return ExecPatchoat(image_location, output_image_fd_arg, output_oat_fd_arg, isa, error_msg);
+}
+
 static ImageHeader* ReadSpecificImageHeader(const char* filename, std::string* error_msg) {
   std::unique_ptr<ImageHeader> hdr(new ImageHeader);
   if (!ReadSpecificImageHeader(filename, hdr.get())) {
@@ -393,13 +437,18 @@ ImageSpace* ImageSpace::Create(const char* image_location,
 
   ImageSpace* space;
   bool relocate = Runtime::Current()->ShouldRelocate();
+  bool relocate_in_memory = relocate && Runtime::Current()->ShouldRelocateInMemory();
   bool can_compile = Runtime::Current()->IsImageDex2OatEnabled();
   if (found_image) {
     const std::string* image_filename;
+    std::string oat_filename;
     bool is_system = false;
     bool relocated_version_used = false;
+    // Images relocated in memory, open until they are mapped.
+    std::unique_ptr<File> memory_image_file;
+    std::unique_ptr<File> memory_oat_file;
     if (relocate) {
-      if (!dalvik_cache_exists) {
+      if (!dalvik_cache_exists && !relocate_in_memory) {
         *error_msg = StringPrintf("Requiring relocation for image '%s' at '%s' but we do not have "
                                   "any dalvik_cache to find/place it in.",
                                   image_location, system_filename.c_str());
@@ -420,6 +469,9 @@ ImageSpace* ImageSpace::Create(const char* image_location,
           if (!can_compile) {
             reason = "Image dex2oat disabled by -Xnoimage-dex2oat.";
             success = false;
+          } else if (relocate_in_memory) {
+            success = RelocateImageInMemory(image_location, image_isa, &memory_image_file,
+                                            &memory_oat_file, &reason);
           } else if (!ImageCreationAllowed(is_global_cache, &reason)) {
             // Whether we can write to the cache.
             success = false;
@@ -428,7 +480,11 @@ ImageSpace* ImageSpace::Create(const char* image_location,
             success = RelocateImage(image_location, cache_filename.c_str(), image_isa, &reason);
           }
 
-          if (success) {
+          if (success && relocate_in_memory) {
+            relocated_version_used = true;
+            image_filename = &memory_image_file->GetPath();
+            oat_filename = memory_oat_file->GetPath();
+          } else if (success) {
             relocated_version_used = true;
             image_filename = &cache_filename;
           } else {
@@ -474,7 +530,10 @@ ImageSpace* ImageSpace::Create(const char* image_location,
       // assume this if we are using a relocated image (i.e. image checksum
       // matches) since this is only different by the offset. We need this to
       // make sure that host tests continue to work.
-      space = ImageSpace::Init(image_filename->c_str(), image_location,
+      if (oat_filename.empty()) {
+        oat_filename = ImageHeader::GetOatLocationFromImageLocation(*image_filename);
+      }
+      space = ImageSpace::Init(image_filename->c_str(), oat_filename, image_location,
                                !(is_system || relocated_version_used), error_msg);
     }
     if (space != nullptr) {
@@ -486,7 +545,7 @@ ImageSpace* ImageSpace::Create(const char* image_location,
     // Otherwise, log a warning and fall through to GenerateImage.
     if (relocated_version_used) {
       LOG(FATAL) << "Attempted to use relocated version of " << image_location << " "
-                 << "at " << cache_filename << " generated from " << system_filename << " "
+                 << "at " << *image_filename << " generated from " << system_filename << " "
                  << "but image failed to load: " << error_msg;
       return nullptr;
     } else if (is_system) {
@@ -517,7 +576,9 @@ ImageSpace* ImageSpace::Create(const char* image_location,
     // we leave Create.
     ScopedFlock image_lock;
     image_lock.Init(cache_filename.c_str(), error_msg);
-    space = ImageSpace::Init(cache_filename.c_str(), image_location, true, error_msg);
+    space = ImageSpace::Init(cache_filename.c_str(),
+                             ImageHeader::GetOatLocationFromImageLocation(cache_filename),
+                             image_location, true, error_msg);
     if (space == nullptr) {
       *error_msg = StringPrintf("Failed to load generated image '%s': %s",
                                 cache_filename.c_str(), error_msg->c_str());
@@ -540,8 +601,9 @@ void ImageSpace::VerifyImageAllocations() {
   }
 }
 
-ImageSpace* ImageSpace::Init(const char* image_filename, const char* image_location,
-                             bool validate_oat_file, std::string* error_msg) {
+ImageSpace* ImageSpace::Init(const char* image_filename, const std::string& oat_filename,
+                             const char* image_location, bool validate_oat_file,
+                             std::string* error_msg) {
   CHECK(image_filename != nullptr);
   CHECK(image_location != nullptr);
 
@@ -612,7 +674,7 @@ ImageSpace* ImageSpace::Init(const char* image_filename, const char* image_locat
   // Object::SizeOf() which VerifyImageAllocations() calls, are not
   // set yet at this point.
 
-  space->oat_file_.reset(space->OpenOatFile(image_filename, error_msg));
+  space->oat_file_.reset(space->OpenOatFile(oat_filename, error_msg));
   if (space->oat_file_.get() == nullptr) {
     DCHECK(!error_msg->empty());
     return nullptr;
@@ -650,9 +712,8 @@ ImageSpace* ImageSpace::Init(const char* image_filename, const char* image_locat
   return space.release();
 }
 
-OatFile* ImageSpace::OpenOatFile(const char* image_path, std::string* error_msg) const {
+OatFile* ImageSpace::OpenOatFile(const std::string& oat_filename, std::string* error_msg) const {
   const ImageHeader& image_header = GetImageHeader();
-  std::string oat_filename = ImageHeader::GetOatLocationFromImageLocation(image_path);
 
   OatFile* oat_file = OatFile::Open(oat_filename, oat_filename, image_header.GetOatDataBegin(),
                                     !Runtime::Current()->IsCompiler(), error_msg);
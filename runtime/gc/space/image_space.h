@@ -121,18 +121,19 @@ class ImageSpace : public MemMapSpace {
                                 bool *is_global_cache);
 
  private:
-  // Tries to initialize an ImageSpace from the given image path,
-  // returning NULL on error.
+  // Tries to initialize an ImageSpace from the given image path and the
+  // oat file next to it, returning NULL on error.
   //
   // If validate_oat_file is false (for /system), do not verify that
   // image's OatFile is up-to-date relative to its DexFile
   // inputs. Otherwise (for /data), validate the inputs and generate
   // the OatFile in /data/dalvik-cache if necessary.
-  static ImageSpace* Init(const char* image_filename, const char* image_location,
-                          bool validate_oat_file, std::string* error_msg)
+  static ImageSpace* Init(const char* image_filename, const std::string& oat_filename,
+                          const char* image_location, bool validate_oat_file,
+                          std::string* error_msg)
       SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
 
-  OatFile* OpenOatFile(const char* image, std::string* error_msg) const
+  OatFile* OpenOatFile(const std::string& oat_filename, std::string* error_msg) const
       SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
 
   bool ValidateOatFile(std::string* error_msg) const
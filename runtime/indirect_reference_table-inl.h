@@ -71,15 +71,56 @@ inline bool IndirectReferenceTable::CheckEntry(const char* what, IndirectRef ire
   return true;
 }
 
+inline IndirectRef IndirectReferenceTable::Add(uint32_t cookie, mirror::Object* obj) {
+  IRTSegmentState prevState;
+  prevState.all = cookie;
+  size_t topIndex = segment_state_.parts.topIndex;
+  // No holes in the current segment and room at the top: append.
+  if (LIKELY(segment_state_.parts.numHoles == prevState.parts.numHoles &&
+             topIndex < max_entries_)) {
+    DCHECK(obj != nullptr);
+    VerifyObject(obj);
+    table_[topIndex].Add(obj);
+    segment_state_.parts.topIndex = topIndex + 1;
+    return ToIndirectRef(topIndex);
+  }
+  return AddSlowPath(cookie, obj);
+}
+
+inline bool IndirectReferenceTable::Remove(uint32_t cookie, IndirectRef iref) {
+  IRTSegmentState prevState;
+  prevState.all = cookie;
+  uint32_t topIndex = segment_state_.parts.topIndex;
+  // Deleting the newest reference of a segment without holes, as local references are deleted in
+  // loops: just drop the top entry. The compare against the reference the entry hands out checks
+  // the kind and the serial number as CheckEntry does.
+  if (LIKELY(segment_state_.parts.numHoles == prevState.parts.numHoles &&
+             topIndex > prevState.parts.topIndex &&
+             ExtractIndex(iref) == topIndex - 1 &&
+             ToIndirectRef(topIndex - 1) == iref)) {
+    *table_[topIndex - 1].GetReference() = GcRoot<mirror::Object>(nullptr);
+    segment_state_.parts.topIndex = topIndex - 1;
+    return true;
+  }
+  return RemoveSlowPath(cookie, iref);
+}
+
 template<ReadBarrierOption kReadBarrierOption>
 inline mirror::Object* IndirectReferenceTable::Get(IndirectRef iref) const {
-  if (!GetChecked(iref)) {
-    return nullptr;
-  }
   uint32_t idx = ExtractIndex(iref);
-  mirror::Object* obj = table_[idx].GetReference()->Read<kReadBarrierOption>();
-  VerifyObject(obj);
-  return obj;
+  // A reference is valid if it is the one its entry would hand out now, which checks the kind and
+  // serial number at once, and the entry hasn't been deleted.
+  if (LIKELY(idx < segment_state_.parts.topIndex && ToIndirectRef(idx) == iref)) {
+    mirror::Object* obj = table_[idx].GetReference()->Read<kReadBarrierOption>();
+    if (LIKELY(obj != nullptr)) {
+      VerifyObject(obj);
+      return obj;
+    }
+  }
+  // Report why the reference is invalid.
+  bool valid = GetChecked(iref);
+  DCHECK(!valid);
+  return nullptr;
 }
 
 }  // namespace art
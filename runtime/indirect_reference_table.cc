@@ -85,7 +85,7 @@ IndirectReferenceTable::IndirectReferenceTable(size_t initialCount,
 IndirectReferenceTable::~IndirectReferenceTable() {
 }
 
-IndirectRef IndirectReferenceTable::Add(uint32_t cookie, mirror::Object* obj) {
+IndirectRef IndirectReferenceTable::AddSlowPath(uint32_t cookie, mirror::Object* obj) {
   IRTSegmentState prevState;
   prevState.all = cookie;
   size_t topIndex = segment_state_.parts.topIndex;
@@ -153,7 +153,7 @@ void IndirectReferenceTable::AssertEmpty() {
 // This method is not called when a local frame is popped; this is only used
 // for explicit single removals.
 // Returns "false" if nothing was removed.
-bool IndirectReferenceTable::Remove(uint32_t cookie, IndirectRef iref) {
+bool IndirectReferenceTable::RemoveSlowPath(uint32_t cookie, IndirectRef iref) {
   IRTSegmentState prevState;
   prevState.all = cookie;
   int topIndex = segment_state_.parts.topIndex;
@@ -198,10 +198,9 @@ static const size_t kIRTPrevCount = kIsDebugBuild ? 7 : 3;
 class PACKED(4) IrtEntry {
  public:
   void Add(mirror::Object* obj) SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
-    ++serial_;
-    if (serial_ == kIRTPrevCount) {
-      serial_ = 0;
-    }
+    // Written as a select so that the wrap around doesn't need a branch.
+    uint32_t serial = serial_ + 1;
+    serial_ = (serial == kIRTPrevCount) ? 0 : serial;
     references_[serial_] = GcRoot<mirror::Object>(obj);
   }
   GcRoot<mirror::Object>* GetReference() {
@@ -263,9 +262,12 @@ class IndirectReferenceTable {
    *
    * Returns NULL if the table is full (max entries reached, or alloc
    * failed during expansion).
+   *
+   * Appending to a segment without holes, the common case for local references which are
+   * released by popping their segment, is inlined. Filling holes and overflow are out of line.
    */
   IndirectRef Add(uint32_t cookie, mirror::Object* obj)
-      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
+      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) ALWAYS_INLINE;
 
   /*
    * Given an IndirectRef in the table, return the Object it refers to.
@@ -292,8 +294,11 @@ class IndirectReferenceTable {
    * required by JNI's DeleteLocalRef function.
    *
    * Returns "false" if nothing was removed.
+   *
+   * Removing the top entry of a segment without holes is inlined, the other cases, which create
+   * or consume holes or report bad references, are out of line.
    */
-  bool Remove(uint32_t cookie, IndirectRef iref);
+  bool Remove(uint32_t cookie, IndirectRef iref) ALWAYS_INLINE;
 
   void AssertEmpty();
 
@@ -349,6 +354,11 @@ class IndirectReferenceTable {
     return reinterpret_cast<IndirectRef>(uref);
   }
 
+  IndirectRef AddSlowPath(uint32_t cookie, mirror::Object* obj)
+      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
+
+  bool RemoveSlowPath(uint32_t cookie, IndirectRef iref);
+
   // Abort if check_jni is not enabled.
   static void AbortIfNoCheckJNI();
 
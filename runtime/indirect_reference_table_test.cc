@@ -250,4 +250,67 @@ TEST_F(IndirectReferenceTableTest, BasicTest) {
   CheckDump(&irt, 0, 0);
 }
 
+// Local references are appended to and removed from the top of their segment, which is then
+// popped as a whole.
+TEST_F(IndirectReferenceTableTest, LocalSegments) {
+  ScopedObjectAccess soa(Thread::Current());
+  static const size_t kTableInitial = 10;
+  static const size_t kTableMax = 20;
+  IndirectReferenceTable irt(kTableInitial, kTableMax, kLocal);
+
+  mirror::Class* c = class_linker_->FindSystemClass(soa.Self(), "Ljava/lang/Object;");
+  ASSERT_TRUE(c != nullptr);
+  mirror::Object* obj0 = c->AllocObject(soa.Self());
+  ASSERT_TRUE(obj0 != nullptr);
+  mirror::Object* obj1 = c->AllocObject(soa.Self());
+  ASSERT_TRUE(obj1 != nullptr);
+
+  const uint32_t cookie0 = IRT_FIRST_SEGMENT;
+  IndirectRef iref0 = irt.Add(cookie0, obj0);
+  IndirectRef iref1 = irt.Add(cookie0, obj1);
+  ASSERT_TRUE(iref0 != nullptr);
+  ASSERT_TRUE(iref1 != nullptr);
+
+  // Push a segment.
+  const uint32_t cookie1 = irt.GetSegmentState();
+  IndirectRef iref2 = irt.Add(cookie1, obj0);
+  ASSERT_TRUE(iref2 != nullptr);
+  EXPECT_EQ(3U, irt.Capacity());
+
+  // References of the previous segment can't be removed from this one.
+  EXPECT_FALSE(irt.Remove(cookie1, iref1));
+  EXPECT_EQ(obj1, irt.Get(iref1));
+
+  // Removing the top entry, twice.
+  EXPECT_TRUE(irt.Remove(cookie1, iref2));
+  EXPECT_EQ(2U, irt.Capacity());
+  EXPECT_FALSE(irt.Remove(cookie1, iref2));
+
+  // The entry is reused with a new serial number, so the removed reference stays stale.
+  IndirectRef iref3 = irt.Add(cookie1, obj1);
+  ASSERT_TRUE(iref3 != nullptr);
+  EXPECT_NE(iref2, iref3);
+  EXPECT_TRUE(irt.Get(iref2) == nullptr) << "stale lookup succeeded";
+  EXPECT_FALSE(irt.Remove(cookie1, iref2));
+  EXPECT_EQ(obj1, irt.Get(iref3));
+
+  // Pop the segment.
+  irt.SetSegmentState(cookie1);
+  EXPECT_EQ(2U, irt.Capacity());
+  EXPECT_TRUE(irt.Get(iref3) == nullptr) << "lookup of popped reference succeeded";
+
+  // Removing below the top leaves a hole, which the next add fills.
+  EXPECT_TRUE(irt.Remove(cookie0, iref0));
+  EXPECT_EQ(2U, irt.Capacity());
+  iref0 = irt.Add(cookie0, obj0);
+  ASSERT_TRUE(iref0 != nullptr);
+  EXPECT_EQ(2U, irt.Capacity());
+  EXPECT_EQ(obj0, irt.Get(iref0));
+
+  // Removing the top entry with a hole below it consumes the hole.
+  EXPECT_TRUE(irt.Remove(cookie0, iref0));
+  EXPECT_TRUE(irt.Remove(cookie0, iref1));
+  EXPECT_EQ(0U, irt.Capacity());
+}
+
 }  // namespace art
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "inline_cache.h"
+
+#include <new>
+#include <utility>
+
+#include "base/stringprintf.h"
+#include "dex_instruction-inl.h"
+#include "gc_root-inl.h"
+#include "mirror/art_method-inl.h"
+#include "mirror/class-inl.h"
+#include "scoped_thread_state_change.h"
+#include "thread.h"
+#include "utils.h"
+
+namespace art {
+
+constexpr size_t InlineCache::kIndividualCacheSize;
+
+MethodInlineCaches::MethodInlineCaches(mirror::ArtMethod* method,
+                                       const std::vector<uint32_t>& dex_pcs)
+    : method_(method), num_caches_(dex_pcs.size()) {
+  for (size_t i = 0; i < num_caches_; ++i) {
+    InlineCache* cache = new (&caches_[i]) InlineCache();
+    cache->dex_pc_ = dex_pcs[i];
+  }
+}
+
+InlineCacheTable::InlineCacheTable() : lock_("inline cache table lock", kDefaultMutexLevel) {
+}
+
+InlineCacheTable::~InlineCacheTable() {
+  for (MethodInlineCaches* caches : method_caches_) {
+    caches->~MethodInlineCaches();
+    delete[] reinterpret_cast<uint8_t*>(caches);
+  }
+}
+
+MethodInlineCaches* InlineCacheTable::CreateMethodInlineCaches(Thread* self,
+                                                               mirror::ArtMethod* method) {
+  const DexFile::CodeItem* code_item = method->GetCodeItem();
+  DCHECK(code_item != nullptr) << PrettyMethod(method);
+  std::vector<uint32_t> dex_pcs;
+  for (uint32_t dex_pc = 0; dex_pc < code_item->insns_size_in_code_units_;) {
+    const Instruction* inst = Instruction::At(&code_item->insns_[dex_pc]);
+    switch (inst->Opcode()) {
+      case Instruction::INVOKE_VIRTUAL:
+      case Instruction::INVOKE_VIRTUAL_RANGE:
+      case Instruction::INVOKE_INTERFACE:
+      case Instruction::INVOKE_INTERFACE_RANGE:
+      case Instruction::INVOKE_VIRTUAL_QUICK:
+      case Instruction::INVOKE_VIRTUAL_RANGE_QUICK:
+        dex_pcs.push_back(dex_pc);
+        break;
+      default:
+        break;
+    }
+    dex_pc += inst->SizeInCodeUnits();
+  }
+
+  MutexLock mu(self, lock_);
+  MethodInlineCaches* caches = method->GetInlineCaches();
+  if (caches != nullptr) {
+    return caches;  // Lost the race with another thread.
+  }
+  uint8_t* memory = new uint8_t[sizeof(MethodInlineCaches) + dex_pcs.size() * sizeof(InlineCache)];
+  caches = new (memory) MethodInlineCaches(method, dex_pcs);
+  method_caches_.push_back(caches);
+  // Publish the caches fully initialized.
+  QuasiAtomic::ThreadFenceForConstructor();
+  method->SetInlineCaches(caches);
+  return caches;
+}
+
+void InlineCacheTable::Update(Thread* self, InlineCache* cache, mirror::Class* klass,
+                              mirror::ArtMethod* target) {
+  MutexLock mu(self, lock_);
+  for (size_t i = 0; i < InlineCache::kIndividualCacheSize; ++i) {
+    mirror::Class* cached = cache->classes_[i].Read();
+    if (cached == klass) {
+      return;  // Another thread added the class first.
+    } else if (cached == nullptr) {
+      cache->targets_[i] = target;
+      // Lookups don't take the lock, make sure they see the target once they see the class.
+      QuasiAtomic::ThreadFenceRelease();
+      cache->classes_[i] = GcRoot<mirror::Class>(klass);
+      return;
+    }
+  }
+  cache->is_megamorphic_ = true;
+}
+
+void InlineCacheTable::VisitRoots(RootCallback* callback, void* arg) {
+  MutexLock mu(Thread::Current(), lock_);
+  for (MethodInlineCaches* caches : method_caches_) {
+    for (size_t i = 0; i < caches->NumCaches(); ++i) {
+      InlineCache* cache = caches->GetCache(i);
+      for (size_t j = 0; j < InlineCache::kIndividualCacheSize; ++j) {
+        if (cache->classes_[j].IsNull()) {
+          break;
+        }
+        cache->classes_[j].VisitRoot(callback, arg, 0, kRootVMInternal);
+      }
+    }
+  }
+}
+
+void InlineCacheTable::DumpCallSite(std::ostream& os, InlineCache* cache) {
+  os << StringPrintf("  0x%04x%s:", cache->GetDexPc(),
+                     cache->IsMegamorphic() ? " megamorphic" : "");
+  for (size_t j = 0; j < InlineCache::kIndividualCacheSize; ++j) {
+    mirror::Class* klass = cache->classes_[j].Read();
+    if (klass == nullptr) {
+      break;
+    }
+    os << " " << PrettyClass(klass);
+  }
+  os << "\n";
+}
+
+void InlineCacheTable::Dump(std::ostream& os) {
+  MutexLock mu(Thread::Current(), lock_);
+  for (MethodInlineCaches* caches : method_caches_) {
+    os << PrettyMethod(caches->GetMethod()) << "\n";
+    for (size_t i = 0; i < caches->NumCaches(); ++i) {
+      InlineCache* cache = caches->GetCache(i);
+      if (!cache->IsUninitialized()) {
+        DumpCallSite(os, cache);
+      }
+    }
+  }
+}
+
+void InlineCacheTable::DumpForSigQuit(std::ostream& os) {
+  static constexpr size_t kMaxDumpedCallSites = 10;
+  Thread* self = Thread::Current();
+  ScopedObjectAccess soa(self);
+  MutexLock mu(self, lock_);
+  size_t num_call_sites = 0;
+  size_t num_monomorphic = 0;
+  std::vector<std::pair<MethodInlineCaches*, InlineCache*>> megamorphic;
+  std::vector<std::pair<MethodInlineCaches*, InlineCache*>> polymorphic;
+  for (MethodInlineCaches* caches : method_caches_) {
+    num_call_sites += caches->NumCaches();
+    for (size_t i = 0; i < caches->NumCaches(); ++i) {
+      InlineCache* cache = caches->GetCache(i);
+      if (cache->IsMegamorphic()) {
+        megamorphic.push_back(std::make_pair(caches, cache));
+      } else if (cache->IsPolymorphic()) {
+        polymorphic.push_back(std::make_pair(caches, cache));
+      } else if (cache->IsMonomorphic()) {
+        ++num_monomorphic;
+      }
+    }
+  }
+  os << "Interpreter inline caches: " << method_caches_.size() << " methods, "
+     << num_call_sites << " call sites, " << num_monomorphic << " monomorphic, "
+     << polymorphic.size() << " polymorphic, " << megamorphic.size() << " megamorphic\n";
+  // Then the call sites that saw the most receiver classes, megamorphic ones first.
+  megamorphic.insert(megamorphic.end(), polymorphic.begin(), polymorphic.end());
+  for (size_t i = 0; i < megamorphic.size() && i < kMaxDumpedCallSites; ++i) {
+    os << PrettyMethod(megamorphic[i].first->GetMethod()) << "\n";
+    DumpCallSite(os, megamorphic[i].second);
+  }
+}
+
+}  // namespace art
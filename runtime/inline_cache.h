@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_INLINE_CACHE_H_
+#define ART_RUNTIME_INLINE_CACHE_H_
+
+#include <iosfwd>
+#include <vector>
+
+#include "atomic.h"
+#include "base/macros.h"
+#include "base/mutex.h"
+#include "gc_root.h"
+#include "object_callbacks.h"
+
+namespace art {
+
+namespace mirror {
+  class ArtMethod;
+  class Class;
+}  // namespace mirror
+
+// The receiver classes seen by one invoke-virtual, quickened or not, or invoke-interface and the
+// methods they dispatched to. Entries are only ever added, until the cache is full and a new class
+// makes it megamorphic, so lookups can race with updates without locking.
+class InlineCache {
+ public:
+  // The number of receiver classes recorded before the call site is megamorphic.
+  static constexpr size_t kIndividualCacheSize = 4;
+
+  uint32_t GetDexPc() const {
+    return dex_pc_;
+  }
+
+  // Returns the method klass dispatched to, or null if klass is not in the cache.
+  mirror::ArtMethod* Lookup(mirror::Class* klass) SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
+    for (size_t i = 0; i < kIndividualCacheSize; ++i) {
+      mirror::Class* cached = classes_[i].Read();
+      if (cached == klass) {
+        // Pairs with the release in InlineCacheTable::Update, which stores the target first.
+        QuasiAtomic::ThreadFenceAcquire();
+        return targets_[i];
+      } else if (cached == nullptr) {
+        break;
+      }
+    }
+    return nullptr;
+  }
+
+  bool IsUninitialized() const {
+    return classes_[0].IsNull();
+  }
+
+  bool IsMonomorphic() const {
+    return !classes_[0].IsNull() && classes_[1].IsNull();
+  }
+
+  bool IsPolymorphic() const {
+    return !classes_[1].IsNull() && !is_megamorphic_;
+  }
+
+  bool IsMegamorphic() const {
+    return is_megamorphic_;
+  }
+
+ private:
+  InlineCache() : dex_pc_(0), is_megamorphic_(false) {}
+
+  uint32_t dex_pc_;
+  bool is_megamorphic_;
+  GcRoot<mirror::Class> classes_[kIndividualCacheSize];
+  mirror::ArtMethod* targets_[kIndividualCacheSize];
+
+  friend class MethodInlineCaches;
+  friend class InlineCacheTable;
+  DISALLOW_COPY_AND_ASSIGN(InlineCache);
+};
+
+// The inline caches of the invoke-virtual and invoke-interface instructions of one method, sorted
+// by dex pc. Attached to the method while it is interpreted.
+class MethodInlineCaches {
+ public:
+  mirror::ArtMethod* GetMethod() const {
+    return method_;
+  }
+
+  size_t NumCaches() const {
+    return num_caches_;
+  }
+
+  InlineCache* GetCache(size_t i) {
+    DCHECK_LT(i, num_caches_);
+    return &caches_[i];
+  }
+
+  // Returns the inline cache of the invoke at dex_pc, or null if there is none.
+  InlineCache* GetCacheForDexPc(uint32_t dex_pc) {
+    size_t lo = 0;
+    size_t hi = num_caches_;
+    while (lo < hi) {
+      size_t mid = (lo + hi) / 2;
+      uint32_t mid_dex_pc = caches_[mid].dex_pc_;
+      if (mid_dex_pc == dex_pc) {
+        return &caches_[mid];
+      } else if (mid_dex_pc < dex_pc) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return nullptr;
+  }
+
+ private:
+  MethodInlineCaches(mirror::ArtMethod* method, const std::vector<uint32_t>& dex_pcs);
+
+  mirror::ArtMethod* const method_;
+  const size_t num_caches_;
+  // Variable length, allocated along with the object.
+  InlineCache caches_[0];
+
+  friend class InlineCacheTable;
+  DISALLOW_COPY_AND_ASSIGN(MethodInlineCaches);
+};
+
+// Owns the inline caches of all interpreted methods, and the receiver classes they hold as roots.
+// The caches only speed up dispatch in the interpreter, they live and die with the runtime.
+class InlineCacheTable {
+ public:
+  InlineCacheTable();
+  ~InlineCacheTable();
+
+  // Create the inline caches of the invoke-virtual and invoke-interface instructions of method
+  // and attach them to it, or return the ones another thread attached first.
+  MethodInlineCaches* CreateMethodInlineCaches(Thread* self, mirror::ArtMethod* method)
+      LOCKS_EXCLUDED(lock_)
+      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
+
+  // Record that an instance of klass dispatched to target at the call site of cache.
+  void Update(Thread* self, InlineCache* cache, mirror::Class* klass, mirror::ArtMethod* target)
+      LOCKS_EXCLUDED(lock_)
+      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
+
+  void VisitRoots(RootCallback* callback, void* arg) LOCKS_EXCLUDED(lock_)
+      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
+
+  // Dump the receiver classes seen by every call site, one line per call site. This is a
+  // diagnostic only: nothing records the classes to the profile file, and the compiler never sees
+  // them, so compiled code does not devirtualize or inline based on them.
+  void Dump(std::ostream& os) LOCKS_EXCLUDED(lock_)
+      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
+
+  // Dump the number of call sites in each state, and the receiver classes of the first
+  // megamorphic and polymorphic call sites in the same format as Dump.
+  void DumpForSigQuit(std::ostream& os) LOCKS_EXCLUDED(lock_);
+
+ private:
+  static void DumpCallSite(std::ostream& os, InlineCache* cache)
+      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
+
+  Mutex lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
+  std::vector<MethodInlineCaches*> method_caches_ GUARDED_BY(lock_);
+
+  DISALLOW_COPY_AND_ASSIGN(InlineCacheTable);
+};
+
+}  // namespace art
+
+#endif  // ART_RUNTIME_INLINE_CACHE_H_
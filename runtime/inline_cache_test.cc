@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "inline_cache.h"
+
+#include <sstream>
+
+#include "common_runtime_test.h"
+#include "dex_instruction-inl.h"
+#include "mirror/art_method-inl.h"
+#include "mirror/class-inl.h"
+#include "scoped_thread_state_change.h"
+
+namespace art {
+
+class InlineCacheTest : public CommonRuntimeTest {};
+
+TEST_F(InlineCacheTest, Transitions) {
+  ScopedObjectAccess soa(Thread::Current());
+  mirror::Class* object = class_linker_->FindSystemClass(soa.Self(), "Ljava/lang/Object;");
+  mirror::Class* string = class_linker_->FindSystemClass(soa.Self(), "Ljava/lang/String;");
+  mirror::Class* integer = class_linker_->FindSystemClass(soa.Self(), "Ljava/lang/Integer;");
+  mirror::Class* thread = class_linker_->FindSystemClass(soa.Self(), "Ljava/lang/Thread;");
+  mirror::Class* klass = class_linker_->FindSystemClass(soa.Self(), "Ljava/lang/Class;");
+  ASSERT_TRUE(object != nullptr);
+  ASSERT_TRUE(string != nullptr);
+  ASSERT_TRUE(integer != nullptr);
+  ASSERT_TRUE(thread != nullptr);
+  ASSERT_TRUE(klass != nullptr);
+  // Object.toString() invokes getClass(), getName() and hashCode().
+  mirror::ArtMethod* method = object->FindVirtualMethod("toString", "()Ljava/lang/String;");
+  mirror::ArtMethod* hash_code = object->FindVirtualMethod("hashCode", "()I");
+  ASSERT_TRUE(method != nullptr);
+  ASSERT_TRUE(hash_code != nullptr);
+
+  InlineCacheTable table;
+  MethodInlineCaches* caches = table.CreateMethodInlineCaches(soa.Self(), method);
+  ASSERT_TRUE(caches != nullptr);
+  EXPECT_EQ(caches, method->GetInlineCaches());
+  EXPECT_EQ(caches, table.CreateMethodInlineCaches(soa.Self(), method));
+  ASSERT_GT(caches->NumCaches(), 0U);
+  for (size_t i = 0; i < caches->NumCaches(); ++i) {
+    InlineCache* cache = caches->GetCache(i);
+    EXPECT_EQ(cache, caches->GetCacheForDexPc(cache->GetDexPc()));
+    const Instruction* inst = Instruction::At(&method->GetCodeItem()->insns_[cache->GetDexPc()]);
+    EXPECT_TRUE(inst->Opcode() == Instruction::INVOKE_VIRTUAL ||
+                inst->Opcode() == Instruction::INVOKE_VIRTUAL_RANGE ||
+                inst->Opcode() == Instruction::INVOKE_INTERFACE ||
+                inst->Opcode() == Instruction::INVOKE_INTERFACE_RANGE ||
+                inst->Opcode() == Instruction::INVOKE_VIRTUAL_QUICK ||
+                inst->Opcode() == Instruction::INVOKE_VIRTUAL_RANGE_QUICK)
+        << inst->DumpString(nullptr);
+    EXPECT_TRUE(cache->IsUninitialized());
+  }
+
+  InlineCache* cache = caches->GetCache(0);
+  EXPECT_TRUE(cache->Lookup(string) == nullptr);
+  table.Update(soa.Self(), cache, string, hash_code);
+  EXPECT_TRUE(cache->IsMonomorphic());
+  EXPECT_EQ(hash_code, cache->Lookup(string));
+  EXPECT_TRUE(cache->Lookup(integer) == nullptr);
+
+  table.Update(soa.Self(), cache, integer, hash_code);
+  table.Update(soa.Self(), cache, integer, hash_code);
+  EXPECT_TRUE(cache->IsPolymorphic());
+  EXPECT_EQ(hash_code, cache->Lookup(integer));
+
+  table.Update(soa.Self(), cache, thread, hash_code);
+  table.Update(soa.Self(), cache, klass, hash_code);
+  EXPECT_TRUE(cache->IsPolymorphic());
+  EXPECT_FALSE(cache->IsMegamorphic());
+  table.Update(soa.Self(), cache, object, hash_code);
+  EXPECT_TRUE(cache->IsMegamorphic());
+  // The classes seen before the cache filled up still hit.
+  EXPECT_EQ(hash_code, cache->Lookup(klass));
+  EXPECT_TRUE(cache->Lookup(object) == nullptr);
+
+  std::ostringstream os;
+  table.Dump(os);
+  std::string dump = os.str();
+  EXPECT_NE(std::string::npos, dump.find(PrettyMethod(method))) << dump;
+  EXPECT_NE(std::string::npos, dump.find("megamorphic: java.lang.String java.lang.Integer"))
+      << dump;
+
+  std::ostringstream sigquit;
+  table.DumpForSigQuit(sigquit);
+  EXPECT_NE(std::string::npos, sigquit.str().find("1 methods")) << sigquit.str();
+  EXPECT_NE(std::string::npos, sigquit.str().find("1 megamorphic")) << sigquit.str();
+  EXPECT_NE(std::string::npos,
+            sigquit.str().find("megamorphic: java.lang.String java.lang.Integer"))
+      << sigquit.str();
+
+  // The table owns the caches, detach them before it goes away.
+  method->SetInlineCaches(nullptr);
+}
+
+}  // namespace art
@@ -313,14 +313,23 @@ static void InterpreterJni(Thread* self, ArtMethod* method, const StringPiece& s
 
 enum InterpreterImplKind {
   kSwitchImpl,            // Switch-based interpreter implementation.
-  kComputedGotoImplKind   // Computed-goto-based interpreter implementation.
+  kComputedGotoImplKind,  // Computed-goto-based interpreter implementation.
+  kMterpImplKind          // Assembly interpreter implementation, backed by the switch-based one.
 };
 
-#if !defined(__clang__)
+// The assembly interpreter reads references straight out of the shadow frame, so it can't be used
+// with read barriers or the portable compiler's shadow frames.
+#if (defined(__x86_64__) || defined(__aarch64__)) && !defined(ART_USE_PORTABLE_COMPILER) && \
+    !defined(USE_BAKER_OR_BROOKS_READ_BARRIER)
+static constexpr InterpreterImplKind kInterpreterImplKind = kMterpImplKind;
+#elif !defined(__clang__)
 static constexpr InterpreterImplKind kInterpreterImplKind = kComputedGotoImplKind;
 #else
-// Clang 3.4 fails to build the goto interpreter implementation.
 static constexpr InterpreterImplKind kInterpreterImplKind = kSwitchImpl;
+#endif
+
+#if defined(__clang__)
+// Clang 3.4 fails to build the goto interpreter implementation.
 template<bool do_access_check, bool transaction_active>
 JValue ExecuteGotoImpl(Thread* self, MethodHelper& mh, const DexFile::CodeItem* code_item,
                        ShadowFrame& shadow_frame, JValue result_register) {
@@ -346,6 +355,58 @@ JValue ExecuteGotoImpl<false, true>(Thread* self, MethodHelper& mh,
                                      ShadowFrame& shadow_frame, JValue result_register);
 #endif
 
+#if defined(__x86_64__) || defined(__aarch64__)
+// Runs the method from the dex pc of the shadow frame. Returns true when the method returned, with
+// its result in result_register. Otherwise returns false, leaving in the shadow frame the dex pc
+// of the instruction that threw the pending exception, or of the next instruction for the switch
+// interpreter to execute.
+extern "C" bool ExecuteMterpImpl(Thread* self, const uint16_t* insns, ShadowFrame* shadow_frame,
+                                 JValue* result_register)
+    SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
+#endif
+
+static JValue ExecuteMterp(Thread* self, MethodHelper& mh, const DexFile::CodeItem* code_item,
+                           ShadowFrame& shadow_frame, JValue result_register)
+    SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
+#if defined(__x86_64__) || defined(__aarch64__)
+  const instrumentation::Instrumentation* const instrumentation =
+      Runtime::Current()->GetInstrumentation();
+  while (true) {
+    if (UNLIKELY(instrumentation->IsActive())) {
+      // The assembly interpreter doesn't report events, finish the method in the switch one.
+      return ExecuteSwitchImpl<false, false>(self, mh, code_item, shadow_frame, result_register,
+                                             false);
+    }
+    if (ExecuteMterpImpl(self, code_item->insns_, &shadow_frame, &result_register)) {
+      return result_register;
+    }
+    // The exception caught by a handler that starts with move-exception stays pending until that
+    // instruction, which the assembly interpreter leaves to the switch one.
+    const Instruction* inst = Instruction::At(code_item->insns_ + shadow_frame.GetDexPC());
+    if (UNLIKELY(self->IsExceptionPending()) && inst->Opcode() != Instruction::MOVE_EXCEPTION) {
+      // An invoke or field access threw, go to the catch handler as the switch interpreter does.
+      uint32_t found_dex_pc = FindNextInstructionFollowingException(self, shadow_frame,
+                                                                    shadow_frame.GetDexPC(),
+                                                                    instrumentation);
+      if (found_dex_pc == DexFile::kDexNoIndex) {
+        return JValue();  // Handled in caller.
+      }
+      shadow_frame.SetDexPC(found_dex_pc);
+      continue;
+    }
+    // Single-step the instruction the assembly interpreter stopped at.
+    result_register = ExecuteSwitchImpl<false, false>(self, mh, code_item, shadow_frame,
+                                                      result_register, true);
+    if (shadow_frame.GetDexPC() == DexFile::kDexNoIndex) {
+      return result_register;  // Returned, or threw an exception not caught by the method.
+    }
+  }
+#else
+  LOG(FATAL) << "UNREACHABLE";
+  UNREACHABLE();
+#endif
+}
+
 static JValue Execute(Thread* self, MethodHelper& mh, const DexFile::CodeItem* code_item,
                       ShadowFrame& shadow_frame, JValue result_register)
     SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
@@ -361,11 +422,15 @@ static inline JValue Execute(Thread* self, MethodHelper& mh, const DexFile::Code
   bool transaction_active = Runtime::Current()->IsActiveTransaction();
   if (LIKELY(shadow_frame.GetMethod()->IsPreverified())) {
     // Enter the "without access check" interpreter.
-    if (kInterpreterImplKind == kSwitchImpl) {
+    if (kInterpreterImplKind == kMterpImplKind && LIKELY(!transaction_active)) {
+      return ExecuteMterp(self, mh, code_item, shadow_frame, result_register);
+    } else if (kInterpreterImplKind == kSwitchImpl || kInterpreterImplKind == kMterpImplKind) {
       if (transaction_active) {
-        return ExecuteSwitchImpl<false, true>(self, mh, code_item, shadow_frame, result_register);
+        return ExecuteSwitchImpl<false, true>(self, mh, code_item, shadow_frame, result_register,
+                                              false);
       } else {
-        return ExecuteSwitchImpl<false, false>(self, mh, code_item, shadow_frame, result_register);
+        return ExecuteSwitchImpl<false, false>(self, mh, code_item, shadow_frame, result_register,
+                                               false);
       }
     } else {
       DCHECK_EQ(kInterpreterImplKind, kComputedGotoImplKind);
@@ -377,11 +442,13 @@ static inline JValue Execute(Thread* self, MethodHelper& mh, const DexFile::Code
     }
   } else {
     // Enter the "with access check" interpreter.
-    if (kInterpreterImplKind == kSwitchImpl) {
+    if (kInterpreterImplKind == kSwitchImpl || kInterpreterImplKind == kMterpImplKind) {
       if (transaction_active) {
-        return ExecuteSwitchImpl<true, true>(self, mh, code_item, shadow_frame, result_register);
+        return ExecuteSwitchImpl<true, true>(self, mh, code_item, shadow_frame, result_register,
+                                             false);
       } else {
-        return ExecuteSwitchImpl<true, false>(self, mh, code_item, shadow_frame, result_register);
+        return ExecuteSwitchImpl<true, false>(self, mh, code_item, shadow_frame, result_register,
+                                              false);
       }
     } else {
       DCHECK_EQ(kInterpreterImplKind, kComputedGotoImplKind);
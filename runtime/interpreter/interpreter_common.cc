@@ -26,6 +26,17 @@ void ThrowNullPointerExceptionFromInterpreter(const ShadowFrame& shadow_frame) {
   ThrowNullPointerExceptionFromDexPC(shadow_frame.GetCurrentLocationForThrow());
 }
 
+// Queues the rewrite of the instance field access inst to its quick form. Only the code of
+// verified methods, which the interpreter runs without access checks, is quickened.
+static void QuickenFieldAccess(Thread* self, const ShadowFrame& shadow_frame,
+                               const Instruction* inst, ArtField* f)
+    SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
+  Quickener* quickener = Runtime::Current()->GetQuickener();
+  if (quickener != nullptr) {
+    quickener->RecordFieldAccess(self, shadow_frame.GetMethod(), inst, f);
+  }
+}
+
 template<FindFieldType find_type, Primitive::Type field_type, bool do_access_check>
 bool DoFieldGet(Thread* self, ShadowFrame& shadow_frame, const Instruction* inst,
                 uint16_t inst_data) {
@@ -82,6 +93,9 @@ bool DoFieldGet(Thread* self, ShadowFrame& shadow_frame, const Instruction* inst
       LOG(FATAL) << "Unreachable: " << field_type;
       UNREACHABLE();
   }
+  if (!do_access_check && !is_static) {
+    QuickenFieldAccess(self, shadow_frame, inst, f);
+  }
   return true;
 }
 
@@ -289,6 +303,9 @@ bool DoFieldPut(Thread* self, const ShadowFrame& shadow_frame, const Instruction
       LOG(FATAL) << "Unreachable: " << field_type;
       UNREACHABLE();
   }
+  if (!do_access_check && !transaction_active && !is_static) {
+    QuickenFieldAccess(self, shadow_frame, inst, f);
+  }
   return true;
 }
 
@@ -33,6 +33,7 @@
 #include "entrypoints/entrypoint_utils-inl.h"
 #include "gc/accounting/card_table-inl.h"
 #include "handle_scope-inl.h"
+#include "inline_cache.h"
 #include "method_helper-inl.h"
 #include "nth_caller_visitor.h"
 #include "mirror/art_field-inl.h"
@@ -43,6 +44,7 @@
 #include "mirror/object-inl.h"
 #include "mirror/object_array-inl.h"
 #include "mirror/string-inl.h"
+#include "quickener.h"
 #include "ScopedLocalRef.h"
 #include "scoped_thread_state_change.h"
 #include "thread.h"
@@ -67,12 +69,16 @@ using ::art::mirror::Throwable;
 namespace art {
 namespace interpreter {
 
-// External references to both interpreter implementations.
+// External references to the C++ interpreter implementations.
 
+// When interpret_one_instruction is set, the switch implementation returns after executing the
+// instruction at the dex pc of the shadow frame, leaving the dex pc of the next one in the shadow
+// frame, or DexFile::kDexNoIndex if the method returned or threw an exception it doesn't catch.
 template<bool do_access_check, bool transaction_active>
 extern JValue ExecuteSwitchImpl(Thread* self, MethodHelper& mh,
                                 const DexFile::CodeItem* code_item,
-                                ShadowFrame& shadow_frame, JValue result_register);
+                                ShadowFrame& shadow_frame, JValue result_register,
+                                bool interpret_one_instruction);
 
 template<bool do_access_check, bool transaction_active>
 extern JValue ExecuteGotoImpl(Thread* self, MethodHelper& mh,
@@ -103,6 +109,21 @@ template<bool is_range, bool do_assignability_check>
 bool DoCall(ArtMethod* method, Thread* self, ShadowFrame& shadow_frame,
             const Instruction* inst, uint16_t inst_data, JValue* result);
 
+// Returns the inline cache of the invoke at dex_pc in method, or null when inline caches are
+// disabled.
+static inline InlineCache* GetInlineCache(Thread* self, ArtMethod* method, uint32_t dex_pc)
+    SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
+  InlineCacheTable* inline_cache_table = Runtime::Current()->GetInlineCacheTable();
+  if (inline_cache_table == nullptr) {
+    return nullptr;
+  }
+  MethodInlineCaches* inline_caches = method->GetInlineCaches();
+  if (UNLIKELY(inline_caches == nullptr)) {
+    inline_caches = inline_cache_table->CreateMethodInlineCaches(self, method);
+  }
+  return inline_caches->GetCacheForDexPc(dex_pc);
+}
+
 // Handles invoke-XXX/range instructions.
 // Returns true on success, otherwise throws an exception and returns false.
 template<InvokeType type, bool is_range, bool do_access_check>
@@ -112,8 +133,24 @@ static inline bool DoInvoke(Thread* self, ShadowFrame& shadow_frame, const Instr
   const uint32_t vregC = (is_range) ? inst->VRegC_3rc() : inst->VRegC_35c();
   Object* receiver = (type == kStatic) ? nullptr : shadow_frame.GetVRegReference(vregC);
   mirror::ArtMethod* sf_method = shadow_frame.GetMethod();
-  ArtMethod* const method = FindMethodFromCode<type, do_access_check>(
-      method_idx, &receiver, &sf_method, self);
+  ArtMethod* method = nullptr;
+  // Virtual and interface calls first look for the receiver's class in the inline cache of the
+  // call site. The target only depends on the call site and the receiver's class, so this also
+  // skips the access checks that already passed for it.
+  InlineCache* inline_cache = nullptr;
+  if ((type == kVirtual || type == kInterface) && LIKELY(receiver != nullptr)) {
+    inline_cache = GetInlineCache(self, sf_method, shadow_frame.GetDexPC());
+    if (inline_cache != nullptr) {
+      method = inline_cache->Lookup(receiver->GetClass());
+    }
+  }
+  if (method == nullptr) {
+    method = FindMethodFromCode<type, do_access_check>(method_idx, &receiver, &sf_method, self);
+    if (inline_cache != nullptr && method != nullptr && !inline_cache->IsMegamorphic()) {
+      Runtime::Current()->GetInlineCacheTable()->Update(self, inline_cache, receiver->GetClass(),
+                                                        method);
+    }
+  }
   // The shadow frame should already be pushed, so we don't need to update it.
   if (UNLIKELY(method == nullptr)) {
     CHECK(self->IsExceptionPending());
@@ -124,6 +161,13 @@ static inline bool DoInvoke(Thread* self, ShadowFrame& shadow_frame, const Instr
     result->SetJ(0);
     return false;
   } else {
+    if (type == kVirtual && !do_access_check) {
+      // The vtable index of the target is now known, queue the rewrite to invoke-virtual-quick.
+      Quickener* quickener = Runtime::Current()->GetQuickener();
+      if (quickener != nullptr) {
+        quickener->RecordInvokeVirtual(self, shadow_frame.GetMethod(), inst, method);
+      }
+    }
     return DoCall<is_range, do_access_check>(method, self, shadow_frame, inst, inst_data, result);
   }
 }
@@ -154,6 +198,15 @@ static inline bool DoInvokeVirtualQuick(Thread* self, ShadowFrame& shadow_frame,
     result->SetJ(0);
     return false;
   } else {
+    // Keep recording the receiver classes in the inline cache of the call site, which quickening
+    // would otherwise freeze at the classes seen before the rewrite.
+    InlineCache* inline_cache = GetInlineCache(self, shadow_frame.GetMethod(),
+                                               shadow_frame.GetDexPC());
+    if (inline_cache != nullptr && !inline_cache->IsMegamorphic() &&
+        inline_cache->Lookup(receiver->GetClass()) == nullptr) {
+      Runtime::Current()->GetInlineCacheTable()->Update(self, inline_cache, receiver->GetClass(),
+                                                        method);
+    }
     // No need to check since we've been quickened.
     return DoCall<is_range, false>(method, self, shadow_frame, inst, inst_data, result);
   }
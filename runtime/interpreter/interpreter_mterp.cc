@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "interpreter_common.h"
+
+namespace art {
+namespace interpreter {
+
+/*
+ * Helpers called by the assembly interpreter for invokes and field accesses, which need the
+ * runtime. The assembly interpreter stores the dex pc of the instruction in the shadow frame
+ * before the call, so that the callee, stack walks and exceptions see it.
+ *
+ * A helper returns true when the assembly interpreter can go on with the next instruction. It
+ * returns false when the instruction threw, leaving the dex pc of the instruction in the shadow
+ * frame for the exception to be delivered, or when instrumentation was enabled while it ran, for
+ * example by a debugger attaching during a call, leaving the dex pc of the next instruction. The
+ * assembly interpreter doesn't report events, so the switch interpreter takes over then.
+ */
+static inline bool MterpShouldContinue(Thread* self, ShadowFrame* shadow_frame,
+                                       const Instruction* inst, bool success)
+    SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
+  if (UNLIKELY(!success)) {
+    DCHECK(self->IsExceptionPending());
+    return false;
+  }
+  if (UNLIKELY(Runtime::Current()->GetInstrumentation()->IsActive())) {
+    shadow_frame->SetDexPC(shadow_frame->GetDexPC() + inst->SizeInCodeUnits());
+    return false;
+  }
+  return true;
+}
+
+#define MTERP_INVOKE(_name, _type, _is_range)                                                  \
+  extern "C" bool MterpInvoke ## _name(Thread* self, ShadowFrame* shadow_frame,                \
+                                       const uint16_t* dex_pc_ptr, JValue* result_register)    \
+      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {                                            \
+    const Instruction* inst = Instruction::At(dex_pc_ptr);                                     \
+    bool success = DoInvoke<_type, _is_range, false>(self, *shadow_frame, inst,                \
+                                                     inst->Fetch16(0), result_register);       \
+    return MterpShouldContinue(self, shadow_frame, inst, success);                             \
+  }
+
+MTERP_INVOKE(Virtual, kVirtual, false)
+MTERP_INVOKE(Super, kSuper, false)
+MTERP_INVOKE(Direct, kDirect, false)
+MTERP_INVOKE(Static, kStatic, false)
+MTERP_INVOKE(Interface, kInterface, false)
+MTERP_INVOKE(VirtualRange, kVirtual, true)
+MTERP_INVOKE(SuperRange, kSuper, true)
+MTERP_INVOKE(DirectRange, kDirect, true)
+MTERP_INVOKE(StaticRange, kStatic, true)
+MTERP_INVOKE(InterfaceRange, kInterface, true)
+#undef MTERP_INVOKE
+
+#define MTERP_INVOKE_VIRTUAL_QUICK(_name, _is_range)                                           \
+  extern "C" bool MterpInvoke ## _name(Thread* self, ShadowFrame* shadow_frame,                \
+                                       const uint16_t* dex_pc_ptr, JValue* result_register)    \
+      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {                                            \
+    const Instruction* inst = Instruction::At(dex_pc_ptr);                                     \
+    bool success = DoInvokeVirtualQuick<_is_range>(self, *shadow_frame, inst,                  \
+                                                   inst->Fetch16(0), result_register);         \
+    return MterpShouldContinue(self, shadow_frame, inst, success);                             \
+  }
+
+MTERP_INVOKE_VIRTUAL_QUICK(VirtualQuick, false)
+MTERP_INVOKE_VIRTUAL_QUICK(VirtualRangeQuick, true)
+#undef MTERP_INVOKE_VIRTUAL_QUICK
+
+#define MTERP_FIELD_GET(_name, _find_type, _field_type)                                        \
+  extern "C" bool Mterp ## _name(Thread* self, ShadowFrame* shadow_frame,                      \
+                                 const uint16_t* dex_pc_ptr, JValue* /* result_register */)    \
+      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {                                            \
+    const Instruction* inst = Instruction::At(dex_pc_ptr);                                     \
+    bool success = DoFieldGet<_find_type, _field_type, false>(self, *shadow_frame, inst,       \
+                                                              inst->Fetch16(0));               \
+    return MterpShouldContinue(self, shadow_frame, inst, success);                             \
+  }
+
+MTERP_FIELD_GET(IGet, InstancePrimitiveRead, Primitive::kPrimInt)
+MTERP_FIELD_GET(IGetWide, InstancePrimitiveRead, Primitive::kPrimLong)
+MTERP_FIELD_GET(IGetObject, InstanceObjectRead, Primitive::kPrimNot)
+MTERP_FIELD_GET(IGetBoolean, InstancePrimitiveRead, Primitive::kPrimBoolean)
+MTERP_FIELD_GET(IGetByte, InstancePrimitiveRead, Primitive::kPrimByte)
+MTERP_FIELD_GET(IGetChar, InstancePrimitiveRead, Primitive::kPrimChar)
+MTERP_FIELD_GET(IGetShort, InstancePrimitiveRead, Primitive::kPrimShort)
+MTERP_FIELD_GET(SGet, StaticPrimitiveRead, Primitive::kPrimInt)
+MTERP_FIELD_GET(SGetWide, StaticPrimitiveRead, Primitive::kPrimLong)
+MTERP_FIELD_GET(SGetObject, StaticObjectRead, Primitive::kPrimNot)
+MTERP_FIELD_GET(SGetBoolean, StaticPrimitiveRead, Primitive::kPrimBoolean)
+MTERP_FIELD_GET(SGetByte, StaticPrimitiveRead, Primitive::kPrimByte)
+MTERP_FIELD_GET(SGetChar, StaticPrimitiveRead, Primitive::kPrimChar)
+MTERP_FIELD_GET(SGetShort, StaticPrimitiveRead, Primitive::kPrimShort)
+#undef MTERP_FIELD_GET
+
+// The assembly interpreter never runs in a transaction.
+#define MTERP_FIELD_PUT(_name, _find_type, _field_type)                                        \
+  extern "C" bool Mterp ## _name(Thread* self, ShadowFrame* shadow_frame,                      \
+                                 const uint16_t* dex_pc_ptr, JValue* /* result_register */)    \
+      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {                                            \
+    const Instruction* inst = Instruction::At(dex_pc_ptr);                                     \
+    bool success = DoFieldPut<_find_type, _field_type, false, false>(self, *shadow_frame,      \
+                                                                     inst, inst->Fetch16(0));  \
+    return MterpShouldContinue(self, shadow_frame, inst, success);                             \
+  }
+
+MTERP_FIELD_PUT(IPut, InstancePrimitiveWrite, Primitive::kPrimInt)
+MTERP_FIELD_PUT(IPutWide, InstancePrimitiveWrite, Primitive::kPrimLong)
+MTERP_FIELD_PUT(IPutObject, InstanceObjectWrite, Primitive::kPrimNot)
+MTERP_FIELD_PUT(IPutBoolean, InstancePrimitiveWrite, Primitive::kPrimBoolean)
+MTERP_FIELD_PUT(IPutByte, InstancePrimitiveWrite, Primitive::kPrimByte)
+MTERP_FIELD_PUT(IPutChar, InstancePrimitiveWrite, Primitive::kPrimChar)
+MTERP_FIELD_PUT(IPutShort, InstancePrimitiveWrite, Primitive::kPrimShort)
+MTERP_FIELD_PUT(SPut, StaticPrimitiveWrite, Primitive::kPrimInt)
+MTERP_FIELD_PUT(SPutWide, StaticPrimitiveWrite, Primitive::kPrimLong)
+MTERP_FIELD_PUT(SPutObject, StaticObjectWrite, Primitive::kPrimNot)
+MTERP_FIELD_PUT(SPutBoolean, StaticPrimitiveWrite, Primitive::kPrimBoolean)
+MTERP_FIELD_PUT(SPutByte, StaticPrimitiveWrite, Primitive::kPrimByte)
+MTERP_FIELD_PUT(SPutChar, StaticPrimitiveWrite, Primitive::kPrimChar)
+MTERP_FIELD_PUT(SPutShort, StaticPrimitiveWrite, Primitive::kPrimShort)
+#undef MTERP_FIELD_PUT
+
+// iput-object-quick needs the card marking of SetFieldObject, the other quickened field accesses
+// are done in assembly.
+extern "C" bool MterpIPutObjectQuick(Thread* self, ShadowFrame* shadow_frame,
+                                     const uint16_t* dex_pc_ptr, JValue* /* result_register */)
+    SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
+  const Instruction* inst = Instruction::At(dex_pc_ptr);
+  bool success = DoIPutQuick<Primitive::kPrimNot, false>(*shadow_frame, inst, inst->Fetch16(0));
+  return MterpShouldContinue(self, shadow_frame, inst, success);
+}
+
+}  // namespace interpreter
+}  // namespace art
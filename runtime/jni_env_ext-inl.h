@@ -19,6 +19,7 @@
 
 #include "jni_env_ext.h"
 
+#include "indirect_reference_table-inl.h"
 #include "utils.h"
 
 namespace art {
@@ -17,7 +17,7 @@
 #include "jni_env_ext.h"
 
 #include "check_jni.h"
-#include "indirect_reference_table.h"
+#include "indirect_reference_table-inl.h"
 #include "java_vm_ext.h"
 #include "jni_internal.h"
 
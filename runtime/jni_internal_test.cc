@@ -16,6 +16,7 @@
 
 #include "jni_internal.h"
 
+#include "base/histogram-inl.h"
 #include "common_compiler_test.h"
 #include "java_vm_ext.h"
 #include "mirror/art_method-inl.h"
@@ -910,6 +911,24 @@ TEST_F(JniInternalTest, RegisterAndUnregisterNatives) {
   EXPECT_FALSE(env_->ExceptionCheck());
   EXPECT_EQ(env_->UnregisterNatives(jlobject), JNI_OK);
 
+  // Check that unregistering drops the fast flag of a "!" registration.
+  {
+    JNINativeMethod methods[] = { { "notify", "!()V", native_function } };
+    EXPECT_EQ(env_->RegisterNatives(jlobject, methods, 1), JNI_OK);
+  }
+  EXPECT_FALSE(env_->ExceptionCheck());
+  jmethodID notify = env_->GetMethodID(jlobject, "notify", "()V");
+  ASSERT_NE(notify, nullptr);
+  {
+    ScopedObjectAccess soa(env_);
+    EXPECT_TRUE(soa.DecodeMethod(notify)->IsFastNative());
+  }
+  EXPECT_EQ(env_->UnregisterNatives(jlobject), JNI_OK);
+  {
+    ScopedObjectAccess soa(env_);
+    EXPECT_FALSE(soa.DecodeMethod(notify)->IsFastNative());
+  }
+
   // Check that registering no methods isn't a failure.
   {
     JNINativeMethod methods[] = { };
@@ -2021,4 +2040,75 @@ TEST_F(JniInternalTest, DetachCurrentThread) {
   vm_->AttachCurrentThread(&env_, nullptr);  // need attached thread for CommonRuntimeTest::TearDown
 }
 
+// Times the JNI calls dominated by local reference handling. The calls are made kCallsPerFrame at
+// a time within a local frame, the pattern of a native method.
+TEST_F(JniInternalTest, LocalReferenceSpeed) {
+  TEST_DISABLED_FOR_PORTABLE();
+  Thread::Current()->TransitionFromSuspendedToRunnable();
+  LoadDex("AllFields");
+  bool started = runtime_->Start();
+  ASSERT_TRUE(started);
+
+  jclass c = env_->FindClass("AllFields");
+  ASSERT_NE(c, nullptr);
+  jobject o = env_->AllocObject(c);
+  ASSERT_NE(o, nullptr);
+  jfieldID i_fid = env_->GetFieldID(c, "iObject", "Ljava/lang/Object;");
+  ASSERT_NE(i_fid, nullptr);
+  env_->SetObjectField(o, i_fid, o);
+  jclass object_class = env_->FindClass("java/lang/Object");
+  ASSERT_NE(object_class, nullptr);
+  jmethodID init = env_->GetMethodID(object_class, "<init>", "()V");
+  ASSERT_NE(init, nullptr);
+
+  static constexpr size_t kChunks = 256;
+  static constexpr size_t kFramesPerChunk = 4;
+  // Fits within the kLocalsMax local references of a thread.
+  static constexpr int kCallsPerFrame = 256;
+  // Times of chunks of 1024 calls, in microseconds.
+  std::unique_ptr<Histogram<uint64_t>> new_local_ref_hist(
+      new Histogram<uint64_t>("NewLocalRef x1024", 5));
+  std::unique_ptr<Histogram<uint64_t>> get_object_field_hist(
+      new Histogram<uint64_t>("GetObjectField x1024", 5));
+  std::unique_ptr<Histogram<uint64_t>> call_void_method_hist(
+      new Histogram<uint64_t>("CallVoidMethod x1024", 5));
+  for (size_t i = 0; i < kChunks; i++) {
+    uint64_t start_time = NanoTime();
+    for (size_t frame = 0; frame < kFramesPerChunk; frame++) {
+      ASSERT_EQ(JNI_OK, env_->PushLocalFrame(kCallsPerFrame));
+      for (int j = 0; j < kCallsPerFrame; j++) {
+        env_->NewLocalRef(o);
+      }
+      env_->PopLocalFrame(nullptr);
+    }
+    new_local_ref_hist->AddValue((NanoTime() - start_time) / 1000);
+
+    start_time = NanoTime();
+    for (size_t frame = 0; frame < kFramesPerChunk; frame++) {
+      ASSERT_EQ(JNI_OK, env_->PushLocalFrame(kCallsPerFrame));
+      for (int j = 0; j < kCallsPerFrame; j++) {
+        env_->GetObjectField(o, i_fid);
+      }
+      env_->PopLocalFrame(nullptr);
+    }
+    get_object_field_hist->AddValue((NanoTime() - start_time) / 1000);
+
+    start_time = NanoTime();
+    for (size_t frame = 0; frame < kFramesPerChunk; frame++) {
+      for (int j = 0; j < kCallsPerFrame; j++) {
+        env_->CallVoidMethod(o, init);
+      }
+    }
+    call_void_method_hist->AddValue((NanoTime() - start_time) / 1000);
+    ASSERT_FALSE(env_->ExceptionCheck());
+  }
+
+  for (Histogram<uint64_t>* hist : { new_local_ref_hist.get(), get_object_field_hist.get(),
+                                     call_void_method_hist.get() }) {
+    Histogram<uint64_t>::CumulativeData data;
+    hist->CreateHistogram(&data);
+    hist->PrintConfidenceIntervals(std::cout, 0.99, data);
+  }
+}
+
 }  // namespace art
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "lock_contention_profiler.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "base/histogram-inl.h"
+#include "base/stl_util.h"
+#include "base/stringprintf.h"
+#include "mirror/art_method-inl.h"
+#include "thread.h"
+#include "utils.h"
+
+namespace art {
+
+constexpr size_t LockContentionProfiler::kMaxBuckets;
+constexpr uint64_t LockContentionProfiler::kInitialBucketSize;
+constexpr size_t LockContentionProfiler::kMaxDumpedCallSites;
+constexpr uint64_t LockContentionProfiler::kAdjust;
+
+bool LockContentionProfiler::CallSite::operator<(const CallSite& other) const {
+  if (owner_method != other.owner_method) {
+    return owner_method < other.owner_method;
+  }
+  if (owner_dex_pc != other.owner_dex_pc) {
+    return owner_dex_pc < other.owner_dex_pc;
+  }
+  if (waiter_method != other.waiter_method) {
+    return waiter_method < other.waiter_method;
+  }
+  return waiter_dex_pc < other.waiter_dex_pc;
+}
+
+static std::string PrettyCallSite(mirror::ArtMethod* method, uint32_t dex_pc)
+    SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
+  if (method == nullptr) {
+    return "<no method>";
+  }
+  return StringPrintf("%s@0x%x", PrettyMethod(method).c_str(), dex_pc);
+}
+
+LockContentionProfiler::LockContentionProfiler()
+    : lock_("lock contention profiler lock", kDefaultMutexLevel) {
+}
+
+LockContentionProfiler::~LockContentionProfiler() {
+  STLDeleteValues(&call_sites_);
+}
+
+void LockContentionProfiler::AddContention(Thread* self, mirror::ArtMethod* owner_method,
+                                           uint32_t owner_dex_pc, mirror::ArtMethod* waiter_method,
+                                           uint32_t waiter_dex_pc, uint64_t wait_ns) {
+  CallSite call_site = { owner_method, owner_dex_pc, waiter_method, waiter_dex_pc };
+  MutexLock mu(self, lock_);
+  auto it = call_sites_.find(call_site);
+  Histogram<uint64_t>* histogram;
+  if (it == call_sites_.end()) {
+    // Name the histogram now while the methods are known to be live, the dump only needs the name.
+    std::string name = PrettyCallSite(waiter_method, waiter_dex_pc) + " waiting for " +
+        PrettyCallSite(owner_method, owner_dex_pc);
+    histogram = new Histogram<uint64_t>(name.c_str(), kInitialBucketSize, kMaxBuckets);
+    call_sites_.Put(call_site, histogram);
+  } else {
+    histogram = it->second;
+  }
+  // Convert to microseconds so that we don't overflow our counters.
+  histogram->AddValue(wait_ns / kAdjust);
+}
+
+void LockContentionProfiler::Dump(std::ostream& os) {
+  MutexLock mu(Thread::Current(), lock_);
+  std::vector<Histogram<uint64_t>*> histograms;
+  for (const auto& it : call_sites_) {
+    histograms.push_back(it.second);
+  }
+  std::sort(histograms.begin(), histograms.end(),
+            [](const Histogram<uint64_t>* a, const Histogram<uint64_t>* b) {
+    return a->Sum() > b->Sum();
+  });
+  os << "Lock contention by call site: " << histograms.size() << " call sites\n";
+  for (size_t i = 0; i < histograms.size() && i < kMaxDumpedCallSites; ++i) {
+    Histogram<uint64_t>::CumulativeData cumulative_data;
+    histograms[i]->CreateHistogram(&cumulative_data);
+    os << "  " << histograms[i]->SampleSize() << " waits, ";
+    histograms[i]->PrintConfidenceIntervals(os, 0.99, cumulative_data);
+  }
+}
+
+void LockContentionProfiler::Reset() {
+  MutexLock mu(Thread::Current(), lock_);
+  STLDeleteValues(&call_sites_);
+}
+
+size_t LockContentionProfiler::NumCallSites() {
+  MutexLock mu(Thread::Current(), lock_);
+  return call_sites_.size();
+}
+
+}  // namespace art
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_LOCK_CONTENTION_PROFILER_H_
+#define ART_RUNTIME_LOCK_CONTENTION_PROFILER_H_
+
+#include <iosfwd>
+
+#include "base/histogram.h"
+#include "base/macros.h"
+#include "base/mutex.h"
+#include "safe_map.h"
+
+namespace art {
+
+class Thread;
+
+namespace mirror {
+  class ArtMethod;
+}  // namespace mirror
+
+// Aggregates the time threads spend blocked on contended monitors by call site, that is the method
+// and dex pc where the owner acquired the lock and where the waiter tried to. Enabled together with
+// lock contention sampling by -Xlockprofthreshold, which makes monitors record where their owner
+// acquired them.
+class LockContentionProfiler {
+ public:
+  LockContentionProfiler();
+  ~LockContentionProfiler();
+
+  // Record that self, trying to lock at waiter_method/waiter_dex_pc, was blocked for wait_ns by the
+  // owner having locked at owner_method/owner_dex_pc. The methods may be null when the lock was
+  // acquired with an empty stack.
+  void AddContention(Thread* self, mirror::ArtMethod* owner_method, uint32_t owner_dex_pc,
+                     mirror::ArtMethod* waiter_method, uint32_t waiter_dex_pc, uint64_t wait_ns)
+      LOCKS_EXCLUDED(lock_)
+      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
+
+  // Dump the histograms of the call sites with the most time spent waiting.
+  void Dump(std::ostream& os) LOCKS_EXCLUDED(lock_);
+
+  void Reset() LOCKS_EXCLUDED(lock_);
+
+  size_t NumCallSites() LOCKS_EXCLUDED(lock_);
+
+ private:
+  struct CallSite {
+    mirror::ArtMethod* owner_method;
+    uint32_t owner_dex_pc;
+    mirror::ArtMethod* waiter_method;
+    uint32_t waiter_dex_pc;
+
+    bool operator<(const CallSite& other) const;
+  };
+
+  static constexpr size_t kMaxBuckets = 100;
+  static constexpr uint64_t kInitialBucketSize = 50;  // 50 microseconds.
+  static constexpr size_t kMaxDumpedCallSites = 20;
+  static constexpr uint64_t kAdjust = 1000;
+
+  Mutex lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
+  // Histograms of wait times in microseconds, named after their call site.
+  SafeMap<CallSite, Histogram<uint64_t>*> call_sites_ GUARDED_BY(lock_);
+
+  DISALLOW_COPY_AND_ASSIGN(LockContentionProfiler);
+};
+
+}  // namespace art
+
+#endif  // ART_RUNTIME_LOCK_CONTENTION_PROFILER_H_
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "lock_contention_profiler.h"
+
+#include <sstream>
+
+#include "common_runtime_test.h"
+#include "mirror/art_method-inl.h"
+#include "mirror/class-inl.h"
+#include "scoped_thread_state_change.h"
+
+namespace art {
+
+class LockContentionProfilerTest : public CommonRuntimeTest {};
+
+TEST_F(LockContentionProfilerTest, AggregatesByCallSite) {
+  ScopedObjectAccess soa(Thread::Current());
+  mirror::Class* c = class_linker_->FindSystemClass(soa.Self(), "Ljava/lang/Object;");
+  ASSERT_TRUE(c != nullptr);
+  mirror::ArtMethod* owner = c->FindVirtualMethod("toString", "()Ljava/lang/String;");
+  mirror::ArtMethod* waiter = c->FindVirtualMethod("hashCode", "()I");
+  ASSERT_TRUE(owner != nullptr);
+  ASSERT_TRUE(waiter != nullptr);
+
+  LockContentionProfiler profiler;
+  EXPECT_EQ(0U, profiler.NumCallSites());
+  profiler.AddContention(soa.Self(), owner, 1, waiter, 2, MsToNs(3));
+  profiler.AddContention(soa.Self(), owner, 1, waiter, 2, MsToNs(5));
+  EXPECT_EQ(1U, profiler.NumCallSites());
+  // A different dex pc in the waiter is a different call site.
+  profiler.AddContention(soa.Self(), owner, 1, waiter, 4, MsToNs(1));
+  // Locks acquired with an empty stack have no owner method.
+  profiler.AddContention(soa.Self(), nullptr, 0, waiter, 2, MsToNs(1));
+  EXPECT_EQ(3U, profiler.NumCallSites());
+
+  std::ostringstream os;
+  profiler.Dump(os);
+  std::string dump = os.str();
+  EXPECT_NE(std::string::npos, dump.find("3 call sites")) << dump;
+  EXPECT_NE(std::string::npos,
+            dump.find("2 waits, int java.lang.Object.hashCode()@0x2 waiting for "
+                      "java.lang.String java.lang.Object.toString()@0x1")) << dump;
+  EXPECT_NE(std::string::npos, dump.find("waiting for <no method>")) << dump;
+
+  profiler.Reset();
+  EXPECT_EQ(0U, profiler.NumCallSites());
+}
+
+}  // namespace art
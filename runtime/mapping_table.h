@@ -23,8 +23,43 @@
 namespace art {
 
 // A utility for processing the raw uleb128 encoded mapping table created by the quick compiler.
+//
+// The table is laid out as:
+//   uleb128 total number of entries
+//   uleb128 number of pc to dex entries
+//   uleb128 number of pc to dex index entries
+//   pc to dex index entries, kPcToDexIndexEntrySize bytes each
+//   pc to dex entries, (uleb128 native pc delta, sleb128 dex pc delta) pairs
+//   dex to pc entries, (uleb128 native pc delta, sleb128 dex pc delta) pairs
+//
+// Native pc offsets of the pc to dex entries are sorted. Every kPcToDexIndexInterval-th pc to dex
+// entry has a fixed-width index entry holding its decoded values and the position of the entry
+// following it, so that FindPcToDex only decodes a bounded number of entries after a binary search.
 class MappingTable {
  public:
+  // Number of pc to dex entries covered by each index entry.
+  static constexpr uint32_t kPcToDexIndexInterval = 16;
+  // An index entry is the native pc offset, the dex pc and the offset of the next entry from the
+  // start of the pc to dex entries, each stored as a little-endian uint32_t.
+  static constexpr size_t kPcToDexIndexEntrySize = 3 * sizeof(uint32_t);
+
+  // The number of index entries for a table with the given number of pc to dex entries.
+  static uint32_t PcToDexIndexSize(uint32_t pc_to_dex_size) {
+    return (pc_to_dex_size == 0u) ? 0u : (pc_to_dex_size - 1u) / kPcToDexIndexInterval;
+  }
+
+  // Whether an index entry should be emitted after writing the given (0-based) pc to dex entry.
+  static bool NeedsPcToDexIndexEntry(uint32_t element, uint32_t pc_to_dex_size) {
+    return (element + 1u) % kPcToDexIndexInterval == 0u && element + 1u < pc_to_dex_size;
+  }
+
+  static uint8_t* EncodePcToDexIndexEntry(uint8_t* dest, uint32_t native_pc_offset, uint32_t dex_pc,
+                                          uint32_t next_entry_offset) {
+    dest = EncodeUint32(dest, native_pc_offset);
+    dest = EncodeUint32(dest, dex_pc);
+    return EncodeUint32(dest, next_entry_offset);
+  }
+
   explicit MappingTable(const uint8_t* encoded_map) : encoded_table_(encoded_map) {
   }
 
@@ -53,6 +88,8 @@ class MappingTable {
     if (table != nullptr) {
       uint32_t total_size = DecodeUnsignedLeb128(&table);
       uint32_t pc_to_dex_size = DecodeUnsignedLeb128(&table);
+      uint32_t index_size = DecodeUnsignedLeb128(&table);
+      table += index_size * kPcToDexIndexEntrySize;
       // We must have dex to pc entries or else the loop will go beyond the end of the table.
       DCHECK_GT(total_size, pc_to_dex_size);
       for (uint32_t i = 0; i < pc_to_dex_size; ++i) {
@@ -136,10 +173,62 @@ class MappingTable {
     if (table != nullptr) {
       DecodeUnsignedLeb128(&table);  // Total_size, unused.
       DecodeUnsignedLeb128(&table);  // PC to Dex size, unused.
+      uint32_t index_size = DecodeUnsignedLeb128(&table);
+      table += index_size * kPcToDexIndexEntrySize;
     }
     return table;
   }
 
+  // Find the dex pc of the first pc to dex entry with the given native pc offset. Uses the index
+  // to skip to the right part of the table instead of decoding it from the start.
+  bool FindPcToDex(uint32_t native_pc_offset, uint32_t* dex_pc) const {
+    const uint8_t* table = encoded_table_;
+    if (table == nullptr) {
+      return false;
+    }
+    DecodeUnsignedLeb128(&table);  // Total_size, unused.
+    uint32_t pc_to_dex_size = DecodeUnsignedLeb128(&table);
+    uint32_t index_size = DecodeUnsignedLeb128(&table);
+    const uint8_t* index = table;
+    const uint8_t* entries = index + index_size * kPcToDexIndexEntrySize;
+    // Find the number of index entries with a native pc offset below the sought one. Entries
+    // before the last of those cannot be the first match.
+    uint32_t lo = 0u;
+    uint32_t hi = index_size;
+    while (lo < hi) {
+      uint32_t mid = lo + (hi - lo) / 2u;
+      if (DecodeUint32(index + mid * kPcToDexIndexEntrySize) < native_pc_offset) {
+        lo = mid + 1u;
+      } else {
+        hi = mid;
+      }
+    }
+    uint32_t element = 0u;
+    uint32_t current_native_pc_offset = 0u;
+    uint32_t current_dex_pc = 0u;
+    const uint8_t* ptr = entries;
+    if (lo != 0u) {
+      const uint8_t* index_entry = index + (lo - 1u) * kPcToDexIndexEntrySize;
+      current_native_pc_offset = DecodeUint32(index_entry);
+      current_dex_pc = DecodeUint32(index_entry + sizeof(uint32_t));
+      ptr = entries + DecodeUint32(index_entry + 2 * sizeof(uint32_t));
+      element = lo * kPcToDexIndexInterval;
+    }
+    for (; element != pc_to_dex_size; ++element) {
+      current_native_pc_offset += DecodeUnsignedLeb128(&ptr);
+      // For negative delta, unsigned overflow after static_cast does exactly what we need.
+      current_dex_pc += static_cast<uint32_t>(DecodeSignedLeb128(&ptr));
+      if (current_native_pc_offset == native_pc_offset) {
+        *dex_pc = current_dex_pc;
+        return true;
+      }
+      if (current_native_pc_offset > native_pc_offset) {
+        break;  // Entries are sorted by native pc offset.
+      }
+    }
+    return false;
+  }
+
   class PcToDexIterator {
    public:
     PcToDexIterator(const MappingTable* table, uint32_t element) :
@@ -198,6 +287,19 @@ class MappingTable {
   }
 
  private:
+  // Index entries are not necessarily aligned, so access them byte by byte.
+  static uint8_t* EncodeUint32(uint8_t* dest, uint32_t value) {
+    for (size_t i = 0; i != sizeof(uint32_t); ++i) {
+      dest[i] = static_cast<uint8_t>(value >> (8u * i));
+    }
+    return dest + sizeof(uint32_t);
+  }
+
+  static uint32_t DecodeUint32(const uint8_t* src) {
+    return static_cast<uint32_t>(src[0]) | (static_cast<uint32_t>(src[1]) << 8) |
+        (static_cast<uint32_t>(src[2]) << 16) | (static_cast<uint32_t>(src[3]) << 24);
+  }
+
   const uint8_t* const encoded_table_;
 };
 
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mapping_table.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace art {
+
+struct MappingEntry {
+  uint32_t native_pc_offset;
+  uint32_t dex_pc;
+};
+
+// Encode a mapping table the same way the compilers do.
+static std::vector<uint8_t> EncodeMappingTable(const std::vector<MappingEntry>& pc2dex,
+                                               const std::vector<MappingEntry>& dex2pc) {
+  uint32_t pc2dex_entries = pc2dex.size();
+  uint32_t index_entries = MappingTable::PcToDexIndexSize(pc2dex_entries);
+  std::vector<uint8_t> data((3 + index_entries * MappingTable::kPcToDexIndexEntrySize +
+                             (pc2dex.size() + dex2pc.size()) * 10) * 2);
+  uint8_t* write_pos = &data[0];
+  write_pos = EncodeUnsignedLeb128(write_pos, pc2dex_entries + dex2pc.size());
+  write_pos = EncodeUnsignedLeb128(write_pos, pc2dex_entries);
+  write_pos = EncodeUnsignedLeb128(write_pos, index_entries);
+  uint8_t* index_pos = write_pos;
+  write_pos += index_entries * MappingTable::kPcToDexIndexEntrySize;
+  uint8_t* pc2dex_start = write_pos;
+  uint32_t native_pc_offset = 0u;
+  uint32_t dex_pc = 0u;
+  for (uint32_t i = 0; i != pc2dex_entries; ++i) {
+    write_pos = EncodeUnsignedLeb128(write_pos, pc2dex[i].native_pc_offset - native_pc_offset);
+    write_pos = EncodeSignedLeb128(write_pos, pc2dex[i].dex_pc - dex_pc);
+    native_pc_offset = pc2dex[i].native_pc_offset;
+    dex_pc = pc2dex[i].dex_pc;
+    if (MappingTable::NeedsPcToDexIndexEntry(i, pc2dex_entries)) {
+      index_pos = MappingTable::EncodePcToDexIndexEntry(index_pos, native_pc_offset, dex_pc,
+                                                        write_pos - pc2dex_start);
+    }
+  }
+  EXPECT_EQ(pc2dex_start, index_pos);
+  native_pc_offset = 0u;
+  dex_pc = 0u;
+  for (const MappingEntry& entry : dex2pc) {
+    write_pos = EncodeUnsignedLeb128(write_pos, entry.native_pc_offset - native_pc_offset);
+    write_pos = EncodeSignedLeb128(write_pos, entry.dex_pc - dex_pc);
+    native_pc_offset = entry.native_pc_offset;
+    dex_pc = entry.dex_pc;
+  }
+  data.resize(write_pos - &data[0]);
+  return data;
+}
+
+static void TestFindPcToDex(const std::vector<MappingEntry>& pc2dex) {
+  std::vector<MappingEntry> dex2pc;
+  dex2pc.push_back(MappingEntry { 3u, 100u });
+  std::vector<uint8_t> data = EncodeMappingTable(pc2dex, dex2pc);
+  MappingTable table(&data[0]);
+  ASSERT_EQ(pc2dex.size(), table.PcToDexSize());
+  ASSERT_EQ(1u, table.DexToPcSize());
+
+  // The iterators skip the index.
+  size_t i = 0;
+  for (auto it = table.PcToDexBegin(), end = table.PcToDexEnd(); it != end; ++it, ++i) {
+    EXPECT_EQ(pc2dex[i].native_pc_offset, it.NativePcOffset());
+    EXPECT_EQ(pc2dex[i].dex_pc, it.DexPc());
+  }
+  auto it2 = table.DexToPcBegin();
+  EXPECT_EQ(3u, it2.NativePcOffset());
+  EXPECT_EQ(100u, it2.DexPc());
+
+  // Every native pc offset maps to the dex pc of its first entry.
+  uint32_t max_native_pc_offset = pc2dex.empty() ? 0u : pc2dex.back().native_pc_offset;
+  for (uint32_t native_pc_offset = 0u; native_pc_offset <= max_native_pc_offset + 1u;
+       ++native_pc_offset) {
+    bool expected_found = false;
+    uint32_t expected_dex_pc = 0u;
+    for (const MappingEntry& entry : pc2dex) {
+      if (entry.native_pc_offset == native_pc_offset) {
+        expected_found = true;
+        expected_dex_pc = entry.dex_pc;
+        break;
+      }
+    }
+    uint32_t dex_pc = 0u;
+    ASSERT_EQ(expected_found, table.FindPcToDex(native_pc_offset, &dex_pc)) << native_pc_offset;
+    if (expected_found) {
+      EXPECT_EQ(expected_dex_pc, dex_pc) << native_pc_offset;
+    }
+  }
+}
+
+TEST(MappingTable, EmptyTable) {
+  MappingTable table(nullptr);
+  uint32_t dex_pc;
+  EXPECT_FALSE(table.FindPcToDex(0u, &dex_pc));
+  TestFindPcToDex(std::vector<MappingEntry>());
+}
+
+TEST(MappingTable, IndexSize) {
+  EXPECT_EQ(0u, MappingTable::PcToDexIndexSize(0u));
+  EXPECT_EQ(0u, MappingTable::PcToDexIndexSize(1u));
+  EXPECT_EQ(0u, MappingTable::PcToDexIndexSize(MappingTable::kPcToDexIndexInterval));
+  EXPECT_EQ(1u, MappingTable::PcToDexIndexSize(MappingTable::kPcToDexIndexInterval + 1u));
+  EXPECT_EQ(2u, MappingTable::PcToDexIndexSize(3u * MappingTable::kPcToDexIndexInterval));
+}
+
+TEST(MappingTable, FindPcToDex) {
+  for (uint32_t size : { 1u, 15u, 16u, 17u, 32u, 33u, 200u }) {
+    std::vector<MappingEntry> pc2dex;
+    for (uint32_t i = 0; i != size; ++i) {
+      // Dex pcs going backwards exercise the signed deltas.
+      pc2dex.push_back(MappingEntry { 4u * i + 2u, (i % 3u == 0u) ? 1000u - i : 7u * i });
+    }
+    TestFindPcToDex(pc2dex);
+  }
+}
+
+TEST(MappingTable, FindPcToDexDuplicates) {
+  // Entries sharing a native pc offset straddle the index boundaries.
+  std::vector<MappingEntry> pc2dex;
+  for (uint32_t i = 0; i != 100u; ++i) {
+    pc2dex.push_back(MappingEntry { 2u * (i / 5u), i });
+  }
+  TestFindPcToDex(pc2dex);
+}
+
+}  // namespace art
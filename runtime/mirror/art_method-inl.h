@@ -285,10 +285,39 @@ inline bool ArtMethod::IsResolutionMethod() {
 }
 
 inline bool ArtMethod::IsImtConflictMethod() {
-  bool result = this == Runtime::Current()->GetImtConflictMethod();
-  // Check that if we do think it is phony it looks like the imt conflict method.
-  DCHECK(!result || IsRuntimeMethod());
-  return result;
+  if (this == Runtime::Current()->GetImtConflictMethod()) {
+    // Check that if we do think it is phony it looks like the imt conflict method.
+    DCHECK(IsRuntimeMethod());
+    return true;
+  }
+  // No other runtime method has dex cache methods.
+  return IsRuntimeMethod() && HasDexCacheResolvedMethods();
+}
+
+inline ObjectArray<ArtMethod>* ArtMethod::GetImtConflictTable() {
+  DCHECK(IsImtConflictMethod());
+  return GetDexCacheResolvedMethods();
+}
+
+inline void ArtMethod::SetImtConflictTable(ObjectArray<ArtMethod>* table) {
+  DCHECK(IsRuntimeMethod());
+  DCHECK(table != nullptr);
+  DCHECK_EQ(table->GetLength() % 2, 0);
+  SetDexCacheResolvedMethods(table);
+}
+
+inline ArtMethod* ArtMethod::FindImtConflictTarget(ArtMethod* interface_method) {
+  ObjectArray<ArtMethod>* table = GetImtConflictTable();
+  if (table == nullptr) {
+    return nullptr;
+  }
+  // Tables only hold the few methods sharing a slot, a linear search is fastest.
+  for (int32_t i = 0, length = table->GetLength(); i < length; i += 2) {
+    if (table->GetWithoutChecks(i) == interface_method) {
+      return table->GetWithoutChecks(i + 1);
+    }
+  }
+  return nullptr;
 }
 
 inline uintptr_t ArtMethod::NativeQuickPcOffset(const uintptr_t pc) {
@@ -298,6 +327,9 @@ inline uintptr_t ArtMethod::NativeQuickPcOffset(const uintptr_t pc) {
 
 template<VerifyObjectFlags kVerifyFlags>
 inline void ArtMethod::SetNativeMethod(const void* native_method) {
+  // Read the flags directly, the image writer calls this on copies whose class isn't usable.
+  DCHECK_NE(GetField32<kVerifyFlags>(OFFSET_OF_OBJECT_MEMBER(ArtMethod, access_flags_)) &
+            kAccNative, 0u);
   SetFieldPtr<false, true, kVerifyFlags>(
       OFFSET_OF_OBJECT_MEMBER(ArtMethod, entry_point_from_jni_), native_method);
 }
@@ -348,7 +380,7 @@ inline const char* ArtMethod::GetName() {
   Runtime* runtime = Runtime::Current();
   if (method == runtime->GetResolutionMethod()) {
     return "<runtime internal resolution method>";
-  } else if (method == runtime->GetImtConflictMethod()) {
+  } else if (method->IsImtConflictMethod()) {
     return "<runtime internal imt conflict method>";
   } else if (method == runtime->GetCalleeSaveMethod(Runtime::kSaveAll)) {
     return "<runtime internal callee-save all registers method>";
@@ -20,6 +20,7 @@
 #include "art_field-inl.h"
 #include "art_method-inl.h"
 #include "base/stringpiece.h"
+#include "class_linker.h"
 #include "class-inl.h"
 #include "dex_file-inl.h"
 #include "dex_instruction.h"
@@ -174,8 +175,9 @@ uint32_t ArtMethod::ToDexPc(const uintptr_t pc, bool abort_on_failure) {
     return static_cast<uint32_t>(pc);
   }
   const void* entry_point = GetQuickOatEntryPoint();
-  MappingTable table(
-      entry_point != nullptr ? GetMappingTable(EntryPointToCodePointer(entry_point)) : nullptr);
+  const uint8_t* mapping_table =
+      entry_point != nullptr ? GetMappingTable(EntryPointToCodePointer(entry_point)) : nullptr;
+  MappingTable table(mapping_table);
   if (table.TotalSize() == 0) {
     // NOTE: Special methods (see Mir2Lir::GenSpecialCase()) have an empty mapping
     // but they have no suspend checks and, consequently, we never call ToDexPc() for them.
@@ -183,12 +185,17 @@ uint32_t ArtMethod::ToDexPc(const uintptr_t pc, bool abort_on_failure) {
     return DexFile::kDexNoIndex;   // Special no mapping case
   }
   uint32_t sought_offset = pc - reinterpret_cast<uintptr_t>(entry_point);
+  Thread* self = Thread::Current();
+  uint32_t dex_pc;
+  if (self != nullptr && self->LookupPcToDexCache(mapping_table, sought_offset, &dex_pc)) {
+    return dex_pc;
+  }
   // Assume the caller wants a pc-to-dex mapping so check here first.
-  typedef MappingTable::PcToDexIterator It;
-  for (It cur = table.PcToDexBegin(), end = table.PcToDexEnd(); cur != end; ++cur) {
-    if (cur.NativePcOffset() == sought_offset) {
-      return cur.DexPc();
+  if (table.FindPcToDex(sought_offset, &dex_pc)) {
+    if (self != nullptr) {
+      self->UpdatePcToDexCache(mapping_table, sought_offset, dex_pc);
     }
+    return dex_pc;
   }
   // Now check dex-to-pc mappings.
   typedef MappingTable::DexToPcIterator It2;
@@ -484,7 +491,7 @@ QuickMethodFrameInfo ArtMethod::GetQuickFrameInfo() {
 
 void ArtMethod::RegisterNative(const void* native_method, bool is_fast) {
   CHECK(IsNative()) << PrettyMethod(this);
-  CHECK(!IsFastNative()) << PrettyMethod(this);
+  // Note: the method may already be fast if it was annotated with @FastNative when loaded.
   CHECK(native_method != NULL) << PrettyMethod(this);
   if (is_fast) {
     SetAccessFlags(GetAccessFlags() | kAccFastNative);
@@ -493,7 +500,19 @@ void ArtMethod::RegisterNative(const void* native_method, bool is_fast) {
 }
 
 void ArtMethod::UnregisterNative() {
-  CHECK(IsNative() && !IsFastNative()) << PrettyMethod(this);
+  CHECK(IsNative()) << PrettyMethod(this);
+  // Drop the fast flag of a "!" signature given to RegisterNatives, but keep the one implied by
+  // a @FastNative annotation.
+  if (IsFastNative()) {
+    const DexFile* dex_file = GetDexFile();
+    const DexFile::ClassDef& class_def =
+        dex_file->GetClassDef(GetDeclaringClass()->GetDexClassDefIndex());
+    uint32_t annotation_flags = ClassLinker::GetNativeMethodAnnotationFlags(
+        *dex_file, class_def, GetDexMethodIndex(), GetAccessFlags());
+    if ((annotation_flags & kAccFastNative) == 0) {
+      SetAccessFlags(GetAccessFlags() & ~kAccFastNative);
+    }
+  }
   // restore stub to lookup native pointer via dlsym
   RegisterNative(GetJniDlsymLookupStub(), false);
 }
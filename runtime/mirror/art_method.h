@@ -33,6 +33,7 @@ struct ArtMethodOffsets;
 struct ConstructorMethodOffsets;
 union JValue;
 class MethodHelper;
+class MethodInlineCaches;
 class ScopedObjectAccessAlreadyRunnable;
 class StringPiece;
 class ShadowFrame;
@@ -132,6 +133,13 @@ class MANAGED ArtMethod FINAL : public Object {
     return (GetAccessFlags() & mask) == mask;
   }
 
+  // A critical native takes neither a JNIEnv* nor a jclass, only has primitive arguments and
+  // return value, and is called without any thread state transition.
+  bool IsCriticalNative() SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
+    uint32_t mask = kAccCriticalNative | kAccNative;
+    return (GetAccessFlags() & mask) == mask;
+  }
+
   bool IsAbstract() SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
     return (GetAccessFlags() & kAccAbstract) != 0;
   }
@@ -406,17 +414,35 @@ class MANAGED ArtMethod FINAL : public Object {
 
   void UnregisterNative() SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
 
+  // Only valid for native methods, the field holds the inline caches of other methods.
   static MemberOffset NativeMethodOffset() {
     return OFFSET_OF_OBJECT_MEMBER(ArtMethod, entry_point_from_jni_);
   }
 
+  // Only valid for native methods, see GetInlineCaches.
   const void* GetNativeMethod() SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
+    DCHECK(IsNative());
     return GetFieldPtr<const void*>(NativeMethodOffset());
   }
 
+  // Only valid for native methods, see GetInlineCaches.
   template<VerifyObjectFlags kVerifyFlags = kDefaultVerifyFlags>
   void SetNativeMethod(const void*) SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
 
+  // The interpreter's inline caches for the method. Only native methods use the JNI entrypoint,
+  // so other methods hold their inline caches there. The native method accessors check that
+  // the method is native so that the two uses of the field can't be mixed up.
+  MethodInlineCaches* GetInlineCaches() SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
+    DCHECK(!IsNative());
+    return GetFieldPtr<MethodInlineCaches*>(NativeMethodOffset());
+  }
+
+  void SetInlineCaches(MethodInlineCaches* inline_caches)
+      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
+    DCHECK(!IsNative());
+    SetFieldPtr<false>(NativeMethodOffset(), inline_caches);
+  }
+
   static MemberOffset GetMethodIndexOffset() {
     return OFFSET_OF_OBJECT_MEMBER(ArtMethod, method_index_);
   }
@@ -430,8 +456,23 @@ class MANAGED ArtMethod FINAL : public Object {
 
   bool IsResolutionMethod() SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
 
+  // Is this the runtime's imt conflict method or one of the conflict methods the class linker
+  // creates for the conflicting slots of an imt?
   bool IsImtConflictMethod() SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
 
+  // The conflict table of an imt conflict method holds pairs of an interface method sharing the
+  // slot and its implementation. Conflict methods are runtime methods, so the table is held in
+  // the dex cache methods field they otherwise don't use. The runtime's own conflict method has no
+  // table.
+  ObjectArray<ArtMethod>* GetImtConflictTable() SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
+  void SetImtConflictTable(ObjectArray<ArtMethod>* table)
+      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
+
+  // Look up the implementation of interface_method in the conflict table of this imt conflict
+  // method. Returns null if there is no table or the method is not in it.
+  ArtMethod* FindImtConflictTarget(ArtMethod* interface_method)
+      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
+
   uintptr_t NativeQuickPcOffset(const uintptr_t pc) SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
 #ifdef NDEBUG
   uintptr_t NativeQuickPcOffset(const uintptr_t pc, const void* quick_entry_point)
@@ -528,6 +569,7 @@ class MANAGED ArtMethod FINAL : public Object {
   uint64_t entry_point_from_interpreter_;
 
   // Pointer to JNI function registered to this method, or a function to resolve the JNI function.
+  // Holds the interpreter's MethodInlineCaches for non-native methods instead.
   uint64_t entry_point_from_jni_;
 
   // Method dispatch from portable compiled code invokes this pointer which may cause bridging into
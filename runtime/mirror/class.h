@@ -29,6 +29,10 @@
 #include "read_barrier_option.h"
 #include "utils.h"
 
+#ifndef IMT_SIZE
+#define IMT_SIZE 64
+#endif
+
 namespace art {
 
 struct ClassOffsets;
@@ -56,8 +60,9 @@ class MANAGED Class FINAL : public Object {
 
   // Interface method table size. Increasing this value reduces the chance of two interface methods
   // colliding in the interface method table but increases the size of classes that implement
-  // (non-marker) interfaces.
-  static constexpr size_t kImtSize = 64;
+  // (non-marker) interfaces. Set with ART_IMT_SIZE at build time, as it is part of the layout of
+  // classes in the image and of the code compiled against them.
+  static constexpr size_t kImtSize = IMT_SIZE;
 
   // imtable entry embedded in class object.
   struct MANAGED ImTableEntry {
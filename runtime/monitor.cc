@@ -16,6 +16,7 @@
 
 #include "monitor.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "base/mutex.h"
@@ -23,6 +24,7 @@
 #include "class_linker.h"
 #include "dex_file-inl.h"
 #include "dex_instruction.h"
+#include "lock_contention_profiler.h"
 #include "lock_word-inl.h"
 #include "mirror/art_method-inl.h"
 #include "mirror/class-inl.h"
@@ -89,7 +91,13 @@ Monitor::Monitor(Thread* self, Thread* owner, mirror::Object* obj, int32_t hash_
       hash_code_(hash_code),
       locking_method_(NULL),
       locking_dex_pc_(0),
-      monitor_id_(MonitorPool::ComputeMonitorId(this, self)) {
+      monitor_id_(MonitorPool::ComputeMonitorId(this, self)),
+      contention_count_(0),
+      spin_acquire_count_(0),
+      contention_wait_ns_(0),
+      acquire_time_ns_(0),
+      average_hold_time_ns_(0),
+      spin_limit_(kMinAdaptiveSpins) {
 #ifdef __LP64__
   DCHECK(false) << "Should not be reached in 64b";
   next_free_ = nullptr;
@@ -112,7 +120,13 @@ Monitor::Monitor(Thread* self, Thread* owner, mirror::Object* obj, int32_t hash_
       hash_code_(hash_code),
       locking_method_(NULL),
       locking_dex_pc_(0),
-      monitor_id_(id) {
+      monitor_id_(id),
+      contention_count_(0),
+      spin_acquire_count_(0),
+      contention_wait_ns_(0),
+      acquire_time_ns_(0),
+      average_hold_time_ns_(0),
+      spin_limit_(kMinAdaptiveSpins) {
 #ifdef __LP64__
   next_free_ = nullptr;
 #endif
@@ -140,7 +154,7 @@ bool Monitor::Install(Thread* self) {
   switch (lw.GetState()) {
     case LockWord::kThinLocked: {
       CHECK_EQ(owner_->GetThreadId(), lw.ThinLockOwner());
-      lock_count_ = lw.ThinLockCount();
+      lock_count_.StoreRelaxed(lw.ThinLockCount());
       break;
     }
     case LockWord::kHashCode: {
@@ -220,12 +234,82 @@ void Monitor::SetObject(mirror::Object* object) {
   obj_ = GcRoot<mirror::Object>(object);
 }
 
+bool Monitor::TryLockRecursive(Thread* self) {
+  if (owner_ != self) {
+    return false;
+  }
+  lock_count_.StoreRelaxed(lock_count_.LoadRelaxed() + 1);
+  return true;
+}
+
+bool Monitor::TryUnlockRecursive(Thread* self) {
+  if (owner_ != self || lock_count_.LoadRelaxed() == 0) {
+    return false;
+  }
+  lock_count_.StoreRelaxed(lock_count_.LoadRelaxed() - 1);
+  return true;
+}
+
+bool Monitor::SpinWhileOwned(Thread* self) {
+  const uint32_t spin_limit = spin_limit_;
+  for (uint32_t i = 0; i < spin_limit; ++i) {
+    // Don't hold up a suspension by spinning.
+    if (GetOwner() == nullptr || self->ReadFlag(kSuspendRequest)) {
+      break;
+    }
+    // As for thin locks, use sched_yield rather than a busy loop or NanoSleep.
+    sched_yield();
+  }
+  return GetOwner() == nullptr;
+}
+
+void Monitor::UpdateSpinLimit(bool spin_succeeded) {
+  if (spin_succeeded) {
+    spin_limit_ = (spin_limit_ * 2 <= kMaxAdaptiveSpins) ? spin_limit_ * 2 : kMaxAdaptiveSpins;
+    ++spin_acquire_count_;
+  } else {
+    spin_limit_ = (spin_limit_ / 2 >= kMinAdaptiveSpins) ? spin_limit_ / 2 : kMinAdaptiveSpins;
+  }
+}
+
+void Monitor::RecordRelease() {
+  if (acquire_time_ns_ != 0) {
+    uint64_t hold_time_ns = NanoTime() - acquire_time_ns_;
+    // Exponential moving average weighting the latest hold time by 1/8.
+    average_hold_time_ns_ = (average_hold_time_ns_ * 7 + hold_time_ns) / 8;
+    acquire_time_ns_ = 0;
+  }
+}
+
+void Monitor::DumpContention(std::ostream& os) {
+  // Same format as the locks in thread dumps, so that the two can be matched up.
+  mirror::Object* obj = GetObject();
+  os << StringPrintf("  <0x%08x> (a %s)", GetHashCode(), PrettyTypeOf(obj).c_str())
+     << " contended " << contention_count_ << " times, "
+     << spin_acquire_count_ << " acquired by spinning, "
+     << PrettyDuration(contention_wait_ns_) << " total wait, "
+     << PrettyDuration(average_hold_time_ns_) << " average hold\n";
+}
+
 void Monitor::Lock(Thread* self) {
+  if (TryLockRecursive(self)) {
+    return;
+  }
   MutexLock mu(self, monitor_lock_);
+  bool contended = false;
+  bool spun = false;
+  uint64_t wait_start_ns = 0;
   while (true) {
     if (owner_ == nullptr) {  // Unowned.
       owner_ = self;
-      CHECK_EQ(lock_count_, 0);
+      CHECK_EQ(lock_count_.LoadRelaxed(), 0);
+      if (contended) {
+        contention_wait_ns_ += NanoTime() - wait_start_ns;
+      }
+      // Only time how long the lock is held once it has been contended.
+      if (contention_count_ != 0) {
+        acquire_time_ns_ = NanoTime();
+      }
       // When debugging, save the current monitor holder for future
       // acquisition failures to use in sampled logging.
       if (lock_profiling_threshold_ != 0) {
@@ -233,12 +317,31 @@ void Monitor::Lock(Thread* self) {
       }
       return;
     } else if (owner_ == self) {  // Recursive.
-      lock_count_++;
+      lock_count_.StoreRelaxed(lock_count_.LoadRelaxed() + 1);
       return;
     }
     // Contended.
+    if (!contended) {
+      contended = true;
+      ++contention_count_;
+      wait_start_ns = NanoTime();
+    }
+    // Spin first if the owner usually releases the lock quickly, on the first contention the
+    // average is still 0 so spinning is tried.
+    if (!spun && average_hold_time_ns_ < kMaxSpinHoldTimeNs) {
+      spun = true;
+      // As when blocking, count ourselves as a waiter so that we don't get deflated.
+      ++num_waiters_;
+      monitor_lock_.Unlock(self);
+      bool spin_succeeded = SpinWhileOwned(self);
+      monitor_lock_.Lock(self);
+      --num_waiters_;
+      UpdateSpinLimit(spin_succeeded && owner_ == nullptr);
+      continue;
+    }
     const bool log_contention = (lock_profiling_threshold_ != 0);
-    uint64_t wait_start_ms = log_contention ? MilliTime() : 0;
+    uint64_t log_wait_start_ns = log_contention ? NanoTime() : 0;
+    uint64_t wait_ns = 0;
     mirror::ArtMethod* owners_method = locking_method_;
     uint32_t owners_dex_pc = locking_dex_pc_;
     // Do this before releasing the lock so that we don't get deflated.
@@ -252,7 +355,8 @@ void Monitor::Lock(Thread* self) {
         monitor_contenders_.Wait(self);  // Still contended so wait.
         // Woken from contention.
         if (log_contention) {
-          uint64_t wait_ms = MilliTime() - wait_start_ms;
+          wait_ns = NanoTime() - log_wait_start_ns;
+          uint64_t wait_ms = wait_ns / MsToNs(1);
           uint32_t sample_percent;
           if (wait_ms >= lock_profiling_threshold_) {
             sample_percent = 100;
@@ -269,6 +373,16 @@ void Monitor::Lock(Thread* self) {
       }
     }
     self->SetMonitorEnterObject(nullptr);
+    if (wait_ns != 0) {
+      // Back to runnable so the call sites can be named. This waiter's dex pc is only looked up
+      // once it actually waited, the owner's was recorded when it acquired the lock.
+      LockContentionProfiler* profiler = Runtime::Current()->GetLockContentionProfiler();
+      if (profiler != nullptr) {
+        uint32_t dex_pc;
+        mirror::ArtMethod* method = self->GetCurrentMethod(&dex_pc, false);
+        profiler->AddContention(self, owners_method, owners_dex_pc, method, dex_pc, wait_ns);
+      }
+    }
     monitor_lock_.Lock(self);  // Reacquire locks in order.
     --num_waiters_;
   }
@@ -364,18 +478,22 @@ void Monitor::FailedUnlock(mirror::Object* o, Thread* expected_owner, Thread* fo
 
 bool Monitor::Unlock(Thread* self) {
   DCHECK(self != NULL);
+  if (TryUnlockRecursive(self)) {
+    return true;
+  }
   MutexLock mu(self, monitor_lock_);
   Thread* owner = owner_;
   if (owner == self) {
     // We own the monitor, so nobody else can be in here.
-    if (lock_count_ == 0) {
+    if (lock_count_.LoadRelaxed() == 0) {
+      RecordRelease();
       owner_ = NULL;
       locking_method_ = NULL;
       locking_dex_pc_ = 0;
       // Wake a contender.
       monitor_contenders_.Signal(self);
     } else {
-      --lock_count_;
+      lock_count_.StoreRelaxed(lock_count_.LoadRelaxed() - 1);
     }
   } else {
     // We don't own this, so we're not allowed to unlock it.
@@ -428,8 +546,9 @@ void Monitor::Wait(Thread* self, int64_t ms, int32_t ns,
    */
   AppendToWaitSet(self);
   ++num_waiters_;
-  int prev_lock_count = lock_count_;
-  lock_count_ = 0;
+  int prev_lock_count = lock_count_.LoadRelaxed();
+  lock_count_.StoreRelaxed(0);
+  RecordRelease();
   owner_ = NULL;
   mirror::ArtMethod* saved_method = locking_method_;
   locking_method_ = NULL;
@@ -501,7 +620,7 @@ void Monitor::Wait(Thread* self, int64_t ms, int32_t ns,
    * updates is not order sensitive as we hold the pthread mutex.
    */
   owner_ = self;
-  lock_count_ = prev_lock_count;
+  lock_count_.StoreRelaxed(prev_lock_count);
   locking_method_ = saved_method;
   locking_dex_pc_ = saved_dex_pc;
   --num_waiters_;
@@ -588,13 +707,14 @@ bool Monitor::Deflate(Thread* self, mirror::Object* obj) {
         return false;
       }
       // Can't deflate if our lock count is too high.
-      if (monitor->lock_count_ > LockWord::kThinLockMaxCount) {
+      if (monitor->lock_count_.LoadRelaxed() > LockWord::kThinLockMaxCount) {
         return false;
       }
       // Deflate to a thin lock.
-      obj->SetLockWord(LockWord::FromThinLockId(owner->GetThreadId(), monitor->lock_count_), false);
+      obj->SetLockWord(LockWord::FromThinLockId(owner->GetThreadId(),
+                                                monitor->lock_count_.LoadRelaxed()), false);
       VLOG(monitor) << "Deflated " << obj << " to thin lock " << owner->GetTid() << " / "
-          << monitor->lock_count_;
+          << monitor->lock_count_.LoadRelaxed();
     } else if (monitor->HasHashCode()) {
       obj->SetLockWord(LockWord::FromHashCode(monitor->GetHashCode()), false);
       VLOG(monitor) << "Deflated " << obj << " to hash monitor " << monitor->GetHashCode();
@@ -1092,6 +1212,30 @@ void MonitorList::AllowNewMonitors() {
   monitor_add_condition_.Broadcast(self);
 }
 
+void MonitorList::DumpForSigQuit(std::ostream& os) {
+  static constexpr size_t kMaxDumpedMonitors = 10;
+  Thread* self = Thread::Current();
+  ScopedObjectAccess soa(self);
+  MutexLock mu(self, monitor_list_lock_);
+  // Snapshot the counts as they keep changing while we sort.
+  std::vector<std::pair<uint32_t, Monitor*>> contended;
+  for (Monitor* m : list_) {
+    uint32_t contention_count = m->GetContentionCount();
+    // Skip deflated monitors.
+    if (contention_count != 0 && m->GetObject() != nullptr) {
+      contended.push_back(std::make_pair(contention_count, m));
+    }
+  }
+  os << "Monitors: " << list_.size() << " inflated, " << contended.size() << " contended\n";
+  std::sort(contended.begin(), contended.end(),
+            [](const std::pair<uint32_t, Monitor*>& lhs, const std::pair<uint32_t, Monitor*>& rhs) {
+    return lhs.first > rhs.first;
+  });
+  for (size_t i = 0; i < contended.size() && i < kMaxDumpedMonitors; ++i) {
+    contended[i].second->DumpContention(os);
+  }
+}
+
 void MonitorList::Add(Monitor* m) {
   Thread* self = Thread::Current();
   MutexLock mu(self, monitor_list_lock_);
@@ -1165,7 +1309,7 @@ MonitorInfo::MonitorInfo(mirror::Object* obj) : owner_(NULL), entry_count_(0) {
     case LockWord::kFatLocked: {
       Monitor* mon = lock_word.FatLockMonitor();
       owner_ = mon->owner_;
-      entry_count_ = 1 + mon->lock_count_;
+      entry_count_ = 1 + mon->lock_count_.LoadRelaxed();
       for (Thread* waiter = mon->wait_set_; waiter != NULL; waiter = waiter->GetWaitNext()) {
         waiters_.push_back(waiter);
       }
@@ -51,6 +51,15 @@ class Monitor {
   // a lock word. See Runtime::max_spins_before_thin_lock_inflation_.
   constexpr static size_t kDefaultMaxSpinsBeforeThinLockInflation = 50;
 
+  // Bounds of the adaptive number of yields a contender on an inflated lock does, waiting for the
+  // owner to release it, before blocking on the monitor. See Monitor::spin_limit_.
+  constexpr static uint32_t kMinAdaptiveSpins = 2;
+  constexpr static uint32_t kMaxAdaptiveSpins = 64;
+
+  // Contenders only spin while the average hold time of the lock is below this threshold, longer
+  // critical sections are better served by blocking straight away.
+  constexpr static uint64_t kMaxSpinHoldTimeNs = 50 * 1000;
+
   ~Monitor();
 
   static bool IsSensitiveThread();
@@ -122,6 +131,11 @@ class Monitor {
     return monitor_id_;
   }
 
+  // Number of times a thread found the monitor owned by another thread when trying to lock it.
+  uint32_t GetContentionCount() const NO_THREAD_SAFETY_ANALYSIS {
+    return contention_count_;
+  }
+
   // Inflate the lock on obj. May fail to inflate for spurious reasons, always re-check.
   static void InflateThinLocked(Thread* self, Handle<mirror::Object> obj, LockWord lock_word,
                                 uint32_t hash_code) NO_THREAD_SAFETY_ANALYSIS;
@@ -171,6 +185,26 @@ class Monitor {
       LOCKS_EXCLUDED(monitor_lock_)
       SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
 
+  // Recursive locking and unlocking by the owner, which doesn't need monitor_lock_ as no other
+  // thread can change owner_ away from the owner. Return false if self isn't the owner or, for
+  // unlocking, if this is the outermost unlock.
+  bool TryLockRecursive(Thread* self) NO_THREAD_SAFETY_ANALYSIS;
+  bool TryUnlockRecursive(Thread* self) NO_THREAD_SAFETY_ANALYSIS;
+
+  // Yield while the monitor is owned, for at most spin_limit_ iterations. Returns true if the
+  // owner released the monitor in the meantime.
+  bool SpinWhileOwned(Thread* self) LOCKS_EXCLUDED(monitor_lock_);
+
+  // Adapt spin_limit_ to whether spinning paid off for the last contender.
+  void UpdateSpinLimit(bool spin_succeeded) EXCLUSIVE_LOCKS_REQUIRED(monitor_lock_);
+
+  // Update the running average hold time when the owner releases the monitor.
+  void RecordRelease() EXCLUSIVE_LOCKS_REQUIRED(monitor_lock_);
+
+  // Print the contention statistics of this monitor, read without monitor_lock_ so they may be
+  // slightly inconsistent.
+  void DumpContention(std::ostream& os) NO_THREAD_SAFETY_ANALYSIS;
+
   static void DoNotify(Thread* self, mirror::Object* obj, bool notify_all)
       SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
 
@@ -226,8 +260,9 @@ class Monitor {
   // Which thread currently owns the lock?
   Thread* volatile owner_ GUARDED_BY(monitor_lock_);
 
-  // Owner's recursive lock depth.
-  int lock_count_ GUARDED_BY(monitor_lock_);
+  // Owner's recursive lock depth. Only changed by the owner, which doesn't take monitor_lock_ for
+  // recursive locking and unlocking, so other threads must read it atomically.
+  Atomic<int32_t> lock_count_;
 
   // What object are we part of. This is a weak root. Do not access
   // this directly, use GetObject() to read it so it will be guarded
@@ -249,6 +284,21 @@ class Monitor {
   // The denser encoded version of this monitor as stored in the lock word.
   MonitorId monitor_id_;
 
+  // Contention statistics, reported in the SIGQUIT dump. contention_count_ also gates the hold
+  // time tracking as an uncontended monitor has no use for it.
+  uint32_t contention_count_ GUARDED_BY(monitor_lock_);
+  uint32_t spin_acquire_count_ GUARDED_BY(monitor_lock_);
+  uint64_t contention_wait_ns_ GUARDED_BY(monitor_lock_);
+
+  // When the current owner acquired the monitor, or 0 if not tracked, and a running average of how
+  // long owners held the monitor. Contenders spin rather than block on short critical sections.
+  uint64_t acquire_time_ns_ GUARDED_BY(monitor_lock_);
+  uint64_t average_hold_time_ns_ GUARDED_BY(monitor_lock_);
+
+  // Number of yields a contender does before blocking. Doubled when spinning got the lock, halved
+  // when it didn't. Read racily by the spinning thread.
+  uint32_t spin_limit_ GUARDED_BY(monitor_lock_);
+
 #ifdef __LP64__
   // Free list for monitor pool.
   Monitor* next_free_ GUARDED_BY(Locks::allocated_monitor_ids_lock_);
@@ -257,6 +307,7 @@ class Monitor {
   friend class MonitorInfo;
   friend class MonitorList;
   friend class MonitorPool;
+  friend class MonitorTest;  // For the contention statistics and spin_limit_.
   friend class mirror::Object;
   DISALLOW_COPY_AND_ASSIGN(Monitor);
 };
@@ -271,6 +322,8 @@ class MonitorList {
   void SweepMonitorList(IsMarkedCallback* callback, void* arg)
       LOCKS_EXCLUDED(monitor_list_lock_) SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
   void DisallowNewMonitors() LOCKS_EXCLUDED(monitor_list_lock_);
+  // Dump the most contended monitors.
+  void DumpForSigQuit(std::ostream& os) LOCKS_EXCLUDED(monitor_list_lock_);
   void AllowNewMonitors() LOCKS_EXCLUDED(monitor_list_lock_);
   // Returns how many monitors were deflated.
   size_t DeflateMonitors() LOCKS_EXCLUDED(monitor_list_lock_)
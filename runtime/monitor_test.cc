@@ -18,6 +18,7 @@
 #include "monitor.h"
 
 #include <string>
+#include <vector>
 
 #include "atomic.h"
 #include "common_runtime_test.h"
@@ -41,6 +42,29 @@ class MonitorTest : public CommonRuntimeTest {
     }
     options->push_back(std::make_pair("-Xint", nullptr));
   }
+
+  // Accessors for the contention statistics and spin limit of an inflated lock.
+  static uint32_t GetSpinAcquireCount(Thread* self, Monitor* monitor) {
+    MutexLock mu(self, monitor->monitor_lock_);
+    return monitor->spin_acquire_count_;
+  }
+  static uint64_t GetContentionWaitNs(Thread* self, Monitor* monitor) {
+    MutexLock mu(self, monitor->monitor_lock_);
+    return monitor->contention_wait_ns_;
+  }
+  static uint64_t GetAverageHoldTimeNs(Thread* self, Monitor* monitor) {
+    MutexLock mu(self, monitor->monitor_lock_);
+    return monitor->average_hold_time_ns_;
+  }
+  static uint32_t GetSpinLimit(Thread* self, Monitor* monitor) {
+    MutexLock mu(self, monitor->monitor_lock_);
+    return monitor->spin_limit_;
+  }
+  static void SetSpinLimit(Thread* self, Monitor* monitor, uint32_t spin_limit) {
+    MutexLock mu(self, monitor->monitor_lock_);
+    monitor->spin_limit_ = spin_limit;
+  }
+
  public:
   std::unique_ptr<Monitor> monitor_;
   Handle<mirror::String> object_;
@@ -378,4 +402,213 @@ TEST_F(MonitorTest, CheckExceptionsWait3) {
                   "Monitor test thread pool 3");
 }
 
+// Recursive locking of an inflated lock by its owner.
+TEST_F(MonitorTest, RecursiveInflatedLock) {
+  Thread* self = Thread::Current();
+  ScopedObjectAccess soa(self);
+  StackHandleScope<1> hs(self);
+  Handle<mirror::String> obj(
+      hs.NewHandle(mirror::String::AllocFromModifiedUtf8(self, "hello, world!")));
+
+  obj->MonitorEnter(self);
+  // Getting the identity hash code of a thin locked object inflates its lock.
+  obj->IdentityHashCode();
+  LockWord lock_word = obj->GetLockWord(true);
+  ASSERT_EQ(LockWord::kFatLocked, lock_word.GetState());
+  Monitor* monitor = lock_word.FatLockMonitor();
+  EXPECT_EQ(self, monitor->GetOwner());
+
+  obj->MonitorEnter(self);
+  obj->MonitorEnter(self);
+  EXPECT_EQ(self, monitor->GetOwner());
+  EXPECT_TRUE(obj->MonitorExit(self));
+  EXPECT_TRUE(obj->MonitorExit(self));
+  EXPECT_EQ(self, monitor->GetOwner());
+  EXPECT_TRUE(obj->MonitorExit(self));
+  EXPECT_EQ(nullptr, monitor->GetOwner());
+
+  // Unlocking once more throws.
+  EXPECT_FALSE(obj->MonitorExit(self));
+  EXPECT_TRUE(self->IsExceptionPending());
+  self->ClearException();
+
+  // No other thread ever wanted the lock.
+  EXPECT_EQ(0U, monitor->GetContentionCount());
+}
+
+// Lock obj and inflate its lock, returning the monitor. Leaves obj unlocked.
+static Monitor* InflateLock(Thread* self, Handle<mirror::String> obj)
+    SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
+  obj->MonitorEnter(self);
+  // Getting the identity hash code of a thin locked object inflates its lock.
+  obj->IdentityHashCode();
+  LockWord lock_word = obj->GetLockWord(true);
+  CHECK_EQ(LockWord::kFatLocked, lock_word.GetState());
+  CHECK(obj->MonitorExit(self));
+  return lock_word.FatLockMonitor();
+}
+
+static constexpr size_t kContendedRounds = 3;
+
+// Takes the lock of object_ once per round, while the test thread holds it.
+class ContendTask : public Task {
+ public:
+  ContendTask(MonitorTest* monitor_test, std::vector<std::unique_ptr<Barrier>>* start_barriers,
+              std::vector<std::unique_ptr<Barrier>>* done_barriers)
+      : monitor_test_(monitor_test), start_barriers_(start_barriers),
+        done_barriers_(done_barriers) {}
+
+  void Run(Thread* self) {
+    for (size_t round = 0; round < kContendedRounds; ++round) {
+      (*start_barriers_)[round]->Wait(self);  // Wait for the test thread to hold the lock.
+      {
+        ScopedObjectAccess soa(self);
+        monitor_test_->object_.Get()->MonitorEnter(self);
+        monitor_test_->object_.Get()->MonitorExit(self);
+      }
+      (*done_barriers_)[round]->Wait(self);
+    }
+  }
+
+  void Finalize() {
+    delete this;
+  }
+
+ private:
+  MonitorTest* monitor_test_;
+  std::vector<std::unique_ptr<Barrier>>* start_barriers_;
+  std::vector<std::unique_ptr<Barrier>>* done_barriers_;
+};
+
+// Contention on a lock held for long: the contender spins in vain while the hold time isn't known,
+// which shrinks the spin limit, and then blocks straight away.
+TEST_F(MonitorTest, ContendedInflatedLockSpinning) {
+  Thread* self = Thread::Current();
+  StackHandleScope<1> hs(self);
+  Monitor* monitor;
+  {
+    ScopedObjectAccess soa(self);
+    object_ = hs.NewHandle(mirror::String::AllocFromModifiedUtf8(self, "hello, world!"));
+    monitor = InflateLock(self, object_);
+  }
+  // Start from the largest spin limit so that every failed spin shows.
+  SetSpinLimit(self, monitor, Monitor::kMaxAdaptiveSpins);
+
+  std::vector<std::unique_ptr<Barrier>> start_barriers;
+  std::vector<std::unique_ptr<Barrier>> done_barriers;
+  for (size_t round = 0; round < kContendedRounds; ++round) {
+    start_barriers.push_back(std::unique_ptr<Barrier>(new Barrier(2)));
+    done_barriers.push_back(std::unique_ptr<Barrier>(new Barrier(2)));
+  }
+  ThreadPool thread_pool("Monitor contention test thread pool", 1);
+  thread_pool.AddTask(self, new ContendTask(this, &start_barriers, &done_barriers));
+  thread_pool.StartWorkers(self);
+
+  uint32_t spin_limits[kContendedRounds];
+  for (size_t round = 0; round < kContendedRounds; ++round) {
+    {
+      ScopedObjectAccess soa(self);
+      object_.Get()->MonitorEnter(self);
+    }  // Need to drop the mutator lock to use the barrier.
+    start_barriers[round]->Wait(self);
+    // Hold the lock until the other thread has contended it, and long after.
+    while (monitor->GetContentionCount() <= round) {
+      sched_yield();
+    }
+    NanoSleep(20 * 1000 * 1000);
+    {
+      ScopedObjectAccess soa(self);
+      EXPECT_TRUE(object_.Get()->MonitorExit(self));
+    }
+    done_barriers[round]->Wait(self);
+    spin_limits[round] = GetSpinLimit(self, monitor);
+  }
+  thread_pool.Wait(self, false, false);
+
+  EXPECT_EQ(kContendedRounds, monitor->GetContentionCount());
+  EXPECT_EQ(0U, GetSpinAcquireCount(self, monitor));
+  EXPECT_GE(GetContentionWaitNs(self, monitor), 20U * 1000 * 1000);
+  // The first hold tracked is the test thread's in the second round, as the first was taken before
+  // the monitor was contended.
+  EXPECT_GE(GetAverageHoldTimeNs(self, monitor), Monitor::kMaxSpinHoldTimeNs);
+  // The first two contenders spun and failed, the last one saw the long hold time and didn't spin.
+  EXPECT_EQ(Monitor::kMaxAdaptiveSpins / 2, spin_limits[0]);
+  EXPECT_EQ(Monitor::kMaxAdaptiveSpins / 4, spin_limits[1]);
+  EXPECT_EQ(Monitor::kMaxAdaptiveSpins / 4, spin_limits[2]);
+  EXPECT_EQ(nullptr, monitor->GetOwner());
+}
+
+static constexpr size_t kHammerIterations = 2000;
+
+// Repeatedly takes the lock of object_, recursively, and increments a counter under it.
+class HammerTask : public Task {
+ public:
+  HammerTask(MonitorTest* monitor_test, size_t* counter)
+      : monitor_test_(monitor_test), counter_(counter) {}
+
+  void Run(Thread* self) {
+    ScopedObjectAccess soa(self);
+    mirror::String* obj = monitor_test_->object_.Get();
+    for (size_t i = 0; i < kHammerIterations; ++i) {
+      obj->MonitorEnter(self);
+      obj->MonitorEnter(self);
+      // Not atomic: the lock is what keeps increments from being lost.
+      size_t count = *counter_;
+      if ((i % 16) == 0) {
+        sched_yield();
+      }
+      *counter_ = count + 1;
+      obj->MonitorExit(self);
+      obj->MonitorExit(self);
+    }
+  }
+
+  void Finalize() {
+    delete this;
+  }
+
+ private:
+  MonitorTest* monitor_test_;
+  size_t* counter_;
+};
+
+// Many threads contending for a lock with short critical sections.
+TEST_F(MonitorTest, ContendedInflatedLockCounters) {
+  static constexpr size_t kNumThreads = 4;
+  Thread* self = Thread::Current();
+  StackHandleScope<1> hs(self);
+  Monitor* monitor;
+  {
+    ScopedObjectAccess soa(self);
+    object_ = hs.NewHandle(mirror::String::AllocFromModifiedUtf8(self, "hello, world!"));
+    monitor = InflateLock(self, object_);
+  }
+
+  size_t counter = 0;
+  ThreadPool thread_pool("Monitor hammer test thread pool", kNumThreads);
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    thread_pool.AddTask(self, new HammerTask(this, &counter));
+  }
+  thread_pool.StartWorkers(self);
+  thread_pool.Wait(self, false, false);
+
+  ScopedObjectAccess soa(self);
+  EXPECT_EQ(kNumThreads * kHammerIterations, counter);
+  // The lock stays inflated, and is free.
+  LockWord lock_word = object_->GetLockWord(true);
+  ASSERT_EQ(LockWord::kFatLocked, lock_word.GetState());
+  EXPECT_EQ(monitor, lock_word.FatLockMonitor());
+  EXPECT_EQ(nullptr, monitor->GetOwner());
+  // Every acquisition by spinning follows a contention, and recursive acquisitions never contend.
+  uint32_t contention_count = monitor->GetContentionCount();
+  EXPECT_LE(contention_count, kNumThreads * kHammerIterations);
+  EXPECT_LE(GetSpinAcquireCount(self, monitor), contention_count);
+  if (contention_count != 0) {
+    EXPECT_NE(0U, GetContentionWaitNs(self, monitor));
+  }
+  uint32_t spin_limit = GetSpinLimit(self, monitor);
+  EXPECT_GE(spin_limit, Monitor::kMinAdaptiveSpins);
+  EXPECT_LE(spin_limit, Monitor::kMaxAdaptiveSpins);
+}
+
 }  // namespace art
@@ -185,10 +185,10 @@ static jclass DexFile_defineClassNative(JNIEnv* env, jclass, jstring javaName, j
     if (dex_class_def != nullptr) {
       ScopedObjectAccess soa(env);
       ClassLinker* class_linker = Runtime::Current()->GetClassLinker();
-      class_linker->RegisterDexFile(*dex_file);
       StackHandleScope<1> hs(soa.Self());
       Handle<mirror::ClassLoader> class_loader(
           hs.NewHandle(soa.Decode<mirror::ClassLoader*>(javaLoader)));
+      class_linker->RegisterDexFile(*dex_file, class_loader);
       mirror::Class* result = class_linker->DefineClass(soa.Self(), descriptor.c_str(),
                                                         class_loader, *dex_file, *dex_class_def);
       if (result != nullptr) {
@@ -33,6 +33,7 @@
 #include "mirror/object-inl.h"
 #include "os.h"
 #include "runtime.h"
+#include "type_lookup_table.h"
 #include "utils.h"
 #include "vmap_table.h"
 
@@ -300,6 +301,15 @@ bool OatFile::Setup(std::string* error_msg) {
       return false;
     }
 
+    uint32_t lookup_table_offset = *reinterpret_cast<const uint32_t*>(oat);
+    oat += sizeof(lookup_table_offset);
+    if (UNLIKELY(oat > End())) {
+      *error_msg = StringPrintf("In oat file '%s' found OatDexFile #%zd for '%s' truncated "
+                                " after lookup table offset", GetLocation().c_str(), i,
+                                dex_file_location.c_str());
+      return false;
+    }
+
     const uint8_t* dex_file_pointer = Begin() + dex_file_offset;
     if (UNLIKELY(!DexFile::IsMagicValid(dex_file_pointer))) {
       *error_msg = StringPrintf("In oat file '%s' found OatDexFile #%zd for '%s' with invalid "
@@ -314,6 +324,22 @@ bool OatFile::Setup(std::string* error_msg) {
       return false;
     }
     const DexFile::Header* header = reinterpret_cast<const DexFile::Header*>(dex_file_pointer);
+
+    const uint8_t* lookup_table_data = nullptr;
+    if (lookup_table_offset != 0U) {
+      if (UNLIKELY(!TypeLookupTable::SupportedSize(header->class_defs_size_) ||
+                   !IsAligned<4>(lookup_table_offset) ||
+                   lookup_table_offset > Size() ||
+                   TypeLookupTable::RawDataLength(header->class_defs_size_) >
+                       Size() - lookup_table_offset)) {
+        *error_msg = StringPrintf("In oat file '%s' found OatDexFile #%zd for '%s' with invalid "
+                                  "lookup table offset %u", GetLocation().c_str(), i,
+                                  dex_file_location.c_str(), lookup_table_offset);
+        return false;
+      }
+      lookup_table_data = Begin() + lookup_table_offset;
+    }
+
     const uint32_t* methods_offsets_pointer = reinterpret_cast<const uint32_t*>(oat);
 
     oat += (sizeof(*methods_offsets_pointer) * header->class_defs_size_);
@@ -332,6 +358,7 @@ bool OatFile::Setup(std::string* error_msg) {
                                               canonical_location,
                                               dex_file_checksum,
                                               dex_file_pointer,
+                                              lookup_table_data,
                                               methods_offsets_pointer);
     oat_dex_files_storage_.push_back(oat_dex_file);
 
@@ -437,12 +464,14 @@ OatFile::OatDexFile::OatDexFile(const OatFile* oat_file,
                                 const std::string& canonical_dex_file_location,
                                 uint32_t dex_file_location_checksum,
                                 const uint8_t* dex_file_pointer,
+                                const uint8_t* lookup_table_data,
                                 const uint32_t* oat_class_offsets_pointer)
     : oat_file_(oat_file),
       dex_file_location_(dex_file_location),
       canonical_dex_file_location_(canonical_dex_file_location),
       dex_file_location_checksum_(dex_file_location_checksum),
       dex_file_pointer_(dex_file_pointer),
+      lookup_table_data_(lookup_table_data),
       oat_class_offsets_pointer_(oat_class_offsets_pointer) {}
 
 OatFile::OatDexFile::~OatDexFile() {}
@@ -453,7 +482,7 @@ size_t OatFile::OatDexFile::FileSize() const {
 
 const DexFile* OatFile::OatDexFile::OpenDexFile(std::string* error_msg) const {
   return DexFile::Open(dex_file_pointer_, FileSize(), dex_file_location_,
-                       dex_file_location_checksum_, error_msg);
+                       dex_file_location_checksum_, lookup_table_data_, error_msg);
 }
 
 uint32_t OatFile::OatDexFile::GetOatClassOffset(uint16_t class_def_index) const {
@@ -244,6 +244,11 @@ class OatFile {
     // Returns the size of the DexFile refered to by this OatDexFile.
     size_t FileSize() const;
 
+    // Returns the start of the DexFile refered to by this OatDexFile, within the oat file.
+    const uint8_t* GetDexFilePointer() const {
+      return dex_file_pointer_;
+    }
+
     // Returns original path of DexFile that was the source of this OatDexFile.
     const std::string& GetDexFileLocation() const {
       return dex_file_location_;
@@ -262,6 +267,11 @@ class OatFile {
     // Returns the OatClass for the class specified by the given DexFile class_def_index.
     OatClass GetOatClass(uint16_t class_def_index) const;
 
+    // Returns the raw data of the TypeLookupTable of the DexFile, nullptr if there is none.
+    const uint8_t* GetLookupTableData() const {
+      return lookup_table_data_;
+    }
+
     // Returns the offset to the OatClass information. Most callers should use GetOatClass.
     uint32_t GetOatClassOffset(uint16_t class_def_index) const;
 
@@ -273,6 +283,7 @@ class OatFile {
                const std::string& canonical_dex_file_location,
                uint32_t dex_file_checksum,
                const uint8_t* dex_file_pointer,
+               const uint8_t* lookup_table_data,
                const uint32_t* oat_class_offsets_pointer);
 
     const OatFile* const oat_file_;
@@ -280,6 +291,7 @@ class OatFile {
     const std::string canonical_dex_file_location_;
     const uint32_t dex_file_location_checksum_;
     const uint8_t* const dex_file_pointer_;
+    const uint8_t* const lookup_table_data_;
     const uint32_t* const oat_class_offsets_pointer_;
 
     friend class OatFile;
@@ -27,6 +27,7 @@
 #include "gc/heap.h"
 #include "monitor.h"
 #include "runtime.h"
+#include "thread.h"
 #include "trace.h"
 #include "utils.h"
 
@@ -41,6 +42,7 @@ ParsedOptions::ParsedOptions()
     compiler_callbacks_(nullptr),
     is_zygote_(false),
     must_relocate_(kDefaultMustRelocate),
+    relocate_in_memory_(false),
     dex2oat_enabled_(true),
     image_dex2oat_enabled_(true),
     interpreter_only_(kPoisonHeapReferences),       // kPoisonHeapReferences currently works with
@@ -92,6 +94,7 @@ ParsedOptions::ParsedOptions()
                                                     // normal collector transition.
     stack_size_(0),                                 // 0 means default.
     max_spins_before_thin_lock_inflation_(Monitor::kDefaultMaxSpinsBeforeThinLockInflation),
+    max_stack_trace_depth_(Thread::kDefaultMaxStackTraceDepth),
     low_memory_mode_(false),
     lock_profiling_threshold_(0),
     method_trace_(false),
@@ -393,6 +396,10 @@ bool ParsedOptions::Parse(const RuntimeOptions& options, bool ignore_unrecognize
       if (!ParseUnsignedInteger(option, '=', &max_spins_before_thin_lock_inflation_)) {
         return false;
       }
+    } else if (StartsWith(option, "-XX:MaxStackTraceDepth=")) {
+      if (!ParseUnsignedInteger(option, '=', &max_stack_trace_depth_)) {
+        return false;
+      }
     } else if (StartsWith(option, "-XX:LongPauseLogThreshold=")) {
       unsigned int value;
       if (!ParseUnsignedInteger(option, '=', &value)) {
@@ -442,6 +449,10 @@ bool ParsedOptions::Parse(const RuntimeOptions& options, bool ignore_unrecognize
       must_relocate_ = true;
     } else if (option == "-Xnorelocate") {
       must_relocate_ = false;
+    } else if (option == "-Xrelocate-in-memory") {
+      relocate_in_memory_ = true;
+    } else if (option == "-Xnorelocate-in-memory") {
+      relocate_in_memory_ = false;
     } else if (option == "-Xnodex2oat") {
       dex2oat_enabled_ = false;
     } else if (option == "-Xdex2oat") {
@@ -810,6 +821,7 @@ void ParsedOptions::Usage(const char* fmt, ...) {
   UsageMessage(stream, "  -XX:ParallelGCThreads=integervalue\n");
   UsageMessage(stream, "  -XX:ConcGCThreads=integervalue\n");
   UsageMessage(stream, "  -XX:MaxSpinsBeforeThinLockInflation=integervalue\n");
+  UsageMessage(stream, "  -XX:MaxStackTraceDepth=integervalue\n");
   UsageMessage(stream, "  -XX:LongPauseLogThreshold=integervalue\n");
   UsageMessage(stream, "  -XX:LongGCLogThreshold=integervalue\n");
   UsageMessage(stream, "  -XX:DumpGCPerformanceOnShutdown\n");
@@ -837,6 +849,8 @@ void ParsedOptions::Usage(const char* fmt, ...) {
   UsageMessage(stream, "  -Ximage-compiler-option dex2oat-option\n");
   UsageMessage(stream, "  -Xpatchoat:filename\n");
   UsageMessage(stream, "  -X[no]relocate\n");
+  UsageMessage(stream, "  -X[no]relocate-in-memory (Whether to relocate the boot image into shared\n"
+                       "      memory instead of the dalvik-cache)\n");
   UsageMessage(stream, "  -X[no]dex2oat (Whether to invoke dex2oat on the application)\n");
   UsageMessage(stream, "  -X[no]image-dex2oat (Whether to create and use a boot image)\n");
   UsageMessage(stream, "\n");
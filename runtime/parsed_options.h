@@ -51,6 +51,7 @@ class ParsedOptions {
   CompilerCallbacks* compiler_callbacks_;
   bool is_zygote_;
   bool must_relocate_;
+  bool relocate_in_memory_;
   bool dex2oat_enabled_;
   bool image_dex2oat_enabled_;
   std::string patchoat_executable_;
@@ -83,6 +84,7 @@ class ParsedOptions {
   gc::CollectorType background_collector_type_;
   size_t stack_size_;
   unsigned int max_spins_before_thin_lock_inflation_;
+  unsigned int max_stack_trace_depth_;
   bool low_memory_mode_;
   unsigned int lock_profiling_threshold_;
   std::string stack_trace_file_;
@@ -146,6 +146,33 @@ class Primitive {
     }
   }
 
+  // Returns the descriptor of the java.lang class boxing values of the given type.
+  static const char* BoxedDescriptor(Type type) {
+    switch (type) {
+      case kPrimBoolean:
+        return "Ljava/lang/Boolean;";
+      case kPrimByte:
+        return "Ljava/lang/Byte;";
+      case kPrimChar:
+        return "Ljava/lang/Character;";
+      case kPrimShort:
+        return "Ljava/lang/Short;";
+      case kPrimInt:
+        return "Ljava/lang/Integer;";
+      case kPrimFloat:
+        return "Ljava/lang/Float;";
+      case kPrimLong:
+        return "Ljava/lang/Long;";
+      case kPrimDouble:
+        return "Ljava/lang/Double;";
+      case kPrimVoid:
+        return "Ljava/lang/Void;";
+      default:
+        LOG(FATAL) << "Primitive box conversion on invalid type " << static_cast<int>(type);
+        return NULL;
+    }
+  }
+
  private:
   DISALLOW_IMPLICIT_CONSTRUCTORS(Primitive);
 };
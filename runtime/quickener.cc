@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "quickener.h"
+
+#include <sys/mman.h>
+
+#include "dex_file.h"
+#include "mirror/art_field-inl.h"
+#include "mirror/art_method-inl.h"
+#include "runtime.h"
+#include "scoped_thread_state_change.h"
+#include "thread_list.h"
+#include "utils.h"
+
+namespace art {
+
+constexpr size_t Quickener::kMaxPendingRewrites;
+constexpr size_t Quickener::kMaxPendingHits;
+
+Quickener::Quickener()
+    : lock_("quickener lock", kDefaultMutexLevel),
+      num_pending_hits_(0),
+      num_quickened_(0),
+      num_failed_(0),
+      num_flushes_(0) {
+}
+
+static Instruction::Code QuickFieldAccessOpcode(Instruction::Code opcode) {
+  switch (opcode) {
+    case Instruction::IGET:
+      return Instruction::IGET_QUICK;
+    case Instruction::IGET_WIDE:
+      return Instruction::IGET_WIDE_QUICK;
+    case Instruction::IGET_OBJECT:
+      return Instruction::IGET_OBJECT_QUICK;
+    case Instruction::IPUT:
+      return Instruction::IPUT_QUICK;
+    case Instruction::IPUT_WIDE:
+      return Instruction::IPUT_WIDE_QUICK;
+    case Instruction::IPUT_OBJECT:
+      return Instruction::IPUT_OBJECT_QUICK;
+    case Instruction::IPUT_BOOLEAN:
+      return Instruction::IPUT_BOOLEAN_QUICK;
+    case Instruction::IPUT_BYTE:
+      return Instruction::IPUT_BYTE_QUICK;
+    case Instruction::IPUT_CHAR:
+      return Instruction::IPUT_CHAR_QUICK;
+    case Instruction::IPUT_SHORT:
+      return Instruction::IPUT_SHORT_QUICK;
+    default:
+      // There are no quick forms of the narrow iget instructions.
+      return Instruction::NOP;
+  }
+}
+
+void Quickener::RecordFieldAccess(Thread* self, mirror::ArtMethod* method,
+                                  const Instruction* inst, mirror::ArtField* field) {
+  DCHECK(!field->IsStatic());
+  Instruction::Code opcode = QuickFieldAccessOpcode(inst->Opcode());
+  if (opcode == Instruction::NOP) {
+    return;
+  }
+  // Quick field accesses don't have the barriers of volatile ones.
+  uint32_t field_offset = field->GetOffset().Uint32Value();
+  if (field->IsVolatile() || !IsUint(16, field_offset)) {
+    return;
+  }
+  Record(self, method->GetDexFile(), inst, opcode, static_cast<uint16_t>(field_offset));
+}
+
+void Quickener::RecordInvokeVirtual(Thread* self, mirror::ArtMethod* method,
+                                    const Instruction* inst, mirror::ArtMethod* target) {
+  Instruction::Code opcode;
+  switch (inst->Opcode()) {
+    case Instruction::INVOKE_VIRTUAL:
+      opcode = Instruction::INVOKE_VIRTUAL_QUICK;
+      break;
+    case Instruction::INVOKE_VIRTUAL_RANGE:
+      opcode = Instruction::INVOKE_VIRTUAL_RANGE_QUICK;
+      break;
+    case Instruction::INVOKE_VIRTUAL_QUICK:
+    case Instruction::INVOKE_VIRTUAL_RANGE_QUICK:
+      // Another thread flushed the rewrite while the caller was suspended resolving the method.
+      return;
+    default:
+      LOG(FATAL) << "Unexpected invoke " << inst->DumpString(method->GetDexFile());
+      UNREACHABLE();
+  }
+  // The target overrides the resolved method, so they share their vtable index.
+  Record(self, method->GetDexFile(), inst, opcode, target->GetMethodIndex());
+}
+
+void Quickener::Record(Thread* self, const DexFile* dex_file, const Instruction* inst,
+                       Instruction::Code opcode, uint16_t index) {
+  bool flush;
+  {
+    MutexLock mu(self, lock_);
+    if (unquickenable_dex_files_.find(dex_file) != unquickenable_dex_files_.end()) {
+      return;
+    }
+    Instruction* key = const_cast<Instruction*>(inst);
+    if (pending_.find(key) == pending_.end()) {
+      pending_.Put(key, PendingRewrite { dex_file, opcode, index });
+    }
+    ++num_pending_hits_;
+    flush = pending_.size() >= kMaxPendingRewrites || num_pending_hits_ >= kMaxPendingHits;
+  }
+  if (flush) {
+    Flush(self);
+  }
+}
+
+void Quickener::Flush(Thread* self) {
+  {
+    MutexLock mu(self, lock_);
+    if (pending_.empty()) {
+      return;  // Another thread flushed first.
+    }
+  }
+  ThreadList* thread_list = Runtime::Current()->GetThreadList();
+  ScopedThreadStateChange tsc(self, kSuspended);
+  thread_list->SuspendAll();
+  {
+    MutexLock mu(self, lock_);
+    for (auto& pending : pending_) {
+      const DexFile* dex_file = pending.second.dex_file;
+      if (pending.first->Opcode() == pending.second.opcode) {
+        continue;  // A thread that was halfway through the instruction queued it again.
+      } else if (unquickenable_dex_files_.find(dex_file) != unquickenable_dex_files_.end()) {
+        ++num_failed_;  // An earlier rewrite of this flush already failed for the dex file.
+      } else if (Apply(pending.first, pending.second)) {
+        ++num_quickened_;
+      } else {
+        unquickenable_dex_files_.insert(dex_file);
+        ++num_failed_;
+      }
+    }
+    pending_.clear();
+    num_pending_hits_ = 0;
+    ++num_flushes_;
+  }
+  thread_list->ResumeAll();
+}
+
+bool Quickener::Apply(Instruction* inst, const PendingRewrite& rewrite) {
+  // The dex code is normally read-only, make the pages holding the instruction writable. The
+  // mapping is private, so this gives the process its own copy of them.
+  uint8_t* begin = AlignDown(reinterpret_cast<uint8_t*>(inst), kPageSize);
+  uint8_t* end = AlignUp(reinterpret_cast<uint8_t*>(inst) + 2 * sizeof(uint16_t), kPageSize);
+  const bool read_only = (rewrite.dex_file->GetPermissions() & PROT_WRITE) == 0;
+  if (read_only && mprotect(begin, end - begin, PROT_READ | PROT_WRITE) != 0) {
+    PLOG(WARNING) << "Failed to make dex code of " << rewrite.dex_file->GetLocation()
+                  << " writable, not quickening it any further";
+    return false;
+  }
+  inst->SetOpcode(rewrite.opcode);
+  switch (Instruction::FormatOf(rewrite.opcode)) {
+    case Instruction::k22c:
+      inst->SetVRegC_22c(rewrite.index);
+      break;
+    case Instruction::k35c:
+      inst->SetVRegB_35c(rewrite.index);
+      break;
+    case Instruction::k3rc:
+      inst->SetVRegB_3rc(rewrite.index);
+      break;
+    default:
+      LOG(FATAL) << "Unexpected quick opcode " << Instruction::Name(rewrite.opcode);
+      UNREACHABLE();
+  }
+  if (read_only) {
+    CHECK_EQ(mprotect(begin, end - begin, PROT_READ), 0) << rewrite.dex_file->GetLocation();
+  }
+  return true;
+}
+
+void Quickener::DumpForSigQuit(std::ostream& os) {
+  MutexLock mu(Thread::Current(), lock_);
+  os << "Interpreter quickening: " << num_quickened_ << " instructions quickened in "
+     << num_flushes_ << " flushes, " << pending_.size() << " pending, " << num_failed_
+     << " failed in " << unquickenable_dex_files_.size() << " read-only dex files\n";
+}
+
+}  // namespace art
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_QUICKENER_H_
+#define ART_RUNTIME_QUICKENER_H_
+
+#include <iosfwd>
+#include <set>
+
+#include "base/macros.h"
+#include "base/mutex.h"
+#include "dex_instruction.h"
+#include "globals.h"
+#include "safe_map.h"
+
+namespace art {
+
+class DexFile;
+class Thread;
+
+namespace mirror {
+  class ArtField;
+  class ArtMethod;
+}  // namespace mirror
+
+// Rewrites the instance field accesses and virtual invokes of interpreted methods to their quick
+// forms once they have been resolved, like the dex-to-dex compiler does for the methods it sees.
+// Dex code lives in private mappings, so the rewritten pages become copy-on-write copies of the
+// dex file.
+//
+// A thread may be between reading the opcode and the index of the instruction being rewritten,
+// which would mix the forms. Rewrites are therefore queued and applied in batches with all threads
+// suspended, when no thread is halfway through decoding an instruction. Dex files whose code can't
+// be made writable are not quickened any further.
+class Quickener {
+ public:
+  Quickener();
+
+  // Queue the rewrite of the iget or iput at inst in method to its quick form, now that it
+  // resolved to field. Does nothing for volatile fields and offsets that don't fit in the
+  // instruction. May suspend to apply the queued rewrites, so the caller must not hold on to
+  // object pointers that aren't otherwise visible to the GC.
+  void RecordFieldAccess(Thread* self, mirror::ArtMethod* method, const Instruction* inst,
+                         mirror::ArtField* field)
+      LOCKS_EXCLUDED(lock_)
+      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
+
+  // Queue the rewrite of the invoke-virtual at inst in method to its quick form, now that it
+  // dispatched to target. Does nothing if another thread's flush already quickened it while the
+  // caller resolved the method. Same suspension rules as RecordFieldAccess.
+  void RecordInvokeVirtual(Thread* self, mirror::ArtMethod* method, const Instruction* inst,
+                           mirror::ArtMethod* target)
+      LOCKS_EXCLUDED(lock_)
+      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
+
+  // Suspend all threads and apply the queued rewrites.
+  void Flush(Thread* self) LOCKS_EXCLUDED(lock_) SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
+
+  void DumpForSigQuit(std::ostream& os) LOCKS_EXCLUDED(lock_);
+
+ private:
+  struct PendingRewrite {
+    const DexFile* dex_file;
+    Instruction::Code opcode;
+    uint16_t index;
+  };
+
+  // Rewrites are applied once this many instructions are queued...
+  static constexpr size_t kMaxPendingRewrites = 256;
+  // ...or once queued instructions were executed this many times, as hot ones are then likely
+  // waiting for their rewrite.
+  static constexpr size_t kMaxPendingHits = 8 * KB;
+
+  void Record(Thread* self, const DexFile* dex_file, const Instruction* inst,
+              Instruction::Code opcode, uint16_t index)
+      LOCKS_EXCLUDED(lock_)
+      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
+
+  // Returns false if the dex code could not be made writable.
+  static bool Apply(Instruction* inst, const PendingRewrite& rewrite)
+      EXCLUSIVE_LOCKS_REQUIRED(Locks::mutator_lock_);
+
+  Mutex lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
+  SafeMap<Instruction*, PendingRewrite> pending_ GUARDED_BY(lock_);
+  size_t num_pending_hits_ GUARDED_BY(lock_);
+  size_t num_quickened_ GUARDED_BY(lock_);
+  size_t num_failed_ GUARDED_BY(lock_);
+  size_t num_flushes_ GUARDED_BY(lock_);
+  // Dex files whose code could not be made writable, so that their instructions are not queued
+  // again and again.
+  std::set<const DexFile*> unquickenable_dex_files_ GUARDED_BY(lock_);
+
+  DISALLOW_COPY_AND_ASSIGN(Quickener);
+};
+
+}  // namespace art
+
+#endif  // ART_RUNTIME_QUICKENER_H_
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "quickener.h"
+
+#include <sstream>
+
+#include "common_runtime_test.h"
+#include "dex_instruction-inl.h"
+#include "mirror/art_field-inl.h"
+#include "mirror/art_method-inl.h"
+#include "mirror/class-inl.h"
+#include "scoped_thread_state_change.h"
+
+namespace art {
+
+class QuickenerTest : public CommonRuntimeTest {};
+
+TEST_F(QuickenerTest, FieldAccessAndInvokeVirtual) {
+  ScopedObjectAccess soa(Thread::Current());
+  mirror::Class* object = class_linker_->FindSystemClass(soa.Self(), "Ljava/lang/Object;");
+  mirror::Class* integer = class_linker_->FindSystemClass(soa.Self(), "Ljava/lang/Integer;");
+  ASSERT_TRUE(object != nullptr);
+  ASSERT_TRUE(integer != nullptr);
+
+  // Integer.intValue() starts with the iget of Integer.value.
+  mirror::ArtMethod* int_value = integer->FindVirtualMethod("intValue", "()I");
+  mirror::ArtField* value = integer->FindDeclaredInstanceField("value", "I");
+  ASSERT_TRUE(int_value != nullptr);
+  ASSERT_TRUE(value != nullptr);
+  const Instruction* iget = Instruction::At(int_value->GetCodeItem()->insns_);
+  ASSERT_EQ(Instruction::IGET, iget->Opcode());
+
+  // Object.toString() invokes getClass().
+  mirror::ArtMethod* to_string = object->FindVirtualMethod("toString", "()Ljava/lang/String;");
+  mirror::ArtMethod* get_class = object->FindVirtualMethod("getClass", "()Ljava/lang/Class;");
+  ASSERT_TRUE(to_string != nullptr);
+  ASSERT_TRUE(get_class != nullptr);
+  const DexFile* dex_file = to_string->GetDexFile();
+  const DexFile::CodeItem* code_item = to_string->GetCodeItem();
+  const Instruction* invoke = nullptr;
+  for (uint32_t dex_pc = 0; dex_pc < code_item->insns_size_in_code_units_;) {
+    const Instruction* inst = Instruction::At(&code_item->insns_[dex_pc]);
+    if (inst->Opcode() == Instruction::INVOKE_VIRTUAL &&
+        strcmp("getClass", dex_file->GetMethodName(dex_file->GetMethodId(inst->VRegB_35c()))) == 0) {
+      invoke = inst;
+      break;
+    }
+    dex_pc += inst->SizeInCodeUnits();
+  }
+  ASSERT_TRUE(invoke != nullptr);
+
+  Quickener quickener;
+  quickener.RecordFieldAccess(soa.Self(), int_value, iget, value);
+  quickener.RecordFieldAccess(soa.Self(), int_value, iget, value);
+  quickener.RecordInvokeVirtual(soa.Self(), to_string, invoke, get_class);
+  // Nothing changes until the rewrites are flushed.
+  EXPECT_EQ(Instruction::IGET, iget->Opcode());
+  EXPECT_EQ(Instruction::INVOKE_VIRTUAL, invoke->Opcode());
+
+  quickener.Flush(soa.Self());
+  EXPECT_EQ(Instruction::IGET_QUICK, iget->Opcode());
+  EXPECT_EQ(value->GetOffset().Uint32Value(), iget->VRegC_22c());
+  EXPECT_EQ(Instruction::INVOKE_VIRTUAL_QUICK, invoke->Opcode());
+  EXPECT_EQ(get_class->GetMethodIndex(), invoke->VRegB_35c());
+
+  std::ostringstream os;
+  quickener.DumpForSigQuit(os);
+  EXPECT_NE(std::string::npos, os.str().find("2 instructions quickened in 1 flushes")) << os.str();
+
+  // A thread that resolved the instructions before the flush may record them once they are
+  // already quickened, which queues nothing.
+  quickener.RecordFieldAccess(soa.Self(), int_value, iget, value);
+  quickener.RecordInvokeVirtual(soa.Self(), to_string, invoke, get_class);
+  quickener.Flush(soa.Self());
+  EXPECT_EQ(Instruction::IGET_QUICK, iget->Opcode());
+  EXPECT_EQ(Instruction::INVOKE_VIRTUAL_QUICK, invoke->Opcode());
+  os.str("");
+  quickener.DumpForSigQuit(os);
+  EXPECT_NE(std::string::npos, os.str().find("2 instructions quickened in 1 flushes, 0 pending"))
+      << os.str();
+}
+
+}  // namespace art
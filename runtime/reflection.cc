@@ -35,6 +35,117 @@
 
 namespace art {
 
+// Returns the number of 32-bit words an argument array for the shorty needs, with room for a
+// receiver.
+static size_t NumArgArrayWords(const char* shorty, uint32_t shorty_len) {
+  size_t num_slots = shorty_len + 1;  // +1 in case of receiver.
+  for (size_t i = 1; i < shorty_len; ++i) {
+    char c = shorty[i];
+    if (c == 'J' || c == 'D') {
+      num_slots++;
+    }
+  }
+  return num_slots;
+}
+
+// Returns the primitive type boxed by instances of klass, or kPrimNot if klass is not one of the
+// java.lang box classes. Box classes are boot classes whose only instance field is the value.
+static Primitive::Type GetBoxedPrimitiveType(mirror::Class* klass)
+    SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
+  if (klass->GetClassLoader() != nullptr || klass->NumInstanceFields() != 1) {
+    return Primitive::kPrimNot;
+  }
+  Primitive::Type type = klass->GetInstanceField(0)->GetTypeAsPrimitiveType();
+  if (type == Primitive::kPrimNot || !klass->DescriptorEquals(Primitive::BoxedDescriptor(type))) {
+    return Primitive::kPrimNot;
+  }
+  return type;
+}
+
+// Returns the boxed types, as bits indexed by Primitive::Type, which Method.invoke widens to an
+// argument of the given primitive type.
+static uint16_t AcceptedBoxedTypes(Primitive::Type type) {
+  uint16_t accepted = 1u << type;
+  switch (type) {
+    case Primitive::kPrimDouble:
+      accepted |= 1u << Primitive::kPrimFloat;
+      FALLTHROUGH_INTENDED;
+    case Primitive::kPrimFloat:
+      accepted |= 1u << Primitive::kPrimLong;
+      FALLTHROUGH_INTENDED;
+    case Primitive::kPrimLong:
+      accepted |= 1u << Primitive::kPrimInt;
+      FALLTHROUGH_INTENDED;
+    case Primitive::kPrimInt:
+      accepted |= (1u << Primitive::kPrimChar) | (1u << Primitive::kPrimShort);
+      FALLTHROUGH_INTENDED;
+    case Primitive::kPrimShort:
+      accepted |= 1u << Primitive::kPrimByte;
+      break;
+    default:
+      break;
+  }
+  return accepted;
+}
+
+static void InitReflectiveInvokePlan(mirror::ArtMethod* m, ReflectiveInvokePlan* plan)
+    SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
+  plan->method = m;
+  plan->shorty = m->GetShorty(&plan->shorty_len);
+  plan->return_type = Primitive::GetType(plan->shorty[0]);
+  const DexFile::TypeList* parameter_types = m->GetParameterTypeList();
+  uint32_t num_parameters = (parameter_types == nullptr) ? 0 : parameter_types->Size();
+  plan->args.resize(num_parameters);
+  uint32_t num_bytes = m->IsStatic() ? 0 : 4;  // Room for the receiver.
+  for (uint32_t i = 0; i < num_parameters; ++i) {
+    ReflectiveInvokeArg& arg_plan = plan->args[i];
+    arg_plan.type = Primitive::GetType(plan->shorty[i + 1]);
+    arg_plan.type_idx = parameter_types->GetTypeItem(i).type_idx_;
+    arg_plan.accepted_boxes =
+        (arg_plan.type == Primitive::kPrimNot) ? 0 : AcceptedBoxedTypes(arg_plan.type);
+    bool is_wide = (arg_plan.type == Primitive::kPrimLong) ||
+        (arg_plan.type == Primitive::kPrimDouble);
+    // Lay wide values out like ArgArray::AppendWide.
+#if defined(ART_USE_PORTABLE_COMPILER) && (defined(__arm__) || defined(__mips__))
+    if (is_wide && num_bytes % 8 == 0) {
+      num_bytes += 4;
+    }
+#endif
+    arg_plan.slot = num_bytes / 4;
+    num_bytes += is_wide ? 8 : 4;
+  }
+  plan->num_arg_bytes = num_bytes;
+}
+
+// Keeps a Method.invoke plan out of the thread's cache while it is in use, so that reflective
+// calls made meanwhile, for example by a class loader resolving a parameter type, cannot evict
+// or change it. The plan is computed if it was not cached, and is cached again when done.
+class ScopedReflectiveInvokePlan {
+ public:
+  ScopedReflectiveInvokePlan(Thread* self, mirror::ArtMethod* m)
+      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_)
+      : self_(self), plan_(self->TakeReflectiveInvokePlan(m)) {
+    if (UNLIKELY(plan_.get() == nullptr)) {
+      plan_.reset(new ReflectiveInvokePlan());
+      InitReflectiveInvokePlan(m, plan_.get());
+    }
+  }
+
+  ~ScopedReflectiveInvokePlan() {
+    self_->CacheReflectiveInvokePlan(std::move(plan_));
+  }
+
+  const ReflectiveInvokePlan& Get() const {
+    return *plan_;
+  }
+
+ private:
+  Thread* const self_;
+  std::unique_ptr<ReflectiveInvokePlan> plan_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedReflectiveInvokePlan);
+};
+
 class ArgArray {
  public:
   explicit ArgArray(const char* shorty, uint32_t shorty_len)
@@ -45,21 +156,16 @@ class ArgArray {
       arg_array_ = small_arg_array_;
     } else {
       // Analyze shorty to see if we need the large arg array.
-      for (size_t i = 1; i < shorty_len; ++i) {
-        char c = shorty[i];
-        if (c == 'J' || c == 'D') {
-          num_slots++;
-        }
-      }
-      if (num_slots <= kSmallArgArraySize) {
-        arg_array_ = small_arg_array_;
-      } else {
-        large_arg_array_.reset(new uint32_t[num_slots]);
-        arg_array_ = large_arg_array_.get();
-      }
+      AllocateArray(NumArgArrayWords(shorty, shorty_len));
     }
   }
 
+  // Sets up an argument array from a plan which already knows its size.
+  explicit ArgArray(const ReflectiveInvokePlan& plan)
+      : shorty_(plan.shorty), shorty_len_(plan.shorty_len), num_bytes_(0) {
+    AllocateArray(plan.num_arg_bytes / 4);
+  }
+
   uint32_t* GetArray() {
     return arg_array_;
   }
@@ -219,20 +325,41 @@ class ArgArray {
                      PrettyDescriptor(found_descriptor).c_str()).c_str());
   }
 
-  bool BuildArgArrayFromObjectArray(const ScopedObjectAccessAlreadyRunnable& soa,
-                                    mirror::Object* receiver,
-                                    mirror::ObjectArray<mirror::Object>* args, MethodHelper& mh)
+  // Throw for an argument of a primitive parameter that isn't a box of a type that widens to it.
+  static void ThrowIllegalUnboxingArgumentException(MethodHelper& mh, size_t args_offset,
+                                                    Primitive::Type type, mirror::Object* arg)
+      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
+    // The name of the primitive type, "int" for an int parameter.
+    const std::string expected = PrettyDescriptor(type);
+    if (arg->GetClass<>()->IsPrimitive()) {
+      std::string temp;
+      ThrowIllegalPrimitiveArgumentException(expected.c_str(),
+                                             arg->GetClass<>()->GetDescriptor(&temp));
+    } else {
+      ThrowIllegalArgumentException(nullptr,
+          StringPrintf("method %s argument %zd has type %s, got %s",
+              PrettyMethod(mh.GetMethod(), false).c_str(),
+              args_offset + 1,
+              expected.c_str(),
+              PrettyTypeOf(arg).c_str()).c_str());
+    }
+  }
+
+  bool BuildArgArrayFromPlan(const ScopedObjectAccessAlreadyRunnable& soa,
+                             mirror::Object* receiver,
+                             mirror::ObjectArray<mirror::Object>* args,
+                             const ReflectiveInvokePlan& plan, MethodHelper& mh)
       SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
-    const DexFile::TypeList* classes = mh.GetMethod()->GetParameterTypeList();
     // Set receiver if non-null (method is not static)
     if (receiver != nullptr) {
       Append(receiver);
     }
-    for (size_t i = 1, args_offset = 0; i < shorty_len_; ++i, ++args_offset) {
+    for (size_t args_offset = 0; args_offset < plan.args.size(); ++args_offset) {
+      const ReflectiveInvokeArg& arg_plan = plan.args[args_offset];
       mirror::Object* arg = args->Get(args_offset);
-      if (((shorty_[i] == 'L') && (arg != nullptr)) || ((arg == nullptr && shorty_[i] != 'L'))) {
-        mirror::Class* dst_class =
-            mh.GetClassFromTypeIdx(classes->GetTypeItem(args_offset).type_idx_);
+      bool is_reference = (arg_plan.type == Primitive::kPrimNot);
+      if ((is_reference && arg != nullptr) || (!is_reference && arg == nullptr)) {
+        mirror::Class* dst_class = mh.GetClassFromTypeIdx(arg_plan.type_idx);
         if (UNLIKELY(arg == nullptr || !arg->InstanceOf(dst_class))) {
           ThrowIllegalArgumentException(nullptr,
               StringPrintf("method %s argument %zd has type %s, got %s",
@@ -243,103 +370,74 @@ class ArgArray {
           return false;
         }
       }
+      if (is_reference) {
+        arg_array_[arg_plan.slot] =
+            StackReference<mirror::Object>::FromMirrorPtr(arg).AsVRegValue();
+        continue;
+      }
 
-#define DO_FIRST_ARG(match_descriptor, get_fn, append) { \
-          if (LIKELY(arg != nullptr && arg->GetClass<>()->DescriptorEquals(match_descriptor))) { \
-            mirror::ArtField* primitive_field = arg->GetClass()->GetIFields()->Get(0); \
-            append(primitive_field-> get_fn(arg));
-
-#define DO_ARG(match_descriptor, get_fn, append) \
-          } else if (LIKELY(arg != nullptr && \
-                            arg->GetClass<>()->DescriptorEquals(match_descriptor))) { \
-            mirror::ArtField* primitive_field = arg->GetClass()->GetIFields()->Get(0); \
-            append(primitive_field-> get_fn(arg));
-
-#define DO_FAIL(expected) \
-          } else { \
-            if (arg->GetClass<>()->IsPrimitive()) { \
-              std::string temp; \
-              ThrowIllegalPrimitiveArgumentException(expected, \
-                                                     arg->GetClass<>()->GetDescriptor(&temp)); \
-            } else { \
-              ThrowIllegalArgumentException(nullptr, \
-                  StringPrintf("method %s argument %zd has type %s, got %s", \
-                      PrettyMethod(mh.GetMethod(), false).c_str(), \
-                      args_offset + 1, \
-                      expected, \
-                      PrettyTypeOf(arg).c_str()).c_str()); \
-            } \
-            return false; \
-          } }
-
-      switch (shorty_[i]) {
-        case 'L':
-          Append(arg);
-          break;
-        case 'Z':
-          DO_FIRST_ARG("Ljava/lang/Boolean;", GetBoolean, Append)
-          DO_FAIL("boolean")
+      Primitive::Type boxed_type = GetBoxedPrimitiveType(arg->GetClass());
+      if (UNLIKELY((arg_plan.accepted_boxes & (1u << boxed_type)) == 0)) {
+        ThrowIllegalUnboxingArgumentException(mh, args_offset, arg_plan.type, arg);
+        return false;
+      }
+      JValue boxed_value;
+      mirror::ArtField* primitive_field = arg->GetClass()->GetInstanceField(0);
+      switch (boxed_type) {
+        case Primitive::kPrimBoolean:
+          boxed_value.SetZ(primitive_field->GetBoolean(arg));
           break;
-        case 'B':
-          DO_FIRST_ARG("Ljava/lang/Byte;", GetByte, Append)
-          DO_FAIL("byte")
+        case Primitive::kPrimByte:
+          boxed_value.SetB(primitive_field->GetByte(arg));
           break;
-        case 'C':
-          DO_FIRST_ARG("Ljava/lang/Character;", GetChar, Append)
-          DO_FAIL("char")
+        case Primitive::kPrimChar:
+          boxed_value.SetC(primitive_field->GetChar(arg));
           break;
-        case 'S':
-          DO_FIRST_ARG("Ljava/lang/Short;", GetShort, Append)
-          DO_ARG("Ljava/lang/Byte;", GetByte, Append)
-          DO_FAIL("short")
+        case Primitive::kPrimShort:
+          boxed_value.SetS(primitive_field->GetShort(arg));
           break;
-        case 'I':
-          DO_FIRST_ARG("Ljava/lang/Integer;", GetInt, Append)
-          DO_ARG("Ljava/lang/Character;", GetChar, Append)
-          DO_ARG("Ljava/lang/Short;", GetShort, Append)
-          DO_ARG("Ljava/lang/Byte;", GetByte, Append)
-          DO_FAIL("int")
+        case Primitive::kPrimInt:
+          boxed_value.SetI(primitive_field->GetInt(arg));
           break;
-        case 'J':
-          DO_FIRST_ARG("Ljava/lang/Long;", GetLong, AppendWide)
-          DO_ARG("Ljava/lang/Integer;", GetInt, AppendWide)
-          DO_ARG("Ljava/lang/Character;", GetChar, AppendWide)
-          DO_ARG("Ljava/lang/Short;", GetShort, AppendWide)
-          DO_ARG("Ljava/lang/Byte;", GetByte, AppendWide)
-          DO_FAIL("long")
+        case Primitive::kPrimLong:
+          boxed_value.SetJ(primitive_field->GetLong(arg));
           break;
-        case 'F':
-          DO_FIRST_ARG("Ljava/lang/Float;", GetFloat, AppendFloat)
-          DO_ARG("Ljava/lang/Long;", GetLong, AppendFloat)
-          DO_ARG("Ljava/lang/Integer;", GetInt, AppendFloat)
-          DO_ARG("Ljava/lang/Character;", GetChar, AppendFloat)
-          DO_ARG("Ljava/lang/Short;", GetShort, AppendFloat)
-          DO_ARG("Ljava/lang/Byte;", GetByte, AppendFloat)
-          DO_FAIL("float")
+        case Primitive::kPrimFloat:
+          boxed_value.SetF(primitive_field->GetFloat(arg));
           break;
-        case 'D':
-          DO_FIRST_ARG("Ljava/lang/Double;", GetDouble, AppendDouble)
-          DO_ARG("Ljava/lang/Float;", GetFloat, AppendDouble)
-          DO_ARG("Ljava/lang/Long;", GetLong, AppendDouble)
-          DO_ARG("Ljava/lang/Integer;", GetInt, AppendDouble)
-          DO_ARG("Ljava/lang/Character;", GetChar, AppendDouble)
-          DO_ARG("Ljava/lang/Short;", GetShort, AppendDouble)
-          DO_ARG("Ljava/lang/Byte;", GetByte, AppendDouble)
-          DO_FAIL("double")
+        case Primitive::kPrimDouble:
+          boxed_value.SetD(primitive_field->GetDouble(arg));
           break;
-#ifndef NDEBUG
         default:
-          LOG(FATAL) << "Unexpected shorty character: " << shorty_[i];
-#endif
+          LOG(FATAL) << "Unexpected boxed type " << boxed_type;
+          UNREACHABLE();
+      }
+      // The accepted boxes only allow widening conversions, which cannot fail.
+      JValue value;
+      bool converted = ConvertPrimitiveValue(nullptr, false, boxed_type, arg_plan.type,
+                                             boxed_value, &value);
+      DCHECK(converted);
+      if (arg_plan.type == Primitive::kPrimLong || arg_plan.type == Primitive::kPrimDouble) {
+        arg_array_[arg_plan.slot] = static_cast<uint32_t>(value.GetJ());
+        arg_array_[arg_plan.slot + 1] = static_cast<uint32_t>(value.GetJ() >> 32);
+      } else {
+        arg_array_[arg_plan.slot] = static_cast<uint32_t>(value.GetI());
       }
-#undef DO_FIRST_ARG
-#undef DO_ARG
-#undef DO_FAIL
     }
+    num_bytes_ = plan.num_arg_bytes;
     return true;
   }
 
  private:
+  void AllocateArray(size_t num_slots) {
+    if (num_slots <= kSmallArgArraySize) {
+      arg_array_ = small_arg_array_;
+    } else {
+      large_arg_array_.reset(new uint32_t[num_slots]);
+      arg_array_ = large_arg_array_.get();
+    }
+  }
+
   enum { kSmallArgArraySize = 16 };
   const char* const shorty_;
   const uint32_t shorty_len_;
@@ -579,11 +677,14 @@ jobject InvokeMethod(const ScopedObjectAccessAlreadyRunnable& soa, jobject javaM
     m = receiver->GetClass()->FindVirtualMethodForVirtualOrInterface(m);
   }
 
+  // Look up how to marshal the arguments, computing the plan on the first call from this thread.
+  ScopedReflectiveInvokePlan scoped_plan(soa.Self(), m);
+  const ReflectiveInvokePlan& plan = scoped_plan.Get();
+
   // Get our arrays of arguments and their types, and check they're the same size.
   mirror::ObjectArray<mirror::Object>* objects =
       soa.Decode<mirror::ObjectArray<mirror::Object>*>(javaArgs);
-  const DexFile::TypeList* classes = m->GetParameterTypeList();
-  uint32_t classes_size = (classes == nullptr) ? 0 : classes->Size();
+  uint32_t classes_size = plan.args.size();
   uint32_t arg_count = (objects != nullptr) ? objects->GetLength() : 0;
   if (arg_count != classes_size) {
     ThrowIllegalArgumentException(NULL,
@@ -608,17 +709,15 @@ jobject InvokeMethod(const ScopedObjectAccessAlreadyRunnable& soa, jobject javaM
 
   // Invoke the method.
   JValue result;
-  uint32_t shorty_len = 0;
-  const char* shorty = m->GetShorty(&shorty_len);
-  ArgArray arg_array(shorty, shorty_len);
+  ArgArray arg_array(plan);
   StackHandleScope<1> hs(soa.Self());
   MethodHelper mh(hs.NewHandle(m));
-  if (!arg_array.BuildArgArrayFromObjectArray(soa, receiver, objects, mh)) {
+  if (!arg_array.BuildArgArrayFromPlan(soa, receiver, objects, plan, mh)) {
     CHECK(soa.Self()->IsExceptionPending());
     return nullptr;
   }
 
-  InvokeWithArgArray(soa, m, &arg_array, &result, shorty);
+  InvokeWithArgArray(soa, m, &arg_array, &result, plan.shorty);
 
   // Wrap any exception with "Ljava/lang/reflect/InvocationTargetException;" and return early.
   if (soa.Self()->IsExceptionPending()) {
@@ -632,8 +731,7 @@ jobject InvokeMethod(const ScopedObjectAccessAlreadyRunnable& soa, jobject javaM
   }
 
   // Box if necessary and return.
-  return soa.AddLocalReference<jobject>(BoxPrimitive(mh.GetReturnType()->GetPrimitiveType(),
-                                                     result));
+  return soa.AddLocalReference<jobject>(BoxPrimitive(plan.return_type, result));
 }
 
 bool VerifyObjectIsClass(mirror::Object* o, mirror::Class* c) {
@@ -17,6 +17,8 @@
 #ifndef ART_RUNTIME_REFLECTION_H_
 #define ART_RUNTIME_REFLECTION_H_
 
+#include <vector>
+
 #include "base/mutex.h"
 #include "jni.h"
 #include "primitive.h"
@@ -34,6 +36,32 @@ class ScopedObjectAccessAlreadyRunnable;
 class ShadowFrame;
 class ThrowLocation;
 
+// How Method.invoke unboxes one argument and where it places it in the argument array.
+struct ReflectiveInvokeArg {
+  // The parameter type, from the shorty.
+  Primitive::Type type;
+  // The dex type of the parameter, to check references and to report errors.
+  uint16_t type_idx;
+  // For primitive parameters, the boxed types which widen to the parameter type, as bits indexed
+  // by Primitive::Type.
+  uint16_t accepted_boxes;
+  // The first 32-bit word of the argument array holding the argument.
+  uint32_t slot;
+};
+
+// How Method.invoke marshals the boxed arguments of a method, computed from the method's dex data
+// on first use and then cached per thread, see Thread::TakeReflectiveInvokePlan.
+struct ReflectiveInvokePlan {
+  // The method this plan is for. ArtMethods are non-movable and never freed.
+  mirror::ArtMethod* method;
+  const char* shorty;
+  uint32_t shorty_len;
+  // Size of the argument array, including the receiver of non-static methods.
+  uint32_t num_arg_bytes;
+  Primitive::Type return_type;
+  std::vector<ReflectiveInvokeArg> args;
+};
+
 mirror::Object* BoxPrimitive(Primitive::Type src_class, const JValue& value)
     SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
 bool UnboxPrimitiveForField(mirror::Object* o, mirror::Class* dst_class, mirror::ArtField* f,
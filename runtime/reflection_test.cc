@@ -22,7 +22,12 @@
 
 #include "common_compiler_test.h"
 #include "mirror/art_method-inl.h"
+#include "mirror/object_array-inl.h"
+#include "mirror/string-inl.h"
+#include "mirror/throwable.h"
 #include "scoped_thread_state_change.h"
+#include "thread.h"
+#include "throw_location.h"
 
 namespace art {
 
@@ -128,6 +133,31 @@ class ReflectionTest : public CommonCompilerTest {
     self->TransitionFromSuspendedToRunnable();
   }
 
+  // Calls static int sum(int, int) through Method.invoke with an Integer and a Byte, which widens
+  // to int.
+  int32_t InvokeSumIntIntReflectively(const ScopedObjectAccess& soa, jobject jmethod,
+                                      int32_t a, int8_t b)
+      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
+    StackHandleScope<1> hs(soa.Self());
+    Handle<mirror::ObjectArray<mirror::Object>> args(hs.NewHandle(
+        mirror::ObjectArray<mirror::Object>::Alloc(
+            soa.Self(), class_linker_->GetClassRoot(ClassLinker::kObjectArrayClass), 2)));
+    JValue value;
+    value.SetI(a);
+    args->Set(0, BoxPrimitive(Primitive::kPrimInt, value));
+    value.SetB(b);
+    args->Set(1, BoxPrimitive(Primitive::kPrimByte, value));
+
+    jobject result = InvokeMethod(soa, jmethod, nullptr,
+                                  soa.AddLocalReference<jobject>(args.Get()), true);
+    CHECK(!soa.Self()->IsExceptionPending());
+    JValue unboxed;
+    bool unboxed_ok = UnboxPrimitiveForResult(ThrowLocation(), soa.Decode<mirror::Object*>(result),
+                                              class_linker_->FindPrimitiveClass('I'), &unboxed);
+    CHECK(unboxed_ok);
+    return unboxed.GetI();
+  }
+
   void InvokeNopMethod(bool is_static) {
     ScopedObjectAccess soa(env_);
     mirror::ArtMethod* method;
@@ -637,4 +667,86 @@ TEST_F(ReflectionTest, NonStaticSumDoubleDoubleDoubleDoubleDoubleMethod) {
   InvokeSumDoubleDoubleDoubleDoubleDoubleMethod(false);
 }
 
+TEST_F(ReflectionTest, ReflectiveInvokePlanCache) {
+  TEST_DISABLED_FOR_PORTABLE();
+  ScopedObjectAccess soa(env_);
+  Thread* self = soa.Self();
+  mirror::ArtMethod* sum;
+  mirror::Object* receiver;
+  ReflectionTestMakeExecutable(&sum, &receiver, true, "sum", "(II)I");
+  jobject jsum = env_->ToReflectedMethod(nullptr, soa.EncodeMethod(sum), JNI_TRUE);
+  ASSERT_TRUE(jsum != nullptr);
+
+  // The plan is computed on the first call, and then cached.
+  EXPECT_TRUE(self->TakeReflectiveInvokePlan(sum) == nullptr);
+  EXPECT_EQ(7, InvokeSumIntIntReflectively(soa, jsum, 3, 4));
+  std::unique_ptr<ReflectiveInvokePlan> plan(self->TakeReflectiveInvokePlan(sum));
+  ASSERT_TRUE(plan.get() != nullptr);
+  EXPECT_EQ(sum, plan->method);
+  EXPECT_EQ(Primitive::kPrimInt, plan->return_type);
+  EXPECT_EQ(8U, plan->num_arg_bytes);
+  ASSERT_EQ(2U, plan->args.size());
+  for (size_t i = 0; i < 2; ++i) {
+    EXPECT_EQ(Primitive::kPrimInt, plan->args[i].type);
+    EXPECT_EQ(i, plan->args[i].slot);
+    EXPECT_NE(0, plan->args[i].accepted_boxes & (1 << Primitive::kPrimByte));
+    EXPECT_EQ(0, plan->args[i].accepted_boxes & (1 << Primitive::kPrimLong));
+  }
+
+  // Later calls hit the cache and reuse the same plan.
+  ReflectiveInvokePlan* cached_plan = plan.get();
+  self->CacheReflectiveInvokePlan(std::move(plan));
+  EXPECT_EQ(-1, InvokeSumIntIntReflectively(soa, jsum, 1, -2));
+  plan = self->TakeReflectiveInvokePlan(sum);
+  EXPECT_EQ(cached_plan, plan.get());
+  self->CacheReflectiveInvokePlan(std::move(plan));
+
+  // Caching the plan of a method using the same slot evicts the plan of sum. The cache is
+  // direct-mapped, so look for such a method among the methods of a few boot classes.
+  mirror::ArtMethod* other = nullptr;
+  const char* descriptors[] = {
+      "Ljava/lang/String;", "Ljava/lang/Class;", "Ljava/lang/Object;", "Ljava/lang/Thread;"
+  };
+  for (size_t i = 0; other == nullptr && i < arraysize(descriptors); ++i) {
+    mirror::Class* klass = class_linker_->FindSystemClass(self, descriptors[i]);
+    ASSERT_TRUE(klass != nullptr);
+    for (size_t j = 0; other == nullptr && j < klass->NumVirtualMethods(); ++j) {
+      std::unique_ptr<ReflectiveInvokePlan> other_plan(new ReflectiveInvokePlan());
+      other_plan->method = klass->GetVirtualMethod(j);
+      self->CacheReflectiveInvokePlan(std::move(other_plan));
+      plan = self->TakeReflectiveInvokePlan(sum);
+      if (plan.get() == nullptr) {
+        other = klass->GetVirtualMethod(j);
+      } else {
+        self->CacheReflectiveInvokePlan(std::move(plan));
+      }
+    }
+  }
+  ASSERT_TRUE(other != nullptr);
+
+  // The next call computes the plan of sum again, which evicts the other plan.
+  EXPECT_EQ(7, InvokeSumIntIntReflectively(soa, jsum, 3, 4));
+  plan = self->TakeReflectiveInvokePlan(sum);
+  ASSERT_TRUE(plan.get() != nullptr);
+  EXPECT_EQ(sum, plan->method);
+  EXPECT_TRUE(self->TakeReflectiveInvokePlan(other) == nullptr);
+
+  // A box that doesn't widen to the parameter type is rejected with the usual message.
+  StackHandleScope<1> hs(self);
+  Handle<mirror::ObjectArray<mirror::Object>> args(hs.NewHandle(
+      mirror::ObjectArray<mirror::Object>::Alloc(
+          self, class_linker_->GetClassRoot(ClassLinker::kObjectArrayClass), 2)));
+  JValue value;
+  value.SetI(1);
+  args->Set(0, BoxPrimitive(Primitive::kPrimInt, value));
+  value.SetJ(2);
+  args->Set(1, BoxPrimitive(Primitive::kPrimLong, value));
+  InvokeMethod(soa, jsum, nullptr, soa.AddLocalReference<jobject>(args.Get()), true);
+  ASSERT_TRUE(self->IsExceptionPending());
+  std::string message = self->GetException(nullptr)->GetDetailMessage()->ToModifiedUtf8();
+  self->ClearException();
+  EXPECT_NE(std::string::npos, message.find("argument 2 has type int, got java.lang.Long"))
+      << message;
+}
+
 }  // namespace art
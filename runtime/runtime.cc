@@ -57,9 +57,11 @@
 #include "gc/space/image_space.h"
 #include "gc/space/space.h"
 #include "image.h"
+#include "inline_cache.h"
 #include "instrumentation.h"
 #include "intern_table.h"
 #include "jni_internal.h"
+#include "lock_contention_profiler.h"
 #include "mirror/art_field-inl.h"
 #include "mirror/art_method-inl.h"
 #include "mirror/array.h"
@@ -85,6 +87,7 @@
 #include "trace.h"
 #include "transaction.h"
 #include "profiler.h"
+#include "quickener.h"
 #include "verifier/method_verifier.h"
 #include "well_known_classes.h"
 
@@ -105,6 +108,7 @@ Runtime::Runtime()
       compiler_callbacks_(nullptr),
       is_zygote_(false),
       must_relocate_(false),
+      relocate_in_memory_(false),
       is_concurrent_gc_enabled_(true),
       is_explicit_gc_disabled_(false),
       dex2oat_enabled_(true),
@@ -112,8 +116,12 @@ Runtime::Runtime()
       default_stack_size_(0),
       heap_(nullptr),
       max_spins_before_thin_lock_inflation_(Monitor::kDefaultMaxSpinsBeforeThinLockInflation),
+      max_stack_trace_depth_(Thread::kDefaultMaxStackTraceDepth),
       monitor_list_(nullptr),
       monitor_pool_(nullptr),
+      lock_contention_profiler_(nullptr),
+      inline_cache_table_(nullptr),
+      quickener_(nullptr),
       thread_list_(nullptr),
       intern_table_(nullptr),
       class_linker_(nullptr),
@@ -195,6 +203,9 @@ Runtime::~Runtime() {
 
   delete monitor_list_;
   delete monitor_pool_;
+  delete lock_contention_profiler_;
+  delete inline_cache_table_;
+  delete quickener_;
   delete class_linker_;
   delete heap_;
   delete intern_table_;
@@ -677,6 +688,7 @@ bool Runtime::Init(const RuntimeOptions& raw_options, bool ignore_unrecognized)
   compiler_callbacks_ = options->compiler_callbacks_;
   patchoat_executable_ = options->patchoat_executable_;
   must_relocate_ = options->must_relocate_;
+  relocate_in_memory_ = options->relocate_in_memory_;
   is_zygote_ = options->is_zygote_;
   is_explicit_gc_disabled_ = options->is_explicit_gc_disabled_;
   dex2oat_enabled_ = options->dex2oat_enabled_;
@@ -695,9 +707,17 @@ bool Runtime::Init(const RuntimeOptions& raw_options, bool ignore_unrecognized)
   image_location_ = options->image_;
 
   max_spins_before_thin_lock_inflation_ = options->max_spins_before_thin_lock_inflation_;
+  max_stack_trace_depth_ = options->max_stack_trace_depth_;
 
   monitor_list_ = new MonitorList;
   monitor_pool_ = MonitorPool::Create();
+  if (options->lock_profiling_threshold_ != 0) {
+    lock_contention_profiler_ = new LockContentionProfiler;
+  }
+  if (!IsCompiler()) {
+    inline_cache_table_ = new InlineCacheTable;
+    quickener_ = new Quickener;
+  }
   thread_list_ = new ThreadList;
   intern_table_ = new InternTable;
 
@@ -1001,6 +1021,16 @@ void Runtime::DumpForSigQuit(std::ostream& os) {
   GetInternTable()->DumpForSigQuit(os);
   GetJavaVM()->DumpForSigQuit(os);
   GetHeap()->DumpForSigQuit(os);
+  GetMonitorList()->DumpForSigQuit(os);
+  if (lock_contention_profiler_ != nullptr) {
+    lock_contention_profiler_->Dump(os);
+  }
+  if (inline_cache_table_ != nullptr) {
+    inline_cache_table_->DumpForSigQuit(os);
+  }
+  if (quickener_ != nullptr) {
+    quickener_->DumpForSigQuit(os);
+  }
   TrackedAllocators::Dump(os);
   os << "\n";
 
@@ -1172,6 +1202,9 @@ void Runtime::VisitNonThreadRoots(RootCallback* callback, void* arg) {
   if (HasDefaultImt()) {
     default_imt_.VisitRoot(callback, arg, 0, kRootVMInternal);
   }
+  if (inline_cache_table_ != nullptr) {
+    inline_cache_table_->VisitRoots(callback, arg);
+  }
   for (int i = 0; i < Runtime::kLastCalleeSaveType; i++) {
     if (!callee_save_methods_[i].IsNull()) {
       callee_save_methods_[i].VisitRoot(callback, arg, 0, kRootVMInternal);
@@ -1204,7 +1237,7 @@ mirror::ObjectArray<mirror::ArtMethod>* Runtime::CreateDefaultImt(ClassLinker* c
   Thread* self = Thread::Current();
   StackHandleScope<1> hs(self);
   Handle<mirror::ObjectArray<mirror::ArtMethod>> imtable(
-      hs.NewHandle(cl->AllocArtMethodArray(self, 64)));
+      hs.NewHandle(cl->AllocArtMethodArray(self, mirror::Class::kImtSize)));
   mirror::ArtMethod* imt_conflict_method = Runtime::Current()->GetImtConflictMethod();
   for (size_t i = 0; i < static_cast<size_t>(imtable->GetLength()); i++) {
     imtable->Set<false>(i, imt_conflict_method);
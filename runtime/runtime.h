@@ -59,11 +59,14 @@ class MethodVerifier;
 }
 class ClassLinker;
 class DexFile;
+class InlineCacheTable;
 class InternTable;
 class JavaVMExt;
+class LockContentionProfiler;
 class MonitorList;
 class MonitorPool;
 class NullPointerHandler;
+class Quickener;
 class SignalCatcher;
 class StackOverflowHandler;
 class SuspensionHandler;
@@ -106,6 +109,12 @@ class Runtime {
     return must_relocate_;
   }
 
+  // Whether a boot image that needs relocating is patched into shared memory rather than into a
+  // copy in the dalvik-cache.
+  bool ShouldRelocateInMemory() const {
+    return relocate_in_memory_;
+  }
+
   bool IsDex2OatEnabled() const {
     return dex2oat_enabled_ && IsImageDex2OatEnabled();
   }
@@ -235,6 +244,11 @@ class Runtime {
     return max_spins_before_thin_lock_inflation_;
   }
 
+  // The maximum number of frames recorded in an exception's stack trace, 0 means no limit.
+  size_t GetMaxStackTraceDepth() const {
+    return max_stack_trace_depth_;
+  }
+
   MonitorList* GetMonitorList() const {
     return monitor_list_;
   }
@@ -243,6 +257,21 @@ class Runtime {
     return monitor_pool_;
   }
 
+  // Null unless lock profiling is enabled with -Xlockprofthreshold.
+  LockContentionProfiler* GetLockContentionProfiler() const {
+    return lock_contention_profiler_;
+  }
+
+  // Null when compiling, as the compiler's interpreter only runs class initializers.
+  InlineCacheTable* GetInlineCacheTable() const {
+    return inline_cache_table_;
+  }
+
+  // Null when compiling, the compiler quickens the dex code it writes out instead.
+  Quickener* GetQuickener() const {
+    return quickener_;
+  }
+
   // Is the given object the special object used to mark a cleared JNI weak global?
   bool IsClearedJniWeakGlobal(mirror::Object* obj) SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
 
@@ -523,6 +552,7 @@ class Runtime {
   CompilerCallbacks* compiler_callbacks_;
   bool is_zygote_;
   bool must_relocate_;
+  bool relocate_in_memory_;
   bool is_concurrent_gc_enabled_;
   bool is_explicit_gc_disabled_;
   bool dex2oat_enabled_;
@@ -545,8 +575,15 @@ class Runtime {
 
   // The number of spins that are done before thread suspension is used to forcibly inflate.
   size_t max_spins_before_thin_lock_inflation_;
+
+  // The maximum number of frames recorded by Thread::CreateInternalStackTrace, 0 means no limit.
+  size_t max_stack_trace_depth_;
+
   MonitorList* monitor_list_;
   MonitorPool* monitor_pool_;
+  LockContentionProfiler* lock_contention_profiler_;
+  InlineCacheTable* inline_cache_table_;
+  Quickener* quickener_;
 
   ThreadList* thread_list_;
 
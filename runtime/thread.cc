@@ -1087,6 +1087,7 @@ Thread::Thread(bool daemon) : tls32_(daemon), wait_monitor_(nullptr), interrupte
   for (uint32_t i = 0; i < kMaxCheckpoints; ++i) {
     tlsPtr_.checkpoint_functions[i] = nullptr;
   }
+  memset(&pc_to_dex_cache_[0], 0, sizeof(pc_to_dex_cache_));
 }
 
 bool Thread::IsStillStarting() const {
@@ -1391,6 +1392,20 @@ void Thread::NotifyLocked(Thread* self) {
   }
 }
 
+std::unique_ptr<ReflectiveInvokePlan> Thread::TakeReflectiveInvokePlan(
+    mirror::ArtMethod* method) {
+  std::unique_ptr<ReflectiveInvokePlan>& slot =
+      reflective_invoke_plans_[ReflectiveInvokePlanIndex(method)];
+  if (slot.get() == nullptr || slot->method != method) {
+    return nullptr;
+  }
+  return std::move(slot);
+}
+
+void Thread::CacheReflectiveInvokePlan(std::unique_ptr<ReflectiveInvokePlan> plan) {
+  reflective_invoke_plans_[ReflectiveInvokePlanIndex(plan->method)] = std::move(plan);
+}
+
 void Thread::SetClassLoaderOverride(jobject class_loader_override) {
   if (tlsPtr_.class_loader_override != nullptr) {
     GetJniEnv()->DeleteGlobalRef(tlsPtr_.class_loader_override);
@@ -1403,7 +1418,8 @@ class CountStackDepthVisitor : public StackVisitor {
   explicit CountStackDepthVisitor(Thread* thread)
       SHARED_LOCKS_REQUIRED(Locks::mutator_lock_)
       : StackVisitor(thread, nullptr),
-        depth_(0), skip_depth_(0), skipping_(true) {}
+        depth_(0), skip_depth_(0), skipping_(true),
+        max_depth_(Runtime::Current()->GetMaxStackTraceDepth()) {}
 
   bool VisitFrame() SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
     // We want to skip frames up to and including the exception's constructor.
@@ -1417,6 +1433,9 @@ class CountStackDepthVisitor : public StackVisitor {
     if (!skipping_) {
       if (!m->IsRuntimeMethod()) {  // Ignore runtime frames (in particular callee save).
         ++depth_;
+        if (depth_ == max_depth_) {
+          return false;  // No need to walk the frames that will not be recorded.
+        }
       }
     } else {
       ++skip_depth_;
@@ -1436,14 +1455,21 @@ class CountStackDepthVisitor : public StackVisitor {
   uint32_t depth_;
   uint32_t skip_depth_;
   bool skipping_;
+  // The maximum number of frames to count, 0 means no limit.
+  const uint32_t max_depth_;
 };
 
+// Outside of transactions the pc trace of an internal stack trace is a long[] holding either the
+// raw native pc of a compiled frame, or a dex pc tagged with this flag.
+static constexpr uint64_t kStackTraceDexPcFlag = UINT64_C(1) << 63;
+
 template<bool kTransactionActive>
 class BuildInternalStackTraceVisitor : public StackVisitor {
  public:
   explicit BuildInternalStackTraceVisitor(Thread* self, Thread* thread, int skip_depth)
       : StackVisitor(thread, nullptr), self_(self),
-        skip_depth_(skip_depth), count_(0), dex_pc_trace_(nullptr), method_trace_(nullptr) {}
+        skip_depth_(skip_depth), count_(0), depth_(0), dex_pc_trace_(nullptr),
+        native_pc_trace_(nullptr), method_trace_(nullptr) {}
 
   bool Init(int depth)
       SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
@@ -1455,20 +1481,29 @@ class BuildInternalStackTraceVisitor : public StackVisitor {
     if (method_trace.Get() == nullptr) {
       return false;
     }
-    mirror::IntArray* dex_pc_trace = mirror::IntArray::Alloc(self_, depth);
-    if (dex_pc_trace == nullptr) {
+    // Native pcs recorded during a transaction would be meaningless in the image, so record dex
+    // pcs right away in that case.
+    mirror::Array* pc_trace;
+    if (kTransactionActive) {
+      dex_pc_trace_ = mirror::IntArray::Alloc(self_, depth);
+      pc_trace = dex_pc_trace_;
+    } else {
+      native_pc_trace_ = mirror::LongArray::Alloc(self_, depth);
+      pc_trace = native_pc_trace_;
+    }
+    if (pc_trace == nullptr) {
       return false;
     }
     // Save PC trace in last element of method trace, also places it into the
     // object graph.
     // We are called from native: use non-transactional mode.
-    method_trace->Set<kTransactionActive>(depth, dex_pc_trace);
+    method_trace->Set<kTransactionActive>(depth, pc_trace);
     // Set the Object*s and assert that no thread suspension is now possible.
     const char* last_no_suspend_cause =
         self_->StartAssertNoThreadSuspension("Building internal stack trace");
     CHECK(last_no_suspend_cause == nullptr) << last_no_suspend_cause;
     method_trace_ = method_trace.Get();
-    dex_pc_trace_ = dex_pc_trace;
+    depth_ = depth;
     return true;
   }
 
@@ -1479,7 +1514,7 @@ class BuildInternalStackTraceVisitor : public StackVisitor {
   }
 
   bool VisitFrame() SHARED_LOCKS_REQUIRED(Locks::mutator_lock_) {
-    if (method_trace_ == nullptr || dex_pc_trace_ == nullptr) {
+    if (method_trace_ == nullptr) {
       return true;  // We're probably trying to fillInStackTrace for an OutOfMemoryError.
     }
     if (skip_depth_ > 0) {
@@ -1491,10 +1526,21 @@ class BuildInternalStackTraceVisitor : public StackVisitor {
       return true;  // Ignore runtime frames (in particular callee save).
     }
     method_trace_->Set<kTransactionActive>(count_, m);
-    dex_pc_trace_->Set<kTransactionActive>(count_,
-        m->IsProxyMethod() ? DexFile::kDexNoIndex : GetDexPc());
+    if (kTransactionActive) {
+      dex_pc_trace_->Set<kTransactionActive>(count_,
+          m->IsProxyMethod() ? DexFile::kDexNoIndex : GetDexPc());
+    } else if (m->IsProxyMethod()) {
+      native_pc_trace_->Set<kTransactionActive>(count_,
+          kStackTraceDexPcFlag | DexFile::kDexNoIndex);
+    } else if (IsShadowFrame() || GetCurrentQuickFrame() == nullptr) {
+      native_pc_trace_->Set<kTransactionActive>(count_, kStackTraceDexPcFlag | GetDexPc());
+    } else {
+      // Leave the mapping table lookup to InternalStackTraceDexPc.
+      native_pc_trace_->Set<kTransactionActive>(count_, GetCurrentQuickFramePc());
+    }
     ++count_;
-    return true;
+    // Stop once the trace is full, it may be truncated by Runtime::GetMaxStackTraceDepth.
+    return count_ != depth_;
   }
 
   mirror::ObjectArray<mirror::Object>* GetInternalStackTrace() const {
@@ -1507,8 +1553,12 @@ class BuildInternalStackTraceVisitor : public StackVisitor {
   int32_t skip_depth_;
   // Current position down stack trace.
   uint32_t count_;
-  // Array of dex PC values.
+  // Number of frames to record.
+  uint32_t depth_;
+  // Array of dex PC values, used during transactions.
   mirror::IntArray* dex_pc_trace_;
+  // Array of tagged dex PC or native PC values, used outside of transactions.
+  mirror::LongArray* native_pc_trace_;
   // An array of the methods on the stack, the last entry is a reference to the PC trace.
   mirror::ObjectArray<mirror::Object>* method_trace_;
 };
@@ -1542,6 +1592,18 @@ template jobject Thread::CreateInternalStackTrace<false>(
 template jobject Thread::CreateInternalStackTrace<true>(
     const ScopedObjectAccessAlreadyRunnable& soa) const;
 
+uint32_t Thread::InternalStackTraceDexPc(mirror::ArtMethod* method, mirror::Object* pc_trace,
+                                         int32_t index) {
+  if (pc_trace->GetClass()->GetComponentType()->IsPrimitiveInt()) {
+    return pc_trace->AsIntArray()->Get(index);
+  }
+  uint64_t value = static_cast<uint64_t>(pc_trace->AsLongArray()->Get(index));
+  if ((value & kStackTraceDexPcFlag) != 0) {
+    return static_cast<uint32_t>(value);
+  }
+  return method->ToDexPc(static_cast<uintptr_t>(value));
+}
+
 jobjectArray Thread::InternalStackTraceToStackTraceElementArray(
     const ScopedObjectAccessAlreadyRunnable& soa, jobject internal, jobjectArray output_array,
     int* stack_depth) {
@@ -1587,8 +1649,7 @@ jobjectArray Thread::InternalStackTraceToStackTraceElementArray(
       class_name_object.Assign(method->GetDeclaringClass()->GetName());
       // source_name_object intentionally left null for proxy methods
     } else {
-      mirror::IntArray* pc_trace = down_cast<mirror::IntArray*>(method_trace->Get(depth));
-      uint32_t dex_pc = pc_trace->Get(i);
+      uint32_t dex_pc = InternalStackTraceDexPc(method, method_trace->Get(depth), i);
       line_number = method->GetLineNumFromDexPC(dex_pc);
       // Allocate element, potentially triggering GC
       // TODO: reuse class_name_object via Class::name_?
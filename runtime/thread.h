@@ -72,6 +72,7 @@ class DexFile;
 class JavaVMExt;
 struct JNIEnvExt;
 class Monitor;
+struct ReflectiveInvokePlan;
 class Runtime;
 class ScopedObjectAccessAlreadyRunnable;
 class ShadowFrame;
@@ -132,6 +133,9 @@ class Thread {
   static constexpr size_t kStackOverflowProtectedSize = 4 * KB;
   static const size_t kStackOverflowImplicitCheckSize;
 
+  // By default stack traces record every frame, see Runtime::GetMaxStackTraceDepth.
+  static constexpr size_t kDefaultMaxStackTraceDepth = 0;
+
   // Creates a new native thread corresponding to the given managed peer.
   // Used to implement Thread.start.
   static void CreateNativeThread(JNIEnv* env, jobject peer, size_t stack_size, bool daemon);
@@ -436,6 +440,37 @@ class Thread {
   }
   void Notify() LOCKS_EXCLUDED(wait_mutex_);
 
+  // Look up a native pc offset to dex pc translation for the given mapping table in this thread's
+  // cache, see ArtMethod::ToDexPc.
+  bool LookupPcToDexCache(const uint8_t* mapping_table, uint32_t native_pc_offset,
+                          uint32_t* dex_pc) const {
+    const PcToDexCacheEntry& entry = pc_to_dex_cache_[PcToDexCacheIndex(mapping_table,
+                                                                        native_pc_offset)];
+    if (entry.mapping_table == mapping_table && entry.native_pc_offset == native_pc_offset) {
+      *dex_pc = entry.dex_pc;
+      return true;
+    }
+    return false;
+  }
+
+  void UpdatePcToDexCache(const uint8_t* mapping_table, uint32_t native_pc_offset,
+                          uint32_t dex_pc) {
+    PcToDexCacheEntry& entry = pc_to_dex_cache_[PcToDexCacheIndex(mapping_table,
+                                                                  native_pc_offset)];
+    entry.mapping_table = mapping_table;
+    entry.native_pc_offset = native_pc_offset;
+    entry.dex_pc = dex_pc;
+  }
+
+  // Takes the Method.invoke plan of the given method out of this thread's cache, see
+  // InvokeMethod. Returns null if the plan is not cached. Plans are taken while in use so that
+  // reflective calls made meanwhile cannot change them, and are then put back with
+  // CacheReflectiveInvokePlan.
+  std::unique_ptr<ReflectiveInvokePlan> TakeReflectiveInvokePlan(mirror::ArtMethod* method);
+
+  // Caches a Method.invoke plan, evicting the plan of any other method using the same slot.
+  void CacheReflectiveInvokePlan(std::unique_ptr<ReflectiveInvokePlan> plan);
+
  private:
   void NotifyLocked(Thread* self) EXCLUSIVE_LOCKS_REQUIRED(wait_mutex_);
 
@@ -473,11 +508,19 @@ class Thread {
   void SetClassLoaderOverride(jobject class_loader_override);
 
   // Create the internal representation of a stack trace, that is more time
-  // and space efficient to compute than the StackTraceElement[].
+  // and space efficient to compute than the StackTraceElement[]. Outside of transactions, compiled
+  // frames record their raw native pc and the translation to a dex pc is deferred until the trace
+  // is converted, as most exceptions are caught without their trace ever being looked at.
   template<bool kTransactionActive>
   jobject CreateInternalStackTrace(const ScopedObjectAccessAlreadyRunnable& soa) const
       SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
 
+  // Get the dex pc of the given frame of an internal stack trace, given the method of that frame
+  // and the pc trace stored in the last element of the trace.
+  static uint32_t InternalStackTraceDexPc(mirror::ArtMethod* method, mirror::Object* pc_trace,
+                                          int32_t index)
+      SHARED_LOCKS_REQUIRED(Locks::mutator_lock_);
+
   // Convert an internal stack trace representation (returned by CreateInternalStackTrace) to a
   // StackTraceElement[]. If output_array is NULL, a new array is created, otherwise as many
   // frames as will fit are written into the given array. If stack_depth is non-NULL, it's updated
@@ -1162,6 +1205,29 @@ class Thread {
   // Thread "interrupted" status; stays raised until queried or thrown.
   bool interrupted_ GUARDED_BY(wait_mutex_);
 
+  // Small direct-mapped cache of recent native pc offset to dex pc translations. Stack walks for
+  // exceptions and profiling tend to revisit the same call sites, whose translation otherwise
+  // requires decoding the method's mapping table. Only accessed by the owning thread.
+  struct PcToDexCacheEntry {
+    const uint8_t* mapping_table;
+    uint32_t native_pc_offset;
+    uint32_t dex_pc;
+  };
+  static constexpr size_t kPcToDexCacheSize = 64;
+  static size_t PcToDexCacheIndex(const uint8_t* mapping_table, uint32_t native_pc_offset) {
+    return ((reinterpret_cast<uintptr_t>(mapping_table) >> 2) ^ native_pc_offset) &
+        (kPcToDexCacheSize - 1);
+  }
+  PcToDexCacheEntry pc_to_dex_cache_[kPcToDexCacheSize];
+
+  // Direct-mapped cache of Method.invoke marshalling plans. Only accessed by the owning thread.
+  static constexpr size_t kReflectiveInvokePlanCacheSize = 32;
+  static size_t ReflectiveInvokePlanIndex(mirror::ArtMethod* method) {
+    return (reinterpret_cast<uintptr_t>(method) / kObjectAlignment) &
+        (kReflectiveInvokePlanCacheSize - 1);
+  }
+  std::unique_ptr<ReflectiveInvokePlan> reflective_invoke_plans_[kReflectiveInvokePlanCacheSize];
+
   friend class Dbg;  // For SetStateUnsafe.
   friend class gc::collector::SemiSpace;  // For getting stack traces.
   friend class Runtime;  // For CreatePeer.
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "type_lookup_table.h"
+
+#include <string.h>
+
+#include <limits>
+
+#include "dex_file-inl.h"
+#include "utf.h"
+#include "utils.h"
+
+namespace art {
+
+TypeLookupTable::~TypeLookupTable() {
+}
+
+bool TypeLookupTable::SupportedSize(uint32_t num_class_defs) {
+  return num_class_defs != 0u && num_class_defs <= std::numeric_limits<uint16_t>::max();
+}
+
+uint32_t TypeLookupTable::Capacity(uint32_t num_class_defs) {
+  DCHECK(SupportedSize(num_class_defs));
+  // Keep at least half of the entries empty so that probe sequences stay short.
+  uint32_t capacity = 1u;
+  while (capacity < 2u * num_class_defs) {
+    capacity <<= 1;
+  }
+  return capacity;
+}
+
+size_t TypeLookupTable::RawDataLength(uint32_t num_class_defs) {
+  return SupportedSize(num_class_defs) ? Capacity(num_class_defs) * sizeof(Entry) : 0u;
+}
+
+TypeLookupTable* TypeLookupTable::Create(const DexFile& dex_file) {
+  const uint32_t num_class_defs = dex_file.NumClassDefs();
+  CHECK(SupportedSize(num_class_defs)) << dex_file.GetLocation();
+  const uint32_t capacity = Capacity(num_class_defs);
+  Entry* entries = new Entry[capacity];
+  memset(entries, 0, capacity * sizeof(Entry));
+  TypeLookupTable* table = new TypeLookupTable(dex_file, entries, entries);
+  for (uint32_t i = 0; i < num_class_defs; ++i) {
+    const char* descriptor = dex_file.GetClassDescriptor(dex_file.GetClassDef(i));
+    uint32_t str_offset = reinterpret_cast<const uint8_t*>(descriptor) - dex_file.Begin();
+    table->Insert(str_offset, static_cast<uint16_t>(i), ComputeUtf8Hash(descriptor));
+  }
+  return table;
+}
+
+TypeLookupTable* TypeLookupTable::Open(const uint8_t* raw_data, const DexFile& dex_file) {
+  DCHECK(SupportedSize(dex_file.NumClassDefs())) << dex_file.GetLocation();
+  DCHECK_ALIGNED(raw_data, sizeof(uint32_t));
+  return new TypeLookupTable(dex_file, nullptr, reinterpret_cast<const Entry*>(raw_data));
+}
+
+TypeLookupTable::TypeLookupTable(const DexFile& dex_file, Entry* owned_entries,
+                                 const Entry* entries)
+    : dex_file_(dex_file),
+      mask_(Capacity(dex_file.NumClassDefs()) - 1u),
+      owned_entries_(owned_entries),
+      entries_(entries) {
+}
+
+void TypeLookupTable::Insert(uint32_t str_offset, uint16_t class_def_idx, uint32_t hash) {
+  DCHECK_NE(str_offset, 0u);
+  Entry* entries = owned_entries_.get();
+  uint32_t pos = hash & mask_;
+  while (entries[pos].str_offset != 0u) {
+    pos = (pos + 1u) & mask_;
+  }
+  entries[pos].str_offset = str_offset;
+  entries[pos].class_def_idx = class_def_idx;
+  entries[pos].hash_bits = HashBits(hash);
+}
+
+uint32_t TypeLookupTable::Lookup(const char* descriptor, uint32_t hash) const {
+  const uint16_t hash_bits = HashBits(hash);
+  // The table is never full, so there is always an empty entry ending the probe sequence.
+  for (uint32_t pos = hash & mask_; entries_[pos].str_offset != 0u; pos = (pos + 1u) & mask_) {
+    const Entry& entry = entries_[pos];
+    if (entry.hash_bits == hash_bits) {
+      DCHECK_LT(entry.str_offset, dex_file_.Size()) << dex_file_.GetLocation();
+      const char* str = reinterpret_cast<const char*>(dex_file_.Begin() + entry.str_offset);
+      if (CompareModifiedUtf8ToModifiedUtf8AsUtf16CodePointValues(descriptor, str) == 0) {
+        return entry.class_def_idx;
+      }
+    }
+  }
+  return DexFile::kDexNoIndex;
+}
+
+}  // namespace art
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_TYPE_LOOKUP_TABLE_H_
+#define ART_RUNTIME_TYPE_LOOKUP_TABLE_H_
+
+#include <memory>
+
+#include "base/macros.h"
+
+namespace art {
+
+class DexFile;
+
+// A hash table from the class descriptors of a dex file to the indexes of their class defs.
+// dex2oat writes the table of each dex file to the oat file, so the runtime uses it straight from
+// the mapped oat file. For dex files that aren't in an oat file, the runtime builds the table.
+//
+// The table is open addressed with linear probing and at most half full. Each entry holds the
+// offset of the descriptor's string data in the dex file, the class def index and the high bits of
+// the descriptor's hash, which rule out most other descriptors without comparing strings.
+class TypeLookupTable {
+ public:
+  ~TypeLookupTable();
+
+  // Whether a dex file with num_class_defs class defs can have a table.
+  static bool SupportedSize(uint32_t num_class_defs);
+
+  // The size of the raw data of the table of a dex file with num_class_defs class defs.
+  static size_t RawDataLength(uint32_t num_class_defs);
+
+  // Build the table of dex_file, which must have a supported number of class defs.
+  static TypeLookupTable* Create(const DexFile& dex_file);
+
+  // Use the raw data of the table of dex_file at raw_data, which is not copied.
+  static TypeLookupTable* Open(const uint8_t* raw_data, const DexFile& dex_file);
+
+  // Returns the class def index of descriptor, whose ComputeUtf8Hash is hash, or
+  // DexFile::kDexNoIndex if dex_file has no class def for it.
+  uint32_t Lookup(const char* descriptor, uint32_t hash) const;
+
+  const uint8_t* RawData() const {
+    return reinterpret_cast<const uint8_t*>(entries_);
+  }
+
+  size_t RawDataLength() const {
+    return (mask_ + 1) * sizeof(Entry);
+  }
+
+ private:
+  struct Entry {
+    // Offset of the descriptor string data from the beginning of the dex file, 0 if empty.
+    uint32_t str_offset;
+    uint16_t class_def_idx;
+    uint16_t hash_bits;
+  };
+
+  static uint32_t Capacity(uint32_t num_class_defs);
+
+  static uint16_t HashBits(uint32_t hash) {
+    return static_cast<uint16_t>(hash >> 16);
+  }
+
+  TypeLookupTable(const DexFile& dex_file, Entry* owned_entries, const Entry* entries);
+
+  void Insert(uint32_t str_offset, uint16_t class_def_idx, uint32_t hash);
+
+  const DexFile& dex_file_;
+  const uint32_t mask_;
+  // The entries when the table was built rather than mapped, nullptr otherwise.
+  const std::unique_ptr<Entry[]> owned_entries_;
+  const Entry* const entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(TypeLookupTable);
+};
+
+}  // namespace art
+
+#endif  // ART_RUNTIME_TYPE_LOOKUP_TABLE_H_
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "type_lookup_table.h"
+
+#include <memory>
+
+#include "common_runtime_test.h"
+#include "dex_file-inl.h"
+#include "utf.h"
+
+namespace art {
+
+class TypeLookupTableTest : public CommonRuntimeTest {};
+
+TEST_F(TypeLookupTableTest, RawDataLength) {
+  EXPECT_EQ(0U, TypeLookupTable::RawDataLength(0));
+  EXPECT_EQ(0U, TypeLookupTable::RawDataLength(0x10000));
+  EXPECT_NE(0U, TypeLookupTable::RawDataLength(1));
+  // At most half of the entries are used.
+  EXPECT_EQ(2 * TypeLookupTable::RawDataLength(1), TypeLookupTable::RawDataLength(2));
+  EXPECT_EQ(TypeLookupTable::RawDataLength(4), TypeLookupTable::RawDataLength(3));
+  EXPECT_EQ(2 * TypeLookupTable::RawDataLength(4), TypeLookupTable::RawDataLength(5));
+}
+
+TEST_F(TypeLookupTableTest, Lookup) {
+  const DexFile* dex_file = java_lang_dex_file_;
+  std::unique_ptr<TypeLookupTable> table(TypeLookupTable::Create(*dex_file));
+  ASSERT_EQ(TypeLookupTable::RawDataLength(dex_file->NumClassDefs()), table->RawDataLength());
+  // A table opened on the raw data, like one mapped from an oat file, gives the same results.
+  std::unique_ptr<TypeLookupTable> opened_table(TypeLookupTable::Open(table->RawData(),
+                                                                      *dex_file));
+  for (uint32_t i = 0; i < dex_file->NumClassDefs(); ++i) {
+    const char* descriptor = dex_file->GetClassDescriptor(dex_file->GetClassDef(i));
+    const uint32_t hash = ComputeUtf8Hash(descriptor);
+    EXPECT_EQ(i, table->Lookup(descriptor, hash)) << descriptor;
+    EXPECT_EQ(i, opened_table->Lookup(descriptor, hash)) << descriptor;
+  }
+  const char* missing = "Ljava/lang/DoesNotExist;";
+  EXPECT_EQ(DexFile::kDexNoIndex, table->Lookup(missing, ComputeUtf8Hash(missing)));
+  // Array descriptors never have class defs.
+  const char* array = "[Ljava/lang/Object;";
+  EXPECT_EQ(DexFile::kDexNoIndex, table->Lookup(array, ComputeUtf8Hash(array)));
+}
+
+}  // namespace art
@@ -25,6 +25,7 @@
 
 #include "base/stringprintf.h"
 #include "base/unix_file/fd_file.h"
+#include "utils.h"
 
 namespace art {
 
@@ -36,6 +37,15 @@ uint32_t ZipEntry::GetCrc32() {
   return zip_entry_->crc32;
 }
 
+bool ZipEntry::IsUncompressed() {
+  return zip_entry_->method == kCompressStored;
+}
+
+bool ZipEntry::IsAlignedTo(size_t alignment) {
+  DCHECK(IsPowerOfTwo(alignment)) << alignment;
+  return IsAlignedParam(zip_entry_->offset, static_cast<int>(alignment));
+}
+
 ZipEntry::~ZipEntry() {
   delete zip_entry_;
 }
@@ -73,6 +83,21 @@ MemMap* ZipEntry::ExtractToMemMap(const char* zip_filename, const char* entry_fi
   return map.release();
 }
 
+MemMap* ZipEntry::MapDirectlyFromFile(const char* zip_filename, std::string* error_msg) {
+  CHECK(IsUncompressed());
+  const int zip_fd = GetFileDescriptor(handle_);
+  // A private mapping keeps the pages clean and shared with other mappings of the zip file until
+  // something makes them writable and writes them, which never reaches the file.
+  std::unique_ptr<MemMap> map(MemMap::MapFile(GetUncompressedLength(), PROT_READ, MAP_PRIVATE,
+                                              zip_fd, zip_entry_->offset, zip_filename,
+                                              error_msg));
+  if (map.get() == nullptr) {
+    DCHECK(!error_msg->empty());
+    return nullptr;
+  }
+  return map.release();
+}
+
 static void SetCloseOnExec(int fd) {
   // This dance is more portable than Linux's O_CLOEXEC open(2) flag.
   int flags = fcntl(fd, F_GETFD);
@@ -39,11 +39,20 @@ class ZipEntry {
   bool ExtractToFile(File& file, std::string* error_msg);
   MemMap* ExtractToMemMap(const char* zip_filename, const char* entry_filename,
                           std::string* error_msg);
+  // Map an uncompressed entry read only and private straight from the zip file, rather than
+  // copying it like ExtractToMemMap. Unlike extraction, this doesn't check the CRC32.
+  MemMap* MapDirectlyFromFile(const char* zip_filename, std::string* error_msg);
   virtual ~ZipEntry();
 
   uint32_t GetUncompressedLength();
   uint32_t GetCrc32();
 
+  // Whether the entry is stored rather than compressed.
+  bool IsUncompressed();
+
+  // Whether the data of the entry starts at a multiple of alignment in the zip file.
+  bool IsAlignedTo(size_t alignment);
+
  private:
   ZipEntry(ZipArchiveHandle handle,
            ::ZipEntry* zip_entry) : handle_(handle), zip_entry_(zip_entry) {}
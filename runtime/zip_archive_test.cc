@@ -21,14 +21,79 @@
 #include <sys/types.h>
 #include <zlib.h>
 #include <memory>
+#include <vector>
 
 #include "base/unix_file/fd_file.h"
 #include "common_runtime_test.h"
 #include "os.h"
+#include "utils.h"
 
 namespace art {
 
-class ZipArchiveTest : public CommonRuntimeTest {};
+class ZipArchiveTest : public CommonRuntimeTest {
+ protected:
+  static void Put16(std::vector<uint8_t>* zip, uint16_t value) {
+    zip->push_back(value & 0xff);
+    zip->push_back(value >> 8);
+  }
+
+  static void Put32(std::vector<uint8_t>* zip, uint32_t value) {
+    Put16(zip, value & 0xffff);
+    Put16(zip, value >> 16);
+  }
+
+  // A zip file with the single stored entry name, padded with the extra field of its local
+  // header so that its data is 4 byte aligned, like zipalign does.
+  static std::vector<uint8_t> MakeStoredZip(const std::string& name,
+                                            const std::vector<uint8_t>& data) {
+    const uint32_t kLocalHeaderSize = 30;
+    const uint32_t crc = crc32(crc32(0L, Z_NULL, 0), &data[0], data.size());
+    const uint16_t extra_size = RoundUp(kLocalHeaderSize + name.size(), 4) -
+        (kLocalHeaderSize + name.size());
+    std::vector<uint8_t> zip;
+    Put32(&zip, 0x04034b50);  // Local file header signature.
+    Put16(&zip, 10);  // Version needed.
+    Put16(&zip, 0);  // Flags.
+    Put16(&zip, 0);  // Stored.
+    Put32(&zip, 0);  // Modification time and date.
+    Put32(&zip, crc);
+    Put32(&zip, data.size());  // Compressed size.
+    Put32(&zip, data.size());  // Uncompressed size.
+    Put16(&zip, name.size());
+    Put16(&zip, extra_size);
+    zip.insert(zip.end(), name.begin(), name.end());
+    zip.insert(zip.end(), extra_size, 0);
+    zip.insert(zip.end(), data.begin(), data.end());
+    const uint32_t central_directory_offset = zip.size();
+    Put32(&zip, 0x02014b50);  // Central directory file header signature.
+    Put16(&zip, 10);  // Version made by.
+    Put16(&zip, 10);  // Version needed.
+    Put16(&zip, 0);  // Flags.
+    Put16(&zip, 0);  // Stored.
+    Put32(&zip, 0);  // Modification time and date.
+    Put32(&zip, crc);
+    Put32(&zip, data.size());  // Compressed size.
+    Put32(&zip, data.size());  // Uncompressed size.
+    Put16(&zip, name.size());
+    Put16(&zip, 0);  // Extra field length.
+    Put16(&zip, 0);  // Comment length.
+    Put16(&zip, 0);  // Disk number start.
+    Put16(&zip, 0);  // Internal attributes.
+    Put32(&zip, 0);  // External attributes.
+    Put32(&zip, 0);  // Local header offset.
+    zip.insert(zip.end(), name.begin(), name.end());
+    const uint32_t central_directory_size = zip.size() - central_directory_offset;
+    Put32(&zip, 0x06054b50);  // End of central directory signature.
+    Put16(&zip, 0);  // Disk number.
+    Put16(&zip, 0);  // Disk with the central directory.
+    Put16(&zip, 1);  // Entries on this disk.
+    Put16(&zip, 1);  // Entries.
+    Put32(&zip, central_directory_size);
+    Put32(&zip, central_directory_offset);
+    Put16(&zip, 0);  // Comment length.
+    return zip;
+  }
+};
 
 TEST_F(ZipArchiveTest, FindAndExtract) {
   std::string error_msg;
@@ -63,4 +128,38 @@ TEST_F(ZipArchiveTest, FindAndExtract) {
   EXPECT_EQ(zip_entry->GetCrc32(), computed_crc);
 }
 
+TEST_F(ZipArchiveTest, MapDirectlyFromFile) {
+  std::vector<uint8_t> data;
+  for (size_t i = 0; i < 3 * kPageSize; ++i) {
+    data.push_back(i * 7);
+  }
+  std::vector<uint8_t> zip = MakeStoredZip("classes.dex", data);
+  ScratchFile tmp;
+  ASSERT_TRUE(tmp.GetFile()->WriteFully(&zip[0], zip.size()));
+
+  std::string error_msg;
+  std::unique_ptr<ZipArchive> zip_archive(ZipArchive::Open(tmp.GetFilename().c_str(),
+                                                           &error_msg));
+  ASSERT_TRUE(zip_archive.get() != nullptr) << error_msg;
+  std::unique_ptr<ZipEntry> zip_entry(zip_archive->Find("classes.dex", &error_msg));
+  ASSERT_TRUE(zip_entry.get() != nullptr) << error_msg;
+  EXPECT_TRUE(zip_entry->IsUncompressed());
+  EXPECT_TRUE(zip_entry->IsAlignedTo(4));
+
+  std::unique_ptr<MemMap> map(zip_entry->MapDirectlyFromFile(tmp.GetFilename().c_str(),
+                                                             &error_msg));
+  ASSERT_TRUE(map.get() != nullptr) << error_msg;
+  EXPECT_EQ(PROT_READ, map->GetProtect());
+  ASSERT_EQ(data.size(), map->Size());
+  EXPECT_EQ(0, memcmp(&data[0], map->Begin(), data.size()));
+
+  // Writes to the mapping, like the quickener's, don't reach the zip file.
+  ASSERT_TRUE(map->Protect(PROT_READ | PROT_WRITE));
+  map->Begin()[0] = ~data[0];
+  std::unique_ptr<MemMap> other_map(zip_entry->MapDirectlyFromFile(tmp.GetFilename().c_str(),
+                                                                   &error_msg));
+  ASSERT_TRUE(other_map.get() != nullptr) << error_msg;
+  EXPECT_EQ(data[0], other_map->Begin()[0]);
+}
+
 }  // namespace art
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Note that $opt$ is a marker for the optimizing compiler to ensure
+// it does compile the method.
+public class Main {
+
+  public static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  public static void expectEquals(long expected, long result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  public static void main(String[] args) {
+    expectEquals(5, $opt$DivOrDefault(10, 2));
+    expectEquals(-1, $opt$DivOrDefault(10, 0));
+
+    // The catch block sees the value of the local at the throwing instruction.
+    expectEquals(42, $opt$LocalModifiedInTry(new int[] { 1, 2 }, 0));
+    expectEquals(1, $opt$LocalModifiedInTry(new int[] { 1, 2 }, 1));
+    expectEquals(1, $opt$LocalModifiedInTry(null, 0));
+
+    expectEquals(42L, $opt$WideLocal(42L, 0));
+    expectEquals(21L, $opt$WideLocal(42L, 2));
+
+    expectEquals(4, $opt$Retry(new int[] { 0, 0, 0, 7 }));
+    expectEquals(0, $opt$Retry(new int[] { 0 }));
+
+    expectEquals(112, $opt$Nested(0, 0));
+    expectEquals(13, $opt$Nested(1, 0));
+    expectEquals(2, $opt$Nested(1, 2));
+
+    expectEquals(10, $opt$ThrowAndCatch(10));
+    expectEquals(-10, $opt$ThrowAndCatch(-10));
+
+    expectEquals(6, $opt$CatchInLoop(new int[] { 1, 0, 2, 0, 3 }));
+
+    try {
+      $opt$Rethrow(0);
+      throw new Error("Expected ArithmeticException");
+    } catch (ArithmeticException e) {
+      // Expected.
+    }
+  }
+
+  static int $opt$DivOrDefault(int a, int b) {
+    try {
+      return a / b;
+    } catch (ArithmeticException e) {
+      return -1;
+    }
+  }
+
+  static int $opt$LocalModifiedInTry(int[] array, int index) {
+    int result = 0;
+    try {
+      result = 1;
+      result += array[index + 1];
+      result = 42;
+      result = array[index + 2];
+    } catch (NullPointerException e) {
+      return result;
+    } catch (ArrayIndexOutOfBoundsException e) {
+      return result;
+    }
+    return -1;
+  }
+
+  static long $opt$WideLocal(long value, int divisor) {
+    long result = value;
+    try {
+      result = value / divisor;
+    } catch (ArithmeticException e) {
+      return result;
+    }
+    return result;
+  }
+
+  static int $opt$Retry(int[] divisors) {
+    int attempts = 0;
+    while (true) {
+      try {
+        attempts++;
+        int unused = 7 / divisors[attempts - 1];
+        return attempts;
+      } catch (ArithmeticException e) {
+        // Try the next divisor.
+      } catch (ArrayIndexOutOfBoundsException e) {
+        return 0;
+      }
+    }
+  }
+
+  static int $opt$Nested(int a, int b) {
+    int result = 100;
+    try {
+      result += 10;
+      try {
+        result = 10 / a;
+        result += 1;
+        result = 10 / b;
+      } catch (ArithmeticException e) {
+        result += 1;
+      }
+      result = result / b;
+    } catch (ArithmeticException e) {
+      result += 1;
+    }
+    return result;
+  }
+
+  static int $opt$ThrowAndCatch(int value) {
+    try {
+      if (value < 0) {
+        throw new IllegalArgumentException();
+      }
+      return value;
+    } catch (IllegalArgumentException e) {
+      return value;
+    }
+  }
+
+  static int $opt$CatchInLoop(int[] divisors) {
+    int sum = 0;
+    for (int i = 0; i < divisors.length; i++) {
+      try {
+        sum += divisors[i] / divisors[i];
+        sum += divisors[i] - 1;
+      } catch (ArithmeticException e) {
+        // Skip zero divisors.
+      }
+    }
+    return sum;
+  }
+
+  static int $opt$Rethrow(int divisor) {
+    try {
+      return 1 / divisor;
+    } catch (ArithmeticException e) {
+      throw e;
+    }
+  }
+}
@@ -0,0 +1,416 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Note that $opt$ is a marker for the optimizing compiler to ensure
+// it does compile the method. The compiled methods only take and return
+// integral and reference types, as the ARM backend does not compile methods
+// with floating point arguments yet.
+
+interface Itf {
+  int $opt$Value();
+}
+
+class Base {
+  int value() {
+    return 1;
+  }
+}
+
+class Derived extends Base implements Itf {
+  int value() {
+    return 2;
+  }
+
+  public int $opt$Value() {
+    return 3;
+  }
+
+  int $opt$SuperValue() {
+    return super.value();
+  }
+}
+
+class Other implements Itf {
+  public int $opt$Value() {
+    return 4;
+  }
+}
+
+class Holder {
+  static boolean booleanField;
+  static byte byteField;
+  static char charField;
+  static short shortField;
+  static int intField;
+  static long longField;
+  static Object objectField;
+}
+
+class Initialized {
+  static int value;
+
+  static {
+    value = 42;
+    Main.initialized = true;
+  }
+}
+
+public class Main {
+  static boolean initialized;
+  static int counter;
+
+  public static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  public static void expectEquals(long expected, long result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  public static void expectEquals(Object expected, Object result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  public static void expectTrue(boolean result) {
+    if (!result) {
+      throw new Error("Expected true");
+    }
+  }
+
+  public static void expectFalse(boolean result) {
+    if (result) {
+      throw new Error("Expected false");
+    }
+  }
+
+  public static void main(String[] args) {
+    staticFields();
+    typeChecks();
+    calls();
+    conversions();
+    longShifts();
+    longDivisions();
+  }
+
+  private static void staticFields() {
+    $opt$IncrementCounter();
+    $opt$IncrementCounter();
+    expectEquals(2, counter);
+
+    $opt$SetFields(true, (byte) -2, 'c', (short) -3, 4, 5L, "field");
+    expectTrue(Holder.booleanField);
+    expectEquals(-2, Holder.byteField);
+    expectEquals('c', Holder.charField);
+    expectEquals(-3, Holder.shortField);
+    expectEquals(4, Holder.intField);
+    expectEquals(5L, Holder.longField);
+    expectEquals("field", Holder.objectField);
+    expectEquals(-2 + 'c' - 3 + 4, $opt$SumFields());
+    expectEquals(5L, $opt$GetLongField());
+    expectEquals("field", $opt$GetObjectField());
+
+    // Reading a static field of another class runs its initializer first.
+    expectFalse(initialized);
+    expectEquals(42, $opt$GetInitializedValue());
+    expectTrue(initialized);
+  }
+
+  private static void typeChecks() {
+    expectEquals(Base.class, $opt$BaseClass());
+    expectEquals(Main.class, $opt$MainClass());
+
+    expectTrue($opt$InstanceOfBase(new Base()));
+    expectTrue($opt$InstanceOfBase(new Derived()));
+    expectFalse($opt$InstanceOfBase(new Other()));
+    expectFalse($opt$InstanceOfBase(null));
+    expectTrue($opt$InstanceOfItf(new Derived()));
+    expectTrue($opt$InstanceOfItf(new Other()));
+    expectFalse($opt$InstanceOfItf(new Base()));
+
+    Derived derived = new Derived();
+    expectEquals(derived, $opt$CastToBase(derived));
+    expectEquals(null, $opt$CastToBase(null));
+    try {
+      $opt$CastToBase(new Other());
+      throw new Error("Expected ClassCastException");
+    } catch (ClassCastException e) {
+      // Expected.
+    }
+  }
+
+  private static void calls() {
+    expectEquals(3, $opt$CallInterface(new Derived()));
+    expectEquals(4, $opt$CallInterface(new Other()));
+    expectEquals(1, new Derived().$opt$SuperValue());
+  }
+
+  private static void conversions() {
+    expectEquals(16777216, $opt$IntToFloatToInt(16777217));
+    expectEquals(-16777216, $opt$IntToFloatToInt(-16777217));
+    expectEquals(Integer.MAX_VALUE, $opt$IntToDoubleToInt(Integer.MAX_VALUE));
+    expectEquals(Integer.MIN_VALUE, $opt$IntToDoubleToInt(Integer.MIN_VALUE));
+    expectEquals(9007199254740992L, $opt$LongToDoubleToLong(9007199254740993L));
+    expectEquals(Long.MIN_VALUE, $opt$LongToDoubleToLong(Long.MIN_VALUE));
+    expectEquals(Long.MAX_VALUE, $opt$LongToDoubleToLong(Long.MAX_VALUE));
+    expectEquals(Long.MIN_VALUE, $opt$LongToFloatToLong(Long.MIN_VALUE));
+    expectEquals(Long.MAX_VALUE, $opt$LongToFloatToLong(Long.MAX_VALUE));
+    expectEquals(-1099511627776L, $opt$LongToFloatToLong(-1099511627776L));
+    expectEquals(16777216L, $opt$LongToDoubleToFloatToLong(16777217L));
+
+    // Floating point values larger than the integral type saturate.
+    expectEquals(Integer.MAX_VALUE, $opt$LongToFloatToInt(Long.MAX_VALUE));
+    expectEquals(Integer.MIN_VALUE, $opt$LongToFloatToInt(Long.MIN_VALUE));
+    expectEquals(Integer.MAX_VALUE, $opt$LongToDoubleToInt(1L << 40));
+    expectEquals(Integer.MIN_VALUE, $opt$LongToDoubleToInt(-(1L << 40)));
+
+    // Conversions round toward zero, and NaN converts to zero.
+    expectEquals(-1, $opt$NegativeFractionToInt());
+    expectEquals(1L, $opt$PositiveFractionToLong());
+    expectEquals(0, $opt$FloatNaNToInt());
+    expectEquals(0L, $opt$FloatNaNToLong());
+    expectEquals(0, $opt$DoubleNaNToInt());
+    expectEquals(0L, $opt$DoubleNaNToLong());
+  }
+
+  private static void longShifts() {
+    expectEquals(2L, $opt$Shl(1L, 1));
+    expectEquals(1L << 32, $opt$Shl(1L, 32));
+    expectEquals(Long.MIN_VALUE, $opt$Shl(1L, 63));
+    // Only the low 6 bits of the distance are used.
+    expectEquals(2L, $opt$Shl(1L, 65));
+    expectEquals(1L, $opt$Shl(1L, 64));
+    expectEquals(-1L, $opt$Shr(Long.MIN_VALUE, 63));
+    expectEquals(-(1L << 31), $opt$Shr(Long.MIN_VALUE, 32));
+    expectEquals(-2L, $opt$Shr(-3L, 1));
+    expectEquals(1L, $opt$UShr(Long.MIN_VALUE, 63));
+    expectEquals(1L << 31, $opt$UShr(Long.MIN_VALUE, 32));
+    expectEquals(Long.MAX_VALUE, $opt$UShr(-1L, 65));
+
+    expectEquals(0x123456789L << 1, $opt$ShlConst1(0x123456789L));
+    expectEquals(0x123456789L << 32, $opt$ShlConst32(0x123456789L));
+    expectEquals(0x123456789L << 33, $opt$ShlConst33(0x123456789L));
+    expectEquals(-0x123456789L >> 1, $opt$ShrConst1(-0x123456789L));
+    expectEquals(-0x123456789L >> 32, $opt$ShrConst32(-0x123456789L));
+    expectEquals(-0x123456789L >> 33, $opt$ShrConst33(-0x123456789L));
+    expectEquals(-0x123456789L >>> 1, $opt$UShrConst1(-0x123456789L));
+    expectEquals(-0x123456789L >>> 32, $opt$UShrConst32(-0x123456789L));
+    expectEquals(-0x123456789L >>> 33, $opt$UShrConst33(-0x123456789L));
+    expectEquals(-0x123456789L >>> 1, $opt$UShrConst65(-0x123456789L));
+  }
+
+  private static void longDivisions() {
+    expectEquals(3L, $opt$Div(10L, 3L));
+    expectEquals(-3L, $opt$Div(-10L, 3L));
+    expectEquals(1L << 31, $opt$Div(1L << 40, 1L << 9));
+    expectEquals(Long.MIN_VALUE, $opt$Div(Long.MIN_VALUE, -1L));
+    expectEquals(1L, $opt$Rem(10L, 3L));
+    expectEquals(-1L, $opt$Rem(-10L, 3L));
+    expectEquals(1L, $opt$Rem(10L, -3L));
+    expectEquals(0L, $opt$Rem(Long.MIN_VALUE, -1L));
+    expectEquals(7L, $opt$Rem(7L, 1L << 40));
+
+    try {
+      $opt$Div(1L, 0L);
+      throw new Error("Expected ArithmeticException");
+    } catch (ArithmeticException e) {
+      // Expected.
+    }
+    try {
+      $opt$Rem(1L, 0L);
+      throw new Error("Expected ArithmeticException");
+    } catch (ArithmeticException e) {
+      // Expected.
+    }
+  }
+
+  static void $opt$IncrementCounter() {
+    counter++;
+  }
+
+  static void $opt$SetFields(boolean z, byte b, char c, short s, int i, long j, Object o) {
+    Holder.booleanField = z;
+    Holder.byteField = b;
+    Holder.charField = c;
+    Holder.shortField = s;
+    Holder.intField = i;
+    Holder.longField = j;
+    Holder.objectField = o;
+  }
+
+  static int $opt$SumFields() {
+    return Holder.byteField + Holder.charField + Holder.shortField + Holder.intField;
+  }
+
+  static long $opt$GetLongField() {
+    return Holder.longField;
+  }
+
+  static Object $opt$GetObjectField() {
+    return Holder.objectField;
+  }
+
+  static int $opt$GetInitializedValue() {
+    return Initialized.value;
+  }
+
+  static Class $opt$BaseClass() {
+    return Base.class;
+  }
+
+  static Class $opt$MainClass() {
+    return Main.class;
+  }
+
+  static boolean $opt$InstanceOfBase(Object o) {
+    return o instanceof Base;
+  }
+
+  static boolean $opt$InstanceOfItf(Object o) {
+    return o instanceof Itf;
+  }
+
+  static Base $opt$CastToBase(Object o) {
+    return (Base) o;
+  }
+
+  static int $opt$CallInterface(Itf itf) {
+    return itf.$opt$Value();
+  }
+
+  static int $opt$IntToFloatToInt(int a) {
+    return (int) (float) a;
+  }
+
+  static int $opt$IntToDoubleToInt(int a) {
+    return (int) (double) a;
+  }
+
+  static long $opt$LongToDoubleToLong(long a) {
+    return (long) (double) a;
+  }
+
+  static long $opt$LongToFloatToLong(long a) {
+    return (long) (float) a;
+  }
+
+  static long $opt$LongToDoubleToFloatToLong(long a) {
+    return (long) (float) (double) a;
+  }
+
+  static int $opt$LongToFloatToInt(long a) {
+    return (int) (float) a;
+  }
+
+  static int $opt$LongToDoubleToInt(long a) {
+    return (int) (double) a;
+  }
+
+  static int $opt$NegativeFractionToInt() {
+    float f = -1.5f;
+    return (int) f;
+  }
+
+  static long $opt$PositiveFractionToLong() {
+    double d = 1.75;
+    return (long) d;
+  }
+
+  static int $opt$FloatNaNToInt() {
+    float f = Float.NaN;
+    return (int) f;
+  }
+
+  static long $opt$FloatNaNToLong() {
+    float f = Float.NaN;
+    return (long) f;
+  }
+
+  static int $opt$DoubleNaNToInt() {
+    double d = Double.NaN;
+    return (int) d;
+  }
+
+  static long $opt$DoubleNaNToLong() {
+    double d = Double.NaN;
+    return (long) d;
+  }
+
+  static long $opt$Shl(long a, int b) {
+    return a << b;
+  }
+
+  static long $opt$Shr(long a, int b) {
+    return a >> b;
+  }
+
+  static long $opt$UShr(long a, int b) {
+    return a >>> b;
+  }
+
+  static long $opt$ShlConst1(long a) {
+    return a << 1;
+  }
+
+  static long $opt$ShlConst32(long a) {
+    return a << 32;
+  }
+
+  static long $opt$ShlConst33(long a) {
+    return a << 33;
+  }
+
+  static long $opt$ShrConst1(long a) {
+    return a >> 1;
+  }
+
+  static long $opt$ShrConst32(long a) {
+    return a >> 32;
+  }
+
+  static long $opt$ShrConst33(long a) {
+    return a >> 33;
+  }
+
+  static long $opt$UShrConst1(long a) {
+    return a >>> 1;
+  }
+
+  static long $opt$UShrConst32(long a) {
+    return a >>> 32;
+  }
+
+  static long $opt$UShrConst33(long a) {
+    return a >>> 33;
+  }
+
+  static long $opt$UShrConst65(long a) {
+    return a >>> 65;
+  }
+
+  static long $opt$Div(long a, long b) {
+    return a / b;
+  }
+
+  static long $opt$Rem(long a, long b) {
+    return a % b;
+  }
+}
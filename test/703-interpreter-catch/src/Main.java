@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class Main {
+    int field;
+    int zero;
+
+    public static void main(String[] args) {
+        Main m = new Main();
+
+        // The catch handlers below all start with move-exception, as they use the exception.
+        try {
+            throwStatic("static");
+            System.out.println("not reached");
+        } catch (IllegalStateException e) {
+            System.out.println("caught invoke: " + e.getMessage());
+        }
+
+        try {
+            m.throwVirtual("virtual");
+            System.out.println("not reached");
+        } catch (IllegalStateException e) {
+            System.out.println("caught invoke: " + e.getMessage());
+        }
+
+        // Go back and forth between the try block and the handler, so that the handler is entered
+        // both from the instruction that threw and after resuming.
+        int caught = 0;
+        for (int i = 0; i < 1000; i++) {
+            try {
+                m.throwVirtual("loop");
+            } catch (IllegalStateException e) {
+                if (e.getMessage().equals("loop")) {
+                    caught++;
+                }
+            }
+        }
+        System.out.println("caught invoke " + caught + " times");
+
+        try {
+            Main none = null;
+            System.out.println(none.field);
+        } catch (NullPointerException e) {
+            System.out.println("caught field access: " + e.getClass().getSimpleName());
+        }
+
+        try {
+            System.out.println(m.field / m.zero);
+        } catch (ArithmeticException e) {
+            System.out.println("caught division: " + e.getClass().getSimpleName());
+        }
+
+        try {
+            callThrow(3);
+        } catch (IllegalStateException e) {
+            System.out.println("caught in caller: " + e.getMessage());
+        }
+
+        try {
+            rethrow();
+        } catch (IllegalArgumentException e) {
+            System.out.println("caught after rethrow: " + e.getMessage());
+        }
+
+        System.out.println("done");
+    }
+
+    static void throwStatic(String message) {
+        throw new IllegalStateException(message);
+    }
+
+    void throwVirtual(String message) {
+        field++;
+        throw new IllegalStateException(message);
+    }
+
+    static void callThrow(int depth) {
+        if (depth == 0) {
+            throwStatic("deep");
+        }
+        callThrow(depth - 1);
+    }
+
+    static void rethrow() {
+        try {
+            throwStatic("first");
+        } catch (IllegalStateException e) {
+            throw new IllegalArgumentException("rethrown", e);
+        }
+    }
+}
@@ -0,0 +1,438 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// A deep class hierarchy with wide vtables for timing class linking. Every level overrides the
+// b methods of Level0 and adds methods of its own, the leaf implements Base with them.
+class DeepHierarchy {
+    interface Base {
+        public void b0();
+        public void b1();
+        public void b2();
+        public void b3();
+        public void b4();
+        public void b5();
+        public void b6();
+        public void b7();
+    }
+    static class Level0 {
+        public void b0() {}
+        public void b1() {}
+        public void b2() {}
+        public void b3() {}
+        public void b4() {}
+        public void b5() {}
+        public void b6() {}
+        public void b7() {}
+        public void m0_0() {}
+        public void m0_1() {}
+        public void m0_2() {}
+        public void m0_3() {}
+        public void m0_4() {}
+        public void m0_5() {}
+        public void m0_6() {}
+        public void m0_7() {}
+        public void m0_8() {}
+        public void m0_9() {}
+        public void m0_10() {}
+        public void m0_11() {}
+        public void m0_12() {}
+        public void m0_13() {}
+        public void m0_14() {}
+        public void m0_15() {}
+        public void m0_16() {}
+        public void m0_17() {}
+        public void m0_18() {}
+        public void m0_19() {}
+        public void m0_20() {}
+        public void m0_21() {}
+        public void m0_22() {}
+        public void m0_23() {}
+    }
+    static class Level1 extends Level0 {
+        public void b0() {}
+        public void b1() {}
+        public void b2() {}
+        public void b3() {}
+        public void b4() {}
+        public void b5() {}
+        public void b6() {}
+        public void b7() {}
+        public void m1_0() {}
+        public void m1_1() {}
+        public void m1_2() {}
+        public void m1_3() {}
+        public void m1_4() {}
+        public void m1_5() {}
+        public void m1_6() {}
+        public void m1_7() {}
+        public void m1_8() {}
+        public void m1_9() {}
+        public void m1_10() {}
+        public void m1_11() {}
+        public void m1_12() {}
+        public void m1_13() {}
+        public void m1_14() {}
+        public void m1_15() {}
+        public void m1_16() {}
+        public void m1_17() {}
+        public void m1_18() {}
+        public void m1_19() {}
+        public void m1_20() {}
+        public void m1_21() {}
+        public void m1_22() {}
+        public void m1_23() {}
+    }
+    static class Level2 extends Level1 {
+        public void b0() {}
+        public void b1() {}
+        public void b2() {}
+        public void b3() {}
+        public void b4() {}
+        public void b5() {}
+        public void b6() {}
+        public void b7() {}
+        public void m2_0() {}
+        public void m2_1() {}
+        public void m2_2() {}
+        public void m2_3() {}
+        public void m2_4() {}
+        public void m2_5() {}
+        public void m2_6() {}
+        public void m2_7() {}
+        public void m2_8() {}
+        public void m2_9() {}
+        public void m2_10() {}
+        public void m2_11() {}
+        public void m2_12() {}
+        public void m2_13() {}
+        public void m2_14() {}
+        public void m2_15() {}
+        public void m2_16() {}
+        public void m2_17() {}
+        public void m2_18() {}
+        public void m2_19() {}
+        public void m2_20() {}
+        public void m2_21() {}
+        public void m2_22() {}
+        public void m2_23() {}
+    }
+    static class Level3 extends Level2 {
+        public void b0() {}
+        public void b1() {}
+        public void b2() {}
+        public void b3() {}
+        public void b4() {}
+        public void b5() {}
+        public void b6() {}
+        public void b7() {}
+        public void m3_0() {}
+        public void m3_1() {}
+        public void m3_2() {}
+        public void m3_3() {}
+        public void m3_4() {}
+        public void m3_5() {}
+        public void m3_6() {}
+        public void m3_7() {}
+        public void m3_8() {}
+        public void m3_9() {}
+        public void m3_10() {}
+        public void m3_11() {}
+        public void m3_12() {}
+        public void m3_13() {}
+        public void m3_14() {}
+        public void m3_15() {}
+        public void m3_16() {}
+        public void m3_17() {}
+        public void m3_18() {}
+        public void m3_19() {}
+        public void m3_20() {}
+        public void m3_21() {}
+        public void m3_22() {}
+        public void m3_23() {}
+    }
+    static class Level4 extends Level3 {
+        public void b0() {}
+        public void b1() {}
+        public void b2() {}
+        public void b3() {}
+        public void b4() {}
+        public void b5() {}
+        public void b6() {}
+        public void b7() {}
+        public void m4_0() {}
+        public void m4_1() {}
+        public void m4_2() {}
+        public void m4_3() {}
+        public void m4_4() {}
+        public void m4_5() {}
+        public void m4_6() {}
+        public void m4_7() {}
+        public void m4_8() {}
+        public void m4_9() {}
+        public void m4_10() {}
+        public void m4_11() {}
+        public void m4_12() {}
+        public void m4_13() {}
+        public void m4_14() {}
+        public void m4_15() {}
+        public void m4_16() {}
+        public void m4_17() {}
+        public void m4_18() {}
+        public void m4_19() {}
+        public void m4_20() {}
+        public void m4_21() {}
+        public void m4_22() {}
+        public void m4_23() {}
+    }
+    static class Level5 extends Level4 {
+        public void b0() {}
+        public void b1() {}
+        public void b2() {}
+        public void b3() {}
+        public void b4() {}
+        public void b5() {}
+        public void b6() {}
+        public void b7() {}
+        public void m5_0() {}
+        public void m5_1() {}
+        public void m5_2() {}
+        public void m5_3() {}
+        public void m5_4() {}
+        public void m5_5() {}
+        public void m5_6() {}
+        public void m5_7() {}
+        public void m5_8() {}
+        public void m5_9() {}
+        public void m5_10() {}
+        public void m5_11() {}
+        public void m5_12() {}
+        public void m5_13() {}
+        public void m5_14() {}
+        public void m5_15() {}
+        public void m5_16() {}
+        public void m5_17() {}
+        public void m5_18() {}
+        public void m5_19() {}
+        public void m5_20() {}
+        public void m5_21() {}
+        public void m5_22() {}
+        public void m5_23() {}
+    }
+    static class Level6 extends Level5 {
+        public void b0() {}
+        public void b1() {}
+        public void b2() {}
+        public void b3() {}
+        public void b4() {}
+        public void b5() {}
+        public void b6() {}
+        public void b7() {}
+        public void m6_0() {}
+        public void m6_1() {}
+        public void m6_2() {}
+        public void m6_3() {}
+        public void m6_4() {}
+        public void m6_5() {}
+        public void m6_6() {}
+        public void m6_7() {}
+        public void m6_8() {}
+        public void m6_9() {}
+        public void m6_10() {}
+        public void m6_11() {}
+        public void m6_12() {}
+        public void m6_13() {}
+        public void m6_14() {}
+        public void m6_15() {}
+        public void m6_16() {}
+        public void m6_17() {}
+        public void m6_18() {}
+        public void m6_19() {}
+        public void m6_20() {}
+        public void m6_21() {}
+        public void m6_22() {}
+        public void m6_23() {}
+    }
+    static class Level7 extends Level6 {
+        public void b0() {}
+        public void b1() {}
+        public void b2() {}
+        public void b3() {}
+        public void b4() {}
+        public void b5() {}
+        public void b6() {}
+        public void b7() {}
+        public void m7_0() {}
+        public void m7_1() {}
+        public void m7_2() {}
+        public void m7_3() {}
+        public void m7_4() {}
+        public void m7_5() {}
+        public void m7_6() {}
+        public void m7_7() {}
+        public void m7_8() {}
+        public void m7_9() {}
+        public void m7_10() {}
+        public void m7_11() {}
+        public void m7_12() {}
+        public void m7_13() {}
+        public void m7_14() {}
+        public void m7_15() {}
+        public void m7_16() {}
+        public void m7_17() {}
+        public void m7_18() {}
+        public void m7_19() {}
+        public void m7_20() {}
+        public void m7_21() {}
+        public void m7_22() {}
+        public void m7_23() {}
+    }
+    static class Level8 extends Level7 {
+        public void b0() {}
+        public void b1() {}
+        public void b2() {}
+        public void b3() {}
+        public void b4() {}
+        public void b5() {}
+        public void b6() {}
+        public void b7() {}
+        public void m8_0() {}
+        public void m8_1() {}
+        public void m8_2() {}
+        public void m8_3() {}
+        public void m8_4() {}
+        public void m8_5() {}
+        public void m8_6() {}
+        public void m8_7() {}
+        public void m8_8() {}
+        public void m8_9() {}
+        public void m8_10() {}
+        public void m8_11() {}
+        public void m8_12() {}
+        public void m8_13() {}
+        public void m8_14() {}
+        public void m8_15() {}
+        public void m8_16() {}
+        public void m8_17() {}
+        public void m8_18() {}
+        public void m8_19() {}
+        public void m8_20() {}
+        public void m8_21() {}
+        public void m8_22() {}
+        public void m8_23() {}
+    }
+    static class Level9 extends Level8 {
+        public void b0() {}
+        public void b1() {}
+        public void b2() {}
+        public void b3() {}
+        public void b4() {}
+        public void b5() {}
+        public void b6() {}
+        public void b7() {}
+        public void m9_0() {}
+        public void m9_1() {}
+        public void m9_2() {}
+        public void m9_3() {}
+        public void m9_4() {}
+        public void m9_5() {}
+        public void m9_6() {}
+        public void m9_7() {}
+        public void m9_8() {}
+        public void m9_9() {}
+        public void m9_10() {}
+        public void m9_11() {}
+        public void m9_12() {}
+        public void m9_13() {}
+        public void m9_14() {}
+        public void m9_15() {}
+        public void m9_16() {}
+        public void m9_17() {}
+        public void m9_18() {}
+        public void m9_19() {}
+        public void m9_20() {}
+        public void m9_21() {}
+        public void m9_22() {}
+        public void m9_23() {}
+    }
+    static class Level10 extends Level9 {
+        public void b0() {}
+        public void b1() {}
+        public void b2() {}
+        public void b3() {}
+        public void b4() {}
+        public void b5() {}
+        public void b6() {}
+        public void b7() {}
+        public void m10_0() {}
+        public void m10_1() {}
+        public void m10_2() {}
+        public void m10_3() {}
+        public void m10_4() {}
+        public void m10_5() {}
+        public void m10_6() {}
+        public void m10_7() {}
+        public void m10_8() {}
+        public void m10_9() {}
+        public void m10_10() {}
+        public void m10_11() {}
+        public void m10_12() {}
+        public void m10_13() {}
+        public void m10_14() {}
+        public void m10_15() {}
+        public void m10_16() {}
+        public void m10_17() {}
+        public void m10_18() {}
+        public void m10_19() {}
+        public void m10_20() {}
+        public void m10_21() {}
+        public void m10_22() {}
+        public void m10_23() {}
+    }
+    static class Level11 extends Level10 implements Base {
+        public void b0() {}
+        public void b1() {}
+        public void b2() {}
+        public void b3() {}
+        public void b4() {}
+        public void b5() {}
+        public void b6() {}
+        public void b7() {}
+        public void m11_0() {}
+        public void m11_1() {}
+        public void m11_2() {}
+        public void m11_3() {}
+        public void m11_4() {}
+        public void m11_5() {}
+        public void m11_6() {}
+        public void m11_7() {}
+        public void m11_8() {}
+        public void m11_9() {}
+        public void m11_10() {}
+        public void m11_11() {}
+        public void m11_12() {}
+        public void m11_13() {}
+        public void m11_14() {}
+        public void m11_15() {}
+        public void m11_16() {}
+        public void m11_17() {}
+        public void m11_18() {}
+        public void m11_19() {}
+        public void m11_20() {}
+        public void m11_21() {}
+        public void m11_22() {}
+        public void m11_23() {}
+    }
+}
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 
+import dalvik.annotation.optimization.CriticalNative;
+import dalvik.annotation.optimization.FastNative;
+
 class MyClassNatives {
     native void throwException();
     native void foo();
@@ -98,4 +101,11 @@ class MyClassNatives {
     static native boolean returnTrue();
     static native boolean returnFalse();
     static native int returnInt();
+
+    @FastNative
+    native int fastII(int x, int y);
+    @CriticalNative
+    static native long criticalSJI(long x, int y);
+    @CriticalNative
+    static native double criticalSIDIF(int i1, double d, int i2, float f);
 }